@@ -0,0 +1,137 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2023  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <kitty/partial_truth_table.hpp>
+#include <lorina/genlib.hpp>
+#include <mockturtle/algorithms/cut_enumeration.hpp>
+#include <mockturtle/algorithms/emap.hpp>
+#include <mockturtle/algorithms/functional_reduction.hpp>
+#include <mockturtle/algorithms/lut_mapper.hpp>
+#include <mockturtle/algorithms/node_resynthesis/xag_npn.hpp>
+#include <mockturtle/algorithms/rewrite.hpp>
+#include <mockturtle/algorithms/sim_resub.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/io/genlib_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/utils/node_map.hpp>
+#include <mockturtle/utils/tech_library.hpp>
+
+#include "bench.hpp"
+
+using namespace mockturtle;
+
+namespace
+{
+
+bench::registration simulation( "simulate_nodes", []( bench::context const& ctx ) {
+  auto const& aig = ctx.aig;
+  partial_simulator sim( aig.num_pis(), 4096u );
+  unordered_node_map<kitty::partial_truth_table, aig_network> tts( aig );
+  return bench::measure( aig.num_gates(), [&]() {
+    simulate_nodes( aig, tts, sim, true );
+  } );
+} );
+
+bench::registration cuts( "cut_enumeration", []( bench::context const& ctx ) {
+  auto const& aig = ctx.aig;
+  cut_enumeration_params ps;
+  ps.cut_size = 6u;
+  ps.cut_limit = 8u;
+  return bench::measure( aig.num_gates(), [&]() {
+    auto const cuts = cut_enumeration( aig, ps );
+    (void)cuts;
+  } );
+} );
+
+bench::registration lut_mapping( "lut_map", []( bench::context const& ctx ) {
+  auto aig = ctx.aig.clone();
+  lut_map_params ps;
+  ps.cut_enumeration_ps.cut_size = 6u;
+  ps.cut_enumeration_ps.cut_limit = 8u;
+  return bench::measure( aig.num_gates(), [&]() {
+    auto const klut = lut_map( aig, ps );
+    (void)klut;
+  } );
+} );
+
+bench::registration technology_mapping( "emap", []( bench::context const& ctx ) {
+  /* the library is constructed once for all benchmarks */
+  static std::unique_ptr<tech_library<9>> library;
+  if ( !library )
+  {
+    std::vector<gate> gates;
+    std::ifstream in( bench::cell_library_path( "multioutput" ) );
+    if ( lorina::read_genlib( in, genlib_reader( gates ) ) != lorina::return_code::success )
+    {
+      throw std::runtime_error( "cannot read the cell library" );
+    }
+    library = std::make_unique<tech_library<9>>( gates );
+  }
+
+  auto const& aig = ctx.aig;
+  emap_params ps;
+  ps.map_multioutput = true;
+  return bench::measure( aig.num_gates(), [&]() {
+    auto const res = emap<9>( aig, *library, ps );
+    (void)res;
+  } );
+} );
+
+bench::registration rewriting( "rewrite", []( bench::context const& ctx ) {
+  using resyn_t = xag_npn_resynthesis<aig_network, xag_network, xag_npn_db_kind::aig_complete>;
+  static resyn_t resyn;
+  static exact_library<aig_network> library( resyn );
+
+  auto aig = ctx.aig.clone();
+  return bench::measure( aig.num_gates(), [&]() {
+    rewrite( aig, library );
+  } );
+} );
+
+bench::registration fraig( "functional_reduction", []( bench::context const& ctx ) {
+  auto aig = ctx.aig.clone();
+  return bench::measure( aig.num_gates(), [&]() {
+    functional_reduction( aig );
+  } );
+} );
+
+bench::registration simulation_guided_resub( "sim_resubstitution", []( bench::context const& ctx ) {
+  auto aig = ctx.aig.clone();
+  resubstitution_params ps;
+  ps.max_inserts = 20u;
+  ps.max_pis = 8u;
+  return bench::measure( aig.num_gates(), [&]() {
+    sim_resubstitution( aig, ps );
+  } );
+} );
+
+} // namespace
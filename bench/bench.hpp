@@ -0,0 +1,165 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2023  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file bench.hpp
+  \brief Framework for microbenchmarks with regression checks
+
+  A benchmark case measures one operation on a network read from an AIGER
+  file.  Cases are registered with `bench::registration` and run by the
+  `mockturtle_bench` driver, which writes the throughput and the peak
+  resident set size of each case into a JSON file, and compares them to
+  the results of a baseline run.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+#if defined( __APPLE__ )
+#include <sys/resource.h>
+#endif
+
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+
+namespace bench
+{
+
+/*! \brief Input of a benchmark case. */
+struct context
+{
+  /*! \brief Name of the benchmark (e.g., `adder`). */
+  std::string benchmark;
+
+  /*! \brief Path to the AIGER file of the benchmark. */
+  std::string path;
+
+  /*! \brief The benchmark read into an AIG. */
+  mockturtle::aig_network const& aig;
+};
+
+/*! \brief Result of one run of a benchmark case.
+ *
+ * `time` only contains the measured operation (without setup), and
+ * `items` is the amount of work done by it (e.g., the number of gates),
+ * such that the throughput is `items / time`.
+ */
+struct sample
+{
+  uint64_t items{ 0u };
+  mockturtle::stopwatch<>::duration time{ 0 };
+};
+
+/*! \brief Measures `fn` and returns a sample with `items` units of work. */
+template<class Fn>
+sample measure( uint64_t items, Fn&& fn )
+{
+  sample s;
+  s.items = items;
+  mockturtle::call_with_stopwatch( s.time, fn );
+  return s;
+}
+
+struct bench_case
+{
+  std::string name;
+  std::function<sample( context const& )> fn;
+};
+
+inline std::vector<bench_case>& registry()
+{
+  static std::vector<bench_case> cases;
+  return cases;
+}
+
+/*! \brief Registers a benchmark case (to be used at namespace scope). */
+struct registration
+{
+  registration( std::string const& name, std::function<sample( context const& )> fn )
+  {
+    registry().push_back( { name, std::move( fn ) } );
+  }
+};
+
+/*! \brief Path to the AIGER file of a bundled benchmark. */
+inline std::string benchmark_path( std::string const& benchmark )
+{
+#ifndef BENCHMARKS_PATH
+  return benchmark + ".aig";
+#else
+  return std::string( BENCHMARKS_PATH ) + "/" + benchmark + ".aig";
+#endif
+}
+
+/*! \brief Path to a bundled cell library. */
+inline std::string cell_library_path( std::string const& library )
+{
+#ifndef CELL_LIBRARIES_PATH
+  return library + ".genlib";
+#else
+  return std::string( CELL_LIBRARIES_PATH ) + "/" + library + ".genlib";
+#endif
+}
+
+/*! \brief Resets the peak resident set size of the process (Linux only). */
+inline void reset_peak_rss()
+{
+#if defined( __linux__ )
+  std::ofstream clear_refs( "/proc/self/clear_refs" );
+  clear_refs << "5";
+#endif
+}
+
+/*! \brief Peak resident set size of the process in KiB (0 if unknown). */
+inline uint64_t peak_rss_kb()
+{
+#if defined( __linux__ )
+  std::ifstream status( "/proc/self/status" );
+  std::string line;
+  while ( std::getline( status, line ) )
+  {
+    if ( line.rfind( "VmHWM:", 0 ) == 0 )
+    {
+      return std::stoull( line.substr( 6 ) );
+    }
+  }
+  return 0u;
+#elif defined( __APPLE__ )
+  struct rusage usage;
+  getrusage( RUSAGE_SELF, &usage );
+  return usage.ru_maxrss / 1024u;
+#else
+  return 0u;
+#endif
+}
+
+} // namespace bench
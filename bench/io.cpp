@@ -0,0 +1,126 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2023  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include <lorina/aiger.hpp>
+#include <lorina/verilog.hpp>
+#include <mockturtle/io/aiger_loader.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/io/serialize.hpp>
+#include <mockturtle/io/verilog_reader.hpp>
+#include <mockturtle/io/write_aiger.hpp>
+#include <mockturtle/io/write_blif.hpp>
+#include <mockturtle/io/write_verilog.hpp>
+#include <mockturtle/networks/aig.hpp>
+
+#include "bench.hpp"
+
+using namespace mockturtle;
+
+namespace
+{
+
+template<class Fn>
+void check( Fn&& fn )
+{
+  if ( !fn() )
+  {
+    throw std::runtime_error( "reading the benchmark failed" );
+  }
+}
+
+bench::registration aiger_file( "read_aiger", []( bench::context const& ctx ) {
+  aig_network aig;
+  return bench::measure( ctx.aig.num_gates(), [&]() {
+    check( [&]() { return lorina::read_aiger( ctx.path, aiger_reader( aig ) ) == lorina::return_code::success; } );
+  } );
+} );
+
+bench::registration aiger_load( "load_aiger", []( bench::context const& ctx ) {
+  aig_network aig;
+  return bench::measure( ctx.aig.num_gates(), [&]() {
+    check( [&]() { return load_aiger( ctx.path, aig ); } );
+  } );
+} );
+
+bench::registration aiger_load_unhashed( "load_aiger_unhashed", []( bench::context const& ctx ) {
+  load_aiger_params ps;
+  ps.strash = false;
+
+  aig_network aig;
+  return bench::measure( ctx.aig.num_gates(), [&]() {
+    check( [&]() { return load_aiger( ctx.path, aig, ps ); } );
+  } );
+} );
+
+bench::registration aiger_stream( "write_aiger", []( bench::context const& ctx ) {
+  std::ostringstream os;
+  return bench::measure( ctx.aig.num_gates(), [&]() {
+    write_aiger( ctx.aig, os );
+  } );
+} );
+
+bench::registration verilog_stream( "write_verilog", []( bench::context const& ctx ) {
+  std::ostringstream os;
+  return bench::measure( ctx.aig.num_gates(), [&]() {
+    os.str( "" );
+    write_verilog( ctx.aig, os );
+  } );
+} );
+
+bench::registration blif_stream( "write_blif", []( bench::context const& ctx ) {
+  std::ostringstream os;
+  return bench::measure( ctx.aig.num_gates(), [&]() {
+    os.str( "" );
+    write_blif( ctx.aig, os );
+  } );
+} );
+
+bench::registration verilog( "read_verilog", []( bench::context const& ctx ) {
+  std::ostringstream os;
+  write_verilog( ctx.aig, os );
+  std::istringstream is( os.str() );
+
+  aig_network aig;
+  return bench::measure( ctx.aig.num_gates(), [&]() {
+    check( [&]() { return lorina::read_verilog( is, verilog_reader( aig ) ) == lorina::return_code::success; } );
+  } );
+} );
+
+bench::registration snapshot( "deserialize_network", []( bench::context const& ctx ) {
+  std::stringstream ss;
+  serialize_network( ctx.aig, ss );
+
+  aig_network aig;
+  return bench::measure( ctx.aig.num_gates(), [&]() {
+    check( [&]() { return deserialize_network( ss, aig ); } );
+  } );
+} );
+
+} // namespace
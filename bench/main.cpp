@@ -0,0 +1,408 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2023  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+  Driver of the microbenchmarks.
+
+  Runs all registered cases (or those selected with `--case`) on the
+  given benchmarks, writes the results as JSON, and, if a baseline is
+  given with `--baseline`, reports the cases that became slower or use
+  more memory than the tolerance allows.  The exit code is 1 if there
+  is such a regression, such that the driver can be used in scripts.
+
+  On POSIX systems, each case runs in its own child process, which also
+  reads the benchmark, such that its peak resident set size is neither
+  hidden by the memory of earlier cases nor includes the networks of the
+  other benchmarks.
+
+  Example:
+
+    ./bench/mockturtle_bench --output baseline.json
+    (change and rebuild)
+    ./bench/mockturtle_bench --baseline baseline.json --output current.json
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+#include <nlohmann/json.hpp>
+
+#include "bench.hpp"
+
+namespace
+{
+
+/* small to medium-sized EPFL benchmarks, such that all cases run in a few minutes */
+std::vector<std::string> const default_benchmarks = { "adder", "bar", "max", "multiplier", "sin", "cavlc", "ctrl", "dec", "i2c", "int2float", "priority", "router" };
+
+/* bound on the number of runs of very fast cases */
+constexpr uint32_t max_runs = 1000u;
+
+struct options
+{
+  std::vector<std::string> benchmarks;
+  std::vector<std::string> cases;
+  uint32_t repeats{ 3u };
+  double min_time{ 0.2 };
+  std::string output{ "bench.json" };
+  std::string baseline;
+  double tolerance{ 0.10 };
+  bool list{ false };
+};
+
+void print_usage()
+{
+  fmt::print( "usage: mockturtle_bench [options] [benchmark ...]\n"
+              "  -c, --case NAME        run the cases whose name contains NAME (can be repeated)\n"
+              "  -r, --repeats N        minimum runs per case, the fastest one is reported (default: 3)\n"
+              "  -m, --min-time S       minimum total time per case in seconds (default: 0.2)\n"
+              "  -o, --output FILE      write the results to FILE (default: bench.json)\n"
+              "  -b, --baseline FILE    compare the results to a previous output\n"
+              "  -t, --tolerance X      relative slowdown reported as regression (default: 0.10)\n"
+              "  -l, --list             list the cases\n" );
+}
+
+bool parse_options( int argc, char* argv[], options& opts )
+{
+  for ( auto i = 1; i < argc; ++i )
+  {
+    std::string const arg = argv[i];
+    auto const value = [&]() -> char const* {
+      return i + 1 < argc ? argv[++i] : nullptr;
+    };
+
+    if ( arg == "-h" || arg == "--help" )
+    {
+      return false;
+    }
+    else if ( arg == "-l" || arg == "--list" )
+    {
+      opts.list = true;
+    }
+    else if ( arg == "-c" || arg == "--case" || arg == "-r" || arg == "--repeats" || arg == "-m" || arg == "--min-time" || arg == "-o" || arg == "--output" ||
+              arg == "-b" || arg == "--baseline" || arg == "-t" || arg == "--tolerance" )
+    {
+      auto const v = value();
+      if ( v == nullptr )
+      {
+        fmt::print( "[e] missing value for {}\n", arg );
+        return false;
+      }
+
+      if ( arg == "-c" || arg == "--case" )
+        opts.cases.push_back( v );
+      else if ( arg == "-r" || arg == "--repeats" )
+        opts.repeats = std::max( 1, std::atoi( v ) );
+      else if ( arg == "-m" || arg == "--min-time" )
+        opts.min_time = std::atof( v );
+      else if ( arg == "-o" || arg == "--output" )
+        opts.output = v;
+      else if ( arg == "-b" || arg == "--baseline" )
+        opts.baseline = v;
+      else
+        opts.tolerance = std::atof( v );
+    }
+    else if ( !arg.empty() && arg[0] == '-' )
+    {
+      fmt::print( "[e] unknown option {}\n", arg );
+      return false;
+    }
+    else
+    {
+      opts.benchmarks.push_back( arg );
+    }
+  }
+
+  if ( opts.benchmarks.empty() )
+  {
+    opts.benchmarks = default_benchmarks;
+  }
+  return true;
+}
+
+struct case_result
+{
+  uint64_t gates;
+  uint64_t items;
+  double seconds;
+  uint64_t peak_rss_kb;
+};
+
+/* reads the benchmark and runs a case on it at least `repeats` times and
+   for at least `min_time` seconds, and keeps the fastest run */
+std::optional<case_result> run_case( bench::bench_case const& c, std::string const& benchmark, options const& opts )
+{
+  auto const path = bench::benchmark_path( benchmark );
+  mockturtle::aig_network aig;
+  if ( lorina::read_aiger( path, mockturtle::aiger_reader( aig ) ) != lorina::return_code::success )
+  {
+    return std::nullopt;
+  }
+
+  bench::context const ctx{ benchmark, path, aig };
+  bench::reset_peak_rss();
+
+  bench::sample best;
+  double total{ 0.0 };
+  for ( auto i = 0u; i < opts.repeats || ( total < opts.min_time && i < max_runs ); ++i )
+  {
+    auto const s = c.fn( ctx );
+    total += mockturtle::to_seconds( s.time );
+    if ( i == 0u || s.time < best.time )
+    {
+      best = s;
+    }
+  }
+
+  return case_result{ aig.num_gates(), best.items, mockturtle::to_seconds( best.time ), bench::peak_rss_kb() };
+}
+
+/* runs `fn` in a child process on POSIX systems, such that the peak memory
+   of a case does not include the memory held by earlier cases, and such
+   that a crashing case does not stop the driver */
+template<class Fn>
+std::optional<case_result> run_isolated( Fn&& fn )
+{
+#if defined( __unix__ ) || defined( __APPLE__ )
+  int fds[2];
+  if ( pipe( fds ) != 0 )
+  {
+    return fn();
+  }
+
+  std::cout.flush();
+  auto const pid = fork();
+  if ( pid < 0 )
+  {
+    close( fds[0] );
+    close( fds[1] );
+    return fn();
+  }
+  if ( pid == 0 )
+  {
+    close( fds[0] );
+    auto const r = fn();
+    auto const written = r ? write( fds[1], &*r, sizeof( *r ) ) : 0;
+    close( fds[1] );
+    _exit( written == sizeof( case_result ) ? 0 : 1 );
+  }
+
+  close( fds[1] );
+  case_result r;
+  auto const num_read = read( fds[0], &r, sizeof( r ) );
+  close( fds[0] );
+
+  int status{ 0 };
+  waitpid( pid, &status, 0 );
+  if ( num_read != sizeof( r ) || !WIFEXITED( status ) || WEXITSTATUS( status ) != 0 )
+  {
+    return std::nullopt;
+  }
+  return r;
+#else
+  return fn();
+#endif
+}
+
+bool selected( options const& opts, std::string const& name )
+{
+  return opts.cases.empty() || std::any_of( opts.cases.begin(), opts.cases.end(), [&]( auto const& c ) {
+           return name.find( c ) != std::string::npos;
+         } );
+}
+
+nlohmann::json const* find_result( nlohmann::json const& results, std::string const& name, std::string const& benchmark )
+{
+  for ( auto const& r : results )
+  {
+    if ( r["case"] == name && r["benchmark"] == benchmark )
+    {
+      return &r;
+    }
+  }
+  return nullptr;
+}
+
+/* returns the number of regressions, cases missing from the baseline are reported but are not regressions */
+uint32_t compare( nlohmann::json const& baseline, nlohmann::json const& current, double tolerance )
+{
+  fmt::print( "[i] compare {} to {} (tolerance {:.0f}%)\n", baseline["version"].get<std::string>(), current["version"].get<std::string>(), 100.0 * tolerance );
+  fmt::print( "| {:>20} | {:>12} | {:>12} | {:>12} | {:>7} | {:>9} | {:>9} | {:>10} |\n",
+              "case", "benchmark", "items/s", "items/s'", "speedup", "peak MB", "peak MB'", "" );
+
+  uint32_t regressions{ 0u };
+  uint32_t missing{ 0u };
+  for ( auto const& r : current["results"] )
+  {
+    auto const* b = find_result( baseline["results"], r["case"], r["benchmark"] );
+    if ( b == nullptr )
+    {
+      ++missing;
+      fmt::print( "| {:>20} | {:>12} | {:>12} | {:>12.0f} | {:>7} | {:>9} | {:>9.1f} | {:>10} |\n",
+                  r["case"].get<std::string>(), r["benchmark"].get<std::string>(), "-", r["throughput"].get<double>(),
+                  "-", "-", r["peak_rss_mb"].get<double>(), "MISSING" );
+      continue;
+    }
+
+    auto const speedup = r["throughput"].get<double>() / std::max( ( *b )["throughput"].get<double>(), 1e-9 );
+    auto const rss = r["peak_rss_mb"].get<double>();
+    auto const rss_base = ( *b )["peak_rss_mb"].get<double>();
+
+    /* differences below 0.1 ms and 1 MB are ignored as noise */
+    bool const slower = speedup * ( 1.0 + tolerance ) < 1.0 && r["seconds"].get<double>() - ( *b )["seconds"].get<double>() > 1e-4;
+    bool const larger = rss > rss_base * ( 1.0 + tolerance ) && rss - rss_base > 1.0;
+    regressions += ( slower || larger ) ? 1u : 0u;
+
+    fmt::print( "| {:>20} | {:>12} | {:>12.0f} | {:>12.0f} | {:>7.2f} | {:>9.1f} | {:>9.1f} | {:>10} |\n",
+                r["case"].get<std::string>(), r["benchmark"].get<std::string>(), ( *b )["throughput"].get<double>(), r["throughput"].get<double>(),
+                speedup, rss_base, rss, slower ? "SLOWER" : ( larger ? "MEMORY" : "" ) );
+  }
+
+  if ( missing != 0u )
+  {
+    fmt::print( "[w] {} cases are missing from the baseline\n", missing );
+  }
+
+  if ( regressions == 0u )
+  {
+    fmt::print( "[i] no regressions\n" );
+  }
+  else
+  {
+    fmt::print( "[w] {} regressions\n", regressions );
+  }
+  return regressions;
+}
+
+} // namespace
+
+int main( int argc, char* argv[] )
+{
+  options opts;
+  if ( !parse_options( argc, argv, opts ) )
+  {
+    print_usage();
+    return 2;
+  }
+
+  auto cases = bench::registry();
+  std::sort( cases.begin(), cases.end(), []( auto const& a, auto const& b ) { return a.name < b.name; } );
+
+  if ( opts.list )
+  {
+    for ( auto const& c : cases )
+    {
+      fmt::print( "{}\n", c.name );
+    }
+    return 0;
+  }
+
+  nlohmann::json results = nlohmann::json::array();
+  fmt::print( "| {:>20} | {:>12} | {:>8} | {:>10} | {:>12} | {:>9} |\n", "case", "benchmark", "gates", "time [s]", "items/s", "peak MB" );
+
+  for ( auto const& benchmark : opts.benchmarks )
+  {
+    auto const path = bench::benchmark_path( benchmark );
+    if ( !std::ifstream( path ).good() )
+    {
+      fmt::print( "[w] cannot read {}\n", path );
+      continue;
+    }
+
+    for ( auto const& c : cases )
+    {
+      if ( !selected( opts, c.name ) )
+        continue;
+
+      auto const r = run_isolated( [&]() { return run_case( c, benchmark, opts ); } );
+      if ( !r )
+      {
+        fmt::print( "[w] case {} failed on {}\n", c.name, benchmark );
+        continue;
+      }
+
+      auto const seconds = r->seconds;
+      auto const throughput = r->items / std::max( seconds, 1e-9 );
+      auto const peak_rss_mb = r->peak_rss_kb / 1024.0;
+      fmt::print( "| {:>20} | {:>12} | {:>8} | {:>10.4f} | {:>12.0f} | {:>9.1f} |\n", c.name, benchmark, r->gates, seconds, throughput, peak_rss_mb );
+
+      results.push_back( { { "case", c.name },
+                           { "benchmark", benchmark },
+                           { "gates", r->gates },
+                           { "items", r->items },
+                           { "seconds", seconds },
+                           { "throughput", throughput },
+                           { "peak_rss_mb", peak_rss_mb } } );
+    }
+  }
+
+#ifdef GIT_SHORT_REVISION
+  std::string const version = GIT_SHORT_REVISION;
+#else
+  std::string const version = "unknown";
+#endif
+  nlohmann::json const current = { { "version", version }, { "repeats", opts.repeats }, { "results", results } };
+
+  std::ofstream os( opts.output );
+  os << current.dump( 2 ) << "\n";
+
+  if ( !opts.baseline.empty() )
+  {
+    std::ifstream in( opts.baseline );
+    if ( !in.good() )
+    {
+      fmt::print( "[e] cannot read baseline {}\n", opts.baseline );
+      return 2;
+    }
+
+    try
+    {
+      return compare( nlohmann::json::parse( in ), current, opts.tolerance ) == 0u ? 0 : 1;
+    }
+    catch ( nlohmann::json::exception const& e )
+    {
+      fmt::print( "[e] invalid baseline {}: {}\n", opts.baseline, e.what() );
+      return 2;
+    }
+  }
+
+  return 0;
+}
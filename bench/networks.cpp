@@ -0,0 +1,112 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2023  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/views/fanout_view.hpp>
+
+#include "bench.hpp"
+
+using namespace mockturtle;
+
+namespace
+{
+
+/* rebuilds the AIG gate by gate into a new network (strash misses) */
+bench::registration create_and( "create_and", []( bench::context const& ctx ) {
+  auto const& aig = ctx.aig;
+  aig_network res;
+  std::vector<aig_network::signal> old2new( aig.size() );
+  return bench::measure( aig.num_gates(), [&]() {
+    old2new[0] = res.get_constant( false );
+    aig.foreach_pi( [&]( auto const& n ) {
+      old2new[n] = res.create_pi();
+    } );
+    aig.foreach_gate( [&]( auto const& n ) {
+      std::array<aig_network::signal, 2> fanins;
+      aig.foreach_fanin( n, [&]( auto const& f, auto i ) {
+        fanins[i] = old2new[aig.get_node( f )] ^ aig.is_complemented( f );
+      } );
+      old2new[n] = res.create_and( fanins[0], fanins[1] );
+    } );
+  } );
+} );
+
+/* looks up all gates of the AIG in its own strash table (strash hits) */
+bench::registration strash_lookup( "strash_lookup", []( bench::context const& ctx ) {
+  auto aig = ctx.aig.clone();
+  uint64_t found{ 0u };
+  auto const s = bench::measure( aig.num_gates(), [&]() {
+    aig.foreach_gate( [&]( auto const& n ) {
+      std::array<aig_network::signal, 2> fanins;
+      aig.foreach_fanin( n, [&]( auto const& f, auto i ) {
+        fanins[i] = f;
+      } );
+      found += aig.has_and( fanins[0], fanins[1] ).has_value();
+    } );
+  } );
+  if ( found != aig.num_gates() )
+  {
+    throw std::runtime_error( "gate not found in the strash table" );
+  }
+  return s;
+} );
+
+bench::registration foreach_fanin( "foreach_fanin", []( bench::context const& ctx ) {
+  auto const& aig = ctx.aig;
+  uint32_t const num_passes = 10u;
+  uint64_t checksum{ 0u };
+  auto const s = bench::measure( uint64_t( num_passes ) * aig.num_gates(), [&]() {
+    for ( auto i = 0u; i < num_passes; ++i )
+    {
+      aig.foreach_gate( [&]( auto const& n ) {
+        aig.foreach_fanin( n, [&]( auto const& f ) {
+          checksum += aig.node_to_index( aig.get_node( f ) );
+        } );
+      } );
+    }
+  } );
+  /* keeps the traversal from being optimized away */
+  if ( checksum == 0u && aig.num_gates() > 0u )
+  {
+    std::abort();
+  }
+  return s;
+} );
+
+bench::registration fanout_view_construction( "fanout_view", []( bench::context const& ctx ) {
+  auto const& aig = ctx.aig;
+  return bench::measure( aig.num_gates(), [&]() {
+    fanout_view<aig_network> fanout_aig{ aig };
+    (void)fanout_aig;
+  } );
+} );
+
+} // namespace
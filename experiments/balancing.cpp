@@ -64,7 +64,7 @@ int main()
     const uint32_t size_after = balanced_xag.num_gates();
     const uint32_t depth_after = depth_view{ balanced_xag }.depth();
 
-    auto const cec = benchmark == "hyp" ? true : abc_cec( balanced_xag, benchmark );
+    auto const cec = benchmark == "hyp" ? true : native_cec( balanced_xag, benchmark );
 
     exp( benchmark, size_before, depth_before, size_after, depth_after, to_seconds( st.time_total ), cec );
   }
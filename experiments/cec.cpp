@@ -0,0 +1,90 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2023  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <optional>
+#include <string>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/aig_balancing.hpp>
+#include <mockturtle/algorithms/cec.hpp>
+#include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/algorithms/equivalence_checking.hpp>
+#include <mockturtle/algorithms/miter.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+
+#include <experiments.hpp>
+
+std::string to_string( std::optional<bool> const& result )
+{
+  return result ? ( *result ? "EQ" : "NEQ" ) : "UNDEC";
+}
+
+/* Compares solving the whole miter at once against SAT sweeping on the miter
+   of each benchmark and its balanced version. */
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, uint32_t, uint32_t, std::string, float, std::string, float, uint32_t, uint32_t, uint32_t>
+      exp( "cec", "benchmark", "size", "miter size", "monolithic", "runtime mono", "sweeping", "runtime sweep", "SAT calls", "FE pairs", "CEX" );
+
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+
+    aig_network aig;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+
+    aig_network opt = cleanup_dangling( aig );
+    aig_balance( opt );
+
+    auto const miter_ntk = *miter<xag_network>( aig, opt );
+
+    equivalence_checking_params ps_mono;
+    ps_mono.functional_reduction = false;
+    ps_mono.conflict_limit = 100000u;
+    stopwatch<>::duration time_mono{ 0 };
+    auto const result_mono = call_with_stopwatch( time_mono, [&]() { return equivalence_checking( miter_ntk, ps_mono ); } );
+
+    cec_stats st;
+    auto const result_sweep = cec( miter_ntk, {}, &st );
+
+    exp( benchmark, aig.num_gates(), miter_ntk.num_gates(), to_string( result_mono ), to_seconds( time_mono ),
+         to_string( result_sweep ), to_seconds( st.time_total ), st.num_sat_calls, st.num_equ_proved, st.num_cex );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
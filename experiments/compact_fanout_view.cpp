@@ -0,0 +1,109 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2023  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <string>
+#include <vector>
+
+#if defined( __GLIBC__ )
+#include <malloc.h>
+#endif
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+#include <mockturtle/views/compact_fanout_view.hpp>
+#include <mockturtle/views/fanout_view.hpp>
+
+#include <experiments.hpp>
+
+/* Visits all fanouts of all nodes and returns a checksum to compare the traversal
+   cost of the two fanout views. */
+template<class Ntk>
+uint64_t traverse_fanouts( Ntk const& ntk )
+{
+  uint64_t checksum = 0u;
+  ntk.foreach_node( [&]( auto const& n ) {
+    ntk.foreach_fanout( n, [&]( auto const& p ) {
+      checksum += ntk.node_to_index( p );
+    } );
+  } );
+  return checksum;
+}
+
+/* Returns the number of heap bytes currently in use (0 if unknown). */
+inline uint64_t heap_bytes()
+{
+#if defined( __GLIBC__ ) && ( __GLIBC__ > 2 || ( __GLIBC__ == 2 && __GLIBC_MINOR__ >= 33 ) )
+  return mallinfo2().uordblks;
+#else
+  return 0u;
+#endif
+}
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, uint32_t, float, float, float, float, float, float, bool>
+      exp( "compact_fanout_view", "benchmark", "size", "build vector", "build compact", "traverse vector", "traverse compact", "MB vector", "MB compact", "identical" );
+
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+
+    aig_network aig;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+
+    stopwatch<>::duration time_build_vector{ 0 }, time_build_compact{ 0 };
+    auto const heap_before = heap_bytes();
+    auto const fanout_aig = call_with_stopwatch( time_build_vector, [&]() { return fanout_view{ aig }; } );
+    auto const heap_vector = heap_bytes();
+    auto const compact_aig = call_with_stopwatch( time_build_compact, [&]() { return compact_fanout_view{ aig }; } );
+    auto const heap_compact = heap_bytes();
+
+    stopwatch<>::duration time_traverse_vector{ 0 }, time_traverse_compact{ 0 };
+    uint64_t checksum_vector{ 0 }, checksum_compact{ 0 };
+    for ( auto i = 0u; i < 10u; ++i )
+    {
+      checksum_vector += call_with_stopwatch( time_traverse_vector, [&]() { return traverse_fanouts( fanout_aig ); } );
+      checksum_compact += call_with_stopwatch( time_traverse_compact, [&]() { return traverse_fanouts( compact_aig ); } );
+    }
+
+    exp( benchmark, aig.num_gates(), to_seconds( time_build_vector ), to_seconds( time_build_compact ),
+         to_seconds( time_traverse_vector ), to_seconds( time_traverse_compact ),
+         ( heap_vector - heap_before ) / double( 1 << 20 ), ( heap_compact - heap_vector ) / double( 1 << 20 ), checksum_vector == checksum_compact );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
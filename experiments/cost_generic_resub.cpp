@@ -65,7 +65,7 @@ int main()
 
     auto cost_after = cost_view( xag, costfn ).get_cost();
 
-    const auto cec = benchmark == "hyp" ? true : abc_cec( xag, benchmark );
+    const auto cec = benchmark == "hyp" ? true : native_cec( xag, benchmark );
     exp( benchmark, cost_before, cost_after, run_time, cec );
   }
   exp.save();
@@ -0,0 +1,108 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2023  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/cut_enumeration.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+
+#include <experiments.hpp>
+
+template<class NetworkCuts>
+bool identical_cuts( mockturtle::aig_network const& aig, NetworkCuts const& cuts1, NetworkCuts const& cuts2 )
+{
+  bool identical = cuts1.total_cuts() == cuts2.total_cuts();
+  aig.foreach_node( [&]( auto const& n ) {
+    auto const& set1 = cuts1.cuts( aig.node_to_index( n ) );
+    auto const& set2 = cuts2.cuts( aig.node_to_index( n ) );
+    if ( set1.size() != set2.size() )
+    {
+      identical = false;
+      return;
+    }
+    for ( auto i = 0u; i < set1.size(); ++i )
+    {
+      identical &= std::equal( set1[i].begin(), set1[i].end(), set2[i].begin(), set2[i].end() ) && set1[i]->func_id == set2[i]->func_id;
+    }
+  } );
+  return identical;
+}
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, uint32_t, uint32_t, float, float, float, float, float, bool>
+      exp( "cut_enumeration", "benchmark", "size", "depth", "time 1", "time 4", "time 16", "speedup 4", "speedup 16", "identical" );
+
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+
+    aig_network aig;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+
+    cut_enumeration_params ps;
+    ps.cut_size = 6u;
+    ps.cut_limit = 8u;
+
+    std::vector<double> times;
+    std::vector<network_cuts<aig_network, true, empty_cut_data>> results;
+    for ( auto num_threads : { 1u, 4u, 16u } )
+    {
+      ps.num_threads = num_threads;
+      stopwatch<>::duration time{ 0 };
+      results.push_back( call_with_stopwatch( time, [&]() { return cut_enumeration<aig_network, true>( aig, ps ); } ) );
+      times.push_back( to_seconds( time ) );
+    }
+
+    bool const identical = identical_cuts( aig, results[0], results[1] ) && identical_cuts( aig, results[0], results[2] );
+
+    uint32_t depth{ 0 };
+    std::vector<uint32_t> levels( aig.size(), 0u );
+    aig.foreach_gate( [&]( auto const& n ) {
+      aig.foreach_fanin( n, [&]( auto const& f ) {
+        levels[aig.node_to_index( n )] = std::max( levels[aig.node_to_index( n )], levels[aig.node_to_index( aig.get_node( f ) )] + 1 );
+      } );
+      depth = std::max( depth, levels[aig.node_to_index( n )] );
+    } );
+
+    exp( benchmark, aig.num_gates(), depth, times[0], times[1], times[2], times[0] / std::max( times[1], 1e-6 ), times[0] / std::max( times[2], 1e-6 ), identical );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
@@ -68,11 +68,11 @@ int main()
     cut_rewriting_with_compatibility_graph( aig, resyn, ps, &st );
     aig = cleanup_dangling( aig );
 
-    auto cec = abc_cec( aig, benchmark );
+    auto cec = native_cec( aig, benchmark );
 
     cut_rewriting_stats st2;
     aig2 = cut_rewriting( aig2, resyn, ps, &st2 );
-    auto cec2 = abc_cec( aig2, benchmark );
+    auto cec2 = native_cec( aig2, benchmark );
 
     exp( benchmark, size_before, aig.num_gates(), aig2.num_gates(), to_seconds( st.time_total ), to_seconds( st2.time_total ), cec, cec2 );
   }
@@ -0,0 +1,133 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2019  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+#include <mockturtle/views/depth_view.hpp>
+#include <mockturtle/views/fanout_view.hpp>
+#include <mockturtle/views/timing_view.hpp>
+#include <mockturtle/views/topo_view.hpp>
+
+#include <experiments.hpp>
+
+/* Stress test for the traversals on very deep generated circuits, which
+ * overflow the default call stack with one stack frame per level. */
+
+template<class Ntk>
+Ntk deep_adder( uint32_t bitwidth )
+{
+  Ntk ntk;
+  std::vector<typename Ntk::signal> a( bitwidth ), b( bitwidth );
+  std::generate( a.begin(), a.end(), [&]() { return ntk.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return ntk.create_pi(); } );
+  auto carry = ntk.create_pi();
+
+  mockturtle::carry_ripple_adder_inplace( ntk, a, b, carry );
+  std::for_each( a.begin(), a.end(), [&]( auto const& f ) { ntk.create_po( f ); } );
+  ntk.create_po( carry );
+  return ntk;
+}
+
+template<class Ntk>
+Ntk deep_multiplier( uint32_t bitwidth )
+{
+  Ntk ntk;
+  std::vector<typename Ntk::signal> a( bitwidth ), b( bitwidth );
+  std::generate( a.begin(), a.end(), [&]() { return ntk.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return ntk.create_pi(); } );
+
+  for ( auto const& f : mockturtle::carry_ripple_multiplier( ntk, a, b ) )
+  {
+    ntk.create_po( f );
+  }
+  return ntk;
+}
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, uint32_t, uint32_t, float, float, float, float>
+      exp( "deep_traversal", "benchmark", "size", "depth", "topo_view", "depth_view", "timing_view", "cleanup" );
+
+  std::vector<std::pair<std::string, aig_network>> circuits;
+  for ( auto bitwidth : { 25000u, 50000u, 100000u } )
+  {
+    circuits.emplace_back( fmt::format( "adder_{}", bitwidth ), deep_adder<aig_network>( bitwidth ) );
+  }
+  for ( auto bitwidth : { 128u, 256u } )
+  {
+    circuits.emplace_back( fmt::format( "multiplier_{}", bitwidth ), deep_multiplier<aig_network>( bitwidth ) );
+  }
+
+  for ( auto const& [name, aig] : circuits )
+  {
+    fmt::print( "[i] processing {}\n", name );
+
+    stopwatch<>::duration time_topo{ 0 }, time_depth{ 0 }, time_timing{ 0 }, time_cleanup{ 0 };
+
+    uint32_t const num_nodes = call_with_stopwatch( time_topo, [&]() {
+      topo_view topo{ aig };
+      return topo.size();
+    } );
+
+    uint32_t const depth = call_with_stopwatch( time_depth, [&]() {
+      depth_view depth_aig{ aig };
+      return depth_aig.depth();
+    } );
+
+    uint32_t const timing_depth = call_with_stopwatch( time_timing, [&]() {
+      fanout_view fanout_aig{ aig };
+      timing_view timing_aig{ fanout_aig };
+      return timing_aig.depth();
+    } );
+
+    uint32_t const num_gates = call_with_stopwatch( time_cleanup, [&]() {
+      return cleanup_dangling( aig ).num_gates();
+    } );
+
+    if ( num_nodes != aig.size() || timing_depth != depth || num_gates != aig.num_gates() )
+    {
+      fmt::print( "[e] inconsistent results on {}\n", name );
+      return 1;
+    }
+
+    exp( name, aig.num_gates(), depth, to_seconds( time_topo ), to_seconds( time_depth ), to_seconds( time_timing ), to_seconds( time_cleanup ) );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
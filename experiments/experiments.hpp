@@ -46,6 +46,11 @@
 
 #include <fmt/color.h>
 #include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/cec.hpp>
+#include <mockturtle/algorithms/klut_to_graph.hpp>
+#include <mockturtle/algorithms/miter.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
 #include <mockturtle/io/write_bench.hpp>
 #include <mockturtle/io/write_verilog.hpp>
 #include <nlohmann/json.hpp>
@@ -565,6 +570,40 @@ inline bool abc_cec( Ntk const& ntk, std::string const& benchmark )
   return abc_cec_impl( ntk, benchmark_path( benchmark ) );
 }
 
+/* equivalence checking against the benchmark with the SAT sweeping engine of mockturtle, without calling ABC */
+template<class Ntk>
+inline bool native_cec_impl( Ntk const& ntk, std::string const& benchmark_fullpath )
+{
+  mockturtle::aig_network aig;
+  if ( lorina::read_aiger( benchmark_fullpath, mockturtle::aiger_reader( aig ) ) != lorina::return_code::success )
+  {
+    return false;
+  }
+
+  std::optional<mockturtle::xag_network> miter_ntk;
+  if constexpr ( std::is_same_v<typename Ntk::base_type, mockturtle::klut_network> )
+  {
+    miter_ntk = mockturtle::miter<mockturtle::xag_network>( mockturtle::convert_klut_to_graph<mockturtle::xag_network>( ntk ), aig );
+  }
+  else
+  {
+    miter_ntk = mockturtle::miter<mockturtle::xag_network>( ntk, aig );
+  }
+  if ( !miter_ntk )
+  {
+    return false;
+  }
+
+  auto const result = mockturtle::cec( *miter_ntk );
+  return result && *result;
+}
+
+template<class Ntk>
+inline bool native_cec( Ntk const& ntk, std::string const& benchmark )
+{
+  return native_cec_impl( ntk, benchmark_path( benchmark ) );
+}
+
 template<class Ntk>
 inline bool abc_cec_mapped_cell_impl( Ntk const& ntk, std::string const& benchmark_full_path, std::string const& library_full_path )
 {
@@ -0,0 +1,106 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2023  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+
+#include <experiments.hpp>
+
+/* Substitutes AND gates `a & b` by the equivalent `a ^ ( a & !b )` to compare
+   substitutions using the built-in fanout index of the storage against
+   scanning all nodes of the network on each substitution. */
+template<class Ntk>
+void substitute_and_gates( Ntk& ntk, uint32_t num_substitutions )
+{
+  std::vector<typename Ntk::node> gates;
+  ntk.foreach_gate( [&]( auto const& n ) {
+    if ( ntk.is_and( n ) && gates.size() < num_substitutions )
+    {
+      gates.push_back( n );
+    }
+  } );
+
+  for ( auto const& n : gates )
+  {
+    if ( ntk.is_dead( n ) )
+      continue;
+
+    std::vector<typename Ntk::signal> fanins;
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      fanins.push_back( f );
+    } );
+    ntk.substitute_node( n, ntk.create_xor( fanins[0], ntk.create_and( fanins[0], !fanins[1] ) ) );
+  }
+}
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, uint32_t, uint32_t, uint32_t, float, float, float, bool>
+      exp( "fanout_index", "benchmark", "size", "size_after", "substitutions", "runtime scan", "runtime index", "speedup", "identical" );
+
+  uint32_t const num_substitutions = 2000u;
+
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+
+    xag_network xag;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( xag ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+
+    uint32_t const size_before = xag.num_gates();
+    xag_network xag_scan = xag.clone();
+    xag_scan.use_fanout_index( false );
+
+    stopwatch<>::duration time_scan{ 0 };
+    call_with_stopwatch( time_scan, [&]() { substitute_and_gates( xag_scan, num_substitutions ); } );
+
+    stopwatch<>::duration time_index{ 0 };
+    call_with_stopwatch( time_index, [&]() { substitute_and_gates( xag, num_substitutions ); } );
+
+    /* both networks must be structurally identical */
+    bool const identical = xag._storage->nodes == xag_scan._storage->nodes &&
+                           xag._storage->outputs == xag_scan._storage->outputs;
+
+    exp( benchmark, size_before, xag.num_gates(), std::min( size_before, num_substitutions ), to_seconds( time_scan ), to_seconds( time_index ),
+         to_seconds( time_scan ) / std::max( to_seconds( time_index ), 1e-6 ), identical );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
@@ -0,0 +1,88 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2019  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/lut_mapper.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/views/depth_view.hpp>
+
+#include <experiments.hpp>
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, uint32_t, uint32_t, uint32_t, uint32_t, float, float, float, float, float, bool, bool>
+      exp( "lut_mapper_parallel", "benchmark", "luts 1", "depth 1", "luts N", "depth N", "time 1", "time 4", "time 16", "speedup 4", "speedup 16", "identical", "equivalent" );
+
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+
+    lut_map_params ps;
+    ps.cut_enumeration_ps.cut_size = 6u;
+    ps.cut_enumeration_ps.cut_limit = 8u;
+    ps.recompute_cuts = true;
+    ps.area_oriented_mapping = false;
+    ps.cut_expansion = true;
+
+    std::vector<double> times;
+    std::vector<klut_network> kluts;
+    for ( auto num_threads : { 1u, 4u, 16u } )
+    {
+      ps.num_threads = num_threads;
+      lut_map_stats st;
+      kluts.push_back( lut_map( aig, ps, &st ) );
+      times.push_back( to_seconds( st.time_total ) );
+    }
+
+    depth_view<klut_network> klut1_d{ kluts[0] };
+    depth_view<klut_network> klutn_d{ kluts[1] };
+
+    /* the parallel mapping does not depend on the number of threads */
+    bool const identical = kluts[1].num_gates() == kluts[2].num_gates() && klutn_d.depth() == depth_view<klut_network>{ kluts[2] }.depth();
+    auto const cec = benchmark == "hyp" ? true : native_cec( kluts[2], benchmark );
+
+    exp( benchmark, kluts[0].num_gates(), klut1_d.depth(), kluts[1].num_gates(), klutn_d.depth(),
+         times[0], times[1], times[2], times[0] / std::max( times[1], 1e-6 ), times[0] / std::max( times[2], 1e-6 ), identical, cec );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
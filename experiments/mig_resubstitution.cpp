@@ -66,7 +66,7 @@ int main()
     mig_resubstitution( fanout_mig, ps, &st );
     mig = cleanup_dangling( mig );
 
-    bool const cec = benchmark == "hyp" ? true : abc_cec( fanout_mig, benchmark );
+    bool const cec = benchmark == "hyp" ? true : native_cec( fanout_mig, benchmark );
     exp( benchmark, size_before, mig.num_gates(), to_seconds( st.time_total ), cec );
   }
 
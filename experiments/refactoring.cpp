@@ -68,7 +68,7 @@ int main()
     const uint32_t size_after = aig.num_gates();
     const uint32_t depth_after = depth_view( aig ).depth();
 
-    const auto cec = benchmark == "hyp" ? true : abc_cec( aig, benchmark );
+    const auto cec = benchmark == "hyp" ? true : native_cec( aig, benchmark );
 
     exp( benchmark, size_before, size_after, depth_before, depth_after, to_seconds( st.time_total ), cec );
   }
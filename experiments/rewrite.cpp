@@ -68,7 +68,7 @@ int main()
 
     rewrite( xag, exact_lib, ps, &st );
 
-    bool const cec = benchmark == "hyp" ? true : abc_cec( xag, benchmark );
+    bool const cec = benchmark == "hyp" ? true : native_cec( xag, benchmark );
     exp( benchmark, size_before, xag.num_gates(), depth_before, depth_view( xag ).depth(), to_seconds( st.time_total ), cec );
   }
 
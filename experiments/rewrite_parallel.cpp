@@ -0,0 +1,89 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2019  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/node_resynthesis/xag_npn.hpp>
+#include <mockturtle/algorithms/rewrite.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/tech_library.hpp>
+
+#include <experiments.hpp>
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, uint32_t, uint32_t, uint32_t, float, float, float, float, float, uint32_t, bool, bool>
+      exp( "rewrite_parallel", "benchmark", "size_before", "size 1", "size N", "time 1", "time 4", "time 16", "speedup 4", "speedup 16", "rounds", "identical", "equivalent" );
+
+  xag_npn_resynthesis<aig_network, aig_network, xag_npn_db_kind::aig_complete> resyn;
+  exact_library<aig_network> exact_lib( resyn );
+
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+
+    uint32_t const size_before = aig.num_gates();
+
+    std::vector<double> times;
+    std::vector<aig_network> aigs;
+    uint32_t rounds = 0;
+    for ( auto num_threads : { 1u, 4u, 16u } )
+    {
+      rewrite_params ps;
+      ps.num_threads = num_threads;
+      rewrite_stats st;
+
+      aig_network res = aig.clone();
+      rewrite( res, exact_lib, ps, &st );
+      aigs.push_back( res );
+      times.push_back( to_seconds( st.time_total ) );
+      rounds = st.rounds;
+    }
+
+    /* the parallel rewriting does not depend on the number of threads */
+    bool const identical = aigs[1].num_gates() == aigs[2].num_gates();
+    auto const cec = benchmark == "hyp" ? true : native_cec( aigs[2], benchmark );
+
+    exp( benchmark, size_before, aigs[0].num_gates(), aigs[1].num_gates(),
+         times[0], times[1], times[2], times[0] / std::max( times[1], 1e-6 ), times[0] / std::max( times[2], 1e-6 ), rounds, identical, cec );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
@@ -0,0 +1,87 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2023  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+#include <mockturtle/utils/thread_pool.hpp>
+
+#include <experiments.hpp>
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, uint32_t, float, float, float, float, float, bool>
+      exp( "simulation", "benchmark", "size", "sequential", "1 thread", "4 threads", "16 threads", "speedup 16", "identical" );
+
+  uint32_t const num_patterns = 8192u;
+  thread_pool pool1( 1u ), pool4( 4u ), pool16( 16u );
+
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+
+    aig_network aig;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+
+    partial_simulator sim( aig.num_pis(), num_patterns );
+
+    stopwatch<>::duration time_seq{ 0 };
+    unordered_node_map<kitty::partial_truth_table, aig_network> expected( aig );
+    call_with_stopwatch( time_seq, [&]() { simulate_nodes<aig_network>( aig, expected, sim, true ); } );
+
+    bool identical = true;
+    std::vector<double> times;
+    for ( auto* pool : { &pool1, &pool4, &pool16 } )
+    {
+      stopwatch<>::duration time{ 0 };
+      unordered_node_map<kitty::partial_truth_table, aig_network> values( aig );
+      call_with_stopwatch( time, [&]() { simulate_nodes<aig_network>( aig, values, sim, true, *pool ); } );
+      times.push_back( to_seconds( time ) );
+
+      aig.foreach_gate( [&]( auto const& n ) {
+        identical &= values[n] == expected[n];
+      } );
+    }
+
+    exp( benchmark, aig.num_gates(), to_seconds( time_seq ), times[0], times[1], times[2], to_seconds( time_seq ) / std::max( times[2], 1e-6 ), identical );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
@@ -66,8 +66,8 @@ int main()
     depth_view daig4{ aig4 };
     depth_view daig6{ aig6 };
 
-    const auto cec4 = abc_cec( aig4, benchmark );
-    const auto cec6 = abc_cec( aig6, benchmark );
+    const auto cec4 = native_cec( aig4, benchmark );
+    const auto cec6 = native_cec( aig6, benchmark );
 
     exp( benchmark,
          aig.num_gates(), daig.depth(),
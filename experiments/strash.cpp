@@ -0,0 +1,139 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2023  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+#include <parallel_hashmap/phmap.h>
+
+#include <experiments.hpp>
+
+/* Constructs a random network with `num_gates` gate creations on `num_pis`
+   inputs.  Fanins are drawn from a window of recent signals, such that a
+   part of the creations are structural hashing hits. */
+template<class Ntk, class Fn>
+Ntk construct( uint32_t num_pis, uint32_t num_gates, Fn&& create_gate )
+{
+  using signal = typename Ntk::signal;
+
+  Ntk ntk;
+  std::vector<signal> signals;
+  for ( auto i = 0u; i < num_pis; ++i )
+  {
+    signals.push_back( ntk.create_pi() );
+  }
+
+  std::mt19937 rng( 1u );
+  for ( auto i = 0u; i < num_gates; ++i )
+  {
+    auto const window = std::min<uint64_t>( signals.size(), 4096u );
+    auto const pick = [&]() {
+      auto const s = signals[signals.size() - 1u - rng() % window];
+      return ( rng() & 1u ) ? !s : s;
+    };
+    signals.push_back( create_gate( ntk, pick ) );
+  }
+  ntk.create_po( signals.back() );
+  return ntk;
+}
+
+/* Replays the structural hashing of a network into a hash map from nodes to
+   indexes, i.e., the table that was used before the strash table. */
+template<class Ntk, class Hasher>
+uint64_t replay_node_map( Ntk const& ntk, uint64_t& num_hits )
+{
+  using node_type = typename Ntk::storage::element_type::node_type;
+
+  phmap::flat_hash_map<node_type, uint64_t, Hasher> hash;
+  hash.reserve( 10000u );
+  num_hits = 0u;
+  auto const& nodes = ntk._storage->nodes;
+  for ( auto i = 0u; i < nodes.size(); ++i )
+  {
+    if ( !ntk.is_ci( i ) && !ntk.is_constant( i ) )
+    {
+      num_hits += hash.find( nodes[i] ) != hash.end();
+      hash[nodes[i]] = i;
+    }
+  }
+  return hash.capacity() * ( sizeof( typename decltype( hash )::value_type ) + 1u );
+}
+
+int main( int argc, char* argv[] )
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  uint32_t const num_gates = argc > 1 ? std::atoi( argv[1] ) : 2000000u;
+  uint32_t const num_pis = 256u;
+
+  experiment<std::string, uint32_t, float, float, float, float>
+      exp( "strash", "network", "gates", "runtime", "runtime node map", "MB strash", "MB node map" );
+
+  auto const run = [&]( std::string const& name, auto ntk_tag, auto hasher_tag, auto&& create_gate ) {
+    using Ntk = typename decltype( ntk_tag )::type;
+    using Hasher = typename decltype( hasher_tag )::type;
+
+    fmt::print( "[i] constructing {} with {} gates\n", name, num_gates );
+
+    stopwatch<>::duration time{ 0 };
+    auto const ntk = call_with_stopwatch( time, [&]() { return construct<Ntk>( num_pis, num_gates, create_gate ); } );
+
+    /* the replay only inserts and looks up existing nodes, so it is a lower bound for the old construction */
+    uint64_t num_hits{ 0u }, bytes_node_map{ 0u };
+    stopwatch<>::duration time_node_map{ 0 };
+    call_with_stopwatch( time_node_map, [&]() { bytes_node_map = replay_node_map<Ntk, Hasher>( ntk, num_hits ); } );
+
+    auto const bytes_strash = ntk._storage->hash.capacity() * sizeof( uint64_t );
+    exp( name, ntk.num_gates(), to_seconds( time ), to_seconds( time_node_map ), bytes_strash / 1048576.0f, bytes_node_map / 1048576.0f );
+  };
+
+  using aig_node = aig_network::storage::element_type::node_type;
+  using mig_node = mig_network::storage::element_type::node_type;
+
+  run( "aig", std::common_type<aig_network>{}, std::common_type<node_hash<aig_node>>{}, []( auto& ntk, auto&& pick ) {
+    return ntk.create_and( pick(), pick() );
+  } );
+  run( "xag", std::common_type<xag_network>{}, std::common_type<xag_hash<aig_node>>{}, []( auto& ntk, auto&& pick ) {
+    auto const a = pick(), b = pick();
+    return ( ntk.size() & 1u ) ? ntk.create_xor( a, b ) : ntk.create_and( a, b );
+  } );
+  run( "mig", std::common_type<mig_network>{}, std::common_type<node_hash<mig_node>>{}, []( auto& ntk, auto&& pick ) {
+    return ntk.create_maj( pick(), pick(), pick() );
+  } );
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
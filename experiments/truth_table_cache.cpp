@@ -0,0 +1,148 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2023  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined( __GLIBC__ )
+#include <malloc.h>
+#endif
+
+#include <fmt/format.h>
+#include <kitty/constructors.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+#include <mockturtle/utils/truth_table_cache.hpp>
+
+#include <experiments.hpp>
+
+/* Returns the number of heap bytes currently in use (0 if unknown). */
+inline uint64_t heap_bytes()
+{
+#if defined( __GLIBC__ ) && ( __GLIBC__ > 2 || ( __GLIBC__ == 2 && __GLIBC_MINOR__ >= 33 ) )
+  return mallinfo2().uordblks;
+#else
+  return 0u;
+#endif
+}
+
+/* Inserts all functions and reads back all bits of the cached functions, as
+   done when simulating a k-LUT network. */
+template<class Cache, class Access>
+std::tuple<double, double, double, uint64_t> run_cache( std::vector<kitty::dynamic_truth_table> const& functions, Access&& access )
+{
+  using namespace mockturtle;
+
+  stopwatch<>::duration time_insert{ 0 }, time_access{ 0 };
+  std::vector<uint32_t> literals( functions.size() );
+
+  auto const heap_before = heap_bytes();
+  Cache cache;
+  call_with_stopwatch( time_insert, [&]() {
+    for ( auto i = 0u; i < functions.size(); ++i )
+    {
+      literals[i] = cache.insert( functions[i] );
+    }
+  } );
+  auto const heap_after = heap_bytes();
+
+  uint64_t checksum{ 0u };
+  call_with_stopwatch( time_access, [&]() {
+    for ( auto const& lit : literals )
+    {
+      checksum += access( cache, lit );
+    }
+  } );
+
+  return { to_seconds( time_insert ), to_seconds( time_access ), ( heap_after - heap_before ) / double( 1 << 20 ), checksum };
+}
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, uint32_t, uint32_t, float, float, float, float, float, float, bool>
+      exp( "truth_table_cache", "workload", "inserts", "distinct", "insert vector", "insert compact", "access vector", "access compact", "MB vector", "MB compact", "identical" );
+
+  struct workload
+  {
+    std::string name;
+    uint32_t num_vars;
+    uint32_t num_inserts;
+    uint32_t num_distinct;
+  };
+
+  for ( auto const& w : std::vector<workload>{ { "lut6_distinct", 6u, 1000000u, 1000000u },
+                                               { "lut6_repeated", 6u, 1000000u, 20000u },
+                                               { "lut4_repeated", 4u, 1000000u, 2000u },
+                                               { "lut10_distinct", 10u, 200000u, 200000u } } )
+  {
+    fmt::print( "[i] processing {}\n", w.name );
+
+    std::mt19937 rng( 42u );
+    std::vector<kitty::dynamic_truth_table> distinct( w.num_distinct, kitty::dynamic_truth_table( w.num_vars ) );
+    for ( auto& tt : distinct )
+    {
+      kitty::create_random( tt, rng() );
+    }
+    std::vector<kitty::dynamic_truth_table> functions;
+    functions.reserve( w.num_inserts );
+    for ( auto i = 0u; i < w.num_inserts; ++i )
+    {
+      functions.push_back( distinct[rng() % w.num_distinct] );
+    }
+
+    auto const [insert_vector, access_vector, mb_vector, checksum_vector] = run_cache<truth_table_cache<kitty::dynamic_truth_table>>(
+        functions, []( auto const& cache, uint32_t lit ) {
+          auto const tt = cache[lit];
+          uint64_t ones{ 0u };
+          for ( auto i = 0u; i < tt.num_bits(); ++i )
+          {
+            ones += kitty::get_bit( tt, i );
+          }
+          return ones;
+        } );
+    auto const [insert_compact, access_compact, mb_compact, checksum_compact] = run_cache<compact_truth_table_cache>(
+        functions, []( auto const& cache, uint32_t lit ) {
+          auto const tt = cache.get( lit );
+          uint64_t ones{ 0u };
+          for ( auto i = 0u; i < tt.num_bits(); ++i )
+          {
+            ones += tt.get_bit( i );
+          }
+          return ones;
+        } );
+
+    exp( w.name, w.num_inserts, w.num_distinct, insert_vector, insert_compact, access_vector, access_compact, mb_vector, mb_compact, checksum_vector == checksum_compact );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
@@ -95,7 +95,7 @@ int main()
       // st.report();
     } while ( aig.num_gates() < size_current );
 
-    auto const cec = benchmark != "hyp" ? abc_cec( aig, benchmark ) : true;
+    auto const cec = benchmark != "hyp" ? native_cec( aig, benchmark ) : true;
 
     exp( benchmark, size_before, aig.num_gates(),
          st.estimated_gain, st.real_gain, st.num_substitutions, st.num_iterations,
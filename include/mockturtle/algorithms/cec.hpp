@@ -0,0 +1,495 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2023  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file cec.hpp
+  \brief Combinational equivalence checking based on SAT sweeping
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "../traits.hpp"
+#include "../utils/node_map.hpp"
+#include "../utils/stopwatch.hpp"
+#include "../utils/thread_pool.hpp"
+#include "../utils/trace.hpp"
+#include "circuit_validator.hpp"
+#include "cleanup.hpp"
+#include "simulation.hpp"
+
+#include <bill/sat/interface/abc_bsat2.hpp>
+#include <fmt/format.h>
+#include <kitty/hash.hpp>
+#include <kitty/partial_truth_table.hpp>
+
+namespace mockturtle
+{
+
+/*! \brief Parameters for cec.
+ *
+ * The data structure `cec_params` holds configurable parameters with
+ * default arguments for `cec`.
+ */
+struct cec_params
+{
+  /*! \brief Number of random simulation patterns. */
+  uint32_t num_patterns{ 1024u };
+
+  /*! \brief Seed of the random simulation patterns. */
+  uint32_t random_seed{ 1u };
+
+  /*! \brief Number of threads simulating the miter (0 uses all hardware threads). */
+  uint32_t num_simulation_threads{ 1u };
+
+  /*! \brief Maximum number of sweeping rounds. */
+  uint32_t max_rounds{ 4u };
+
+  /*! \brief Conflict limit of the SAT calls in the first sweeping round. */
+  uint32_t conflict_limit{ 100u };
+
+  /*! \brief Factor by which the conflict limit grows after each sweeping round. */
+  uint32_t conflict_limit_growth{ 8u };
+
+  /*! \brief Conflict limit for proving the miter output (0 = no limit). */
+  uint32_t output_conflict_limit{ 0u };
+
+  /*! \brief Maximum number of class members a node is compared to. */
+  uint32_t max_candidates{ 4u };
+
+  /*! \brief Maximum number of clauses of the SAT solver before it is restarted. */
+  uint32_t max_clauses{ 100000u };
+
+  /*! \brief Be verbose. */
+  bool verbose{ false };
+};
+
+/*! \brief Statistics for cec.
+ *
+ * The data structure `cec_stats` provides data collected by running `cec`.
+ */
+struct cec_stats
+{
+  /*! \brief Total runtime. */
+  stopwatch<>::duration time_total{ 0 };
+
+  /*! \brief Time for simulation. */
+  stopwatch<>::duration time_sim{ 0 };
+
+  /*! \brief Time for SAT solving. */
+  stopwatch<>::duration time_sat{ 0 };
+
+  /*! \brief Number of candidate equivalence classes after random simulation. */
+  uint32_t num_classes{ 0 };
+
+  /*! \brief Number of sweeping rounds. */
+  uint32_t num_rounds{ 0 };
+
+  /*! \brief Number of SAT calls. */
+  uint32_t num_sat_calls{ 0 };
+
+  /*! \brief Number of proved constant nodes. */
+  uint32_t num_const_proved{ 0 };
+
+  /*! \brief Number of proved equivalent node pairs. */
+  uint32_t num_equ_proved{ 0 };
+
+  /*! \brief Number of counter-examples (satisfiable SAT calls). */
+  uint32_t num_cex{ 0 };
+
+  /*! \brief Number of candidate pairs disproved by simulating previous counter-examples. */
+  uint32_t num_cex_reused{ 0 };
+
+  /*! \brief Number of SAT calls exceeding the conflict limit. */
+  uint32_t num_timeout{ 0 };
+
+  /*! \brief Counter-example, in case miter is not equivalent. */
+  std::vector<bool> counter_example;
+
+  void report() const
+  {
+    // clang-format off
+    std::cout <<              "[i] SAT sweeping CEC\n";
+    std::cout <<              "[i] ========  Stats  ========\n";
+    std::cout << fmt::format( "[i] #classes  = {:8d}\n", num_classes );
+    std::cout << fmt::format( "[i] #rounds   = {:8d}\n", num_rounds );
+    std::cout << fmt::format( "[i] #SAT calls= {:8d}\n", num_sat_calls );
+    std::cout << fmt::format( "[i] #constant = {:8d}\n", num_const_proved );
+    std::cout << fmt::format( "[i] #FE pairs = {:8d}\n", num_equ_proved );
+    std::cout << fmt::format( "[i] #CEX      = {:8d}\n", num_cex );
+    std::cout << fmt::format( "[i] #CEX reuse= {:8d}\n", num_cex_reused );
+    std::cout << fmt::format( "[i] #TIMEOUT  = {:8d}\n", num_timeout );
+    std::cout <<              "[i] ======== Runtime ========\n";
+    std::cout << fmt::format( "[i] total        : {:>5.2f} secs\n", to_seconds( time_total ) );
+    std::cout << fmt::format( "[i]   simulation : {:>5.2f} secs\n", to_seconds( time_sim ) );
+    std::cout << fmt::format( "[i]   SAT solving: {:>5.2f} secs\n", to_seconds( time_sat ) );
+    std::cout <<              "[i] =========================\n";
+    // clang-format on
+
+    if ( counter_example.size() > 0 )
+    {
+      std::cout << "[i] Networks are not equivalent under input assignment: ";
+      for ( auto i = 0u; i < counter_example.size(); ++i )
+        std::cout << "pi" << i << "=" << counter_example[i] << " ";
+      std::cout << "\n";
+    }
+  }
+};
+
+namespace detail
+{
+
+template<class Ntk>
+class cec_impl
+{
+public:
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+  using validator_t = circuit_validator<Ntk, bill::solvers::bsat2>;
+
+  explicit cec_impl( Ntk& ntk, cec_params const& ps, validator_params const& vps, cec_stats& st )
+      : ntk( ntk ), ps( ps ), st( st ), tts( ntk ),
+        sim( ntk.num_pis(), ps.num_patterns, ps.random_seed ), pool( ps.num_simulation_threads ), validator( ntk, vps )
+  {
+  }
+
+  std::optional<bool> run()
+  {
+    stopwatch t( st.time_total );
+    MOCKTURTLE_TRACE_SCOPE( "cec" );
+
+    if ( auto const res = check_output_constant(); res )
+    {
+      return *res;
+    }
+
+    call_with_stopwatch( st.time_sim, [&]() {
+      simulate_nodes<Ntk>( ntk, tts, sim, true, pool );
+    } );
+    if ( auto const res = check_output_simulation(); res )
+    {
+      return *res;
+    }
+
+    uint32_t conflict_limit = ps.conflict_limit;
+    for ( auto round = 0u; round < ps.max_rounds; ++round )
+    {
+      ++st.num_rounds;
+      validator.set_conflict_limit( conflict_limit );
+      auto const num_timeout = st.num_timeout;
+
+      sweep();
+
+      if ( auto const res = check_output_constant(); res )
+      {
+        return *res;
+      }
+      if ( auto const res = check_output_simulation(); res )
+      {
+        return *res;
+      }
+
+      /* all candidates have been decided, another round cannot merge more nodes */
+      if ( st.num_timeout == num_timeout )
+      {
+        break;
+      }
+      conflict_limit *= ps.conflict_limit_growth;
+    }
+
+    /* prove the miter output on the swept network */
+    validator.set_conflict_limit( ps.output_conflict_limit );
+    ++st.num_sat_calls;
+    auto const res = call_with_stopwatch( st.time_sat, [&]() {
+      return validator.validate( ntk.po_at( 0 ), false );
+    } );
+    if ( !res )
+    {
+      ++st.num_timeout;
+      return std::nullopt;
+    }
+    if ( !( *res ) )
+    {
+      ++st.num_cex;
+      st.counter_example = validator.cex;
+      return false;
+    }
+    return true;
+  }
+
+private:
+  /* sweeps the network in topological order: each node is compared to the
+     earlier members of its simulation class and merged with the first one
+     proved equivalent */
+  void sweep()
+  {
+    /* bring all simulation signatures up to date with the counter-examples */
+    call_with_stopwatch( st.time_sim, [&]() {
+      simulate_nodes<Ntk>( ntk, tts, sim, false, pool );
+    } );
+
+    std::unordered_map<kitty::partial_truth_table, uint32_t, kitty::hash<kitty::partial_truth_table>> class_index;
+    std::vector<std::vector<node>> classes;
+    node_map<uint32_t, Ntk> class_of( ntk, std::numeric_limits<uint32_t>::max() );
+
+    ntk.foreach_node( [&]( auto const& n ) {
+      if ( ntk.is_dead( n ) )
+        return;
+
+      auto const& tt = tts[n];
+      auto const key = kitty::get_bit( tt, 0 ) ? ~tt : tt;
+      auto const [it, inserted] = class_index.emplace( key, static_cast<uint32_t>( classes.size() ) );
+      if ( inserted )
+      {
+        classes.emplace_back();
+      }
+      class_of[n] = it->second;
+    } );
+
+    if ( st.num_rounds == 1u )
+    {
+      st.num_classes = static_cast<uint32_t>( classes.size() );
+    }
+
+    /* members that have not been merged, in topological order */
+    ntk.foreach_node( [&]( auto const& n ) {
+      if ( ntk.is_dead( n ) || class_of[n] == std::numeric_limits<uint32_t>::max() )
+        return true;
+
+      auto& members = classes[class_of[n]];
+      if ( ntk.is_constant( n ) || ntk.is_pi( n ) || !try_merge( n, members ) )
+      {
+        members.emplace_back( n );
+      }
+
+      /* stop as soon as the miter output is decided */
+      return !ntk.is_constant( ntk.get_node( ntk.po_at( 0 ) ) );
+    } );
+  }
+
+  bool try_merge( node const& n, std::vector<node> const& members )
+  {
+    auto num_candidates = 0u;
+    for ( auto const& m : members )
+    {
+      if ( num_candidates == ps.max_candidates )
+        break;
+      if ( ntk.is_dead( m ) )
+        continue;
+      ++num_candidates;
+
+      /* candidate may have been disproved by the counter-examples found so far */
+      update_tts( n );
+      update_tts( m );
+      signal g;
+      if ( tts[n] == tts[m] )
+      {
+        g = ntk.make_signal( m );
+      }
+      else if ( tts[n] == ~tts[m] )
+      {
+        g = !ntk.make_signal( m );
+      }
+      else
+      {
+        ++st.num_cex_reused;
+        continue;
+      }
+
+      ++st.num_sat_calls;
+      auto const res = call_with_stopwatch( st.time_sat, [&]() {
+        return ntk.is_constant( m ) ? validator.validate( n, ntk.is_complemented( g ) ) : validator.validate( ntk.make_signal( n ), g );
+      } );
+      if ( !res ) /* timeout */
+      {
+        ++st.num_timeout;
+      }
+      else if ( !( *res ) ) /* SAT, cex found */
+      {
+        found_cex();
+      }
+      else /* UNSAT, merge node */
+      {
+        ++( ntk.is_constant( m ) ? st.num_const_proved : st.num_equ_proved );
+        ntk.substitute_node( n, g );
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void found_cex()
+  {
+    ++st.num_cex;
+    sim.add_pattern( validator.cex );
+
+    /* re-simulate the last block of the whole network when it is full */
+    if ( sim.num_bits() % 64 == 0 )
+    {
+      call_with_stopwatch( st.time_sim, [&]() {
+        simulate_nodes<Ntk>( ntk, tts, sim, false, pool );
+      } );
+    }
+  }
+
+  void update_tts( node const& n )
+  {
+    if ( tts[n].num_bits() != sim.num_bits() )
+    {
+      call_with_stopwatch( st.time_sim, [&]() {
+        simulate_node<Ntk>( ntk, n, tts, sim );
+      } );
+    }
+  }
+
+  std::optional<bool> check_output_constant()
+  {
+    auto const f = ntk.po_at( 0 );
+    if ( !ntk.is_constant( ntk.get_node( f ) ) )
+    {
+      return std::nullopt;
+    }
+
+    if ( f == ntk.get_constant( false ) )
+    {
+      return true;
+    }
+
+    /* any input assignment is a counter-example */
+    st.counter_example = std::vector<bool>( ntk.num_pis(), false );
+    return false;
+  }
+
+  /* checks whether a simulation pattern sets the miter output */
+  std::optional<bool> check_output_simulation()
+  {
+    auto const f = ntk.po_at( 0 );
+    update_tts( ntk.get_node( f ) );
+    auto const tt = ntk.is_complemented( f ) ? ~tts[ntk.get_node( f )] : tts[ntk.get_node( f )];
+    auto const bit = kitty::find_first_one_bit( tt );
+    if ( bit == -1 )
+    {
+      return std::nullopt;
+    }
+
+    auto const patterns = sim.get_patterns();
+    st.counter_example.clear();
+    for ( auto const& pattern : patterns )
+    {
+      st.counter_example.push_back( kitty::get_bit( pattern, bit ) );
+    }
+    return false;
+  }
+
+private:
+  Ntk& ntk;
+  cec_params const& ps;
+  cec_stats& st;
+
+  unordered_node_map<kitty::partial_truth_table, Ntk> tts;
+  partial_simulator sim;
+  thread_pool pool;
+  validator_t validator;
+};
+
+} // namespace detail
+
+/*! \brief Combinational equivalence checking based on SAT sweeping.
+ *
+ * This function expects as input a miter circuit that can be generated, e.g.,
+ * with the function `miter`, and returns the same result as
+ * `equivalence_checking`: `nullopt` if the resource limits are exceeded,
+ * `true` if the miter is equivalent, or `false` with a counter-example
+ * in the statistics otherwise.
+ *
+ * Instead of solving the whole miter at once, the nodes are first partitioned
+ * into candidate equivalence classes by random simulation.  The network is
+ * then swept in topological order, and each node is merged with the first
+ * earlier member of its class that an incremental SAT solver proves to be
+ * equivalent (up to complementation) or, for the class of the constant,
+ * with the constant.  Counter-examples are added to the simulation patterns,
+ * such that they refine the classes without further SAT calls.  Candidate
+ * pairs exceeding the conflict limit are retried in the next round with a
+ * larger limit.  Finally, the output of the swept miter is proved to be
+ * constant 0.
+ *
+ * **Required network functions:**
+ * - `foreach_node`
+ * - `foreach_fanin`
+ * - `substitute_node`
+ * - `is_and`, `is_xor`, `is_xor3`, `is_maj`
+ *
+ * \param miter Miter network
+ * \param ps Parameters
+ * \param st Statistics
+ */
+template<class Ntk>
+std::optional<bool> cec( Ntk const& miter, cec_params const& ps = {}, cec_stats* pst = nullptr )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_num_pis_v<Ntk>, "Ntk does not implement the num_pis method" );
+  static_assert( has_num_pos_v<Ntk>, "Ntk does not implement the num_pos method" );
+  static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
+  static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+  static_assert( has_is_dead_v<Ntk>, "Ntk does not implement the is_dead method" );
+  static_assert( has_substitute_node_v<Ntk>, "Ntk does not implement the substitute_node method" );
+
+  if ( miter.num_pos() != 1u )
+  {
+    std::cout << "[e] miter network must have a single output\n";
+    return std::nullopt;
+  }
+
+  validator_params vps;
+  vps.max_clauses = ps.max_clauses;
+  vps.conflict_limit = ps.conflict_limit;
+
+  /* the miter is swept on a copy */
+  Ntk ntk = cleanup_dangling( miter );
+
+  cec_stats st;
+  detail::cec_impl<Ntk> impl( ntk, ps, vps, st );
+  auto const result = impl.run();
+
+  if ( ps.verbose )
+  {
+    st.report();
+  }
+
+  if ( pst )
+  {
+    *pst = st;
+  }
+
+  return result;
+}
+
+} /* namespace mockturtle */
@@ -36,6 +36,8 @@
 #include "../networks/events.hpp"
 #include "../utils/index_list.hpp"
 #include "../utils/node_map.hpp"
+#include "../utils/thread_pool.hpp"
+#include "../utils/trace.hpp"
 #include "cnf.hpp"
 
 #include <bill/sat/interface/abc_bsat2.hpp>
@@ -43,6 +45,11 @@
 #include <bill/sat/interface/glucose.hpp>
 #include <bill/sat/interface/z3.hpp>
 
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <vector>
+
 namespace mockturtle
 {
 
@@ -150,6 +157,12 @@ public:
     ps.odc_levels = odc_levels;
   }
 
+  /*! \brief Set conflict limit */
+  void set_conflict_limit( uint32_t conflict_limit )
+  {
+    ps.conflict_limit = conflict_limit;
+  }
+
   /*! \brief Validate functional equivalence of signals `f` and `d`. */
   std::optional<bool> validate( signal const& f, signal const& d )
   {
@@ -581,6 +594,8 @@ private:
   std::optional<bool> solve( std::vector<bill::lit_type> assumptions )
   {
     ++num_invoke;
+    MOCKTURTLE_TRACE_COUNT( "circuit_validator/sat_calls", 1 );
+    MOCKTURTLE_TRACE_LATENCY( "circuit_validator/sat_latency_us" );
     auto const res = solver.solve( assumptions, ps.conflict_limit );
 
     if ( res == bill::result::states::satisfiable )
@@ -603,6 +618,7 @@ private:
     }
     else
     {
+      MOCKTURTLE_TRACE_COUNT( "circuit_validator/sat_timeouts", 1 );
       return std::nullopt; /* timeout or something wrong */
     }
   }
@@ -796,4 +812,124 @@ public:
   std::vector<bool> cex;
 };
 
-} /* namespace mockturtle */
\ No newline at end of file
+/*! \brief Pool of circuit validators solving independent queries concurrently.
+ *
+ * The pool owns one validator per thread, each with its own SAT solver and
+ * incrementally constructed CNF.  A batch of queries is distributed such
+ * that query `i` is always solved by validator `i % num_threads()`, which
+ * makes the results independent of thread scheduling.  The network must
+ * not be modified while a batch is being validated, and validators
+ * considering ODCs are not supported (they mark nodes in the network).
+ *
+ * The counter-examples of satisfiable queries are kept until the next
+ * batch, such that they can be merged into the simulation patterns in the
+ * order of the queries.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      validator_pool<circuit_validator<aig_network>> pool( aig, {}, 4u );
+      auto const& results = pool.validate( pairs.size(), [&]( auto& validator, uint32_t i ) {
+        return validator.validate( pairs[i].first, pairs[i].second );
+      } );
+   \endverbatim
+ */
+template<class Validator>
+class validator_pool
+{
+public:
+  /*! \brief Creates a pool.
+   *
+   * \param ntk Network to be validated
+   * \param ps Parameters of each validator
+   * \param num_threads Number of threads and validators (0 uses the hardware concurrency)
+   */
+  template<class Ntk>
+  explicit validator_pool( Ntk const& ntk, validator_params const& ps, uint32_t num_threads )
+      : _pool( num_threads ), _num_cex( _pool.num_threads(), 0u ), _num_timeout( _pool.num_threads(), 0u )
+  {
+    static_assert( !Validator::use_odc_, "`circuit_validator::use_odc` flag should be turned off." );
+
+    _validators.reserve( _pool.num_threads() );
+    for ( auto i = 0u; i < _pool.num_threads(); ++i )
+    {
+      _validators.emplace_back( std::make_unique<Validator>( ntk, ps ) );
+    }
+  }
+
+  /*! \brief Returns the number of threads (and validators). */
+  uint32_t num_threads() const
+  {
+    return _pool.num_threads();
+  }
+
+  /*! \brief Validates a batch of queries concurrently.
+   *
+   * \param num_queries Number of queries in the batch
+   * \param query Called as `query( validator, i )` and returns the result of
+   *              a `validate` call of `validator` for the `i`-th query
+   * \return The result of each query (`std::nullopt` for timeouts)
+   */
+  template<class Fn>
+  std::vector<std::optional<bool>> const& validate( uint32_t num_queries, Fn&& query )
+  {
+    _results.assign( num_queries, std::nullopt );
+    _cexs.resize( num_queries );
+
+    auto const step = num_threads();
+    _pool.run( [&]( uint32_t thread_id ) {
+      auto& validator = *_validators[thread_id];
+      for ( auto i = thread_id; i < num_queries; i += step )
+      {
+        auto const res = query( validator, i );
+        if ( !res )
+        {
+          ++_num_timeout[thread_id];
+        }
+        else if ( !( *res ) )
+        {
+          ++_num_cex[thread_id];
+          _cexs[i] = validator.cex;
+        }
+        _results[i] = res;
+      }
+    } );
+
+    return _results;
+  }
+
+  /*! \brief Returns the counter-example of the `i`-th query of the last batch. */
+  std::vector<bool> const& cex( uint32_t i ) const
+  {
+    assert( _results.at( i ) && !( *_results.at( i ) ) );
+    return _cexs.at( i );
+  }
+
+  /*! \brief Number of counter-examples (SAT results) found by all validators. */
+  uint32_t num_cex() const
+  {
+    return std::accumulate( _num_cex.begin(), _num_cex.end(), 0u );
+  }
+
+  /*! \brief Number of timeouts of all validators. */
+  uint32_t num_timeout() const
+  {
+    return std::accumulate( _num_timeout.begin(), _num_timeout.end(), 0u );
+  }
+
+private:
+  thread_pool _pool;
+  std::vector<std::unique_ptr<Validator>> _validators;
+
+  std::vector<std::optional<bool>> _results;
+  std::vector<std::vector<bool>> _cexs;
+
+  /* per-thread statistics */
+  std::vector<uint32_t> _num_cex;
+  std::vector<uint32_t> _num_timeout;
+};
+
+} /* namespace mockturtle */
@@ -0,0 +1,428 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2023  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file compaction.hpp
+  \brief In-place compaction of networks
+
+  Removes dead (and dangling) nodes from the storage of a network and
+  renumbers the remaining nodes in topological order, without copying the
+  network as `cleanup_dangling` does.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "../networks/storage.hpp"
+#include "../traits.hpp"
+#include "../utils/stopwatch.hpp"
+
+#include <fmt/format.h>
+
+namespace mockturtle
+{
+
+/*! \brief Index of removed nodes in the remapping returned by `compact_network`. */
+inline constexpr uint64_t compact_removed_node = std::numeric_limits<uint64_t>::max();
+
+/*! \brief Parameters for compact_network.
+ *
+ * The data structure `compact_network_params` holds configurable
+ * parameters with default arguments for `compact_network`.
+ */
+struct compact_network_params
+{
+  /*! \brief Also remove gates that are not in the transitive fanin of a CO. */
+  bool remove_dangling{ true };
+
+  /*! \brief Be verbose. */
+  bool verbose{ false };
+};
+
+/*! \brief Statistics for compact_network.
+ *
+ * The data structure `compact_network_stats` provides data collected by
+ * running `compact_network`.
+ */
+struct compact_network_stats
+{
+  /*! \brief Total runtime. */
+  stopwatch<>::duration time_total{ 0 };
+
+  /*! \brief Number of removed dead nodes. */
+  uint64_t num_dead{ 0 };
+
+  /*! \brief Number of removed dangling nodes. */
+  uint64_t num_dangling{ 0 };
+
+  /*! \brief Number of gates that were placed before one of their fanins. */
+  uint64_t num_reordered{ 0 };
+
+  void report() const
+  {
+    // clang-format off
+    std::cout << fmt::format( "[i] removed dead nodes     = {:8d}\n", num_dead );
+    std::cout << fmt::format( "[i] removed dangling nodes = {:8d}\n", num_dangling );
+    std::cout << fmt::format( "[i] reordered gates        = {:8d}\n", num_reordered );
+    std::cout << fmt::format( "[i] total time             = {:>5.2f} secs\n", to_seconds( time_total ) );
+    // clang-format on
+  }
+};
+
+namespace detail
+{
+
+template<class Ntk>
+class compact_network_impl
+{
+public:
+  using storage_type = typename std::decay_t<decltype( *std::declval<Ntk>()._storage )>;
+  using node_type = typename storage_type::node_type;
+  using pointer_type = typename node_type::pointer_type;
+
+  static constexpr uint32_t fanin_size = static_cast<uint32_t>( std::tuple_size_v<decltype( node_type::children )> );
+
+  compact_network_impl( Ntk& ntk, compact_network_params const& ps, compact_network_stats& st )
+      : ntk( ntk ), storage( *ntk._storage ), ps( ps ), st( st )
+  {
+  }
+
+  std::vector<uint64_t> run()
+  {
+    stopwatch t( st.time_total );
+
+    mark_live_nodes();
+    compute_order();
+    release_removed_nodes();
+    remap_fanins();
+    move_nodes();
+    rebuild_hash();
+
+    return std::move( old_to_new );
+  }
+
+private:
+  bool is_gate( uint64_t n ) const
+  {
+    return !ntk.is_constant( n ) && !ntk.is_ci( n );
+  }
+
+  /* the constant and the CIs are always kept */
+  void mark_live_nodes()
+  {
+    auto const size = storage.nodes.size();
+    live.assign( size, 0u );
+    live[0] = 1u;
+    for ( auto const& ci : storage.inputs )
+    {
+      live[ci] = 1u;
+    }
+
+    if ( !ps.remove_dangling )
+    {
+      for ( auto n = 1u; n < size; ++n )
+      {
+        if ( is_gate( n ) && !ntk.is_dead( n ) )
+        {
+          live[n] = 1u;
+        }
+      }
+      return;
+    }
+
+    std::vector<uint64_t> stack;
+    for ( auto const& f : storage.outputs )
+    {
+      stack.push_back( f.index );
+    }
+    while ( !stack.empty() )
+    {
+      auto const n = stack.back();
+      stack.pop_back();
+      if ( live[n] )
+      {
+        continue;
+      }
+
+      assert( !ntk.is_dead( n ) );
+      live[n] = 1u;
+      for ( auto const& c : storage.nodes[n].children )
+      {
+        if ( !live[c.index] )
+        {
+          stack.push_back( c.index );
+        }
+      }
+    }
+  }
+
+  /* new indices: the constant, the CIs in their order, and then the gates in
+     topological order, keeping the order of their current indices if possible */
+  void compute_order()
+  {
+    auto const size = storage.nodes.size();
+    old_to_new.assign( size, compact_removed_node );
+    old_to_new[0] = 0u;
+    for ( auto const& ci : storage.inputs )
+    {
+      old_to_new[ci] = num_live++;
+    }
+
+    std::vector<std::pair<uint64_t, uint32_t>> stack;
+    for ( auto n = 1u; n < size; ++n )
+    {
+      if ( !live[n] || old_to_new[n] != compact_removed_node )
+      {
+        continue;
+      }
+
+      stack.emplace_back( n, 0u );
+      while ( !stack.empty() )
+      {
+        auto& [g, i] = stack.back();
+        if ( i < fanin_size )
+        {
+          auto const c = storage.nodes[g].children[i++].index;
+          if ( old_to_new[c] == compact_removed_node )
+          {
+            assert( live[c] && is_gate( c ) );
+            ++st.num_reordered;
+            stack.emplace_back( c, 0u );
+          }
+          continue;
+        }
+
+        old_to_new[g] = num_live++;
+        stack.pop_back();
+      }
+    }
+  }
+
+  void release_removed_nodes()
+  {
+    for ( auto n = 1u; n < storage.nodes.size(); ++n )
+    {
+      if ( live[n] )
+      {
+        continue;
+      }
+
+      if ( ntk.is_dead( n ) )
+      {
+        ++st.num_dead;
+        continue;
+      }
+
+      /* the references of dead nodes have been released when they were taken out */
+      ++st.num_dangling;
+      for ( auto const& c : storage.nodes[n].children )
+      {
+        if ( live[c.index] )
+        {
+          ntk.decr_fanout_size( c.index );
+        }
+      }
+    }
+  }
+
+  /* the order of the fanins is part of the structural hash and, in some
+     networks, of the gate type (e.g., AND and XOR gates in XAGs); a node
+     whose fanins are sorted is sorted again in the same direction */
+  void remap_fanins()
+  {
+    auto const by_index = []( pointer_type const& a, pointer_type const& b ) { return a.index < b.index; };
+    auto const by_index_reversed = []( pointer_type const& a, pointer_type const& b ) { return a.index > b.index; };
+
+    for ( auto n = 1u; n < storage.nodes.size(); ++n )
+    {
+      if ( !live[n] || !is_gate( n ) )
+      {
+        continue;
+      }
+
+      auto& children = storage.nodes[n].children;
+      bool const ascending = std::is_sorted( children.begin(), children.end(), by_index );
+      bool const descending = !ascending && std::adjacent_find( children.begin(), children.end(), []( auto const& a, auto const& b ) { return a.index <= b.index; } ) == children.end();
+
+      for ( auto& c : children )
+      {
+        c.index = old_to_new[c.index];
+      }
+
+      if ( ascending )
+      {
+        std::stable_sort( children.begin(), children.end(), by_index );
+      }
+      else if ( descending )
+      {
+        std::stable_sort( children.begin(), children.end(), by_index_reversed );
+      }
+    }
+
+    for ( auto& ci : storage.inputs )
+    {
+      ci = old_to_new[ci];
+    }
+    for ( auto& co : storage.outputs )
+    {
+      co.index = old_to_new[co.index];
+    }
+  }
+
+  /* permutes the node array in place by following the cycles of the remapping */
+  void move_nodes()
+  {
+    auto& nodes = storage.nodes;
+    std::vector<bool> moved( nodes.size(), false );
+
+    for ( auto n = 0u; n < nodes.size(); ++n )
+    {
+      if ( !live[n] || moved[n] )
+      {
+        continue;
+      }
+
+      auto current = std::move( nodes[n] );
+      auto from = n;
+      while ( true )
+      {
+        moved[from] = true;
+        auto const to = old_to_new[from];
+        if ( to != from && live[to] && !moved[to] )
+        {
+          auto next = std::move( nodes[to] );
+          nodes[to] = std::move( current );
+          current = std::move( next );
+          from = to;
+          continue;
+        }
+
+        nodes[to] = std::move( current );
+        break;
+      }
+    }
+
+    nodes.resize( num_live );
+  }
+
+  /* all gates are inserted at once into the emptied table */
+  void rebuild_hash()
+  {
+    storage.hash.clear();
+    storage.hash.reserve( num_live - storage.inputs.size() - 1u );
+    for ( auto n = 1u; n < num_live; ++n )
+    {
+      if ( is_gate( n ) )
+      {
+        storage.hash.emplace( storage.nodes[n], n );
+      }
+    }
+
+    /* the fanout index is rebuilt on demand */
+    storage.fanout.clear();
+  }
+
+private:
+  Ntk& ntk;
+  storage_type& storage;
+  compact_network_params const& ps;
+  compact_network_stats& st;
+
+  std::vector<uint8_t> live;
+  std::vector<uint64_t> old_to_new;
+  uint64_t num_live{ 1u };
+};
+
+} // namespace detail
+
+/*! \brief Compacts the storage of a network in place.
+ *
+ * Removes the dead nodes of the network and, unless
+ * `ps.remove_dangling` is false, all gates that are not in the
+ * transitive fanin of a CO.  The remaining nodes are renumbered: the
+ * constant keeps index 0, followed by the CIs in their order and the
+ * gates in topological order.  The relative order of the gates is kept
+ * unless a gate had a fanin with a larger index.  The fanout sizes are
+ * updated, the structural hash table is rebuilt in one pass, and the
+ * fanout index is reset.
+ *
+ * Unlike `cleanup_dangling`, the network is not copied, such that the
+ * memory peak is hardly larger than the network itself.  All nodes that
+ * are kept outside of the network (e.g., in node maps, views, or
+ * signals) are invalidated.  The returned vector maps the old index of
+ * each node to its new index, or to `compact_removed_node` if the node
+ * has been removed; it can be used to migrate node maps with
+ * `node_map::remap`.
+ *
+ * This function works on networks whose storage hashes nodes with a
+ * fixed number of fanins, such as `aig_network`, `xag_network`,
+ * `mig_network`, and `xmg_network` (also wrapped in `sequential`).
+ *
+ * **Required network functions:**
+ * - `is_constant`
+ * - `is_ci`
+ * - `is_dead`
+ * - `decr_fanout_size`
+ *
+ * \param ntk Network
+ * \param ps Parameters
+ * \param pst Statistics
+ * \return Old-to-new index of each node
+ */
+template<class Ntk>
+std::vector<uint64_t> compact_network( Ntk& ntk, compact_network_params const& ps = {}, compact_network_stats* pst = nullptr )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_is_constant_v<Ntk>, "Ntk does not implement the is_constant method" );
+  static_assert( has_is_ci_v<Ntk>, "Ntk does not implement the is_ci method" );
+  static_assert( has_is_dead_v<Ntk>, "Ntk does not implement the is_dead method" );
+  static_assert( has_decr_fanout_size_v<Ntk>, "Ntk does not implement the decr_fanout_size method" );
+  static_assert( is_strash_table_v<typename detail::compact_network_impl<Ntk>::storage_type::hash_type>, "Ntk does not store nodes with a fixed number of fanins" );
+
+  compact_network_stats st;
+  detail::compact_network_impl<Ntk> impl( ntk, ps, st );
+  auto old_to_new = impl.run();
+
+  if ( ps.verbose )
+  {
+    st.report();
+  }
+
+  if ( pst )
+  {
+    *pst = st;
+  }
+
+  return old_to_new;
+}
+
+} /* namespace mockturtle */
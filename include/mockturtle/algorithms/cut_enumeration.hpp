@@ -36,11 +36,14 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <cstdint>
 #include <iostream>
+#include <limits>
 #include <optional>
+#include <utility>
 #include <vector>
 
 #include <kitty/constructors.hpp>
@@ -52,6 +55,8 @@
 #include "../utils/cuts.hpp"
 #include "../utils/mixed_radix.hpp"
 #include "../utils/stopwatch.hpp"
+#include "../utils/trace.hpp"
+#include "../utils/thread_pool.hpp"
 #include "../utils/truth_table_cache.hpp"
 
 namespace mockturtle
@@ -76,6 +81,15 @@ struct cut_enumeration_params
   /*! \brief Prune cuts by removing don't cares. */
   bool minimize_truth_table{ false };
 
+  /*! \brief Number of threads (0 uses all hardware threads).
+   *
+   * With more than one thread, the gates are partitioned by level and the
+   * cut sets of the gates on one level are computed in parallel.  The cuts,
+   * their data, and their truth table literals are identical to the ones of
+   * the sequential enumeration.
+   */
+  uint32_t num_threads{ 1u };
+
   /*! \brief Be verbose. */
   bool verbose{ false };
 
@@ -120,6 +134,290 @@ struct cut_data<false, T>
 template<bool ComputeTruth, typename T>
 using cut_type = cut<max_cut_size, cut_data<ComputeTruth, T>>;
 
+/*! \cond PRIVATE */
+namespace detail
+{
+
+/* partitions the gates of a network by level (gates at level `l + 1` are
+ * stored in `levels[l]`), keeping the order of `foreach_node` on each level */
+template<typename Ntk>
+std::vector<std::vector<uint32_t>> cut_enumeration_levels( Ntk const& ntk )
+{
+  std::vector<uint32_t> node_levels( ntk.size(), 0u );
+  std::vector<std::vector<uint32_t>> levels;
+
+  ntk.foreach_node( [&]( auto const& n ) {
+    if ( ntk.is_constant( n ) || ntk.is_ci( n ) )
+    {
+      return;
+    }
+
+    uint32_t level{ 0 };
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      level = std::max( level, node_levels[ntk.node_to_index( ntk.get_node( f ) )] );
+    } );
+
+    auto const index = ntk.node_to_index( n );
+    node_levels[index] = level + 1;
+    if ( levels.size() <= level )
+    {
+      levels.resize( level + 1 );
+    }
+    levels[level].push_back( index );
+  } );
+
+  return levels;
+}
+
+/* Truth tables of the parallel cut enumeration.
+ *
+ * The literals of the truth table cache depend on the insertion order, so
+ * worker threads must not insert into it.  Instead, each node collects its
+ * truth tables in a local log, whose literals are tagged with `local_flag`.
+ * After each level, the logs are moved into a provisional cache, whose
+ * literals are tagged with `provisional_flag`.  In the end, the truth tables
+ * are inserted into the final cache in the order of the sequential
+ * enumeration and the literals of all cuts are remapped.
+ */
+template<typename TT>
+class cut_enumeration_truth_tables
+{
+public:
+  static constexpr uint32_t local_flag = 1u << 30;
+  static constexpr uint32_t provisional_flag = 1u << 31;
+
+  explicit cut_enumeration_truth_tables( uint32_t size = 0u ) : _ranges( size ) {}
+
+  TT lookup( uint32_t lit, truth_table_cache<TT> const& cache, std::vector<TT> const* log ) const
+  {
+    if ( lit & provisional_flag )
+    {
+      return _cache[lit ^ provisional_flag];
+    }
+    if ( lit & local_flag )
+    {
+      return ( *log )[lit ^ local_flag];
+    }
+    return cache[lit];
+  }
+
+  template<typename CutSet>
+  void commit( uint32_t index, std::vector<TT>& log, CutSet& cut_set )
+  {
+    auto const begin = _literals.size();
+    _ranges[index] = { begin, static_cast<uint32_t>( log.size() ) };
+    for ( auto const& tt : log )
+    {
+      _literals.push_back( _cache.insert( tt ) );
+    }
+
+    for ( auto& cut : cut_set )
+    {
+      if ( ( *cut )->func_id & local_flag )
+      {
+        ( *cut )->func_id = provisional_flag | _literals[begin + ( ( *cut )->func_id ^ local_flag )];
+      }
+    }
+
+    log.clear();
+    log.shrink_to_fit();
+  }
+
+  template<typename Ntk, typename CutSet>
+  void finalize( Ntk const& ntk, truth_table_cache<TT>& cache, std::vector<CutSet>& cut_sets )
+  {
+    std::vector<uint32_t> final_literals( _cache.size(), std::numeric_limits<uint32_t>::max() );
+    ntk.foreach_node( [&]( auto const& n ) {
+      auto const& range = _ranges[ntk.node_to_index( n )];
+      for ( auto i = range.first; i < range.first + range.second; ++i )
+      {
+        auto const lit = _literals[i];
+        auto& final_lit = final_literals[lit >> 1];
+        if ( final_lit == std::numeric_limits<uint32_t>::max() )
+        {
+          final_lit = cache.insert( _cache[lit & ~1u] );
+        }
+      }
+    } );
+
+    for ( auto& cut_set : cut_sets )
+    {
+      for ( auto& cut : cut_set )
+      {
+        if ( ( *cut )->func_id & provisional_flag )
+        {
+          auto const lit = ( *cut )->func_id ^ provisional_flag;
+          ( *cut )->func_id = final_literals[lit >> 1] ^ ( lit & 1 );
+        }
+      }
+    }
+  }
+
+private:
+  truth_table_cache<TT> _cache;
+  std::vector<uint32_t> _literals;
+  std::vector<std::pair<uint64_t, uint32_t>> _ranges;
+};
+
+/* Enumeration driver shared by `cut_enumeration_impl` and `fast_cut_enumeration_impl`.
+ *
+ * `run` calls `compute_cuts( index, state )` on all nodes in topological
+ * order, or level by level with several threads if `ps.num_threads` is
+ * not 1, and collects the statistics of all workers.
+ */
+template<typename Ntk, typename NetworkCuts, typename TT>
+class cut_enumeration_driver
+{
+public:
+  struct worker_state
+  {
+    std::array<typename NetworkCuts::cut_set_t*, Ntk::max_fanin_size + 1> lcuts;
+
+    /* truth tables of the current node (parallel enumeration only) */
+    std::vector<TT>* log{ nullptr };
+
+    stopwatch<>::duration time_truth_table{ 0 };
+    uint64_t total_tuples{ 0 };
+    std::size_t total_cuts{ 0 };
+  };
+
+  cut_enumeration_driver( Ntk const& ntk, cut_enumeration_params const& ps, cut_enumeration_stats& st, NetworkCuts& cuts )
+      : ntk( ntk ),
+        ps( ps ),
+        st( st ),
+        cuts( cuts )
+  {
+  }
+
+  template<typename ComputeCuts>
+  void run( ComputeCuts&& compute_cuts )
+  {
+    stopwatch t( st.time_total );
+    MOCKTURTLE_TRACE_SCOPE( "cut_enumeration" );
+
+    std::optional<thread_pool> pool;
+    if ( ps.num_threads != 1u )
+    {
+      pool.emplace( ps.num_threads );
+    }
+
+    if ( pool && pool->num_threads() > 1u )
+    {
+      run_parallel( *pool, compute_cuts );
+    }
+    else
+    {
+      states.resize( 1u );
+      ntk.foreach_node( [&]( auto node ) {
+        compute_cuts( ntk.node_to_index( node ), states[0] );
+      } );
+    }
+
+    for ( auto const& state : states )
+    {
+      st.time_truth_table += state.time_truth_table;
+      cuts._total_tuples += static_cast<uint32_t>( state.total_tuples );
+      cuts._total_cuts += state.total_cuts;
+    }
+  }
+
+  TT lookup_truth_table( uint32_t func_id, worker_state const& state ) const
+  {
+    return truth_tables.lookup( func_id, cuts._truth_tables, state.log );
+  }
+
+  uint32_t insert_truth_table( TT const& tt, worker_state& state )
+  {
+    if ( state.log == nullptr )
+    {
+      return cuts._truth_tables.insert( tt );
+    }
+
+    state.log->push_back( tt );
+    return cut_enumeration_truth_tables<TT>::local_flag | static_cast<uint32_t>( state.log->size() - 1u );
+  }
+
+private:
+  template<typename ComputeCuts>
+  void run_parallel( thread_pool& pool, ComputeCuts& compute_cuts )
+  {
+    states.resize( pool.num_threads() );
+
+    ntk.foreach_node( [&]( auto node ) {
+      if ( ntk.is_constant( node ) || ntk.is_ci( node ) )
+      {
+        compute_cuts( ntk.node_to_index( node ), states[0] );
+      }
+    } );
+
+    if constexpr ( NetworkCuts::compute_truth )
+    {
+      truth_tables = cut_enumeration_truth_tables<TT>( ntk.size() );
+      cuts._pending = &truth_tables;
+    }
+
+    std::vector<std::vector<TT>> logs;
+    for ( auto const& level : cut_enumeration_levels( ntk ) )
+    {
+      logs.resize( std::max<std::size_t>( logs.size(), level.size() ) );
+
+      auto const compute_level_cuts = [&]( uint64_t i, uint32_t thread_id ) {
+        auto& state = states[thread_id];
+        if constexpr ( NetworkCuts::compute_truth )
+        {
+          state.log = &logs[i];
+          NetworkCuts::_worker_log = &logs[i];
+        }
+        compute_cuts( level[i], state );
+      };
+
+      /* small levels are not worth waking up the workers */
+      if ( level.size() < 8u * pool.num_threads() )
+      {
+        for ( auto i = 0u; i < level.size(); ++i )
+        {
+          compute_level_cuts( i, 0u );
+        }
+      }
+      else
+      {
+        pool.parallel_for( 0u, level.size(), compute_level_cuts, 4u );
+      }
+
+      if constexpr ( NetworkCuts::compute_truth )
+      {
+        for ( auto i = 0u; i < level.size(); ++i )
+        {
+          truth_tables.commit( level[i], logs[i], cuts.cuts( level[i] ) );
+        }
+      }
+    }
+
+    if constexpr ( NetworkCuts::compute_truth )
+    {
+      truth_tables.finalize( ntk, cuts._truth_tables, cuts._cuts );
+      cuts._pending = nullptr;
+    }
+
+    for ( auto& state : states )
+    {
+      state.log = nullptr;
+    }
+  }
+
+private:
+  Ntk const& ntk;
+  cut_enumeration_params const& ps;
+  cut_enumeration_stats& st;
+  NetworkCuts& cuts;
+
+  std::vector<worker_state> states;
+  cut_enumeration_truth_tables<TT> truth_tables;
+};
+
+} /* namespace detail */
+/*! \endcond */
+
 /* forward declarations */
 /*! \cond PRIVATE */
 template<typename Ntk, bool ComputeTruth, typename CutData>
@@ -188,6 +486,11 @@ public:
   template<bool enabled = ComputeTruth, typename = std::enable_if_t<std::is_same_v<Ntk, Ntk> && enabled>>
   auto truth_table( cut_t const& cut ) const
   {
+    if ( _pending != nullptr )
+    {
+      /* called by `cut_enumeration_update_cut` during a parallel enumeration */
+      return _pending->lookup( cut->func_id, _truth_tables, _worker_log );
+    }
     return _truth_tables[cut->func_id];
   }
 
@@ -247,6 +550,9 @@ private:
   template<typename _Ntk, bool _ComputeTruth, typename _CutData>
   friend class detail::cut_enumeration_impl;
 
+  template<typename _Ntk, typename _NetworkCuts, typename _TT>
+  friend class detail::cut_enumeration_driver;
+
   template<typename _Ntk, bool _ComputeTruth, typename _CutData>
   friend network_cuts<_Ntk, _ComputeTruth, _CutData> cut_enumeration( _Ntk const& ntk, cut_enumeration_params const& ps, cut_enumeration_stats* pst );
 
@@ -278,6 +584,10 @@ private:
   /* cut truth tables */
   truth_table_cache<kitty::dynamic_truth_table> _truth_tables;
 
+  /* truth tables of a running parallel enumeration, and the ones of the node of the current worker thread */
+  detail::cut_enumeration_truth_tables<kitty::dynamic_truth_table> const* _pending{ nullptr };
+  static inline thread_local std::vector<kitty::dynamic_truth_table> const* _worker_log{ nullptr };
+
   /* statistics */
   uint32_t _total_tuples{};
   std::size_t _total_cuts{};
@@ -293,12 +603,16 @@ class cut_enumeration_impl
 public:
   using cut_t = typename network_cuts<Ntk, ComputeTruth, CutData>::cut_t;
   using cut_set_t = typename network_cuts<Ntk, ComputeTruth, CutData>::cut_set_t;
+  using tt_t = kitty::dynamic_truth_table;
+  using driver_t = cut_enumeration_driver<Ntk, network_cuts<Ntk, ComputeTruth, CutData>, tt_t>;
+  using worker_state = typename driver_t::worker_state;
 
   explicit cut_enumeration_impl( Ntk const& ntk, cut_enumeration_params const& ps, cut_enumeration_stats& st, network_cuts<Ntk, ComputeTruth, CutData>& cuts )
       : ntk( ntk ),
         ps( ps ),
         st( st ),
-        cuts( cuts )
+        cuts( cuts ),
+        driver( ntk, ps, st, cuts )
   {
     assert( ps.cut_limit < cuts.max_cut_num && "cut_limit exceeds the compile-time limit for the maximum number of cuts" );
   }
@@ -306,48 +620,50 @@ public:
 public:
   void run()
   {
-    stopwatch t( st.time_total );
-
-    ntk.foreach_node( [this]( auto node ) {
-      const auto index = ntk.node_to_index( node );
+    driver.run( [this]( uint32_t index, worker_state& state ) {
+      compute_cuts( index, state );
+    } );
+  }
 
-      if ( ps.very_verbose )
-      {
-        std::cout << fmt::format( "[i] compute cut for node at index {}\n", index );
-      }
+private:
+  void compute_cuts( uint32_t index, worker_state& state )
+  {
+    if ( ps.very_verbose )
+    {
+      std::cout << fmt::format( "[i] compute cut for node at index {}\n", index );
+    }
 
-      if ( ntk.is_constant( node ) )
-      {
-        cuts.add_zero_cut( index );
-      }
-      else if ( ntk.is_ci( node ) )
+    auto const node = ntk.index_to_node( index );
+    if ( ntk.is_constant( node ) )
+    {
+      cuts.add_zero_cut( index );
+    }
+    else if ( ntk.is_ci( node ) )
+    {
+      cuts.add_unit_cut( index );
+    }
+    else
+    {
+      if constexpr ( Ntk::min_fanin_size == 2 && Ntk::max_fanin_size == 2 )
       {
-        cuts.add_unit_cut( index );
+        merge_cuts2( index, state );
       }
       else
       {
-        if constexpr ( Ntk::min_fanin_size == 2 && Ntk::max_fanin_size == 2 )
-        {
-          merge_cuts2( index );
-        }
-        else
-        {
-          merge_cuts( index );
-        }
+        merge_cuts( index, state );
       }
-    } );
+    }
   }
 
-private:
-  uint32_t compute_truth_table( uint32_t index, std::vector<cut_t const*> const& vcuts, cut_t& res )
+  uint32_t compute_truth_table( uint32_t index, std::vector<cut_t const*> const& vcuts, cut_t& res, worker_state& state )
   {
-    stopwatch t( st.time_truth_table );
+    stopwatch t( state.time_truth_table );
 
     std::vector<kitty::dynamic_truth_table> tt( vcuts.size() );
     auto i = 0;
     for ( auto const& cut : vcuts )
     {
-      tt[i] = kitty::extend_to( cuts._truth_tables[( *cut )->func_id], res.size() );
+      tt[i] = kitty::extend_to( driver.lookup_truth_table( ( *cut )->func_id, state ), res.size() );
       const auto supp = cuts.compute_truth_table_support( *cut, res );
       kitty::expand_inplace( tt[i], supp );
       ++i;
@@ -371,34 +687,34 @@ private:
           *it_leaves++ = leaves_before[*it_support++];
         }
         res.set_leaves( leaves_after.begin(), leaves_after.end() );
-        return cuts._truth_tables.insert( tt_res_shrink );
+        return driver.insert_truth_table( tt_res_shrink, state );
       }
     }
 
-    return cuts._truth_tables.insert( tt_res );
+    return driver.insert_truth_table( tt_res, state );
   }
 
-  void merge_cuts2( uint32_t index )
+  void merge_cuts2( uint32_t index, worker_state& state )
   {
     const auto fanin = 2;
 
     uint32_t pairs{ 1 };
-    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &pairs]( auto child, auto i ) {
-      lcuts[i] = &cuts.cuts( ntk.node_to_index( ntk.get_node( child ) ) );
-      pairs *= static_cast<uint32_t>( lcuts[i]->size() );
+    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &state, &pairs]( auto child, auto i ) {
+      state.lcuts[i] = &cuts.cuts( ntk.node_to_index( ntk.get_node( child ) ) );
+      pairs *= static_cast<uint32_t>( state.lcuts[i]->size() );
     } );
-    lcuts[2] = &cuts.cuts( index );
-    auto& rcuts = *lcuts[fanin];
+    state.lcuts[2] = &cuts.cuts( index );
+    auto& rcuts = *state.lcuts[fanin];
     rcuts.clear();
 
     cut_t new_cut;
 
     std::vector<cut_t const*> vcuts( fanin );
 
-    cuts._total_tuples += pairs;
-    for ( auto const& c1 : *lcuts[0] )
+    state.total_tuples += pairs;
+    for ( auto const& c1 : *state.lcuts[0] )
     {
-      for ( auto const& c2 : *lcuts[1] )
+      for ( auto const& c2 : *state.lcuts[1] )
       {
         if ( !c1->merge( *c2, new_cut, ps.cut_size ) )
         {
@@ -414,7 +730,7 @@ private:
         {
           vcuts[0] = c1;
           vcuts[1] = c2;
-          new_cut->func_id = compute_truth_table( index, vcuts, new_cut );
+          new_cut->func_id = compute_truth_table( index, vcuts, new_cut, state );
         }
 
         cut_enumeration_update_cut<CutData>::apply( new_cut, cuts, ntk, index );
@@ -426,7 +742,8 @@ private:
     /* limit the maximum number of cuts */
     rcuts.limit( ps.cut_limit - 1 );
 
-    cuts._total_cuts += rcuts.size();
+    state.total_cuts += rcuts.size();
+    MOCKTURTLE_TRACE_HISTOGRAM( "cut_enumeration/cut_set_size", rcuts.size() );
 
     if ( rcuts.size() > 1 || ( *rcuts.begin() )->size() > 1 )
     {
@@ -434,20 +751,20 @@ private:
     }
   }
 
-  void merge_cuts( uint32_t index )
+  void merge_cuts( uint32_t index, worker_state& state )
   {
     uint32_t pairs{ 1 };
     std::vector<uint32_t> cut_sizes;
-    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &pairs, &cut_sizes]( auto child, auto i ) {
-      lcuts[i] = &cuts.cuts( ntk.node_to_index( ntk.get_node( child ) ) );
-      cut_sizes.push_back( static_cast<uint32_t>( lcuts[i]->size() ) );
+    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &state, &pairs, &cut_sizes]( auto child, auto i ) {
+      state.lcuts[i] = &cuts.cuts( ntk.node_to_index( ntk.get_node( child ) ) );
+      cut_sizes.push_back( static_cast<uint32_t>( state.lcuts[i]->size() ) );
       pairs *= cut_sizes.back();
     } );
 
     const auto fanin = cut_sizes.size();
-    lcuts[fanin] = &cuts.cuts( index );
+    state.lcuts[fanin] = &cuts.cuts( index );
 
-    auto& rcuts = *lcuts[fanin];
+    auto& rcuts = *state.lcuts[fanin];
 
     if ( fanin > 1 && fanin <= ps.fanin_limit )
     {
@@ -457,13 +774,13 @@ private:
 
       std::vector<cut_t const*> vcuts( fanin );
 
-      cuts._total_tuples += pairs;
+      state.total_tuples += pairs;
       foreach_mixed_radix_tuple( cut_sizes.begin(), cut_sizes.end(), [&]( auto begin, auto end ) {
         auto it = vcuts.begin();
         auto i = 0u;
         while ( begin != end )
         {
-          *it++ = &( ( *lcuts[i++] )[*begin++] );
+          *it++ = &( ( *state.lcuts[i++] )[*begin++] );
         }
 
         if ( !vcuts[0]->merge( *vcuts[1], new_cut, ps.cut_size ) )
@@ -487,7 +804,7 @@ private:
 
         if constexpr ( ComputeTruth )
         {
-          new_cut->func_id = compute_truth_table( index, vcuts, new_cut );
+          new_cut->func_id = compute_truth_table( index, vcuts, new_cut, state );
         }
 
         cut_enumeration_update_cut<CutData>::apply( new_cut, cuts, ntk, ntk.index_to_node( index ) );
@@ -504,13 +821,13 @@ private:
     {
       rcuts.clear();
 
-      for ( auto const& cut : *lcuts[0] )
+      for ( auto const& cut : *state.lcuts[0] )
       {
         cut_t new_cut = *cut;
 
         if constexpr ( ComputeTruth )
         {
-          new_cut->func_id = compute_truth_table( index, { cut }, new_cut );
+          new_cut->func_id = compute_truth_table( index, { cut }, new_cut, state );
         }
 
         cut_enumeration_update_cut<CutData>::apply( new_cut, cuts, ntk, ntk.index_to_node( index ) );
@@ -522,7 +839,8 @@ private:
       rcuts.limit( ps.cut_limit - 1 );
     }
 
-    cuts._total_cuts += static_cast<uint32_t>( rcuts.size() );
+    state.total_cuts += static_cast<uint32_t>( rcuts.size() );
+    MOCKTURTLE_TRACE_HISTOGRAM( "cut_enumeration/cut_set_size", rcuts.size() );
 
     cuts.add_unit_cut( index );
   }
@@ -533,7 +851,7 @@ private:
   cut_enumeration_stats& st;
   network_cuts<Ntk, ComputeTruth, CutData>& cuts;
 
-  std::array<cut_set_t*, Ntk::max_fanin_size + 1> lcuts;
+  driver_t driver;
 };
 } /* namespace detail */
 /*! \endcond */
@@ -671,6 +989,11 @@ public:
   template<bool enabled = ComputeTruth, typename = std::enable_if_t<std::is_same_v<Ntk, Ntk> && enabled>>
   auto truth_table( cut_t const& cut ) const
   {
+    if ( _pending != nullptr )
+    {
+      /* called by `cut_enumeration_update_cut` during a parallel enumeration */
+      return _pending->lookup( cut->func_id, _truth_tables, _worker_log );
+    }
     return _truth_tables[cut->func_id];
   }
 
@@ -730,6 +1053,9 @@ private:
   template<typename _Ntk, uint32_t _NumVars, bool _ComputeTruth, typename _CutData>
   friend class detail::fast_cut_enumeration_impl;
 
+  template<typename _Ntk, typename _NetworkCuts, typename _TT>
+  friend class detail::cut_enumeration_driver;
+
   template<typename _Ntk, uint32_t _NumVars, bool _ComputeTruth, typename _CutData>
   friend fast_network_cuts<_Ntk, _NumVars, _ComputeTruth, _CutData> fast_cut_enumeration( _Ntk const& ntk, cut_enumeration_params const& ps, cut_enumeration_stats* pst );
 
@@ -761,6 +1087,10 @@ private:
   /* cut truth tables */
   truth_table_cache<kitty::static_truth_table<NumVars>> _truth_tables;
 
+  /* truth tables of a running parallel enumeration, and the ones of the node of the current worker thread */
+  detail::cut_enumeration_truth_tables<kitty::static_truth_table<NumVars>> const* _pending{ nullptr };
+  static inline thread_local std::vector<kitty::static_truth_table<NumVars>> const* _worker_log{ nullptr };
+
   /* statistics */
   uint32_t _total_tuples{};
   std::size_t _total_cuts{};
@@ -776,12 +1106,16 @@ class fast_cut_enumeration_impl
 public:
   using cut_t = typename fast_network_cuts<Ntk, NumVars, ComputeTruth, CutData>::cut_t;
   using cut_set_t = typename fast_network_cuts<Ntk, NumVars, ComputeTruth, CutData>::cut_set_t;
+  using tt_t = kitty::static_truth_table<NumVars>;
+  using driver_t = cut_enumeration_driver<Ntk, fast_network_cuts<Ntk, NumVars, ComputeTruth, CutData>, tt_t>;
+  using worker_state = typename driver_t::worker_state;
 
   explicit fast_cut_enumeration_impl( Ntk const& ntk, cut_enumeration_params const& ps, cut_enumeration_stats& st, fast_network_cuts<Ntk, NumVars, ComputeTruth, CutData>& cuts )
       : ntk( ntk ),
         ps( ps ),
         st( st ),
-        cuts( cuts )
+        cuts( cuts ),
+        driver( ntk, ps, st, cuts )
   {
     assert( ps.cut_limit < cuts.max_cut_num && "cut_limit exceeds the compile-time limit for the maximum number of cuts" );
   }
@@ -789,48 +1123,50 @@ public:
 public:
   void run()
   {
-    stopwatch t( st.time_total );
-
-    ntk.foreach_node( [this]( auto node ) {
-      const auto index = ntk.node_to_index( node );
+    driver.run( [this]( uint32_t index, worker_state& state ) {
+      compute_cuts( index, state );
+    } );
+  }
 
-      if ( ps.very_verbose )
-      {
-        std::cout << fmt::format( "[i] compute cut for node at index {}\n", index );
-      }
+private:
+  void compute_cuts( uint32_t index, worker_state& state )
+  {
+    if ( ps.very_verbose )
+    {
+      std::cout << fmt::format( "[i] compute cut for node at index {}\n", index );
+    }
 
-      if ( ntk.is_constant( node ) )
-      {
-        cuts.add_zero_cut( index );
-      }
-      else if ( ntk.is_ci( node ) )
+    auto const node = ntk.index_to_node( index );
+    if ( ntk.is_constant( node ) )
+    {
+      cuts.add_zero_cut( index );
+    }
+    else if ( ntk.is_ci( node ) )
+    {
+      cuts.add_unit_cut( index );
+    }
+    else
+    {
+      if constexpr ( Ntk::min_fanin_size == 2 && Ntk::max_fanin_size == 2 )
       {
-        cuts.add_unit_cut( index );
+        merge_cuts2( index, state );
       }
       else
       {
-        if constexpr ( Ntk::min_fanin_size == 2 && Ntk::max_fanin_size == 2 )
-        {
-          merge_cuts2( index );
-        }
-        else
-        {
-          merge_cuts( index );
-        }
+        merge_cuts( index, state );
       }
-    } );
+    }
   }
 
-private:
-  uint32_t compute_truth_table( uint32_t index, std::vector<cut_t const*> const& vcuts, cut_t& res )
+  uint32_t compute_truth_table( uint32_t index, std::vector<cut_t const*> const& vcuts, cut_t& res, worker_state& state )
   {
-    stopwatch t( st.time_truth_table );
+    stopwatch t( state.time_truth_table );
 
     std::vector<kitty::static_truth_table<NumVars>> tt( vcuts.size() );
     auto i = 0;
     for ( auto const& cut : vcuts )
     {
-      tt[i] = cuts._truth_tables[( *cut )->func_id];
+      tt[i] = driver.lookup_truth_table( ( *cut )->func_id, state );
       const auto supp = cuts.compute_truth_table_support( *cut, res );
       kitty::expand_inplace( tt[i], supp );
       ++i;
@@ -856,30 +1192,30 @@ private:
       }
     }
 
-    return cuts._truth_tables.insert( tt_res );
+    return driver.insert_truth_table( tt_res, state );
   }
 
-  void merge_cuts2( uint32_t index )
+  void merge_cuts2( uint32_t index, worker_state& state )
   {
     const auto fanin = 2;
 
     uint32_t pairs{ 1 };
-    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &pairs]( auto child, auto i ) {
-      lcuts[i] = &cuts.cuts( ntk.node_to_index( ntk.get_node( child ) ) );
-      pairs *= static_cast<uint32_t>( lcuts[i]->size() );
+    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &state, &pairs]( auto child, auto i ) {
+      state.lcuts[i] = &cuts.cuts( ntk.node_to_index( ntk.get_node( child ) ) );
+      pairs *= static_cast<uint32_t>( state.lcuts[i]->size() );
     } );
-    lcuts[2] = &cuts.cuts( index );
-    auto& rcuts = *lcuts[fanin];
+    state.lcuts[2] = &cuts.cuts( index );
+    auto& rcuts = *state.lcuts[fanin];
     rcuts.clear();
 
     cut_t new_cut;
 
     std::vector<cut_t const*> vcuts( fanin );
 
-    cuts._total_tuples += pairs;
-    for ( auto const& c1 : *lcuts[0] )
+    state.total_tuples += pairs;
+    for ( auto const& c1 : *state.lcuts[0] )
     {
-      for ( auto const& c2 : *lcuts[1] )
+      for ( auto const& c2 : *state.lcuts[1] )
       {
         if ( !c1->merge( *c2, new_cut, NumVars ) )
         {
@@ -895,7 +1231,7 @@ private:
         {
           vcuts[0] = c1;
           vcuts[1] = c2;
-          new_cut->func_id = compute_truth_table( index, vcuts, new_cut );
+          new_cut->func_id = compute_truth_table( index, vcuts, new_cut, state );
         }
 
         cut_enumeration_update_cut<CutData>::apply( new_cut, cuts, ntk, index );
@@ -907,7 +1243,8 @@ private:
     /* limit the maximum number of cuts */
     rcuts.limit( ps.cut_limit - 1 );
 
-    cuts._total_cuts += rcuts.size();
+    state.total_cuts += rcuts.size();
+    MOCKTURTLE_TRACE_HISTOGRAM( "cut_enumeration/cut_set_size", rcuts.size() );
 
     if ( rcuts.size() > 1 || ( *rcuts.begin() )->size() > 1 )
     {
@@ -915,20 +1252,20 @@ private:
     }
   }
 
-  void merge_cuts( uint32_t index )
+  void merge_cuts( uint32_t index, worker_state& state )
   {
     uint32_t pairs{ 1 };
     std::vector<uint32_t> cut_sizes;
-    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &pairs, &cut_sizes]( auto child, auto i ) {
-      lcuts[i] = &cuts.cuts( ntk.node_to_index( ntk.get_node( child ) ) );
-      cut_sizes.push_back( static_cast<uint32_t>( lcuts[i]->size() ) );
+    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &state, &pairs, &cut_sizes]( auto child, auto i ) {
+      state.lcuts[i] = &cuts.cuts( ntk.node_to_index( ntk.get_node( child ) ) );
+      cut_sizes.push_back( static_cast<uint32_t>( state.lcuts[i]->size() ) );
       pairs *= cut_sizes.back();
     } );
 
     const auto fanin = cut_sizes.size();
-    lcuts[fanin] = &cuts.cuts( index );
+    state.lcuts[fanin] = &cuts.cuts( index );
 
-    auto& rcuts = *lcuts[fanin];
+    auto& rcuts = *state.lcuts[fanin];
 
     if ( fanin > 1 && fanin <= ps.fanin_limit )
     {
@@ -938,13 +1275,13 @@ private:
 
       std::vector<cut_t const*> vcuts( fanin );
 
-      cuts._total_tuples += pairs;
+      state.total_tuples += pairs;
       foreach_mixed_radix_tuple( cut_sizes.begin(), cut_sizes.end(), [&]( auto begin, auto end ) {
         auto it = vcuts.begin();
         auto i = 0u;
         while ( begin != end )
         {
-          *it++ = &( ( *lcuts[i++] )[*begin++] );
+          *it++ = &( ( *state.lcuts[i++] )[*begin++] );
         }
 
         if ( !vcuts[0]->merge( *vcuts[1], new_cut, NumVars ) )
@@ -968,7 +1305,7 @@ private:
 
         if constexpr ( ComputeTruth )
         {
-          new_cut->func_id = compute_truth_table( index, vcuts, new_cut );
+          new_cut->func_id = compute_truth_table( index, vcuts, new_cut, state );
         }
 
         cut_enumeration_update_cut<CutData>::apply( new_cut, cuts, ntk, ntk.index_to_node( index ) );
@@ -985,13 +1322,13 @@ private:
     {
       rcuts.clear();
 
-      for ( auto const& cut : *lcuts[0] )
+      for ( auto const& cut : *state.lcuts[0] )
       {
         cut_t new_cut = *cut;
 
         if constexpr ( ComputeTruth )
         {
-          new_cut->func_id = compute_truth_table( index, { cut }, new_cut );
+          new_cut->func_id = compute_truth_table( index, { cut }, new_cut, state );
         }
 
         cut_enumeration_update_cut<CutData>::apply( new_cut, cuts, ntk, ntk.index_to_node( index ) );
@@ -1003,7 +1340,8 @@ private:
       rcuts.limit( ps.cut_limit - 1 );
     }
 
-    cuts._total_cuts += static_cast<uint32_t>( rcuts.size() );
+    state.total_cuts += static_cast<uint32_t>( rcuts.size() );
+    MOCKTURTLE_TRACE_HISTOGRAM( "cut_enumeration/cut_set_size", rcuts.size() );
 
     cuts.add_unit_cut( index );
   }
@@ -1014,7 +1352,7 @@ private:
   cut_enumeration_stats& st;
   fast_network_cuts<Ntk, NumVars, ComputeTruth, CutData>& cuts;
 
-  std::array<cut_set_t*, Ntk::max_fanin_size + 1> lcuts;
+  driver_t driver;
 };
 } /* namespace detail */
 /*! \endcond */
@@ -1285,6 +1623,7 @@ public:
   void run()
   {
     stopwatch t( st.time_total );
+    MOCKTURTLE_TRACE_SCOPE( "cut_enumeration" );
 
     ntk.foreach_node( [this]( auto node ) {
       const auto index = ntk.node_to_index( node );
@@ -1472,6 +1811,7 @@ private:
     rcuts.limit( ps.cut_limit );
 
     cuts._total_cuts += rcuts.size();
+    MOCKTURTLE_TRACE_HISTOGRAM( "cut_enumeration/cut_set_size", rcuts.size() );
 
     if ( rcuts.size() > 1 || ( *rcuts.begin() )->size() > 1 )
     {
@@ -1568,6 +1908,7 @@ private:
     }
 
     cuts._total_cuts += static_cast<uint32_t>( rcuts.size() );
+    MOCKTURTLE_TRACE_HISTOGRAM( "cut_enumeration/cut_set_size", rcuts.size() );
 
     cuts.add_unit_cut( index );
   }
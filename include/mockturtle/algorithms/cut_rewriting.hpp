@@ -48,6 +48,7 @@
 #include "../utils/node_map.hpp"
 #include "../utils/progress_bar.hpp"
 #include "../utils/stopwatch.hpp"
+#include "../utils/trace.hpp"
 #include "../views/cut_view.hpp"
 #include "../views/depth_view.hpp"
 #include "../views/fanout_view.hpp"
@@ -403,6 +404,7 @@ public:
   void run()
   {
     stopwatch t( st.time_total );
+    MOCKTURTLE_TRACE_SCOPE( "cut_rewriting" );
 
     /* enumerate cuts */
     const auto cuts = call_with_stopwatch( st.time_cuts, [&]() { return cut_enumeration<Ntk, true, cut_enumeration_cut_rewriting_cut>( ntk, ps.cut_enumeration_ps ); } );
@@ -54,6 +54,7 @@
 #include "../utils/node_map.hpp"
 #include "../utils/stopwatch.hpp"
 #include "../utils/tech_library.hpp"
+#include "../utils/trace.hpp"
 #include "../views/binding_view.hpp"
 #include "../views/cell_view.hpp"
 #include "../views/choice_view.hpp"
@@ -777,6 +778,7 @@ public:
   cell_view<block_network> run_block()
   {
     time_begin = clock::now();
+    MOCKTURTLE_TRACE_SCOPE( "emap" );
 
     auto [res, old2new] = initialize_block_network();
 
@@ -831,6 +833,7 @@ public:
   binding_view<klut_network> run_klut()
   {
     time_begin = clock::now();
+    MOCKTURTLE_TRACE_SCOPE( "emap" );
 
     auto [res, old2new] = initialize_map_network();
 
@@ -885,6 +888,7 @@ public:
   binding_view<klut_network> run_node_map()
   {
     time_begin = clock::now();
+    MOCKTURTLE_TRACE_SCOPE( "emap" );
 
     auto [res, old2new] = initialize_map_network();
 
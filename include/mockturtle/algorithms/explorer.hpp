@@ -60,8 +60,12 @@
 #include "../io/write_aiger.hpp"
 #include "../io/verilog_reader.hpp"
 #include "../utils/stopwatch.hpp"
+#include "../utils/thread_pool.hpp"
 #include "../utils/abc.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <random>
 
 #define explorer_debug 0
@@ -90,6 +94,28 @@ struct explorer_params
   /*! \brief Timeout per iteration in seconds. */
   uint32_t timeout{30u};
 
+  /*! \brief Number of restarts running concurrently (0 uses all hardware threads).
+   *
+   * Each concurrent restart works on its own clone of the network, but the
+   * scripts and the cost function are called concurrently and must be
+   * thread-safe.
+   */
+  uint32_t num_threads{1u};
+
+  /*! \brief Number of steps after which restarts worse than the best network
+   * found so far continue from a copy of it (0 = never).  Only used with
+   * multiple threads. */
+  uint32_t migration_interval{10u};
+
+  /*! \brief Synchronize the concurrent restarts at each migration.
+   *
+   * Restarts then run in rounds of `num_threads` and migrate at the same
+   * steps, such that the result only depends on the random seed and the
+   * number of threads (unless a restart reaches the timeout).  Otherwise,
+   * the restarts run freely and share the best network when they improve
+   * it. */
+  bool deterministic{false};
+
   /*! \brief Be verbose. */
   bool verbose{false};
 
@@ -151,87 +177,237 @@ public:
 
     RandEngine rnd( _ps.random_seed );
     auto init_cost = call_with_stopwatch( _st.time_evaluate, [&](){ return cost( ntk ); } );
+    if ( _ps.num_threads != 1u )
+    {
+      return _ps.deterministic ? run_rounds( ntk, rnd, init_cost ) : run_portfolio( ntk, rnd, init_cost );
+    }
+
     Ntk best = ntk.clone();
     auto best_cost = init_cost;
     for ( auto i = 0u; i < _ps.num_restarts; ++i )
     {
-      Ntk current = ntk.clone();
-      auto new_cost = run_one_iteration( current, rnd(), init_cost );
-      if ( new_cost < best_cost )
+      restart_state s( i, ntk, rnd(), init_cost );
+      if ( _ps.verbose )
       {
-        best = current.clone();
-        best_cost = new_cost;
+        fmt::print( "\n[i] new restart using seed {}, original cost = {}\n", s.seed, init_cost );
+      }
+      run_steps( s, _ps.max_steps );
+      _st.time_evaluate += s.time_evaluate;
+      std::cout << std::flush;
+
+      if ( s.best_cost < best_cost )
+      {
+        best = s.best.clone();
+        best_cost = s.best_cost;
       }
       if ( _ps.verbose )
-        fmt::print( "[i] best cost in restart {}: {}, overall best cost: {}\n", i, new_cost, best_cost );
+        fmt::print( "[i] best cost in restart {}: {}, overall best cost: {}\n", i, s.best_cost, best_cost );
     }
     return best;
   }
 
 private:
-  uint32_t run_one_iteration( Ntk& ntk, uint32_t seed, uint32_t init_cost )
+  /* state of one restart, which can be suspended between steps */
+  struct restart_state
   {
-    if ( _ps.verbose )
+    restart_state( uint32_t index, Ntk const& ntk, uint32_t seed, uint32_t init_cost )
+        : index( index ), seed( seed ), rnd( seed ), current( ntk.clone() ), best( ntk.clone() ), best_cost( init_cost )
     {
-      fmt::print( "\n[i] new restart using seed {}, original cost = {}\n", seed, init_cost );
     }
- 
-    stopwatch<>::duration elapsed_time{0};
-    RandEngine rnd( seed );
-    Ntk best = ntk.clone();
-    auto best_cost = init_cost;
+
+    uint32_t index;
+    uint32_t seed;
+    RandEngine rnd;
+    Ntk current;
+    Ntk best;
+    uint32_t best_cost;
+
+    uint32_t step{0u};
     uint32_t last_update{0u};
-    for ( auto i = 0u; i < _ps.max_steps; ++i )
+    bool done{false};
+    stopwatch<>::duration elapsed_time{0};
+    stopwatch<>::duration time_evaluate{0};
+  };
+
+  /* runs at most `num_steps` steps of a restart */
+  void run_steps( restart_state& s, uint32_t num_steps )
+  {
+    for ( auto const end = s.step + std::min( num_steps, _ps.max_steps - s.step ); !s.done && s.step < end; ++s.step )
     {
+      auto const i = s.step;
     #if explorer_debug
-      Ntk backup = ntk.clone();
+      Ntk backup = s.current.clone();
     #endif
 
       {
-        stopwatch t( elapsed_time );
-        decompress( ntk, rnd, i );
-        compress( ntk, rnd, i );
+        stopwatch t( s.elapsed_time );
+        decompress( s.current, s.rnd, i );
+        compress( s.current, s.rnd, i );
       }
-      auto new_cost = call_with_stopwatch( _st.time_evaluate, [&](){ return cost( ntk ); } );
+      auto new_cost = call_with_stopwatch( s.time_evaluate, [&](){ return cost( s.current ); } );
       if ( _ps.very_verbose )
         fmt::print( "[i] after step {}, cost = {}\n", i, new_cost );
 
     #if explorer_debug
-      if ( !*equivalence_checking( *miter<Ntk>( ntk, best ) ) )
+      if ( !*equivalence_checking( *miter<Ntk>( s.current, s.best ) ) )
       {
         write_verilog( backup, "debug.v" );
-        write_verilog( ntk, "wrong.v" );
+        write_verilog( s.current, "wrong.v" );
         fmt::print( "NEQ at step {}!\n", i );
+        s.done = true;
         break;
       }
     #endif
 
-      if ( new_cost < best_cost )
+      if ( new_cost < s.best_cost )
       {
-        best = ntk.clone();
-        best_cost = new_cost;
-        last_update = i;
+        s.best = s.current.clone();
+        s.best_cost = new_cost;
+        s.last_update = i;
         if ( _ps.verbose )
         {
-          fmt::print( "[i] updated new best at step {}: {}\n", i, best_cost );
+          fmt::print( "[i] updated new best at step {}: {}\n", i, s.best_cost );
         }
       }
-      if ( i - last_update >= _ps.max_steps_no_impr )
+      if ( i - s.last_update >= _ps.max_steps_no_impr )
       {
         if ( _ps.verbose )
-          fmt::print( "[i] break restart at step {} after {} steps without improvement (elapsed time: {} secs)\n", i, _ps.max_steps_no_impr, to_seconds( elapsed_time ) );
-        break;
+          fmt::print( "[i] break restart at step {} after {} steps without improvement (elapsed time: {} secs)\n", i, _ps.max_steps_no_impr, to_seconds( s.elapsed_time ) );
+        s.done = true;
       }
-      if ( to_seconds( elapsed_time ) >= _ps.timeout )
+      else if ( to_seconds( s.elapsed_time ) >= _ps.timeout )
       {
         if ( _ps.verbose )
-          fmt::print( "[i] break restart at step {} after timeout of {} secs\n", i, to_seconds( elapsed_time ) );
-        break;
+          fmt::print( "[i] break restart at step {} after timeout of {} secs\n", i, to_seconds( s.elapsed_time ) );
+        s.done = true;
       }
     }
-    std::cout << std::flush;
-    ntk = best;
-    return best_cost;
+
+    if ( s.step >= _ps.max_steps )
+    {
+      s.done = true;
+    }
+  }
+
+  /* continues a restart from a copy of a better network */
+  void migrate( restart_state& s, Ntk const& best, uint32_t best_cost )
+  {
+    if ( _ps.very_verbose )
+      fmt::print( "[i] restart {} continues from the best network at step {}: {} -> {}\n", s.index, s.step, s.best_cost, best_cost );
+
+    s.current = best.clone();
+    s.best = best.clone();
+    s.best_cost = best_cost;
+    s.last_update = s.step;
+  }
+
+  /* Runs `num_threads` restarts at a time, synchronized after every
+   * `migration_interval` steps.  The restarts worse than the best network
+   * found so far migrate to it in a deterministic order. */
+  Ntk run_rounds( Ntk const& ntk, RandEngine& rnd, uint32_t init_cost )
+  {
+    thread_pool pool( _ps.num_threads );
+    auto const interval = _ps.migration_interval == 0u ? _ps.max_steps : _ps.migration_interval;
+
+    Ntk best = ntk.clone();
+    auto best_cost = init_cost;
+    std::vector<restart_state> states;
+    for ( auto first = 0u; first < _ps.num_restarts; first += pool.num_threads() )
+    {
+      states.clear();
+      for ( auto i = first; i < std::min( _ps.num_restarts, first + pool.num_threads() ); ++i )
+      {
+        states.emplace_back( i, ntk, rnd(), init_cost );
+      }
+
+      while ( std::any_of( states.begin(), states.end(), []( auto const& s ) { return !s.done; } ) )
+      {
+        pool.run( [&]( uint32_t thread_id ) {
+          if ( thread_id < states.size() )
+          {
+            run_steps( states[thread_id], interval );
+          }
+        } );
+
+        for ( auto const& s : states )
+        {
+          if ( s.best_cost < best_cost )
+          {
+            best = s.best.clone();
+            best_cost = s.best_cost;
+          }
+        }
+
+        if ( _ps.migration_interval == 0u )
+        {
+          continue;
+        }
+        for ( auto& s : states )
+        {
+          if ( !s.done && best_cost < s.best_cost )
+          {
+            migrate( s, best, best_cost );
+          }
+        }
+      }
+
+      for ( auto const& s : states )
+      {
+        _st.time_evaluate += s.time_evaluate;
+        if ( _ps.verbose )
+          fmt::print( "[i] best cost in restart {}: {}, overall best cost: {}\n", s.index, s.best_cost, best_cost );
+      }
+    }
+    return best;
+  }
+
+  /* Runs the restarts on all threads without synchronization.  The best cost
+   * found so far is kept in an atomic slot, such that restarts only lock the
+   * shared network when they improve it or migrate to it. */
+  Ntk run_portfolio( Ntk const& ntk, RandEngine& rnd, uint32_t init_cost )
+  {
+    thread_pool pool( _ps.num_threads );
+    auto const interval = _ps.migration_interval == 0u ? _ps.max_steps : _ps.migration_interval;
+
+    std::vector<uint32_t> seeds( _ps.num_restarts );
+    std::generate( seeds.begin(), seeds.end(), [&]() { return rnd(); } );
+
+    Ntk best = ntk.clone();
+    std::atomic<uint32_t> best_cost{ init_cost };
+    std::mutex best_mutex;
+    std::atomic<uint32_t> next_restart{ 0u };
+
+    pool.run( [&]( uint32_t ) {
+      for ( auto i = next_restart++; i < _ps.num_restarts; i = next_restart++ )
+      {
+        restart_state s( i, ntk, seeds[i], init_cost );
+        while ( !s.done )
+        {
+          run_steps( s, interval );
+
+          if ( s.best_cost < best_cost.load() )
+          {
+            std::lock_guard<std::mutex> lock( best_mutex );
+            if ( s.best_cost < best_cost.load() )
+            {
+              best = s.best.clone();
+              best_cost.store( s.best_cost );
+            }
+          }
+          else if ( _ps.migration_interval != 0u && !s.done && best_cost.load() < s.best_cost )
+          {
+            std::lock_guard<std::mutex> lock( best_mutex );
+            migrate( s, best, best_cost.load() );
+          }
+        }
+
+        std::lock_guard<std::mutex> lock( best_mutex );
+        _st.time_evaluate += s.time_evaluate;
+        if ( _ps.verbose )
+          fmt::print( "[i] best cost in restart {}: {}, overall best cost: {}\n", i, s.best_cost, best_cost.load() );
+      }
+    } );
+    return best;
   }
 
   void decompress( Ntk& ntk, RandEngine& rnd, uint32_t i )
@@ -35,11 +35,17 @@
 
 #include "../utils/progress_bar.hpp"
 #include "../utils/stopwatch.hpp"
+#include "../utils/thread_pool.hpp"
+#include "../utils/trace.hpp"
 #include "../views/fanout_view.hpp"
 
 #include <bill/sat/interface/abc_bsat2.hpp>
 #include <kitty/partial_truth_table.hpp>
 
+#include <algorithm>
+#include <optional>
+#include <vector>
+
 #include "../io/write_patterns.hpp"
 #include "circuit_validator.hpp"
 #include "simulation.hpp"
@@ -83,6 +89,17 @@ struct functional_reduction_params
 
   /*! \brief Maximum number of simulation patterns. Discards all patterns and re-seeds with random patterns when exceeded. */
   uint32_t max_patterns{ 1024 };
+
+  /*! \brief Number of threads simulating the whole network (0 uses all hardware threads). */
+  uint32_t num_simulation_threads{ 1u };
+
+  /*! \brief Number of threads validating candidates with SAT (0 uses all hardware threads).
+   *
+   * With more than one thread, the candidates of several nodes are validated
+   * concurrently in batches, and the counter-examples are added to the
+   * simulation patterns after each batch.
+   */
+  uint32_t num_validation_threads{ 1u };
 };
 
 struct functional_reduction_stats
@@ -142,9 +159,14 @@ public:
 
   explicit functional_reduction_impl( Ntk& ntk, functional_reduction_params const& ps, validator_params const& vps, functional_reduction_stats& st )
       : ntk( ntk ), ps( ps ), st( st ), tts( ntk ),
-        sim( ps.pattern_filename ? partial_simulator( *ps.pattern_filename ) : partial_simulator( ntk.num_pis(), ps.num_patterns, std::rand() ) ), validator( ntk, vps )
+        sim( ps.pattern_filename ? partial_simulator( *ps.pattern_filename ) : partial_simulator( ntk.num_pis(), ps.num_patterns, std::rand() ) ), pool( ps.num_simulation_threads ), validator( ntk, vps )
   {
     static_assert( !validator_t::use_odc_, "`circuit_validator::use_odc` flag should be turned off." );
+
+    if ( ps.num_validation_threads != 1u )
+    {
+      validators.emplace( ntk, vps, ps.num_validation_threads );
+    }
   }
 
   ~functional_reduction_impl()
@@ -158,23 +180,37 @@ public:
   void run()
   {
     stopwatch t( st.time_total );
+    MOCKTURTLE_TRACE_SCOPE( "functional_reduction" );
 
     /* first simulation: the whole circuit; from 0 bits. */
     call_with_stopwatch( st.time_sim, [&]() {
-      simulate_nodes<Ntk>( ntk, tts, sim, true );
+      simulate_nodes<Ntk>( ntk, tts, sim, true, pool );
     } );
 
     /* remove constant nodes. */
-    substitute_constants();
+    if ( validators )
+    {
+      substitute_constants_parallel();
+    }
+    else
+    {
+      substitute_constants();
+    }
 
     /* substitute functional equivalent nodes. */
     auto size_before = ntk.size();
-    substitute_equivalent_nodes();
+    validators ? substitute_equivalent_nodes_parallel() : substitute_equivalent_nodes();
     uint32_t iterations{0};
     while ( ps.max_iterations && iterations++ <= ps.max_iterations && ntk.size() != size_before )
     {
       size_before = ntk.size();
-      substitute_equivalent_nodes();
+      validators ? substitute_equivalent_nodes_parallel() : substitute_equivalent_nodes();
+    }
+
+    if ( validators )
+    {
+      st.num_cex += validators->num_cex();
+      st.num_timeout += validators->num_timeout();
     }
   }
 
@@ -231,6 +267,202 @@ private:
     } );
   }
 
+  void substitute_constants_parallel()
+  {
+    progress_bar pbar{ ntk.size(), "FR-const |{0}| node = {1:>4}   cand = {2:>4}", ps.progress };
+
+    auto zero = sim.compute_constant( false );
+    auto one = sim.compute_constant( true );
+    std::vector<std::pair<node, bool>> queries;
+
+    /* validates the queued candidates and commits the results in their order */
+    auto const flush = [&]() {
+      auto const results = call_with_stopwatch( st.time_sat, [&]() {
+        return validators->validate( queries.size(), [&]( auto& validator, uint32_t i ) {
+          return validator.validate( queries[i].first, queries[i].second );
+        } );
+      } );
+
+      bool has_cex = false;
+      for ( auto i = 0u; i < queries.size(); ++i )
+      {
+        if ( !results[i] ) /* timeout */
+        {
+          continue;
+        }
+        else if ( !( *results[i] ) ) /* SAT, cex found */
+        {
+          add_cex( validators->cex( i ) );
+          has_cex = true;
+        }
+        else if ( !ntk.is_dead( queries[i].first ) ) /* UNSAT, constant verified */
+        {
+          ++st.num_reduction;
+          ++st.num_const_accepts;
+          ntk.substitute_node( queries[i].first, ntk.get_constant( queries[i].second ) );
+        }
+      }
+      queries.clear();
+
+      if ( has_cex )
+      {
+        zero = sim.compute_constant( false );
+        one = sim.compute_constant( true );
+      }
+    };
+
+    ntk.foreach_gate( [&]( auto const& n, auto i ) {
+      pbar( i, i, candidates );
+
+      check_tts( n );
+      if ( tts[n] != zero && tts[n] != one )
+      {
+        return true; /* next */
+      }
+
+      /* update progress bar */
+      candidates++;
+
+      queries.emplace_back( n, tts[n] == one );
+      if ( queries.size() >= batch_size() )
+      {
+        flush();
+      }
+      return true;
+    } );
+    flush();
+  }
+
+  void substitute_equivalent_nodes_parallel()
+  {
+    progress_bar pbar{ ntk.size(), "FR-equ |{0}| node = {1:>4}   cand = {2:>4}", ps.progress };
+
+    struct root_state
+    {
+      node root;
+      /* candidates which timed out */
+      std::vector<signal> skipped;
+    };
+
+    std::vector<node> roots;
+    ntk.foreach_gate( [&]( auto const& n ) {
+      roots.emplace_back( n );
+    } );
+
+    /* Roots with a disproved candidate are retried in the next batch with the
+     * updated simulation patterns.  Substitutions never add nodes to the
+     * transitive fanin of other nodes, hence candidates validated in the same
+     * batch remain acyclic when committed. */
+    std::vector<root_state> pending, retry;
+    std::vector<signal> queries;
+    auto next = 0u;
+    while ( next < roots.size() || !pending.empty() )
+    {
+      while ( pending.size() < batch_size() && next < roots.size() )
+      {
+        pbar( next, next, candidates );
+        pending.push_back( { roots[next++], {} } );
+      }
+
+      /* find the next candidate of each root */
+      retry.clear();
+      queries.clear();
+      for ( auto& s : pending )
+      {
+        if ( ntk.is_dead( s.root ) )
+        {
+          continue;
+        }
+
+        if ( auto const g = find_candidate( s.root, s.skipped ); g )
+        {
+          /* update progress bar */
+          candidates++;
+
+          retry.emplace_back( std::move( s ) );
+          queries.emplace_back( *g );
+        }
+      }
+      std::swap( pending, retry );
+
+      auto const results = call_with_stopwatch( st.time_sat, [&]() {
+        return validators->validate( queries.size(), [&]( auto& validator, uint32_t i ) {
+          return validator.validate( pending[i].root, queries[i] );
+        } );
+      } );
+
+      retry.clear();
+      for ( auto i = 0u; i < queries.size(); ++i )
+      {
+        auto& s = pending[i];
+        if ( !results[i] ) /* timeout */
+        {
+          s.skipped.emplace_back( queries[i] );
+          retry.emplace_back( std::move( s ) );
+        }
+        else if ( !( *results[i] ) ) /* SAT, cex found */
+        {
+          add_cex( validators->cex( i ) );
+          retry.emplace_back( std::move( s ) );
+        }
+        else if ( !ntk.is_dead( s.root ) ) /* UNSAT, equivalent node verified */
+        {
+          if ( ntk.is_dead( ntk.get_node( queries[i] ) ) )
+          {
+            retry.emplace_back( std::move( s ) );
+            continue;
+          }
+
+          ++st.num_reduction;
+          ++st.num_equ_accepts;
+          ntk.substitute_node( s.root, queries[i] );
+        }
+      }
+      std::swap( pending, retry );
+    }
+  }
+
+  std::optional<signal> find_candidate( node const& root, std::vector<signal> const& skipped )
+  {
+    check_tts( root );
+    auto const tt = tts[root];
+    auto const ntt = ~tts[root];
+
+    std::optional<signal> candidate;
+    foreach_candidate( root, [&]( node const& n ) {
+      check_tts( n );
+
+      signal g;
+      if ( tt == tts[n] )
+      {
+        g = ntk.make_signal( n );
+      }
+      else if ( ntt == tts[n] )
+      {
+        g = !ntk.make_signal( n );
+      }
+      else /* not equivalent */
+      {
+        return true; /* try next candidate */
+      }
+
+      if ( std::find( skipped.begin(), skipped.end(), g ) != skipped.end() )
+      {
+        return true; /* try next candidate */
+      }
+
+      candidate = g;
+      return false;
+    } );
+    return candidate;
+  }
+
+  /* number of candidates validated together */
+  uint32_t batch_size() const
+  {
+    return 4u * validators->num_threads();
+  }
+
   void substitute_equivalent_nodes()
   {
     progress_bar pbar{ ntk.size(), "FR-equ |{0}| node = {1:>4}   cand = {2:>4}", ps.progress };
@@ -240,76 +472,87 @@ private:
       check_tts( root );
       auto tt = tts[root];
       auto ntt = ~tts[root];
-      std::vector<node> tfi;
-      bool keep_trying = true;
-      foreach_transitive_fanin( root, [&]( auto const& n ) {
-        tfi.emplace_back( n );
-        if ( tfi.size() > ps.max_TFI_nodes )
-        {
-          return false;
-        }
-
-        keep_trying = try_node( tt, ntt, root, n );
-        return keep_trying;
+      foreach_candidate( root, [&]( node const& n ) {
+        return try_node( tt, ntt, root, n );
       } );
 
-      if ( keep_trying ) /* didn't find a substitution in TFI cone, explore fanouts. */
+      return true; /* next */
+    } );
+  }
+
+  /* Calls `fn` on the nodes which may substitute `root`: first on its transitive
+   * fanin, then on the fanouts of those nodes with all fanins in the transitive
+   * fanin.  Stops when `fn` returns `false`. */
+  template<typename Fn>
+  void foreach_candidate( node const& root, Fn&& fn )
+  {
+    std::vector<node> tfi;
+    bool keep_trying = true;
+    foreach_transitive_fanin( root, [&]( auto const& n ) {
+      tfi.emplace_back( n );
+      if ( tfi.size() > ps.max_TFI_nodes )
+      {
+        return false;
+      }
+
+      keep_trying = fn( n );
+      return keep_trying;
+    } );
+
+    if ( keep_trying ) /* didn't find a substitution in TFI cone, explore fanouts. */
+    {
+      for ( auto j = 0u; j < tfi.size() && tfi.size() <= ps.max_TFI_nodes && keep_trying; ++j )
       {
-        for ( auto j = 0u; j < tfi.size() && tfi.size() <= ps.max_TFI_nodes && keep_trying; ++j )
+        auto& n = tfi.at( j );
+        if ( ntk.fanout_size( n ) > ps.skip_fanout_limit )
         {
-          auto& n = tfi.at( j );
-          if ( ntk.fanout_size( n ) > ps.skip_fanout_limit )
+          continue;
+        }
+
+        /* if the fanout has all fanins in the set, add it */
+        ntk.foreach_fanout( n, [&]( node const& p ) {
+          if ( ntk.visited( p ) == ntk.trav_id() )
           {
-            continue;
+            return true; /* next fanout */
           }
 
-          /* if the fanout has all fanins in the set, add it */
-          ntk.foreach_fanout( n, [&]( node const& p ) {
-            if ( ntk.visited( p ) == ntk.trav_id() )
+          bool all_fanins_visited = true;
+          ntk.foreach_fanin( p, [&]( const auto& g ) {
+            if ( ntk.visited( ntk.get_node( g ) ) != ntk.trav_id() )
             {
-              return true; /* next fanout */
-            }
-
-            bool all_fanins_visited = true;
-            ntk.foreach_fanin( p, [&]( const auto& g ) {
-              if ( ntk.visited( ntk.get_node( g ) ) != ntk.trav_id() )
-              {
-                all_fanins_visited = false;
-                return false; /* terminate fanin-loop */
-              }
-              return true; /* next fanin */
-            } );
-            if ( !all_fanins_visited )
-            {
-              return true; /* next fanout */
+              all_fanins_visited = false;
+              return false; /* terminate fanin-loop */
             }
+            return true; /* next fanin */
+          } );
+          if ( !all_fanins_visited )
+          {
+            return true; /* next fanout */
+          }
 
-            bool has_root_as_child = false;
-            ntk.foreach_fanin( p, [&]( const auto& g ) {
-              if ( ntk.get_node( g ) == root )
-              {
-                has_root_as_child = true;
-                return false; /* terminate fanin-loop */
-              }
-              return true; /* next fanin */
-            } );
-            if ( has_root_as_child )
+          bool has_root_as_child = false;
+          ntk.foreach_fanin( p, [&]( const auto& g ) {
+            if ( ntk.get_node( g ) == root )
             {
-              return true; /* next fanout */
+              has_root_as_child = true;
+              return false; /* terminate fanin-loop */
             }
+            return true; /* next fanin */
+          } );
+          if ( has_root_as_child )
+          {
+            return true; /* next fanout */
+          }
 
-            tfi.emplace_back( p );
-            ntk.set_visited( p, ntk.trav_id() );
+          tfi.emplace_back( p );
+          ntk.set_visited( p, ntk.trav_id() );
 
-            check_tts( p );
-            keep_trying = try_node( tt, ntt, root, p );
-            return keep_trying;
-          } );
-        }
+          check_tts( p );
+          keep_trying = fn( p );
+          return keep_trying;
+        } );
       }
-
-      return true; /* next */
-    } );
+    }
   }
 
   bool try_node( kitty::partial_truth_table& tt, kitty::partial_truth_table& ntt, node const& root, node const& n )
@@ -360,7 +603,12 @@ private:
   void found_cex()
   {
     ++st.num_cex;
-    sim.add_pattern( validator.cex );
+    add_cex( validator.cex );
+  }
+
+  void add_cex( std::vector<bool> const& pattern )
+  {
+    sim.add_pattern( pattern );
 
     if ( sim.num_bits() > ps.max_patterns )
     {
@@ -392,7 +640,7 @@ private:
     sim = partial_simulator( ntk.num_pis(), ps.num_patterns, std::rand() );
     tts.reset();
     call_with_stopwatch( st.time_sim, [&]() {
-      simulate_nodes<Ntk>( ntk, tts, sim, true );
+      simulate_nodes<Ntk>( ntk, tts, sim, true, pool );
     } );
   }
 
@@ -435,7 +683,9 @@ private:
 
   TT tts;
   partial_simulator sim;
+  thread_pool pool;
   validator_t validator;
+  std::optional<validator_pool<validator_t>> validators;
 
   uint32_t candidates{ 0 };
 }; /* functional_reduction_impl */
@@ -456,6 +706,7 @@ void functional_reduction( Ntk& ntk, functional_reduction_params const& ps = {},
   static_assert( has_get_constant_v<Ntk>, "Ntk does not implement the get_constant method" );
   static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
   static_assert( has_is_complemented_v<Ntk>, "Ntk does not implement the is_complemented method" );
+  static_assert( has_is_dead_v<Ntk>, "Ntk does not implement the is_dead method" );
   static_assert( has_is_pi_v<Ntk>, "Ntk does not implement the is_pi method" );
   static_assert( has_make_signal_v<Ntk>, "Ntk does not implement the make_signal method" );
   static_assert( has_set_visited_v<Ntk>, "Ntk does not implement the set_visited method" );
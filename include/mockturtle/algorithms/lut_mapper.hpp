@@ -32,10 +32,12 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <fstream>
 #include <iostream>
 #include <limits>
+#include <optional>
 #include <queue>
 #include <sstream>
 #include <string>
@@ -52,6 +54,9 @@
 #include "../utils/cuts.hpp"
 #include "../utils/node_map.hpp"
 #include "../utils/stopwatch.hpp"
+#include "../utils/thread_pool.hpp"
+#include "../utils/trace.hpp"
+#include "../utils/traversal.hpp"
 #include "../utils/truth_table_cache.hpp"
 #include "../views/choice_view.hpp"
 #include "../views/mapping_view.hpp"
@@ -130,6 +135,19 @@ struct lut_map_params
   /*! \brief Maximum number variables for cost function caching */
   uint32_t cost_cache_vars{ 3u };
 
+  /*! \brief Number of threads (0 uses all hardware threads).
+   *
+   * With a value different from 1, the gates are partitioned by level and
+   * the best cuts of the gates on one level are computed in parallel in the
+   * delay and area flow rounds.  In these rounds, the references of the
+   * mapping are not updated while the gates are visited, but only at the end
+   * of each round.  Hence, the result does not depend on the number of
+   * threads, but it may differ from the result of the sequential mapper.
+   * Area sharing, exact area, and cut expansion rounds are sequential.
+   * Parallel rounds are not supported when computing truth tables.
+   */
+  uint32_t num_threads{ 1u };
+
   /*! \brief Be verbose. */
   bool verbose{ false };
 };
@@ -151,6 +169,24 @@ struct lut_map_stats
   /*! \brief Total runtime. */
   stopwatch<>::duration time_total{ 0 };
 
+  /*! \brief Runtime of the delay-oriented rounds. */
+  stopwatch<>::duration time_delay{ 0 };
+
+  /*! \brief Runtime of the area flow rounds. */
+  stopwatch<>::duration time_area_flow{ 0 };
+
+  /*! \brief Runtime of the area sharing rounds. */
+  stopwatch<>::duration time_area_share{ 0 };
+
+  /*! \brief Runtime of the exact area rounds. */
+  stopwatch<>::duration time_exact_area{ 0 };
+
+  /*! \brief Runtime of cut expansion. */
+  stopwatch<>::duration time_cut_expansion{ 0 };
+
+  /*! \brief Runtime to derive the mapped network. */
+  stopwatch<>::duration time_network{ 0 };
+
   /*! \brief Cut enumeration stats. */
   cut_enumeration_stats cut_enumeration_st{};
 
@@ -163,6 +199,12 @@ struct lut_map_stats
     {
       std::cout << stat;
     }
+    std::cout << fmt::format( "[i] Delay rounds            = {:>5.2f} secs\n", to_seconds( time_delay ) );
+    std::cout << fmt::format( "[i] Area flow rounds        = {:>5.2f} secs\n", to_seconds( time_area_flow ) );
+    std::cout << fmt::format( "[i] Area sharing rounds     = {:>5.2f} secs\n", to_seconds( time_area_share ) );
+    std::cout << fmt::format( "[i] Exact area rounds       = {:>5.2f} secs\n", to_seconds( time_exact_area ) );
+    std::cout << fmt::format( "[i] Cut expansion           = {:>5.2f} secs\n", to_seconds( time_cut_expansion ) );
+    std::cout << fmt::format( "[i] Network derivation      = {:>5.2f} secs\n", to_seconds( time_network ) );
     std::cout << fmt::format( "[i] Total runtime           = {:>5.2f} secs\n", to_seconds( time_total ) );
   }
 };
@@ -621,6 +663,13 @@ public:
   using cubes_queue_t = std::priority_queue<uint32_t, std::vector<uint32_t>, std::greater<uint32_t>>;
   using lut_info = std::pair<kitty::dynamic_truth_table, std::vector<signal<klut_network>>>;
 
+private:
+  struct worker_state
+  {
+    cut_merge_t lcuts;        /* cut merger container */
+    uint32_t cuts_total{ 0 }; /* cuts computed in the current round */
+  };
+
 public:
   explicit lut_map_impl( Ntk& ntk, lut_map_params const& ps, lut_map_stats& st )
       : ntk( ntk ),
@@ -661,6 +710,7 @@ public:
   klut_network run()
   {
     stopwatch t( st.time_total );
+    MOCKTURTLE_TRACE_SCOPE( "lut_map" );
 
     /* compute and save topological order */
     topo_order.reserve( ntk.size() );
@@ -669,12 +719,16 @@ public:
     } );
 
     perform_mapping();
+
+    stopwatch t_network( st.time_network );
+    MOCKTURTLE_TRACE_SCOPE( "lut_map/network" );
     return create_lut_network();
   }
 
   void run_inplace()
   {
     stopwatch t( st.time_total );
+    MOCKTURTLE_TRACE_SCOPE( "lut_map" );
 
     /* compute and save topological order */
     topo_order.reserve( ntk.size() );
@@ -689,6 +743,9 @@ public:
     }
 
     perform_mapping();
+
+    stopwatch t_network( st.time_network );
+    MOCKTURTLE_TRACE_SCOPE( "lut_map/network" );
     derive_mapping();
   }
 
@@ -701,6 +758,7 @@ private:
     /* init the data structure */
     init_nodes();
     init_cuts();
+    init_threads();
 
     /* compute mapping for depth or area */
     if ( !ps.area_oriented_mapping )
@@ -800,48 +858,82 @@ private:
     } );
   }
 
-  template<bool DO_AREA, bool ELA>
-  void compute_mapping( lut_cut_sort_type const sort, bool preprocess, bool recompute_cuts )
+  void init_threads()
   {
-    cuts_total = 0;
+    states.resize( 1u );
+
+    /* truth tables are inserted into a shared cache */
+    if constexpr ( StoreFunction )
+      return;
+
+    if ( ps.num_threads == 1u )
+      return;
+
+    pool.emplace( ps.num_threads );
+    states.resize( pool->num_threads() );
+
+    /* partition the gates by level */
+    std::vector<uint32_t> node_levels( ntk.size(), 0u );
     for ( auto const& n : topo_order )
     {
-      if constexpr ( !ELA )
+      if ( ntk.is_constant( n ) || ntk.is_ci( n ) )
       {
-        auto const index = ntk.node_to_index( n );
-        if ( !preprocess && iteration != 0 )
-        {
-          node_match[index].est_refs = ( 2.0 * node_match[index].est_refs + 1.0 * node_match[index].map_refs ) / 3.0;
-        }
-        else
-        {
-          node_match[index].est_refs = static_cast<float>( node_match[index].map_refs );
-        }
+        continue;
       }
 
-      if ( ntk.is_constant( n ) || ntk.is_ci( n ) )
+      uint32_t level{ 0 };
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        level = std::max( level, node_levels[ntk.node_to_index( ntk.get_node( f ) )] );
+      } );
+
+      node_levels[ntk.node_to_index( n )] = level + 1;
+      if ( levels.size() <= level )
       {
-        continue;
+        levels.resize( level + 1 );
       }
+      levels[level].push_back( n );
+    }
+  }
 
-      if ( recompute_cuts )
+  template<bool DO_AREA, bool ELA>
+  void compute_mapping( lut_cut_sort_type const sort, bool preprocess, bool recompute_cuts )
+  {
+    stopwatch t( ELA ? st.time_exact_area : ( DO_AREA ? st.time_area_flow : st.time_delay ) );
+    MOCKTURTLE_TRACE_SCOPE( ELA ? "lut_map/exact_area" : ( DO_AREA ? "lut_map/area_flow" : "lut_map/delay" ) );
+
+    for ( auto& state : states )
+    {
+      state.cuts_total = 0;
+    }
+
+    if ( pool && !ELA )
+    {
+      compute_mapping_parallel<DO_AREA>( sort, preprocess, recompute_cuts );
+    }
+    else
+    {
+      for ( auto const& n : topo_order )
       {
-        if constexpr ( Ntk::min_fanin_size == 2 && Ntk::max_fanin_size == 2 )
+        if constexpr ( !ELA )
         {
-          compute_best_cut2<DO_AREA, ELA>( n, sort, preprocess );
+          update_est_refs( n, preprocess );
         }
-        else
+
+        if ( ntk.is_constant( n ) || ntk.is_ci( n ) )
         {
-          compute_best_cut<DO_AREA, ELA>( n, sort, preprocess );
+          continue;
         }
-      }
-      else
-      {
-        /* update cost the function and move the best one first */
-        update_cut_data<DO_AREA, ELA>( n, sort );
+
+        compute_node_mapping<DO_AREA, ELA>( n, sort, preprocess, recompute_cuts, states[0] );
       }
     }
 
+    cuts_total = 0;
+    for ( auto const& state : states )
+    {
+      cuts_total += state.cuts_total;
+    }
+
     set_mapping_refs<ELA>();
 
     if constexpr ( DO_AREA )
@@ -873,8 +965,75 @@ private:
     }
   }
 
+  template<bool DO_AREA>
+  void compute_mapping_parallel( lut_cut_sort_type const sort, bool preprocess, bool recompute_cuts )
+  {
+    /* the estimated references only depend on the previous round */
+    for ( auto const& n : topo_order )
+    {
+      update_est_refs( n, preprocess );
+    }
+
+    for ( auto const& level : levels )
+    {
+      auto const compute_level_mapping = [&]( uint64_t i, uint32_t thread_id ) {
+        compute_node_mapping<DO_AREA, false>( level[i], sort, preprocess, recompute_cuts, states[thread_id] );
+      };
+
+      /* small levels are not worth waking up the workers */
+      if ( level.size() < 8u * pool->num_threads() )
+      {
+        for ( auto i = 0u; i < level.size(); ++i )
+        {
+          compute_level_mapping( i, 0u );
+        }
+      }
+      else
+      {
+        pool->parallel_for( 0u, level.size(), compute_level_mapping, 4u );
+      }
+    }
+  }
+
+  void update_est_refs( node const& n, bool preprocess )
+  {
+    auto const index = ntk.node_to_index( n );
+    if ( !preprocess && iteration != 0 )
+    {
+      node_match[index].est_refs = ( 2.0 * node_match[index].est_refs + 1.0 * node_match[index].map_refs ) / 3.0;
+    }
+    else
+    {
+      node_match[index].est_refs = static_cast<float>( node_match[index].map_refs );
+    }
+  }
+
+  template<bool DO_AREA, bool ELA>
+  void compute_node_mapping( node const& n, lut_cut_sort_type const sort, bool preprocess, bool recompute_cuts, worker_state& state )
+  {
+    if ( recompute_cuts )
+    {
+      if constexpr ( Ntk::min_fanin_size == 2 && Ntk::max_fanin_size == 2 )
+      {
+        compute_best_cut2<DO_AREA, ELA>( n, sort, preprocess, state );
+      }
+      else
+      {
+        compute_best_cut<DO_AREA, ELA>( n, sort, preprocess, state );
+      }
+    }
+    else
+    {
+      /* update cost the function and move the best one first */
+      update_cut_data<DO_AREA, ELA>( n, sort );
+    }
+  }
+
   void compute_share_mapping( lut_cut_sort_type const sort, bool first )
   {
+    stopwatch t( st.time_area_share );
+    MOCKTURTLE_TRACE_SCOPE( "lut_map/area_share" );
+
     /* reset required times and references except for POs */
     compute_share_mapping_init( first );
 
@@ -902,6 +1061,9 @@ private:
   template<bool ELA>
   void expand_cuts()
   {
+    stopwatch t( st.time_cut_expansion );
+    MOCKTURTLE_TRACE_SCOPE( "lut_map/cut_expansion" );
+
     /* cut expansion is not yet compatible with truth table computation */
     if constexpr ( StoreFunction )
       return;
@@ -1139,7 +1301,7 @@ private:
   }
 
   template<bool DO_AREA, bool ELA>
-  void compute_best_cut2( node const& n, lut_cut_sort_type const sort, bool preprocess )
+  void compute_best_cut2( node const& n, lut_cut_sort_type const sort, bool preprocess, worker_state& state )
   {
     auto index = ntk.node_to_index( n );
     auto& node_data = node_match[index];
@@ -1148,7 +1310,8 @@ private:
     /* compute cuts */
     const auto fanin = 2;
     uint32_t pairs{ 1 };
-    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &pairs]( auto child, auto i ) {
+    auto& lcuts = state.lcuts;
+    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &lcuts, &pairs]( auto child, auto i ) {
       lcuts[i] = &cuts[ntk.node_to_index( ntk.get_node( child ) )];
       pairs *= static_cast<uint32_t>( lcuts[i]->size() );
     } );
@@ -1157,7 +1320,7 @@ private:
 
     if constexpr ( DO_AREA )
     {
-      if ( iteration != 0 && node_data.map_refs > 0 )
+      if ( iteration != 0 && node_data.map_refs > 0 && ( ELA || !pool ) )
       {
         cut_deref( rcuts[0] );
       }
@@ -1226,7 +1389,7 @@ private:
       }
     }
 
-    cuts_total += rcuts.size();
+    state.cuts_total += rcuts.size();
 
     /* limit the maximum number of cuts */
     rcuts.limit( ps.cut_enumeration_ps.cut_limit );
@@ -1243,7 +1406,7 @@ private:
 
     if constexpr ( DO_AREA )
     {
-      if ( iteration != 0 && node_data.map_refs > 0 )
+      if ( iteration != 0 && node_data.map_refs > 0 && ( ELA || !pool ) )
       {
         cut_ref( rcuts[0] );
       }
@@ -1251,7 +1414,7 @@ private:
   }
 
   template<bool DO_AREA, bool ELA>
-  void compute_best_cut( node const& n, lut_cut_sort_type const sort, bool preprocess )
+  void compute_best_cut( node const& n, lut_cut_sort_type const sort, bool preprocess, worker_state& state )
   {
     auto index = ntk.node_to_index( n );
     auto& node_data = node_match[index];
@@ -1260,7 +1423,8 @@ private:
     /* compute cuts */
     uint32_t pairs{ 1 };
     std::vector<uint32_t> cut_sizes;
-    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &pairs, &cut_sizes]( auto child, auto i ) {
+    auto& lcuts = state.lcuts;
+    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &lcuts, &pairs, &cut_sizes]( auto child, auto i ) {
       lcuts[i] = &cuts[ntk.node_to_index( ntk.get_node( child ) )];
       cut_sizes.push_back( static_cast<uint32_t>( lcuts[i]->size() ) );
       pairs *= cut_sizes.back();
@@ -1271,7 +1435,7 @@ private:
 
     if constexpr ( DO_AREA )
     {
-      if ( iteration != 0 && node_data.map_refs > 0 )
+      if ( iteration != 0 && node_data.map_refs > 0 && ( ELA || !pool ) )
       {
         cut_deref( rcuts[0] );
       }
@@ -1394,7 +1558,7 @@ private:
       rcuts.limit( ps.cut_enumeration_ps.cut_limit );
     }
 
-    cuts_total += rcuts.size();
+    state.cuts_total += rcuts.size();
 
     /* replace the new best cut with previous one */
     if ( preprocess && rcuts[0]->data.delay > node_data.required )
@@ -1404,7 +1568,7 @@ private:
 
     if constexpr ( DO_AREA )
     {
-      if ( iteration != 0 && node_data.map_refs > 0 )
+      if ( iteration != 0 && node_data.map_refs > 0 && ( ELA || !pool ) )
       {
         cut_ref( rcuts[0] );
       }
@@ -1424,7 +1588,7 @@ private:
 
     if constexpr ( DO_AREA )
     {
-      if ( iteration != 0 && node_data.map_refs > 0 )
+      if ( iteration != 0 && node_data.map_refs > 0 && ( ELA || !pool ) )
       {
         cut_deref( *best_cut );
       }
@@ -1468,7 +1632,7 @@ private:
 
     if constexpr ( DO_AREA || ELA )
     {
-      if ( iteration != 0 && node_data.map_refs > 0 )
+      if ( iteration != 0 && node_data.map_refs > 0 && ( ELA || !pool ) )
       {
         cut_ref( *best_cut );
       }
@@ -1558,7 +1722,7 @@ private:
       if ( node_match[leaf].map_refs == 0 )
         ++cost_before;
     }
-    mark_cut_volume_rec( n );
+    mark_cut_volume( n );
 
     /* improve cut */
     while ( improve_cut( leaves ) )
@@ -1837,16 +2001,18 @@ private:
     return count;
   }
 
-  void mark_cut_volume_rec( node const& n )
+  void mark_cut_volume( node const& n )
   {
-    if ( ntk.visited( n ) == ntk.trav_id() )
-      return;
-
-    ntk.set_visited( n, ntk.trav_id() );
+    volume_dfs.run_fanin(
+        ntk, n,
+        [&]( node const& m ) {
+          if ( ntk.visited( m ) == ntk.trav_id() )
+            return false;
 
-    ntk.foreach_fanin( n, [&]( auto const& f ) {
-      mark_cut_volume_rec( ntk.get_node( f ) );
-    } );
+          ntk.set_visited( m, ntk.trav_id() );
+          return true;
+        },
+        []( node const& ) {} );
   }
 
   /* compute positions of leave indices in cut `sub` (subset) with respect to
@@ -2842,12 +3008,16 @@ private:
   std::vector<node> topo_order;
   std::vector<uint32_t> tmp_visited;
   std::vector<node_lut> node_match;
+  iterative_dfs<node> volume_dfs; /* stack to mark cut volumes */
 
   std::vector<cut_set_t> cuts;  /* compressed representation of cuts */
-  cut_merge_t lcuts;            /* cut merger container */
   tt_cache truth_tables;        /* cut truth tables */
   cost_cache truth_tables_cost; /* truth tables cost */
   isop_cache isops;             /* cache for isops */
+
+  std::optional<thread_pool> pool;       /* workers of parallel rounds */
+  std::vector<std::vector<node>> levels; /* gates partitioned by level */
+  std::vector<worker_state> states;      /* per-thread state */
 };
 #pragma endregion
 
@@ -36,13 +36,21 @@
 #pragma once
 
 #include <iostream>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
 
 #include "../traits.hpp"
 #include "../utils/node_map.hpp"
 #include "../utils/stopwatch.hpp"
+#include "../utils/thread_pool.hpp"
+#include "../utils/trace.hpp"
 #include "../views/topo_view.hpp"
+#include "node_resynthesis/traits.hpp"
 
 #include <fmt/format.h>
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/hash.hpp>
 
 namespace mockturtle
 {
@@ -54,6 +62,15 @@ namespace mockturtle
  */
 struct node_resynthesis_params
 {
+  /*! \brief Number of threads to precompute the node functions (0 uses all hardware threads).
+   *
+   * If different from 1 and the resynthesis function implements
+   * `precompute_functions`, the distinct node functions are collected and
+   * passed to `precompute_functions` together with a thread pool before the
+   * network is rebuilt serially with the resynthesis function it returns.
+   */
+  uint32_t num_threads{ 1u };
+
   /*! \brief Be verbose. */
   bool verbose{ false };
 };
@@ -68,9 +85,19 @@ struct node_resynthesis_stats
   /*! \brief Total runtime. */
   stopwatch<>::duration time_total{ 0 };
 
+  /*! \brief Runtime for precomputing the node functions. */
+  stopwatch<>::duration time_precompute{ 0 };
+
+  /*! \brief Number of distinct node functions passed to the precomputation. */
+  uint64_t num_precomputed_functions{ 0 };
+
   void report() const
   {
     std::cout << fmt::format( "[i] total time = {:>5.2f} secs\n", to_seconds( time_total ) );
+    if ( num_precomputed_functions > 0u )
+    {
+      std::cout << fmt::format( "[i] precompute = {:>5.2f} secs ({} functions)\n", to_seconds( time_precompute ), num_precomputed_functions );
+    }
   }
 };
 
@@ -88,11 +115,14 @@ public:
         ps( ps ),
         st( st )
   {
+    static_assert( has_precompute_functions_v<ResynthesisFn> || !has_mutable_precompute_functions<ResynthesisFn>::value,
+                   "precompute_functions of ResynthesisFn is not a const method" );
   }
 
   NtkDest run()
   {
     stopwatch t( st.time_total );
+    MOCKTURTLE_TRACE_SCOPE( "node_resynthesis" );
 
     node_map<signal<NtkDest>, NtkSource> node2new( ntk );
 
@@ -128,36 +158,22 @@ public:
     }
 
     /* map nodes */
-    topo_view ntk_topo{ ntk };
-    ntk_topo.foreach_node( [&]( auto n ) {
-      if ( ntk.is_constant( n ) || ntk.is_ci( n ) )
-        return;
-
-      std::vector<signal<NtkDest>> children;
-      ntk.foreach_fanin( n, [&]( auto const& f ) {
-        children.push_back( ntk.is_complemented( f ) ? ntk_dest.create_not( node2new[f] ) : node2new[f] );
-      } );
-
-      bool performed_resyn = false;
-      resynthesis_fn( ntk_dest, ntk.node_function( n ), children.begin(), children.end(), [&]( auto const& f ) {
-        node2new[n] = f;
-
-        if constexpr ( has_has_name_v<NtkSource> && has_get_name_v<NtkSource> && has_set_name_v<NtkDest> )
-        {
-          if ( ntk.has_name( ntk.make_signal( n ) ) )
-            ntk_dest.set_name( f, ntk.get_name( ntk.make_signal( n ) ) );
-        }
-
-        performed_resyn = true;
-        return false;
-      } );
-
-      if ( !performed_resyn )
+    if constexpr ( has_precompute_functions_v<ResynthesisFn> )
+    {
+      if ( ps.num_threads != 1u )
       {
-        fmt::print( "[e] could not perform resynthesis for node {} in node_resynthesis\n", ntk.node_to_index( n ) );
-        std::abort();
+        /* the precomputed chains are kept by a copy of the resynthesis function that is local to this call */
+        map_nodes( node2new, precompute_functions() );
       }
-    } );
+      else
+      {
+        map_nodes( node2new, resynthesis_fn );
+      }
+    }
+    else
+    {
+      map_nodes( node2new, resynthesis_fn );
+    }
 
     /* map primary outputs */
     ntk.foreach_po( [&]( auto const& f, auto index ) {
@@ -196,6 +212,68 @@ public:
     return ntk_dest;
   }
 
+private:
+  template<class Fn>
+  void map_nodes( node_map<signal<NtkDest>, NtkSource>& node2new, Fn&& fn )
+  {
+    topo_view ntk_topo{ ntk };
+    ntk_topo.foreach_node( [&]( auto n ) {
+      if ( ntk.is_constant( n ) || ntk.is_ci( n ) )
+        return;
+
+      std::vector<signal<NtkDest>> children;
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        children.push_back( ntk.is_complemented( f ) ? ntk_dest.create_not( node2new[f] ) : node2new[f] );
+      } );
+
+      bool performed_resyn = false;
+      fn( ntk_dest, ntk.node_function( n ), children.begin(), children.end(), [&]( auto const& f ) {
+        node2new[n] = f;
+
+        if constexpr ( has_has_name_v<NtkSource> && has_get_name_v<NtkSource> && has_set_name_v<NtkDest> )
+        {
+          if ( ntk.has_name( ntk.make_signal( n ) ) )
+            ntk_dest.set_name( f, ntk.get_name( ntk.make_signal( n ) ) );
+        }
+
+        performed_resyn = true;
+        return false;
+      } );
+
+      if ( !performed_resyn )
+      {
+        fmt::print( "[e] could not perform resynthesis for node {} in node_resynthesis\n", ntk.node_to_index( n ) );
+        std::abort();
+      }
+    } );
+  }
+
+  /* passes the distinct node functions to the resynthesis function, which
+     synthesizes them in parallel and returns the resynthesis function for
+     the rebuild */
+  auto precompute_functions()
+  {
+    stopwatch t( st.time_precompute );
+
+    std::vector<kitty::dynamic_truth_table> functions;
+    std::unordered_set<kitty::dynamic_truth_table, kitty::hash<kitty::dynamic_truth_table>> visited;
+    ntk.foreach_node( [&]( auto n ) {
+      if ( ntk.is_constant( n ) || ntk.is_ci( n ) )
+        return;
+
+      auto function = ntk.node_function( n );
+      if ( visited.insert( function ).second )
+      {
+        functions.push_back( std::move( function ) );
+      }
+    } );
+    st.num_precomputed_functions = functions.size();
+
+    thread_pool pool( ps.num_threads );
+    static_assert( !std::is_void_v<decltype( resynthesis_fn.precompute_functions( functions, pool ) )>, "precompute_functions does not return a resynthesis function" );
+    return resynthesis_fn.precompute_functions( functions, pool );
+  }
+
 private:
   NtkDest& ntk_dest;
   NtkSource const& ntk;
@@ -35,7 +35,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <iostream>
+#include <iterator>
 #include <memory>
 #include <optional>
 #include <unordered_map>
@@ -49,11 +51,22 @@
 #include "../../networks/aig.hpp"
 #include "../../networks/klut.hpp"
 #include "../../networks/xmg.hpp"
+#include "../../utils/exact_synthesis_cache.hpp"
 #include "../../utils/include/percy.hpp"
+#include "../../utils/thread_pool.hpp"
 
 namespace mockturtle
 {
 
+namespace detail
+{
+
+/* kinds of the chains in a shared `exact_synthesis_cache`, LUT chains use their fanin size */
+static constexpr uint32_t exact_aig_cache_kind = 0x10000u;
+static constexpr uint32_t exact_xag_cache_kind = 0x10001u;
+
+} // namespace detail
+
 struct exact_resynthesis_params
 {
   using cache_map_t = std::unordered_map<kitty::dynamic_truth_table, percy::chain, kitty::hash<kitty::dynamic_truth_table>>;
@@ -65,6 +78,12 @@ struct exact_resynthesis_params
   cache_t cache;
   blacklist_cache_t blacklist_cache;
 
+  /*! \brief NPN-canonical cache shared by several resynthesis functions and threads.
+   *
+   * If set, it is used instead of `cache` and `blacklist_cache`.
+   */
+  std::shared_ptr<exact_synthesis_cache> shared_cache;
+
   bool add_alonce_clauses{ true };
   bool add_colex_clauses{ true };
   bool add_lex_clauses{ false };
@@ -81,6 +100,61 @@ struct exact_resynthesis_params
   percy::SynthMethod synthesis_method = percy::SYNTH_STD;
 };
 
+namespace detail
+{
+
+/* synthesizes the NPN classes of `functions` on `pool` and stores the
+   chains in the shared cache of `ps`, or otherwise in its cache, which is
+   created if not set; failed functions are blacklisted with the conflict
+   limit, such that they are only retried with larger limits */
+template<class Fn>
+void precompute_exact_chains( exact_resynthesis_params& ps, uint32_t kind, std::vector<kitty::dynamic_truth_table> const& functions, thread_pool& pool, bool denormalize, Fn&& synthesize )
+{
+  if ( ps.shared_cache )
+  {
+    ps.shared_cache->precompute( kind, functions, ps.conflict_limit, pool, synthesize );
+    return;
+  }
+
+  if ( !ps.cache )
+  {
+    ps.cache = std::make_shared<exact_resynthesis_params::cache_map_t>();
+  }
+
+  std::vector<kitty::dynamic_truth_table> missing;
+  std::copy_if( functions.begin(), functions.end(), std::back_inserter( missing ), [&]( auto const& function ) {
+    if ( ps.cache->find( function ) != ps.cache->end() )
+      return false;
+    if ( !ps.blacklist_cache )
+      return true;
+    auto const it = ps.blacklist_cache->find( function );
+    return it == ps.blacklist_cache->end() || ( it->second != 0 && ps.conflict_limit > it->second );
+  } );
+
+  exact_synthesis_cache precomputed;
+  precomputed.precompute( kind, missing, ps.conflict_limit, pool, synthesize );
+
+  for ( auto const& function : missing )
+  {
+    /* all representatives have been synthesized, nothing is synthesized again */
+    auto c = precomputed.get_or_synthesize( kind, function, ps.conflict_limit, []( kitty::dynamic_truth_table const&, percy::chain& ) { return percy::failure; } );
+    if ( c )
+    {
+      if ( denormalize )
+      {
+        c->denormalize();
+      }
+      ( *ps.cache )[function] = *c;
+    }
+    else if ( ps.blacklist_cache )
+    {
+      ( *ps.blacklist_cache )[function] = ps.conflict_limit;
+    }
+  }
+}
+
+} // namespace detail
+
 /*! \brief Resynthesis function based on exact synthesis.
  *
  * This resynthesis function can be passed to ``node_resynthesis``,
@@ -150,17 +224,7 @@ public:
       return;
     }
 
-    percy::spec spec;
-    spec.fanin = _fanin_size;
-    spec.verbosity = 0;
-    spec.add_alonce_clauses = _ps.add_alonce_clauses;
-    spec.add_colex_clauses = _ps.add_colex_clauses;
-    spec.add_lex_clauses = _ps.add_lex_clauses;
-    spec.add_lex_func_clauses = _ps.add_lex_func_clauses;
-    spec.add_nontriv_clauses = _ps.add_nontriv_clauses;
-    spec.add_noreapply_clauses = _ps.add_noreapply_clauses;
-    spec.add_symvar_clauses = _ps.add_symvar_clauses;
-    spec.conflict_limit = _ps.conflict_limit;
+    auto spec = make_spec();
     spec[0] = function;
     bool with_dont_cares{ false };
     if ( !kitty::is_const0( dont_cares ) )
@@ -170,6 +234,18 @@ public:
     }
 
     auto c = [&]() -> std::optional<percy::chain> {
+      if ( !with_dont_cares && _ps.shared_cache )
+      {
+        auto c = _ps.shared_cache->get_or_synthesize( _fanin_size, function, _ps.conflict_limit, [&]( kitty::dynamic_truth_table const& representative, percy::chain& chain ) {
+          spec[0] = representative;
+          return percy::synthesize( spec, chain, _ps.solver_type, _ps.encoder_type, _ps.synthesis_method );
+        } );
+        if ( c )
+        {
+          c->denormalize();
+        }
+        return c;
+      }
       if ( !with_dont_cares && _ps.cache )
       {
         const auto it = _ps.cache->find( function );
@@ -227,6 +303,47 @@ public:
     fn( signals.back() );
   }
 
+  /*! \brief Synthesizes functions in parallel.
+   *
+   * Synthesizes the NPN classes of `functions` on the threads of `pool`
+   * and returns a copy of this resynthesis function that takes the chains
+   * from its cache.  The chains are stored in `shared_cache` if it is set,
+   * and otherwise in `cache`, which is created for the copy if it is not
+   * set.  The parameters of this object are not changed.
+   */
+  exact_resynthesis precompute_functions( std::vector<kitty::dynamic_truth_table> const& functions, thread_pool& pool ) const
+  {
+    std::vector<kitty::dynamic_truth_table> large_functions;
+    std::copy_if( functions.begin(), functions.end(), std::back_inserter( large_functions ), [&]( auto const& function ) {
+      return static_cast<uint32_t>( function.num_vars() ) > _fanin_size;
+    } );
+
+    exact_resynthesis resyn( *this );
+    detail::precompute_exact_chains( resyn._ps, _fanin_size, large_functions, pool, true, [&]( kitty::dynamic_truth_table const& representative, percy::chain& chain ) {
+      auto spec = make_spec();
+      spec[0] = representative;
+      return percy::synthesize( spec, chain, _ps.solver_type, _ps.encoder_type, _ps.synthesis_method );
+    } );
+    return resyn;
+  }
+
+private:
+  percy::spec make_spec() const
+  {
+    percy::spec spec;
+    spec.fanin = _fanin_size;
+    spec.verbosity = 0;
+    spec.add_alonce_clauses = _ps.add_alonce_clauses;
+    spec.add_colex_clauses = _ps.add_colex_clauses;
+    spec.add_lex_clauses = _ps.add_lex_clauses;
+    spec.add_lex_func_clauses = _ps.add_lex_func_clauses;
+    spec.add_nontriv_clauses = _ps.add_nontriv_clauses;
+    spec.add_noreapply_clauses = _ps.add_noreapply_clauses;
+    spec.add_symvar_clauses = _ps.add_symvar_clauses;
+    spec.conflict_limit = _ps.conflict_limit;
+    return spec;
+  }
+
 private:
   uint32_t _fanin_size{ 3u };
   exact_resynthesis_params _ps;
@@ -307,21 +424,7 @@ public:
   void operator()( Ntk& ntk, kitty::dynamic_truth_table const& function, kitty::dynamic_truth_table const& dont_cares, LeavesIterator begin, LeavesIterator end, Fn&& fn ) const
   {
     // TODO: special case for small functions (up to 2 variables)?
-    percy::spec spec;
-    if ( !_allow_xor )
-    {
-      spec.set_primitive( percy::AIG );
-    }
-    spec.fanin = 2;
-    spec.verbosity = 0;
-    spec.add_alonce_clauses = _ps.add_alonce_clauses;
-    spec.add_colex_clauses = _ps.add_colex_clauses;
-    spec.add_lex_clauses = _ps.add_lex_clauses;
-    spec.add_lex_func_clauses = _ps.add_lex_func_clauses;
-    spec.add_nontriv_clauses = _ps.add_nontriv_clauses;
-    spec.add_noreapply_clauses = _ps.add_noreapply_clauses;
-    spec.add_symvar_clauses = _ps.add_symvar_clauses;
-    spec.conflict_limit = _ps.conflict_limit;
+    auto spec = make_spec();
     if ( _lower_bound )
     {
       spec.initial_steps = *_lower_bound;
@@ -345,6 +448,13 @@ public:
     }
 
     auto c = [&]() -> std::optional<percy::chain> {
+      if ( !with_dont_cares && _ps.shared_cache && uses_shared_cache() )
+      {
+        return _ps.shared_cache->get_or_synthesize( cache_kind(), function, _ps.conflict_limit, [&]( kitty::dynamic_truth_table const& representative, percy::chain& chain ) {
+          spec[0] = representative;
+          return percy::synthesize( spec, chain, _ps.solver_type, _ps.encoder_type, _ps.synthesis_method );
+        } );
+      }
       if ( !with_dont_cares && _ps.cache )
       {
         const auto it = _ps.cache->find( function );
@@ -433,6 +543,63 @@ public:
     _upper_bound = upper_bound;
   }
 
+  /*! \brief Synthesizes functions in parallel.
+   *
+   * Synthesizes the NPN classes of `functions` on the threads of `pool`
+   * and returns a copy of this resynthesis function that takes the chains
+   * from its cache.  The chains are stored in `shared_cache` if it is set,
+   * and otherwise in `cache`, which is created for the copy if it is not
+   * set.  The parameters of this object are not changed.  Nothing is
+   * synthesized if existing functions or bounds are set.
+   */
+  exact_aig_resynthesis precompute_functions( std::vector<kitty::dynamic_truth_table> const& functions, thread_pool& pool ) const
+  {
+    exact_aig_resynthesis resyn( *this );
+    if ( !uses_shared_cache() )
+    {
+      return resyn;
+    }
+
+    detail::precompute_exact_chains( resyn._ps, cache_kind(), functions, pool, false, [&]( kitty::dynamic_truth_table const& representative, percy::chain& chain ) {
+      auto spec = make_spec();
+      spec[0] = representative;
+      return percy::synthesize( spec, chain, _ps.solver_type, _ps.encoder_type, _ps.synthesis_method );
+    } );
+    return resyn;
+  }
+
+private:
+  percy::spec make_spec() const
+  {
+    percy::spec spec;
+    if ( !_allow_xor )
+    {
+      spec.set_primitive( percy::AIG );
+    }
+    spec.fanin = 2;
+    spec.verbosity = 0;
+    spec.add_alonce_clauses = _ps.add_alonce_clauses;
+    spec.add_colex_clauses = _ps.add_colex_clauses;
+    spec.add_lex_clauses = _ps.add_lex_clauses;
+    spec.add_lex_func_clauses = _ps.add_lex_func_clauses;
+    spec.add_nontriv_clauses = _ps.add_nontriv_clauses;
+    spec.add_noreapply_clauses = _ps.add_noreapply_clauses;
+    spec.add_symvar_clauses = _ps.add_symvar_clauses;
+    spec.conflict_limit = _ps.conflict_limit;
+    return spec;
+  }
+
+  /* chains depending on existing functions or bounds are not shared */
+  bool uses_shared_cache() const
+  {
+    return existing_functions.empty() && !_lower_bound && !_upper_bound;
+  }
+
+  uint32_t cache_kind() const
+  {
+    return _allow_xor ? detail::exact_xag_cache_kind : detail::exact_aig_cache_kind;
+  }
+
 private:
   bool _allow_xor = false;
   exact_resynthesis_params _ps;
@@ -34,12 +34,14 @@
 #pragma once
 
 #include "../../traits.hpp"
+#include "../../utils/thread_pool.hpp"
 
 #include <kitty/dynamic_truth_table.hpp>
 
 #include <cstdint>
 #include <optional>
 #include <type_traits>
+#include <vector>
 
 namespace mockturtle
 {
@@ -89,4 +91,36 @@ template<class ResynFn, class Ntk>
 inline constexpr bool has_add_function_v = has_add_function<ResynFn, Ntk>::value;
 #pragma endregion
 
+#pragma region has_precompute_functions
+template<class ResynFn, class = void>
+struct has_precompute_functions : std::false_type
+{
+};
+
+/* `precompute_functions` must be callable on const objects, as it must not change the resynthesis function */
+template<class ResynFn>
+struct has_precompute_functions<ResynFn, std::void_t<decltype( std::declval<std::remove_reference_t<ResynFn> const&>().precompute_functions( std::vector<kitty::dynamic_truth_table>(), std::declval<thread_pool&>() ) )>> : std::true_type
+{
+};
+
+template<class ResynFn>
+inline constexpr bool has_precompute_functions_v = has_precompute_functions<ResynFn>::value;
+
+namespace detail
+{
+
+/* detects a non-const `precompute_functions`, which is rejected */
+template<class ResynFn, class = void>
+struct has_mutable_precompute_functions : std::false_type
+{
+};
+
+template<class ResynFn>
+struct has_mutable_precompute_functions<ResynFn, std::void_t<decltype( std::declval<std::remove_reference_t<ResynFn>&>().precompute_functions( std::vector<kitty::dynamic_truth_table>(), std::declval<thread_pool&>() ) )>> : std::true_type
+{
+};
+
+} // namespace detail
+#pragma endregion
+
 } /* namespace mockturtle */
\ No newline at end of file
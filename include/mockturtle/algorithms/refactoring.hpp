@@ -40,6 +40,7 @@
 #include "../utils/cost_functions.hpp"
 #include "../utils/progress_bar.hpp"
 #include "../utils/stopwatch.hpp"
+#include "../utils/trace.hpp"
 #include "../views/cut_view.hpp"
 #include "../views/mffc_view.hpp"
 #include "../views/topo_view.hpp"
@@ -145,6 +146,7 @@ public:
     progress_bar pbar{ ntk.size(), "refactoring |{0}| node = {1:>4}   cand = {2:>4}   est. reduction = {3:>5}", ps.progress };
 
     stopwatch t( st.time_total );
+    MOCKTURTLE_TRACE_SCOPE( "refactoring" );
 
     ntk.clear_visited();
 
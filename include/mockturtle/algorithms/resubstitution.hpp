@@ -39,6 +39,7 @@
 #include "../traits.hpp"
 #include "../utils/progress_bar.hpp"
 #include "../utils/stopwatch.hpp"
+#include "../utils/trace.hpp"
 #include "../views/depth_view.hpp"
 #include "../views/fanout_view.hpp"
 
@@ -46,6 +47,7 @@
 #include "dont_cares.hpp"
 #include "reconv_cut.hpp"
 
+#include <type_traits>
 #include <vector>
 
 namespace mockturtle
@@ -115,6 +117,15 @@ struct resubstitution_params
   /*! \brief Maximum number of trials to call the resub functor. Only used by simulation-based resub engine. */
   uint32_t max_trials{ 100 };
 
+  /*! \brief Number of threads simulating the whole network (0 uses all hardware threads). Only used by simulation-based resub engine. */
+  uint32_t num_simulation_threads{ 1u };
+
+  /*! \brief Number of threads validating candidates with SAT (0 uses all hardware threads).
+   * With more than one thread, the candidates of several nodes are validated concurrently in batches.
+   * Only used by simulation-based resub engine without ODCs.
+   */
+  uint32_t num_validation_threads{ 1u };
+
   /* k-resub engine specific */
   /*! \brief Maximum number of divisors to consider in k-resub engine. Only used by `abc_resub_functor` with simulation-based resub engine. */
   uint32_t max_divisors_k{ 50 };
@@ -585,6 +596,16 @@ private:
   window_simulator<Ntk, TTsim> sim;
 }; /* window_based_resub_engine */
 
+template<class ResubEngine, class = void>
+struct supports_batch_validation : std::false_type
+{
+};
+
+template<class ResubEngine>
+struct supports_batch_validation<ResubEngine, std::enable_if_t<ResubEngine::supports_batch_validation>> : std::true_type
+{
+};
+
 /*! \brief The top-level resubstitution framework.
  *
  * \param ResubEngine The engine that computes the resubtitution for a given root
@@ -600,6 +621,11 @@ private:
  * three public data members: `leaves`, `divs`, and `mffc` (see documentation
  * of `default_divisor_collector` for details). When using `simulation_based_resub_engine`,
  * only `divs` is needed.
+ *
+ * Engines defining `supports_batch_validation = true` can validate the
+ * candidates of several nodes concurrently (see `run_batched`), which is
+ * enabled with `num_validation_threads`.  The `DivCollector` then also has
+ * to prepare `leaves` and `mffc`.
  */
 template<class Ntk, class ResubEngine = window_based_resub_engine<Ntk, kitty::dynamic_truth_table>, class DivCollector = default_divisor_collector<Ntk>>
 class resubstitution_impl
@@ -640,7 +666,17 @@ public:
 
   void run( resub_callback_t const& callback = substitute_fn<Ntk> )
   {
+    if constexpr ( supports_batch_validation<ResubEngine>::value )
+    {
+      if ( ps.num_validation_threads != 1u )
+      {
+        run_batched( callback );
+        return;
+      }
+    }
+
     stopwatch t( st.time_total );
+    MOCKTURTLE_TRACE_SCOPE( "resubstitution" );
 
     /* start the managers */
     DivCollector collector( ntk, ps, collector_st );
@@ -708,6 +744,194 @@ public:
   }
 
 private:
+  struct batch_candidate
+  {
+    node root;
+    uint32_t trials;
+    uint32_t gain;
+
+    /* divisors followed by the MFFC, and their structure when the candidate was computed */
+    std::vector<node> window;
+    uint32_t num_leaves;
+    uint32_t num_divs;
+    std::vector<uint64_t> structure;
+  };
+
+  /*! \brief Resubstitution with concurrent validation.
+   *
+   * Candidates are computed for a batch of roots on the same network, then
+   * validated concurrently, and finally committed in the order of the roots.
+   * A validated candidate is only committed if the structure of its window
+   * (the fanins of its divisors and MFFC nodes, and the fanout sizes of the
+   * MFFC nodes) has not been modified by the previous commits.  Then, its
+   * divisors still cannot depend on the root, and the estimated gain is
+   * still exact.  Roots with a counter-example or a modified window are
+   * retried in the next batch, up to `max_trials` times.
+   */
+  void run_batched( resub_callback_t const& callback )
+  {
+    stopwatch t( st.time_total );
+    MOCKTURTLE_TRACE_SCOPE( "resubstitution" );
+
+    /* start the managers */
+    DivCollector collector( ntk, ps, collector_st );
+    ResubEngine resub_engine( ntk, ps, engine_st );
+    call_with_stopwatch( st.time_resub, [&]() {
+      resub_engine.init();
+    } );
+
+    progress_bar pbar{ ntk.size(), "resub |{0}| node = {1:>4}   cand = {2:>4}   est. gain = {3:>5}", ps.progress };
+
+    std::vector<node> roots;
+    auto const size = ntk.num_gates();
+    ntk.foreach_gate( [&]( auto const& n, auto i ) {
+      if ( i >= size )
+      {
+        return false; /* terminate */
+      }
+      roots.emplace_back( n );
+      return true; /* next */
+    } );
+
+    std::vector<std::pair<node, uint32_t>> pending, retry;
+    std::vector<batch_candidate> batch;
+    auto next = 0u;
+    while ( next < roots.size() || !pending.empty() )
+    {
+      while ( pending.size() < resub_engine.batch_size() && next < roots.size() )
+      {
+        pbar( next, next, candidates, st.estimated_gain );
+        pending.emplace_back( roots[next++], 0u );
+      }
+
+      /* compute the candidates of all roots on the same network */
+      resub_engine.clear_candidates();
+      batch.clear();
+      for ( auto const& [n, trials] : pending )
+      {
+        if ( ntk.is_dead( n ) )
+        {
+          continue;
+        }
+
+        mffc_result_t potential_gain;
+        const auto collector_success = call_with_stopwatch( st.time_divs, [&]() {
+          return collector.run( n, potential_gain );
+        } );
+        if ( !collector_success )
+        {
+          continue;
+        }
+
+        if ( trials == 0u )
+        {
+          st.num_total_divisors += collector.divs.size();
+        }
+
+        uint32_t gain = 0;
+        const auto found = call_with_stopwatch( st.time_resub, [&]() {
+          return resub_engine.propose( n, collector.divs, potential_gain, gain );
+        } );
+        if ( !found )
+        {
+          continue;
+        }
+
+        auto& c = batch.emplace_back();
+        c.root = n;
+        c.trials = trials;
+        c.gain = gain;
+        c.window = collector.divs;
+        c.window.insert( c.window.end(), collector.mffc.begin(), collector.mffc.end() );
+        c.num_leaves = collector.leaves.size();
+        c.num_divs = collector.divs.size();
+        window_structure( c, c.structure );
+      }
+
+      auto const results = call_with_stopwatch( st.time_resub, [&]() {
+        return resub_engine.validate_candidates();
+      } );
+
+      /* commit in order */
+      retry.clear();
+      std::vector<uint64_t> structure;
+      for ( auto i = 0u; i < batch.size(); ++i )
+      {
+        auto const& c = batch[i];
+        if ( !results[i] ) /* timeout */
+        {
+          continue;
+        }
+
+        if ( !( *results[i] ) ) /* SAT, cex found */
+        {
+          call_with_stopwatch( st.time_resub, [&]() {
+            resub_engine.found_candidate_cex( i );
+          } );
+          if ( c.trials + 1u < ps.max_trials )
+          {
+            retry.emplace_back( c.root, c.trials + 1u );
+          }
+          continue;
+        }
+
+        if ( !window_structure( c, structure ) || structure != c.structure )
+        {
+          if ( c.trials + 1u < ps.max_trials )
+          {
+            retry.emplace_back( c.root, c.trials + 1u );
+          }
+          continue;
+        }
+
+        auto const g = call_with_stopwatch( st.time_resub, [&]() {
+          return resub_engine.insert_candidate( i );
+        } );
+
+        /* update progress bar */
+        candidates++;
+        st.estimated_gain += c.gain;
+
+        /* update network */
+        bool updated = call_with_stopwatch( st.time_callback, [&]() {
+          return callback( ntk, c.root, g );
+        } );
+        if ( updated )
+        {
+          resub_engine.update();
+        }
+      }
+      std::swap( pending, retry );
+    }
+  }
+
+  /* collects the structure of the window of `c`, returns false if a window node is dead */
+  bool window_structure( batch_candidate const& c, std::vector<uint64_t>& structure ) const
+  {
+    structure.clear();
+    for ( auto i = 0u; i < c.window.size(); ++i )
+    {
+      auto const& n = c.window[i];
+      if ( ntk.is_dead( n ) )
+      {
+        return false;
+      }
+      if ( i < c.num_leaves )
+      {
+        continue;
+      }
+
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        structure.emplace_back( ( uint64_t( ntk.node_to_index( ntk.get_node( f ) ) ) << 1 ) | ntk.is_complemented( f ) );
+      } );
+      if ( i >= c.num_divs && n != c.root )
+      {
+        structure.emplace_back( ntk.fanout_size( n ) );
+      }
+    }
+    return true;
+  }
+
   void register_events()
   {
     auto const update_level_of_new_node = [&]( const auto& n ) {
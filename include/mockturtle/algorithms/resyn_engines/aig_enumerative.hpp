@@ -38,6 +38,7 @@
 
 #include "../../utils/index_list.hpp"
 #include "../../utils/null_utils.hpp"
+#include "../../utils/word_operations.hpp"
 #include <kitty/kitty.hpp>
 #include <optional>
 #include <vector>
@@ -200,19 +201,36 @@ public:
       return std::nullopt;
     }
 
+    /* the candidates are tested on the words of the truth tables: all
+       unate literals and pairs imply the target (positive) or are implied
+       by it (negative), such that the equality of a combination with the
+       target reduces to checking that some intersection is empty */
+    num_words = target.num_blocks();
+    scratch.resize( 4u * num_words );
+    uint64_t* const s0 = scratch.data();
+    uint64_t* const s1 = s0 + num_words;
+    uint64_t* const s2 = s1 + num_words;
+    uint64_t* const s3 = s2 + num_words;
+    uint64_t const* const tw = truth_table_words( target );
+    uint64_t const* const ntw = truth_table_words( ntarget );
+    auto const words = [&]( uint32_t lit ) {
+      return truth_table_words( tts[*( begin + ( lit / 2 ) - 1 )] );
+    };
+
     /* collect unate literals */
     std::vector<uint32_t> pos_unate, neg_unate, binate;
     for ( it = begin, i = 0u; it != end; ++it, ++i )
     {
-      if ( kitty::implies( tts[*it], target ) )
+      auto const div = truth_table_words( tts[*it] );
+      if ( and_is_zero_words( div, 0u, ntw, 0u, num_words ) )
       {
         pos_unate.emplace_back( make_lit( i ) );
       }
-      else if ( kitty::implies( target, tts[*it] ) )
+      else if ( and_is_zero_words( tw, 0u, div, ones, num_words ) )
       {
         neg_unate.emplace_back( make_lit( i ) );
       }
-      else if ( kitty::implies( target, ~tts[*it] ) )
+      else if ( and_is_zero_words( tw, 0u, div, 0u, num_words ) )
       {
         neg_unate.emplace_back( make_lit( i, true ) );
       }
@@ -220,7 +238,7 @@ public:
       {
         if constexpr ( !normalized )
         {
-          if ( kitty::implies( ~tts[*it], target ) )
+          if ( and_is_zero_words( div, ones, ntw, 0u, num_words ) )
           {
             pos_unate.emplace_back( make_lit( i, true ) );
           }
@@ -241,7 +259,8 @@ public:
     {
       for ( j = i + 1; j < pos_unate.size(); ++j )
       {
-        if ( target == ( get_tt_from_lit( pos_unate[i], tts, begin ) | get_tt_from_lit( pos_unate[j], tts, begin ) ) )
+        /* target == ( lit_i | lit_j ) */
+        if ( and3_is_zero_words( tw, 0u, words( pos_unate[i] ), ~lit_mask( pos_unate[i] ), words( pos_unate[j] ), ~lit_mask( pos_unate[j] ), num_words ) )
         {
           il.add_output( il.add_and( pos_unate[i] ^ 0x1, pos_unate[j] ^ 0x1 ) ^ 0x1 ); // OR
           return il;
@@ -252,7 +271,8 @@ public:
     {
       for ( j = i + 1; j < neg_unate.size(); ++j )
       {
-        if ( target == ( get_tt_from_lit( neg_unate[i], tts, begin ) & get_tt_from_lit( neg_unate[j], tts, begin ) ) )
+        /* target == ( lit_i & lit_j ) */
+        if ( and3_is_zero_words( ntw, 0u, words( neg_unate[i] ), lit_mask( neg_unate[i] ), words( neg_unate[j] ), lit_mask( neg_unate[j] ), num_words ) )
         {
           il.add_output( il.add_and( neg_unate[i], neg_unate[j] ) ); // AND
           return il;
@@ -268,11 +288,14 @@ public:
     /* 2-resub */
     for ( i = 0u; i < pos_unate.size(); ++i )
     {
+      and_words( s0, tw, 0u, words( pos_unate[i] ), ~lit_mask( pos_unate[i] ), num_words );
       for ( j = i + 1; j < pos_unate.size(); ++j )
       {
+        and_words( s1, s0, 0u, words( pos_unate[j] ), ~lit_mask( pos_unate[j] ), num_words );
         for ( k = j + 1; k < pos_unate.size(); ++k )
         {
-          if ( target == ( get_tt_from_lit( pos_unate[i], tts, begin ) | get_tt_from_lit( pos_unate[j], tts, begin ) | get_tt_from_lit( pos_unate[k], tts, begin ) ) )
+          /* target == ( lit_i | lit_j | lit_k ) */
+          if ( and_is_zero_words( s1, 0u, words( pos_unate[k] ), ~lit_mask( pos_unate[k] ), num_words ) )
           {
             il.add_output( il.add_and( il.add_and( pos_unate[i] ^ 0x1, pos_unate[j] ^ 0x1 ), pos_unate[k] ^ 0x1 ) ^ 0x1 ); // OR-OR
             return il;
@@ -283,11 +306,14 @@ public:
 
     for ( i = 0u; i < neg_unate.size(); ++i )
     {
+      and_words( s0, ntw, 0u, words( neg_unate[i] ), lit_mask( neg_unate[i] ), num_words );
       for ( j = i + 1; j < neg_unate.size(); ++j )
       {
+        and_words( s1, s0, 0u, words( neg_unate[j] ), lit_mask( neg_unate[j] ), num_words );
         for ( k = j + 1; k < neg_unate.size(); ++k )
         {
-          if ( target == ( get_tt_from_lit( neg_unate[i], tts, begin ) & get_tt_from_lit( neg_unate[j], tts, begin ) & get_tt_from_lit( neg_unate[k], tts, begin ) ) )
+          /* target == ( lit_i & lit_j & lit_k ) */
+          if ( and_is_zero_words( s1, 0u, words( neg_unate[k] ), lit_mask( neg_unate[k] ), num_words ) )
           {
             il.add_output( il.add_and( il.add_and( neg_unate[i], neg_unate[j] ), neg_unate[k] ) ); // AND-AND
             return il;
@@ -307,58 +333,76 @@ public:
       }
       for ( j = i + 1; j < binate.size(); ++j )
       {
-        auto const& tt_s0 = get_tt_from_lit( binate[i], tts, begin );
-        auto const& tt_s1 = get_tt_from_lit( binate[j], tts, begin );
+        auto const tt_s0 = words( binate[i] );
+        auto const tt_s1 = words( binate[j] );
         if ( pos_binates.size() < 500 )
         {
-          if ( kitty::implies( tt_s0 & tt_s1, target ) )
+          /* ( s0 & s1 ) implies target */
+          if ( and3_is_zero_words( tt_s0, 0u, tt_s1, 0u, ntw, 0u, num_words ) )
           {
             pos_binates.emplace_back( std::make_pair( binate[i], binate[j] ) );
           }
-          if ( kitty::implies( ~tt_s0 & tt_s1, target ) )
+          if ( and3_is_zero_words( tt_s0, ones, tt_s1, 0u, ntw, 0u, num_words ) )
           {
             pos_binates.emplace_back( std::make_pair( binate[i] ^ 0x1, binate[j] ) );
           }
 
-          if ( kitty::implies( tt_s0 & ~tt_s1, target ) )
+          if ( and3_is_zero_words( tt_s0, 0u, tt_s1, ones, ntw, 0u, num_words ) )
           {
             pos_binates.emplace_back( std::make_pair( binate[i], binate[j] ^ 0x1 ) );
           }
 
-          if ( kitty::implies( ~tt_s0 & ~tt_s1, target ) )
+          if ( and3_is_zero_words( tt_s0, ones, tt_s1, ones, ntw, 0u, num_words ) )
           {
             pos_binates.emplace_back( std::make_pair( binate[i] ^ 0x1, binate[j] ^ 0x1 ) );
           }
         }
         if ( neg_binates.size() < 500 )
         {
-          if ( kitty::implies( target, tt_s0 | tt_s1 ) )
+          /* target implies ( s0 | s1 ) */
+          if ( and3_is_zero_words( tw, 0u, tt_s0, ones, tt_s1, ones, num_words ) )
           {
             neg_binates.emplace_back( std::make_pair( binate[i], binate[j] ) );
           }
-          if ( kitty::implies( target, ~tt_s0 | tt_s1 ) )
+          if ( and3_is_zero_words( tw, 0u, tt_s0, 0u, tt_s1, ones, num_words ) )
           {
             neg_binates.emplace_back( std::make_pair( binate[i] ^ 0x1, binate[j] ) );
           }
 
-          if ( kitty::implies( target, tt_s0 | ~tt_s1 ) )
+          if ( and3_is_zero_words( tw, 0u, tt_s0, ones, tt_s1, 0u, num_words ) )
           {
             neg_binates.emplace_back( std::make_pair( binate[i], binate[j] ^ 0x1 ) );
           }
 
-          if ( kitty::implies( target, ~tt_s0 | ~tt_s1 ) )
+          if ( and3_is_zero_words( tw, 0u, tt_s0, 0u, tt_s1, 0u, num_words ) )
           {
             neg_binates.emplace_back( std::make_pair( binate[i] ^ 0x1, binate[j] ^ 0x1 ) );
           }
         }
       }
     }
+
+    /* s0 = target & ~( first & second ) for positive pairs, and ~target & ( first | second ) for negative pairs */
+    auto const uncovered_by_pos_pair = [&]( uint64_t* out, std::pair<uint32_t, uint32_t> const& pair ) {
+      and_words( s3, words( pair.first ), lit_mask( pair.first ), words( pair.second ), lit_mask( pair.second ), num_words );
+      and_words( out, s3, ones, tw, 0u, num_words );
+    };
+    auto const covered_by_neg_pair = [&]( uint64_t* out, std::pair<uint32_t, uint32_t> const& pair ) {
+      and_words( s3, words( pair.first ), ~lit_mask( pair.first ), words( pair.second ), ~lit_mask( pair.second ), num_words );
+      and_words( out, s3, ones, ntw, 0u, num_words );
+    };
+
     for ( i = 0u; i < pos_binates.size(); ++i )
     {
-      auto const& tt_binate = get_tt_from_lit( pos_binates[i].first, tts, begin ) & get_tt_from_lit( pos_binates[i].second, tts, begin );
+      if ( pos_unate.empty() )
+      {
+        break;
+      }
+      uncovered_by_pos_pair( s0, pos_binates[i] );
       for ( j = 0u; j < pos_unate.size(); ++j )
       {
-        if ( target == ( get_tt_from_lit( pos_unate[j], tts, begin ) | tt_binate ) )
+        /* target == ( lit_j | pair_i ) */
+        if ( and_is_zero_words( s0, 0u, words( pos_unate[j] ), ~lit_mask( pos_unate[j] ), num_words ) )
         {
           il.add_output( il.add_and( il.add_and( pos_binates[i].first, pos_binates[i].second ) ^ 0x1, pos_unate[j] ^ 0x1 ) ^ 0x1 ); // AND-OR
           return il;
@@ -367,10 +411,15 @@ public:
     }
     for ( i = 0u; i < neg_binates.size(); ++i )
     {
-      auto const& tt_binate = get_tt_from_lit( neg_binates[i].first, tts, begin ) | get_tt_from_lit( neg_binates[i].second, tts, begin );
+      if ( neg_unate.empty() )
+      {
+        break;
+      }
+      covered_by_neg_pair( s0, neg_binates[i] );
       for ( j = 0u; j < neg_unate.size(); ++j )
       {
-        if ( target == ( get_tt_from_lit( neg_unate[j], tts, begin ) & tt_binate ) )
+        /* target == ( lit_j & pair_i ) */
+        if ( and_is_zero_words( s0, 0u, words( neg_unate[j] ), lit_mask( neg_unate[j] ), num_words ) )
         {
           il.add_output( il.add_and( il.add_and( neg_binates[i].first ^ 0x1, neg_binates[i].second ^ 0x1 ) ^ 0x1, neg_unate[j] ) ); // OR-AND
           return il;
@@ -384,24 +433,28 @@ public:
     }
 
     /* 3-resub */
-    for ( i = 0u; i < neg_binates.size(); ++i )
+    for ( i = 0u; i + 1 < neg_binates.size(); ++i )
     {
-      auto const& tt_binate = get_tt_from_lit( neg_binates[i].first, tts, begin ) | get_tt_from_lit( neg_binates[i].second, tts, begin );
+      covered_by_neg_pair( s0, neg_binates[i] );
       for ( j = i + 1; j < neg_binates.size(); ++j )
       {
-        if ( target == ( ( get_tt_from_lit( neg_binates[j].first, tts, begin ) | get_tt_from_lit( neg_binates[j].second, tts, begin ) ) & tt_binate ) )
+        /* target == ( pair_j & pair_i ) */
+        if ( and_is_zero_words( s0, 0u, words( neg_binates[j].first ), lit_mask( neg_binates[j].first ), num_words ) &&
+             and_is_zero_words( s0, 0u, words( neg_binates[j].second ), lit_mask( neg_binates[j].second ), num_words ) )
         {
           il.add_output( il.add_and( il.add_and( neg_binates[i].first ^ 0x1, neg_binates[i].second ^ 0x1 ) ^ 0x1, il.add_and( neg_binates[j].first ^ 0x1, neg_binates[j].second ^ 0x1 ) ^ 0x1 ) ); // AND-2OR
           return il;
         }
       }
     }
-    for ( i = 0u; i < pos_binates.size(); ++i )
+    for ( i = 0u; i + 1 < pos_binates.size(); ++i )
     {
-      auto const& tt_binate = get_tt_from_lit( pos_binates[i].first, tts, begin ) & get_tt_from_lit( pos_binates[i].second, tts, begin );
+      uncovered_by_pos_pair( s0, pos_binates[i] );
       for ( j = i + 1; j < pos_binates.size(); ++j )
       {
-        if ( target == ( ( get_tt_from_lit( pos_binates[j].first, tts, begin ) & get_tt_from_lit( pos_binates[j].second, tts, begin ) ) | tt_binate ) )
+        /* target == ( pair_j | pair_i ) */
+        if ( and_is_zero_words( s0, 0u, words( pos_binates[j].first ), ~lit_mask( pos_binates[j].first ), num_words ) &&
+             and_is_zero_words( s0, 0u, words( pos_binates[j].second ), ~lit_mask( pos_binates[j].second ), num_words ) )
         {
           il.add_output( il.add_and( il.add_and( pos_binates[i].first, pos_binates[i].second ) ^ 0x1, il.add_and( pos_binates[j].first, pos_binates[j].second ) ^ 0x1 ) ^ 0x1 ); // OR-2AND
           return il;
@@ -411,13 +464,17 @@ public:
 
     for ( i = 0u; i < pos_unate.size(); ++i )
     {
+      and_words( s0, tw, 0u, words( pos_unate[i] ), ~lit_mask( pos_unate[i] ), num_words );
       for ( j = i + 1; j < pos_unate.size(); ++j )
       {
+        and_words( s1, s0, 0u, words( pos_unate[j] ), ~lit_mask( pos_unate[j] ), num_words );
         for ( k = j + 1; k < pos_unate.size(); ++k )
         {
+          and_words( s2, s1, 0u, words( pos_unate[k] ), ~lit_mask( pos_unate[k] ), num_words );
           for ( l = k + 1; l < pos_unate.size(); ++l )
           {
-            if ( target == ( get_tt_from_lit( pos_unate[i], tts, begin ) | get_tt_from_lit( pos_unate[j], tts, begin ) | get_tt_from_lit( pos_unate[k], tts, begin ) | get_tt_from_lit( pos_unate[l], tts, begin ) ) )
+            /* target == ( lit_i | lit_j | lit_k | lit_l ) */
+            if ( and_is_zero_words( s2, 0u, words( pos_unate[l] ), ~lit_mask( pos_unate[l] ), num_words ) )
             {
               il.add_output( il.add_and( il.add_and( pos_unate[i] ^ 0x1, pos_unate[j] ^ 0x1 ), il.add_and( pos_unate[k] ^ 0x1, pos_unate[l] ^ 0x1 ) ) ^ 0x1 ); // OR-2OR
               return il;
@@ -429,13 +486,17 @@ public:
 
     for ( i = 0u; i < neg_unate.size(); ++i )
     {
+      and_words( s0, ntw, 0u, words( neg_unate[i] ), lit_mask( neg_unate[i] ), num_words );
       for ( j = i + 1; j < neg_unate.size(); ++j )
       {
+        and_words( s1, s0, 0u, words( neg_unate[j] ), lit_mask( neg_unate[j] ), num_words );
         for ( k = j + 1; k < neg_unate.size(); ++k )
         {
+          and_words( s2, s1, 0u, words( neg_unate[k] ), lit_mask( neg_unate[k] ), num_words );
           for ( l = k + 1; l < neg_unate.size(); ++l )
           {
-            if ( target == ( get_tt_from_lit( neg_unate[i], tts, begin ) & get_tt_from_lit( neg_unate[j], tts, begin ) & get_tt_from_lit( neg_unate[k], tts, begin ) & get_tt_from_lit( neg_unate[l], tts, begin ) ) )
+            /* target == ( lit_i & lit_j & lit_k & lit_l ) */
+            if ( and_is_zero_words( s2, 0u, words( neg_unate[l] ), lit_mask( neg_unate[l] ), num_words ) )
             {
               il.add_output( il.add_and( il.add_and( neg_unate[i], neg_unate[j] ), il.add_and( neg_unate[k], neg_unate[l] ) ) ); // AND-2AND
               return il;
@@ -459,13 +520,18 @@ private:
     return ( var + 1 ) * 2 + (uint32_t)inv;
   }
 
-  template<class truth_table_storage_type, class iterator_type>
-  TT get_tt_from_lit( uint32_t const& lit, truth_table_storage_type const& tts, iterator_type const& begin )
+  /* all-ones mask if the literal is complemented */
+  static uint64_t lit_mask( uint32_t lit )
   {
-    return ( lit % 2 ) ? ~tts[*( begin + ( lit / 2 ) - 1 )] : tts[*( begin + ( lit / 2 ) - 1 )];
+    return ( lit % 2 ) ? ones : 0u;
   }
 
 private:
+  static constexpr uint64_t ones = ~uint64_t( 0 );
+
+  uint64_t num_words{ 0 };
+  std::vector<uint64_t> scratch;
+
   stats& st;
 }; /* aig_enumerative_resyn */
 
@@ -33,6 +33,7 @@
 #pragma once
 
 #include "../../utils/index_list.hpp"
+#include "../../utils/word_operations.hpp"
 
 #include <fmt/format.h>
 #include <kitty/kitty.hpp>
@@ -169,11 +170,11 @@ private:
     /* the second fanin: 2 * #newly-covered-bits + 1 * #cover-again-bits */
     uint64_t max_score = 0u;
     max_j = 0u;
-    auto const not_covered_by_i = ~function_i;
+    auto const num_words = function_i.num_blocks();
     for ( auto j = 0u; j < divisors.size(); ++j )
     {
-      auto const covered_by_j = divisors.at( j );
-      uint32_t score = kitty::count_ones( covered_by_j ) + kitty::count_ones( not_covered_by_i & covered_by_j );
+      auto const covered_by_j = truth_table_words( divisors.at( j ) );
+      uint32_t score = kitty::count_ones( divisors.at( j ) ) + count_and_words( truth_table_words( function_i ), ~uint64_t( 0 ), covered_by_j, 0u, num_words );
       if ( score > max_score && ( j >> 1 ) != ( max_i >> 1 ) )
       {
         max_score = score;
@@ -185,10 +186,10 @@ private:
     /* the third fanin: only care about the disagreed bits */
     max_score = 0u;
     max_k = 0u;
-    auto const disagree_in_ij = function_i ^ divisors.at( max_j );
     for ( auto k = 0u; k < divisors.size(); ++k )
     {
-      uint32_t score = kitty::count_ones( divisors.at( k ) & disagree_in_ij );
+      /* bits of k in which i and j disagree */
+      uint32_t score = count_xor_and_words( truth_table_words( function_i ), truth_table_words( divisors.at( max_j ) ), 0u, truth_table_words( divisors.at( k ) ), num_words );
       if ( score > max_score && ( k >> 1 ) != ( max_i >> 1 ) && ( k >> 1 ) != ( max_j >> 1 ) )
       {
         max_score = score;
@@ -587,7 +588,7 @@ private:
     uint32_t max_i = 0u;
     for ( auto i = 0u; i < divisors.size(); ++i )
     {
-      scores.at( i ) = kitty::count_ones( divisors.at( i ) & care );
+      scores.at( i ) = count_and_words( truth_table_words( divisors.at( i ) ), 0u, truth_table_words( care ), 0u, care.num_blocks() );
       if ( scores.at( i ) > max_score )
       {
         max_score = scores.at( i );
@@ -598,11 +599,9 @@ private:
     /* the second fanin: 2 * #newly-covered-bits + 1 * #cover-again-bits */
     max_score = 0u;
     uint32_t max_j = 0u;
-    auto const not_covered_by_i = ~divisors.at( max_i );
     for ( auto j = 0u; j < divisors.size(); ++j )
     {
-      auto const covered_by_j = divisors.at( j ) & care;
-      scores.at( j ) = kitty::count_ones( covered_by_j ) + kitty::count_ones( not_covered_by_i & covered_by_j );
+      scores.at( j ) = score_second_fanin( care, max_i, j );
       if ( scores.at( j ) > max_score && !same_divisor( j, max_i ) )
       {
         max_score = scores.at( j );
@@ -613,11 +612,9 @@ private:
     /* the third fanin: 2 * #cover-never-covered-bits + 1 * #cover-covered-once-bits */
     max_score = 0u;
     uint32_t max_k = 0u;
-    auto const not_covered_by_j = ~divisors.at( max_j );
     for ( auto k = 0u; k < divisors.size(); ++k )
     {
-      auto const covered_by_k = divisors.at( k ) & care;
-      scores.at( k ) = kitty::count_ones( covered_by_k & not_covered_by_i ) + kitty::count_ones( covered_by_k & not_covered_by_j );
+      scores.at( k ) = score_third_fanin( care, max_i, max_j, k );
       if ( scores.at( k ) > max_score && !same_divisor( k, max_i ) && !same_divisor( k, max_j ) )
       {
         max_score = scores.at( k );
@@ -637,7 +634,7 @@ private:
     uint64_t max_score = 0u;
     for ( auto i = 0u; i < divisors.size(); ++i )
     {
-      scores.at( i ) = kitty::count_ones( divisors.at( i ) & care );
+      scores.at( i ) = count_and_words( truth_table_words( divisors.at( i ) ), 0u, truth_table_words( care ), 0u, care.num_blocks() );
       if ( scores.at( i ) > max_score )
       {
         max_score = scores.at( i );
@@ -660,11 +657,9 @@ private:
   {
     /* the second fanin: 2 * #newly-covered-bits + 1 * #cover-again-bits */
     uint64_t max_score = 0u;
-    auto const not_covered_by_i = ~divisors.at( max_i );
     for ( auto j = 0u; j < divisors.size(); ++j )
     {
-      auto const covered_by_j = divisors.at( j ) & care;
-      scores.at( j ) = kitty::count_ones( covered_by_j ) + kitty::count_ones( not_covered_by_i & covered_by_j );
+      scores.at( j ) = score_second_fanin( care, max_i, j );
       if ( scores.at( j ) > max_score && !same_divisor( j, max_i ) )
       {
         max_score = scores.at( j );
@@ -687,12 +682,9 @@ private:
   {
     /* the third fanin: 2 * #cover-never-covered-bits + 1 * #cover-covered-once-bits */
     uint64_t max_score = 0u;
-    auto const not_covered_by_i = ~divisors.at( max_i );
-    auto const not_covered_by_j = ~divisors.at( max_j );
     for ( auto k = 0u; k < divisors.size(); ++k )
     {
-      auto const covered_by_k = divisors.at( k ) & care;
-      scores.at( k ) = kitty::count_ones( covered_by_k & not_covered_by_i ) + kitty::count_ones( covered_by_k & not_covered_by_j );
+      scores.at( k ) = score_third_fanin( care, max_i, max_j, k );
       if ( scores.at( k ) > max_score && !same_divisor( k, max_i ) && !same_divisor( k, max_j ) )
       {
         max_score = scores.at( k );
@@ -782,6 +774,24 @@ private:
     return ( i >> 1 ) == ( j >> 1 );
   }
 
+  /* 2 * #newly-covered-bits + 1 * #cover-again-bits */
+  uint64_t score_second_fanin( TT const& care, uint32_t i, uint32_t j ) const
+  {
+    auto const num_words = care.num_blocks();
+    auto const covered_by_j = truth_table_words( divisors.at( j ) );
+    return count_and_words( covered_by_j, 0u, truth_table_words( care ), 0u, num_words ) +
+           count_and3_words( truth_table_words( divisors.at( i ) ), ~uint64_t( 0 ), covered_by_j, 0u, truth_table_words( care ), 0u, num_words );
+  }
+
+  /* 2 * #cover-never-covered-bits + 1 * #cover-covered-once-bits */
+  uint64_t score_third_fanin( TT const& care, uint32_t i, uint32_t j, uint32_t k ) const
+  {
+    auto const num_words = care.num_blocks();
+    auto const covered_by_k = truth_table_words( divisors.at( k ) );
+    return count_and3_words( truth_table_words( divisors.at( i ) ), ~uint64_t( 0 ), covered_by_k, 0u, truth_table_words( care ), 0u, num_words ) +
+           count_and3_words( truth_table_words( divisors.at( j ) ), ~uint64_t( 0 ), covered_by_k, 0u, truth_table_words( care ), 0u, num_words );
+  }
+
   bool fulfilled( TT const& func, TT const& care )
   {
     return kitty::is_const0( ~func & care );
@@ -36,6 +36,7 @@
 #include "../../utils/index_list.hpp"
 #include "../../utils/node_map.hpp"
 #include "../../utils/stopwatch.hpp"
+#include "../../utils/word_operations.hpp"
 
 #include <fmt/format.h>
 #include <kitty/kitty.hpp>
@@ -120,6 +121,9 @@ struct xag_resyn_stats
   /*! \brief Time for finding 1-resub. */
   stopwatch<>::duration time_resub1{ 0 };
 
+  /*! \brief Time for collecting XOR-type unate pairs and finding 1-resub with XOR. */
+  stopwatch<>::duration time_xor{ 0 };
+
   /*! \brief Time for finding 2-resub. */
   stopwatch<>::duration time_resub2{ 0 };
 
@@ -140,6 +144,7 @@ struct xag_resyn_stats
     fmt::print( "[i]         <xag_resyn_decompose>\n" );
     fmt::print( "[i]             0-resub      : {:>5.2f} secs\n", to_seconds( time_unate ) );
     fmt::print( "[i]             1-resub      : {:>5.2f} secs\n", to_seconds( time_resub1 ) );
+    fmt::print( "[i]             1-resub XOR  : {:>5.2f} secs\n", to_seconds( time_xor ) );
     fmt::print( "[i]             2-resub      : {:>5.2f} secs\n", to_seconds( time_resub2 ) );
     fmt::print( "[i]             3-resub      : {:>5.2f} secs\n", to_seconds( time_resub3 ) );
     fmt::print( "[i]             sort         : {:>5.2f} secs\n", to_seconds( time_sort ) );
@@ -162,6 +167,11 @@ struct xag_resyn_stats
  * When no simple solutions can be found, the algorithm heuristically chooses an unate
  * divisor or an unate pair to divide the target function with and recursively calls
  * itself to decompose the remainder function.
+ *
+ * The divisors are classified and combined with the word-level kernels of
+ * `word_operations.hpp`, which test the words of the truth tables without
+ * building temporary truth tables and stop at the first overlapping word.
+ * The binate divisors are copied into a packed matrix before pairing them.
    \verbatim embed:rst
 
    Example
@@ -267,6 +277,14 @@ public:
       ++begin;
     }
 
+    num_words = on_off_sets[0].num_blocks();
+    div_words.resize( divisors.size() );
+    for ( auto v = 1u; v < divisors.size(); ++v )
+    {
+      div_words[v] = truth_table_words( get_div( v ) );
+    }
+    scratch.resize( 2u * num_words );
+
     return compute_function( max_size );
   }
 
@@ -340,11 +358,14 @@ private:
     {
       binate_divs.resize( static_params::max_binates );
     }
+    pack_binate_divs();
 
     if constexpr ( static_params::use_xor )
     {
       /* collect XOR-type unate pairs and try 1-resub with XOR */
-      auto const res1xor = find_xor();
+      auto const res1xor = call_with_stopwatch( st.time_xor, [&]() {
+        return find_xor();
+      } );
       if ( res1xor )
       {
         return *res1xor;
@@ -515,28 +536,30 @@ private:
       return 0;
     }
 
+    auto const off_set = set_words( 0 );
+    auto const on_set = set_words( 1 );
     for ( auto v = 1u; v < divisors.size(); ++v )
     {
       bool unateness[4] = { false, false, false, false };
       /* check intersection with off-set */
-      if ( kitty::intersection_is_empty<TT, 1, 1>( get_div( v ), on_off_sets[0] ) )
+      if ( and_is_zero_words( div_words[v], 0u, off_set, 0u, num_words ) )
       {
         pos_unate_lits.emplace_back( v << 1 );
         unateness[0] = true;
       }
-      else if ( kitty::intersection_is_empty<TT, 0, 1>( get_div( v ), on_off_sets[0] ) )
+      else if ( and_is_zero_words( div_words[v], ones, off_set, 0u, num_words ) )
       {
         pos_unate_lits.emplace_back( v << 1 | 0x1 );
         unateness[1] = true;
       }
 
       /* check intersection with on-set */
-      if ( kitty::intersection_is_empty<TT, 1, 1>( get_div( v ), on_off_sets[1] ) )
+      if ( and_is_zero_words( div_words[v], 0u, on_set, 0u, num_words ) )
       {
         neg_unate_lits.emplace_back( v << 1 );
         unateness[2] = true;
       }
-      else if ( kitty::intersection_is_empty<TT, 0, 1>( get_div( v ), on_off_sets[1] ) )
+      else if ( and_is_zero_words( div_words[v], ones, on_set, 0u, num_words ) )
       {
         neg_unate_lits.emplace_back( v << 1 | 0x1 );
         unateness[3] = true;
@@ -572,9 +595,10 @@ private:
    */
   void sort_unate_lits( std::vector<unate_lit>& unate_lits, uint32_t on_off )
   {
+    auto const set = set_words( on_off );
     for ( auto& l : unate_lits )
     {
-      l.score = kitty::count_ones( ( l.lit & 0x1 ? ~get_div( l.lit >> 1 ) : get_div( l.lit >> 1 ) ) & on_off_sets[on_off] );
+      l.score = static_cast<uint32_t>( count_and_words( div_words[l.lit >> 1], lit_mask( l.lit ), set, 0u, num_words ) );
     }
     std::sort( unate_lits.begin(), unate_lits.end(), [&]( unate_lit const& l1, unate_lit const& l2 ) {
       return l1.score > l2.score; // descending order
@@ -583,16 +607,16 @@ private:
 
   void sort_unate_pairs( std::vector<fanin_pair>& unate_pairs, uint32_t on_off )
   {
+    auto const set = set_words( on_off );
     for ( auto& p : unate_pairs )
     {
-      if constexpr ( static_params::use_xor )
+      if ( is_xor_pair( p ) )
       {
-        p.score = ( p.lit1 > p.lit2 ) ? kitty::count_ones( ( ( p.lit1 & 0x1 ? ~get_div( p.lit1 >> 1 ) : get_div( p.lit1 >> 1 ) ) ^ ( p.lit2 & 0x1 ? ~get_div( p.lit2 >> 1 ) : get_div( p.lit2 >> 1 ) ) ) & on_off_sets[on_off] )
-                                      : kitty::count_ones( ( p.lit1 & 0x1 ? ~get_div( p.lit1 >> 1 ) : get_div( p.lit1 >> 1 ) ) & ( p.lit2 & 0x1 ? ~get_div( p.lit2 >> 1 ) : get_div( p.lit2 >> 1 ) ) & on_off_sets[on_off] );
+        p.score = static_cast<uint32_t>( count_xor_and_words( div_words[p.lit1 >> 1], div_words[p.lit2 >> 1], lit_mask( p.lit1 ) ^ lit_mask( p.lit2 ), set, num_words ) );
       }
       else
       {
-        p.score = kitty::count_ones( ( p.lit1 & 0x1 ? ~get_div( p.lit1 >> 1 ) : get_div( p.lit1 >> 1 ) ) & ( p.lit2 & 0x1 ? ~get_div( p.lit2 >> 1 ) : get_div( p.lit2 >> 1 ) ) & on_off_sets[on_off] );
+        p.score = static_cast<uint32_t>( count_and3_words( div_words[p.lit1 >> 1], lit_mask( p.lit1 ), div_words[p.lit2 >> 1], lit_mask( p.lit2 ), set, 0u, num_words ) );
       }
     }
     std::sort( unate_pairs.begin(), unate_pairs.end(), [&]( fanin_pair const& p1, fanin_pair const& p2 ) {
@@ -620,9 +644,8 @@ private:
         {
           break;
         }
-        auto const ntt1 = lit1 & 0x1 ? get_div( lit1 >> 1 ) : ~get_div( lit1 >> 1 );
-        auto const ntt2 = lit2 & 0x1 ? get_div( lit2 >> 1 ) : ~get_div( lit2 >> 1 );
-        if ( kitty::intersection_is_empty( ntt1, ntt2, on_off_sets[on_off] ) )
+        /* ~lit1 & ~lit2 & on_off_set = 0 */
+        if ( and3_is_zero_words( div_words[lit1 >> 1], ~lit_mask( lit1 ), div_words[lit2 >> 1], ~lit_mask( lit2 ), set_words( on_off ), 0u, num_words ) )
         {
           auto const new_lit = index_list.add_and( ( lit1 ^ 0x1 ), ( lit2 ^ 0x1 ) );
           return new_lit + on_off;
@@ -637,6 +660,13 @@ private:
     for ( auto i = 0u; i < unate_lits.size(); ++i )
     {
       uint32_t const& lit1 = unate_lits[i].lit;
+      if ( unate_pairs.empty() || unate_lits[i].score + unate_pairs[0].score < num_bits[on_off] )
+      {
+        continue;
+      }
+
+      /* the bits of the on-set (or off-set) not covered by lit1 */
+      and_words( scratch.data(), div_words[lit1 >> 1], ~lit_mask( lit1 ), set_words( on_off ), 0u, num_words );
       for ( auto j = 0u; j < unate_pairs.size(); ++j )
       {
         fanin_pair const& pair2 = unate_pairs[j];
@@ -644,25 +674,8 @@ private:
         {
           break;
         }
-        auto const ntt1 = lit1 & 0x1 ? get_div( lit1 >> 1 ) : ~get_div( lit1 >> 1 );
-        TT ntt2;
-        if constexpr ( static_params::use_xor )
-        {
-          if ( pair2.lit1 > pair2.lit2 )
-          {
-            ntt2 = ( pair2.lit1 & 0x1 ? get_div( pair2.lit1 >> 1 ) : ~get_div( pair2.lit1 >> 1 ) ) ^ ( pair2.lit2 & 0x1 ? ~get_div( pair2.lit2 >> 1 ) : get_div( pair2.lit2 >> 1 ) );
-          }
-          else
-          {
-            ntt2 = ( pair2.lit1 & 0x1 ? get_div( pair2.lit1 >> 1 ) : ~get_div( pair2.lit1 >> 1 ) ) | ( pair2.lit2 & 0x1 ? get_div( pair2.lit2 >> 1 ) : ~get_div( pair2.lit2 >> 1 ) );
-          }
-        }
-        else
-        {
-          ntt2 = ( pair2.lit1 & 0x1 ? get_div( pair2.lit1 >> 1 ) : ~get_div( pair2.lit1 >> 1 ) ) | ( pair2.lit2 & 0x1 ? get_div( pair2.lit2 >> 1 ) : ~get_div( pair2.lit2 >> 1 ) );
-        }
 
-        if ( kitty::intersection_is_empty( ntt1, ntt2, on_off_sets[on_off] ) )
+        if ( covers( pair2, scratch.data() ) )
         {
           uint32_t new_lit1;
           if constexpr ( static_params::use_xor )
@@ -697,6 +710,24 @@ private:
       {
         break;
       }
+      if ( i + 1 == unate_pairs.size() || pair1.score + unate_pairs[i + 1].score < num_bits[on_off] )
+      {
+        continue;
+      }
+
+      /* the bits of the on-set (or off-set) not covered by pair1 */
+      uint64_t* const pair_words = scratch.data() + num_words;
+      if ( is_xor_pair( pair1 ) )
+      {
+        xor_words( pair_words, div_words[pair1.lit1 >> 1], ~lit_mask( pair1.lit1 ), div_words[pair1.lit2 >> 1], lit_mask( pair1.lit2 ), num_words );
+        and_words( scratch.data(), pair_words, 0u, set_words( on_off ), 0u, num_words );
+      }
+      else
+      {
+        and_words( pair_words, div_words[pair1.lit1 >> 1], lit_mask( pair1.lit1 ), div_words[pair1.lit2 >> 1], lit_mask( pair1.lit2 ), num_words );
+        and_words( scratch.data(), pair_words, ones, set_words( on_off ), 0u, num_words );
+      }
+
       for ( auto j = i + 1; j < unate_pairs.size(); ++j )
       {
         fanin_pair const& pair2 = unate_pairs[j];
@@ -704,33 +735,8 @@ private:
         {
           break;
         }
-        TT ntt1, ntt2;
-        if constexpr ( static_params::use_xor )
-        {
-          if ( pair1.lit1 > pair1.lit2 )
-          {
-            ntt1 = ( pair1.lit1 & 0x1 ? get_div( pair1.lit1 >> 1 ) : ~get_div( pair1.lit1 >> 1 ) ) ^ ( pair1.lit2 & 0x1 ? ~get_div( pair1.lit2 >> 1 ) : get_div( pair1.lit2 >> 1 ) );
-          }
-          else
-          {
-            ntt1 = ( pair1.lit1 & 0x1 ? get_div( pair1.lit1 >> 1 ) : ~get_div( pair1.lit1 >> 1 ) ) | ( pair1.lit2 & 0x1 ? get_div( pair1.lit2 >> 1 ) : ~get_div( pair1.lit2 >> 1 ) );
-          }
-          if ( pair2.lit1 > pair2.lit2 )
-          {
-            ntt2 = ( pair2.lit1 & 0x1 ? get_div( pair2.lit1 >> 1 ) : ~get_div( pair2.lit1 >> 1 ) ) ^ ( pair2.lit2 & 0x1 ? ~get_div( pair2.lit2 >> 1 ) : get_div( pair2.lit2 >> 1 ) );
-          }
-          else
-          {
-            ntt2 = ( pair2.lit1 & 0x1 ? get_div( pair2.lit1 >> 1 ) : ~get_div( pair2.lit1 >> 1 ) ) | ( pair2.lit2 & 0x1 ? get_div( pair2.lit2 >> 1 ) : ~get_div( pair2.lit2 >> 1 ) );
-          }
-        }
-        else
-        {
-          ntt1 = ( pair1.lit1 & 0x1 ? get_div( pair1.lit1 >> 1 ) : ~get_div( pair1.lit1 >> 1 ) ) | ( pair1.lit2 & 0x1 ? get_div( pair1.lit2 >> 1 ) : ~get_div( pair1.lit2 >> 1 ) );
-          ntt2 = ( pair2.lit1 & 0x1 ? get_div( pair2.lit1 >> 1 ) : ~get_div( pair2.lit1 >> 1 ) ) | ( pair2.lit2 & 0x1 ? get_div( pair2.lit2 >> 1 ) : ~get_div( pair2.lit2 >> 1 ) );
-        }
 
-        if ( kitty::intersection_is_empty( ntt1, ntt2, on_off_sets[on_off] ) )
+        if ( covers( pair2, scratch.data() ) )
         {
           uint32_t fanin_lit1, fanin_lit2;
           if constexpr ( static_params::use_xor )
@@ -768,31 +774,39 @@ private:
   std::optional<uint32_t> find_xor()
   {
     /* collect XOR-type pairs (d1 ^ d2) & off = 0 or ~(d1 ^ d2) & on = 0, selecting d1, d2 from binate_divs */
+    auto const off_set = set_words( 0 );
+    auto const on_set = set_words( 1 );
     for ( auto i = 0u; i < binate_divs.size(); ++i )
     {
       for ( auto j = i + 1; j < binate_divs.size(); ++j )
       {
-        auto const tt_xor = get_div( binate_divs[i] ) ^ get_div( binate_divs[j] );
+        auto const div1 = binate_row( i );
+        auto const div2 = binate_row( j );
+        bool const xor_off_empty = xor_and_is_zero_words( div1, div2, 0u, off_set, num_words );
+        bool const xor_on_empty = xor_and_is_zero_words( div1, div2, 0u, on_set, num_words );
+        bool const xnor_off_empty = xor_and_is_zero_words( div1, div2, ones, off_set, num_words );
+        bool const xnor_on_empty = xor_and_is_zero_words( div1, div2, ones, on_set, num_words );
+
         bool unateness[4] = { false, false, false, false };
         /* check intersection with off-set; additionally check intersection with on-set is not empty (otherwise it's useless) */
-        if ( kitty::intersection_is_empty<TT, 1, 1>( tt_xor, on_off_sets[0] ) && !kitty::intersection_is_empty<TT, 1, 1>( tt_xor, on_off_sets[1] ) )
+        if ( xor_off_empty && !xor_on_empty )
         {
           pos_unate_pairs.emplace_back( binate_divs[i] << 1, binate_divs[j] << 1, true );
           unateness[0] = true;
         }
-        if ( kitty::intersection_is_empty<TT, 0, 1>( tt_xor, on_off_sets[0] ) && !kitty::intersection_is_empty<TT, 0, 1>( tt_xor, on_off_sets[1] ) )
+        if ( xnor_off_empty && !xnor_on_empty )
         {
           pos_unate_pairs.emplace_back( ( binate_divs[i] << 1 ) + 1, binate_divs[j] << 1, true );
           unateness[1] = true;
         }
 
         /* check intersection with on-set; additionally check intersection with off-set is not empty (otherwise it's useless) */
-        if ( kitty::intersection_is_empty<TT, 1, 1>( tt_xor, on_off_sets[1] ) && !kitty::intersection_is_empty<TT, 1, 1>( tt_xor, on_off_sets[0] ) )
+        if ( xor_on_empty && !xor_off_empty )
         {
           neg_unate_pairs.emplace_back( binate_divs[i] << 1, binate_divs[j] << 1, true );
           unateness[2] = true;
         }
-        if ( kitty::intersection_is_empty<TT, 0, 1>( tt_xor, on_off_sets[1] ) && !kitty::intersection_is_empty<TT, 0, 1>( tt_xor, on_off_sets[0] ) )
+        if ( xnor_on_empty && !xnor_off_empty )
         {
           neg_unate_pairs.emplace_back( ( binate_divs[i] << 1 ) + 1, binate_divs[j] << 1, true );
           unateness[3] = true;
@@ -819,24 +833,33 @@ private:
     {
       for ( auto j = i + 1; j < binate_divs.size(); ++j )
       {
-        collect_unate_pairs_detail<1, 1>( binate_divs[i], binate_divs[j] );
-        collect_unate_pairs_detail<0, 1>( binate_divs[i], binate_divs[j] );
-        collect_unate_pairs_detail<1, 0>( binate_divs[i], binate_divs[j] );
-        collect_unate_pairs_detail<0, 0>( binate_divs[i], binate_divs[j] );
+        collect_unate_pairs_detail<1, 1>( i, j );
+        collect_unate_pairs_detail<0, 1>( i, j );
+        collect_unate_pairs_detail<1, 0>( i, j );
+        collect_unate_pairs_detail<0, 0>( i, j );
       }
     }
   }
 
+  /* `i` and `j` are positions in `binate_divs` */
   template<bool pol1, bool pol2>
-  void collect_unate_pairs_detail( uint32_t div1, uint32_t div2 )
+  void collect_unate_pairs_detail( uint32_t i, uint32_t j )
   {
+    uint32_t const div1 = binate_divs[i];
+    uint32_t const div2 = binate_divs[j];
+    uint64_t const mask1 = pol1 ? 0u : ones;
+    uint64_t const mask2 = pol2 ? 0u : ones;
+    auto const and_is_empty = [&]( uint32_t on_off ) {
+      return and3_is_zero_words( binate_row( i ), mask1, binate_row( j ), mask2, set_words( on_off ), 0u, num_words );
+    };
+
     /* check intersection with off-set; additionally check intersection with on-set is not empty (otherwise it's useless) */
-    if ( kitty::intersection_is_empty<TT, pol1, pol2>( get_div( div1 ), get_div( div2 ), on_off_sets[0] ) && !kitty::intersection_is_empty<TT, pol1, pol2>( get_div( div1 ), get_div( div2 ), on_off_sets[1] ) )
+    if ( and_is_empty( 0 ) && !and_is_empty( 1 ) )
     {
       pos_unate_pairs.emplace_back( ( div1 << 1 ) + (uint32_t)( !pol1 ), ( div2 << 1 ) + (uint32_t)( !pol2 ) );
     }
     /* check intersection with on-set; additionally check intersection with off-set is not empty (otherwise it's useless) */
-    else if ( kitty::intersection_is_empty<TT, pol1, pol2>( get_div( div1 ), get_div( div2 ), on_off_sets[1] ) && !kitty::intersection_is_empty<TT, pol1, pol2>( get_div( div1 ), get_div( div2 ), on_off_sets[0] ) )
+    else if ( and_is_empty( 1 ) && !and_is_empty( 0 ) )
     {
       neg_unate_pairs.emplace_back( ( div1 << 1 ) + (uint32_t)( !pol1 ), ( div2 << 1 ) + (uint32_t)( !pol2 ) );
     }
@@ -854,7 +877,53 @@ private:
     }
   }
 
+  /* all-ones mask if the literal is complemented */
+  static uint64_t lit_mask( uint32_t lit )
+  {
+    return lit & 0x1 ? ones : 0u;
+  }
+
+  static bool is_xor_pair( fanin_pair const& pair )
+  {
+    return static_params::use_xor && pair.lit1 > pair.lit2;
+  }
+
+  uint64_t const* set_words( uint32_t on_off ) const
+  {
+    return truth_table_words( on_off_sets[on_off] );
+  }
+
+  uint64_t const* binate_row( uint32_t i ) const
+  {
+    return binate_words.data() + i * num_words;
+  }
+
+  /* copies the binate divisors into consecutive rows of a matrix */
+  void pack_binate_divs()
+  {
+    binate_words.resize( binate_divs.size() * num_words );
+    for ( auto i = 0u; i < binate_divs.size(); ++i )
+    {
+      std::copy_n( div_words[binate_divs[i]], num_words, binate_words.begin() + i * num_words );
+    }
+  }
+
+  /* whether the pair covers all bits in `words`, i.e., `words & ~pair = 0` */
+  bool covers( fanin_pair const& pair, uint64_t const* words ) const
+  {
+    auto const div1 = div_words[pair.lit1 >> 1];
+    auto const div2 = div_words[pair.lit2 >> 1];
+    if ( is_xor_pair( pair ) )
+    {
+      return xor_and_is_zero_words( div1, div2, ~( lit_mask( pair.lit1 ) ^ lit_mask( pair.lit2 ) ), words, num_words );
+    }
+    /* ~(lit1 & lit2) = ~lit1 | ~lit2 */
+    return and_is_zero_words( words, 0u, div1, ~lit_mask( pair.lit1 ), num_words ) && and_is_zero_words( words, 0u, div2, ~lit_mask( pair.lit2 ), num_words );
+  }
+
 private:
+  static constexpr uint64_t ones = ~uint64_t( 0 );
+
   std::array<TT, 2> on_off_sets;
   std::array<uint32_t, 2> num_bits; /* number of bits in on-set and off-set */
 
@@ -869,6 +938,12 @@ private:
   std::vector<uint32_t> binate_divs;
   std::vector<fanin_pair> pos_unate_pairs, neg_unate_pairs;
 
+  /* words of the divisor truth tables, the packed binate divisors, and scratch space */
+  uint64_t num_words{ 0 };
+  std::vector<uint64_t const*> div_words;
+  std::vector<uint64_t> binate_words;
+  std::vector<uint64_t> scratch;
+
   stats& st;
 }; /* xag_resyn_decompose */
 
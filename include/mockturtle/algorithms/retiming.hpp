@@ -37,6 +37,7 @@
 
 #include "../utils/node_map.hpp"
 #include "../utils/stopwatch.hpp"
+#include "../utils/traversal.hpp"
 #include "../views/fanout_view.hpp"
 #include "../views/topo_view.hpp"
 #include <fmt/format.h>
@@ -630,26 +631,38 @@ private:
 
   void rec_mark_tfo( node const& n )
   {
-    if ( _ntk.value( n ) )
-      return;
+    _dfs.run(
+        n, [&]( node const& m, auto&& push ) {
+          _ntk.foreach_fanout( m, [&]( auto const& f ) {
+            push( f );
+          } );
+        },
+        [&]( node const& m ) {
+          if ( _ntk.value( m ) )
+            return false;
 
-    _ntk.set_value( n, 1 );
-    _ntk.foreach_fanout( n, [&]( auto const& f ) {
-      rec_mark_tfo( f );
-    } );
+          _ntk.set_value( m, 1 );
+          return true;
+        } );
   }
 
   void rec_mark_tfi( node const& n )
   {
-    if ( _ntk.value( n ) )
-      return;
+    _dfs.run(
+        n, [&]( node const& m, auto&& push ) {
+          _ntk.foreach_fanin( m, [&]( auto const& f ) {
+            if ( _ntk.is_constant( _ntk.get_node( f ) ) )
+              return;
+            push( _ntk.get_node( f ) );
+          } );
+        },
+        [&]( node const& m ) {
+          if ( _ntk.value( m ) )
+            return false;
 
-    _ntk.set_value( n, 1 );
-    _ntk.foreach_fanin( n, [&]( auto const& f ) {
-      if ( _ntk.is_constant( _ntk.get_node( f ) ) )
-        return;
-      rec_mark_tfi( _ntk.get_node( f ) );
-    } );
+          _ntk.set_value( m, 1 );
+          return true;
+        } );
   }
 
   template<bool forward>
@@ -737,6 +750,7 @@ private:
   retime_stats& _st;
 
   node_map<uint32_t, Ntk> _flow_path;
+  iterative_dfs<node> _dfs;
 };
 
 } /* namespace detail */
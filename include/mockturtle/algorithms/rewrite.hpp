@@ -36,6 +36,8 @@
 #include "../utils/cost_functions.hpp"
 #include "../utils/node_map.hpp"
 #include "../utils/stopwatch.hpp"
+#include "../utils/thread_pool.hpp"
+#include "../utils/trace.hpp"
 #include "../views/color_view.hpp"
 #include "../views/depth_view.hpp"
 #include "../views/fanout_view.hpp"
@@ -87,6 +89,21 @@ struct rewrite_params
   /*! \brief Window size for don't cares calculation. */
   uint32_t window_size{ 8u };
 
+  /*! \brief Number of threads (0 uses the hardware concurrency).
+   *
+   * With more than one thread, rewriting proceeds in rounds.  In each round,
+   * the candidates of all pending nodes are evaluated in parallel on the
+   * unchanged network.  Then, they are committed sequentially in order of
+   * decreasing gain, skipping candidates whose MFFC overlaps with the window
+   * (MFFC, cut leaves, and reused nodes) of an already committed candidate,
+   * or whose window overlaps with the MFFC of an already committed one.
+   * Skipped nodes and the fanouts of the committed structures are evaluated
+   * again in the next round.  The result does not depend on the number of threads, but it
+   * may differ from the result of the sequential pass.  The parallel engine
+   * is not used when preserving depth or when using don't cares.
+   */
+  uint32_t num_threads{ 1u };
+
   /*! \brief Be verbose. */
   bool verbose{ false };
 };
@@ -107,9 +124,28 @@ struct rewrite_stats
   /*! \brief Candidates */
   uint32_t candidates{ 0 };
 
+  /*! \brief Runtime of the parallel evaluation of candidates. */
+  stopwatch<>::duration time_evaluation{ 0 };
+
+  /*! \brief Runtime of the commit of candidates. */
+  stopwatch<>::duration time_commit{ 0 };
+
+  /*! \brief Rounds of the parallel engine. */
+  uint32_t rounds{ 0 };
+
+  /*! \brief Candidates skipped because of overlapping windows. */
+  uint32_t conflicts{ 0 };
+
   void report() const
   {
     std::cout << fmt::format( "[i] total time       = {:>5.2f} secs\n", to_seconds( time_total ) );
+    if ( rounds > 0 )
+    {
+      std::cout << fmt::format( "[i] evaluation time  = {:>5.2f} secs\n", to_seconds( time_evaluation ) );
+      std::cout << fmt::format( "[i] commit time      = {:>5.2f} secs\n", to_seconds( time_commit ) );
+      std::cout << fmt::format( "[i] rounds           = {:>5}\n", rounds );
+      std::cout << fmt::format( "[i] conflicts        = {:>5}\n", conflicts );
+    }
   }
 };
 
@@ -121,11 +157,39 @@ class rewrite_impl
 {
   static constexpr uint32_t num_vars = 4u;
   static constexpr uint32_t max_window_size = 8u;
+  static constexpr uint32_t reevaluation_depth = 2u; /* fanout levels evaluated again after a commit */
   using network_cuts_t = dynamic_network_cuts<Ntk, num_vars, true, cut_enumeration_rewrite_cut>;
   using cut_manager_t = detail::dynamic_cut_enumeration_impl<Ntk, num_vars, true, cut_enumeration_rewrite_cut>;
   using cut_t = typename network_cuts_t::cut_t;
   using node_data = typename Ntk::storage::element_type::node_type;
 
+  /* per-thread state of the parallel evaluation */
+  struct worker_state
+  {
+    std::vector<uint32_t> fanout;         /* fanout sizes with the MFFC dereferenced */
+    std::vector<uint32_t> fanout_visited; /* evaluation in which `fanout` was initialized */
+    std::vector<uint64_t> db_value;       /* signals in `ntk` matching database nodes */
+    std::vector<uint32_t> db_visited;     /* evaluation in which a database node was visited */
+    std::vector<node<Ntk>> mffc;          /* MFFC of the current cut */
+    std::vector<node<Ntk>> reused;        /* existing nodes reused by the current structure */
+    uint32_t trav_id{ 0 };
+    uint32_t db_trav_id{ 0 };
+    uint32_t candidates{ 0 };
+  };
+
+  /* best replacement of a node found by the parallel evaluation */
+  struct candidate
+  {
+    node<Ntk> root;
+    int32_t gain{ -1 };
+    uint32_t level{ UINT32_MAX };
+    signal<Ntk> structure;
+    std::array<signal<Ntk>, num_vars> leaves;
+    bool phase{ false };
+    std::vector<node<Ntk>> window; /* MFFC followed by cut leaves and reused nodes */
+    uint32_t mffc_size{ 0 };       /* number of MFFC nodes in `window` */
+  };
+
 public:
   rewrite_impl( Ntk& ntk, Library&& library, rewrite_params const& ps, rewrite_stats& st, NodeCostFn const& cost_fn )
       : ntk( ntk ), library( library ), ps( ps ), st( st ), cost_fn( cost_fn ), required( ntk, UINT32_MAX )
@@ -146,6 +210,7 @@ public:
   void run()
   {
     stopwatch t( st.time_total );
+    MOCKTURTLE_TRACE_SCOPE( "rewrite" );
 
     ntk.incr_trav_id();
 
@@ -156,6 +221,8 @@ public:
 
     if ( ps.use_dont_cares )
       perform_rewriting_dc();
+    else if ( ps.num_threads != 1u && !ps.preserve_depth )
+      perform_rewriting_parallel();
     else
       perform_rewriting();
 
@@ -559,6 +626,417 @@ private:
     } );
   }
 
+  void perform_rewriting_parallel()
+  {
+    /* initialize the cut manager */
+    cut_enumeration_stats cst;
+    network_cuts_t cuts( ntk.size() + ( ntk.size() >> 1 ) );
+    cut_manager_t cut_manager( ntk, ps.cut_enumeration_ps, cst, cuts );
+
+    /* initialize cuts for constant nodes and PIs */
+    cut_manager.init_cuts();
+
+    auto& db = library.get_database();
+
+    thread_pool pool( ps.num_threads );
+    std::vector<worker_state> states( pool.num_threads() );
+    for ( auto& state : states )
+    {
+      state.db_value.resize( db.size() );
+      state.db_visited.resize( db.size(), 0u );
+    }
+
+    /* as in the sequential pass, nodes created by rewriting are not rewritten */
+    const auto size = ntk.size();
+    std::vector<node<Ntk>> pending;
+    ntk.foreach_gate( [&]( auto const& n ) {
+      pending.push_back( n );
+    } );
+
+    std::vector<candidate> candidates;
+    std::vector<uint32_t> order;
+    std::vector<uint32_t> mffc_marks;
+    std::vector<uint32_t> used_marks;
+
+    while ( !pending.empty() )
+    {
+      ++st.rounds;
+
+      {
+        stopwatch t( st.time_evaluation );
+
+        /* cut enumeration updates a shared database */
+        for ( auto const& n : pending )
+        {
+          if ( ntk.fanout_size( n ) == 0u )
+            continue;
+
+          cut_manager.clear_cuts( n );
+          cut_manager.compute_cuts( n );
+        }
+
+        for ( auto& state : states )
+        {
+          state.fanout.resize( ntk.size() );
+          state.fanout_visited.resize( ntk.size(), 0u );
+        }
+
+        candidates.resize( pending.size() );
+        pool.parallel_for(
+            0u, pending.size(), [&]( uint64_t i, uint32_t thread_id ) {
+              evaluate_candidate( cuts, pending[i], states[thread_id], candidates[i] );
+            },
+            4u );
+      }
+
+      stopwatch t( st.time_commit );
+
+      /* windows may contain nodes created in previous rounds */
+      mffc_marks.resize( ntk.size(), 0u );
+      used_marks.resize( ntk.size(), 0u );
+
+      /* commit in order of decreasing gain (ties broken by node index) */
+      order.clear();
+      for ( auto i = 0u; i < candidates.size(); ++i )
+      {
+        if ( candidates[i].gain > 0 || ( ps.allow_zero_gain && candidates[i].gain == 0 ) )
+          order.push_back( i );
+      }
+      std::stable_sort( order.begin(), order.end(), [&]( auto a, auto b ) {
+        return candidates[a].gain > candidates[b].gain;
+      } );
+
+      std::vector<node<Ntk>> next;
+      for ( auto i : order )
+      {
+        auto const& cand = candidates[i];
+
+        /* the MFFC is removed and the leaves and reused nodes gain fanouts */
+        auto const mffc_end = cand.window.begin() + cand.mffc_size;
+        bool const overlaps = std::any_of( cand.window.begin(), mffc_end, [&]( auto const& g ) {
+                                return mffc_marks[ntk.node_to_index( g )] == st.rounds || used_marks[ntk.node_to_index( g )] == st.rounds;
+                              } ) ||
+                              std::any_of( mffc_end, cand.window.end(), [&]( auto const& g ) {
+                                return mffc_marks[ntk.node_to_index( g )] == st.rounds;
+                              } );
+        if ( overlaps )
+        {
+          ++st.conflicts;
+          next.push_back( cand.root );
+          continue;
+        }
+
+        std::for_each( cand.window.begin(), mffc_end, [&]( auto const& g ) {
+          mffc_marks[ntk.node_to_index( g )] = st.rounds;
+        } );
+        std::for_each( mffc_end, cand.window.end(), [&]( auto const& g ) {
+          used_marks[ntk.node_to_index( g )] = st.rounds;
+        } );
+
+        /* replace node wth the new structure */
+        topo_view topo{ db, cand.structure };
+        auto new_f = cleanup_dangling( topo, ntk, cand.leaves.begin(), cand.leaves.end() ).front();
+
+        if ( cand.root == ntk.get_node( new_f ) )
+          continue;
+
+        _estimated_gain += cand.gain;
+        ntk.substitute_node_no_restrash( cand.root, new_f ^ cand.phase );
+
+        clear_cuts_fanout_rec( cuts, cut_manager, ntk.get_node( new_f ) );
+        collect_fanout_rec( ntk.get_node( new_f ), size, reevaluation_depth, next );
+      }
+
+      std::sort( next.begin(), next.end() );
+      next.erase( std::unique( next.begin(), next.end() ), next.end() );
+      pending.swap( next );
+    }
+
+    for ( auto const& state : states )
+    {
+      _candidates += state.candidates;
+    }
+  }
+
+  void collect_fanout_rec( node<Ntk> const& n, uint32_t size, uint32_t depth, std::vector<node<Ntk>>& nodes )
+  {
+    if ( depth == 0 )
+      return;
+
+    ntk.foreach_fanout( n, [&]( auto const& g ) {
+      if ( ntk.node_to_index( g ) < size )
+        nodes.push_back( g );
+      collect_fanout_rec( g, size, depth - 1, nodes );
+    } );
+  }
+
+  void evaluate_candidate( network_cuts_t const& cuts, node<Ntk> const& n, worker_state& state, candidate& best )
+  {
+    auto& db = library.get_database();
+
+    std::array<signal<Ntk>, num_vars> leaves;
+    std::array<uint8_t, num_vars> permutation;
+
+    best.root = n;
+    best.gain = -1;
+    best.level = UINT32_MAX;
+    best.window.clear();
+
+    if ( ntk.fanout_size( n ) == 0u )
+      return;
+
+    for ( auto& cut : cuts.cuts( ntk.node_to_index( n ) ) )
+    {
+      /* skip trivial cut */
+      if ( ( cut->size() == 1 && *cut->begin() == ntk.node_to_index( n ) ) )
+        continue;
+
+      /* Boolean matching */
+      auto config = kitty::exact_npn_canonization( cuts.truth_table( *cut ) );
+      auto tt_npn = std::get<0>( config );
+      auto neg = std::get<1>( config );
+      auto perm = std::get<2>( config );
+
+      auto const structures = library.get_supergates( tt_npn );
+
+      if ( structures == nullptr )
+        continue;
+
+      uint32_t negation = 0;
+      for ( auto j = 0u; j < num_vars; ++j )
+      {
+        permutation[perm[j]] = j;
+        negation |= ( ( neg >> perm[j] ) & 1 ) << j;
+      }
+
+      /* save output negation to apply */
+      bool phase = ( neg >> num_vars == 1 ) ? true : false;
+
+      {
+        auto j = 0u;
+        for ( auto const leaf : *cut )
+        {
+          leaves[permutation[j++]] = ntk.make_signal( ntk.index_to_node( leaf ) );
+        }
+
+        while ( j < num_vars )
+          leaves[permutation[j++]] = ntk.get_constant( false );
+      }
+
+      for ( auto j = 0u; j < num_vars; ++j )
+      {
+        if ( ( negation >> j ) & 1 )
+        {
+          leaves[j] = !leaves[j];
+        }
+      }
+
+      /* measure the MFFC contained in the cut */
+      int32_t mffc_size = measure_mffc_local( n, cut, state );
+
+      for ( auto const& dag : *structures )
+      {
+        state.reused.clear();
+        auto [nodes_added, level] = evaluate_entry_local( n, db.get_node( dag.root ), leaves, state );
+        int32_t gain = mffc_size - nodes_added;
+
+        /* discard if dag.root and n are the same */
+        if ( state.db_visited[db.node_to_index( db.get_node( dag.root ) )] == state.db_trav_id &&
+             ntk.node_to_index( n ) == state.db_value[db.node_to_index( db.get_node( dag.root ) )] >> 1 )
+          continue;
+
+        /* discard if no gain */
+        if ( gain < 0 || ( !ps.allow_zero_gain && gain == 0 ) )
+          continue;
+
+        if ( ( gain > best.gain ) || ( gain == best.gain && level < best.level ) )
+        {
+          ++state.candidates;
+          best.gain = gain;
+          best.structure = dag.root;
+          best.leaves = leaves;
+          best.phase = phase;
+          best.level = level;
+
+          best.window = state.mffc;
+          best.mffc_size = static_cast<uint32_t>( state.mffc.size() );
+          for ( auto const leaf : *cut )
+          {
+            best.window.push_back( ntk.index_to_node( leaf ) );
+          }
+          best.window.insert( best.window.end(), state.reused.begin(), state.reused.end() );
+        }
+
+        if ( !ps.allow_multiple_structures )
+          break;
+      }
+
+      if ( cut->size() == 0 || ( cut->size() == 1 && *cut->begin() != ntk.node_to_index( n ) ) )
+        break;
+    }
+  }
+
+  /* fanout size of a node after dereferencing the MFFC of the current cut */
+  uint32_t& local_fanout_size( node<Ntk> const& n, worker_state& state )
+  {
+    auto const index = ntk.node_to_index( n );
+    if ( state.fanout_visited[index] != state.trav_id )
+    {
+      state.fanout_visited[index] = state.trav_id;
+      state.fanout[index] = ntk.fanout_size( n );
+    }
+    return state.fanout[index];
+  }
+
+  int32_t measure_mffc_local( node<Ntk> const& n, cut_t const* cut, worker_state& state )
+  {
+    /* the network is not modified: dereferenced fanout sizes are stored in the worker state */
+    ++state.trav_id;
+    state.mffc.clear();
+
+    /* reference cut leaves */
+    for ( auto leaf : *cut )
+    {
+      ++local_fanout_size( ntk.index_to_node( leaf ), state );
+    }
+
+    return static_cast<int32_t>( recursive_deref_local( n, state ) );
+  }
+
+  uint32_t recursive_deref_local( node<Ntk> const& n, worker_state& state )
+  {
+    /* terminate? */
+    if ( ntk.is_constant( n ) || ntk.is_pi( n ) )
+      return 0;
+
+    /* recursively collect nodes */
+    state.mffc.push_back( n );
+    uint32_t value{ cost_fn( ntk, n ) };
+    ntk.foreach_fanin( n, [&]( auto const& s ) {
+      if ( --local_fanout_size( ntk.get_node( s ), state ) == 0 )
+      {
+        value += recursive_deref_local( ntk.get_node( s ), state );
+      }
+    } );
+    return value;
+  }
+
+  inline std::pair<int32_t, uint32_t> evaluate_entry_local( node<Ntk> const& current_root, node<Ntk> const& n, std::array<signal<Ntk>, num_vars> const& leaves, worker_state& state )
+  {
+    ++state.db_trav_id;
+    return evaluate_entry_local_rec( current_root, n, leaves, state );
+  }
+
+  /* same as `evaluate_entry_rec`, but without modifying the database and the network */
+  std::pair<int32_t, uint32_t> evaluate_entry_local_rec( node<Ntk> const& current_root, node<Ntk> const& n, std::array<signal<Ntk>, num_vars> const& leaves, worker_state& state )
+  {
+    auto& db = library.get_database();
+    if ( db.is_pi( n ) || db.is_constant( n ) )
+      return { 0, 0 };
+    if ( state.db_visited[db.node_to_index( n )] == state.db_trav_id )
+      return { 0, 0 };
+
+    state.db_visited[db.node_to_index( n )] = state.db_trav_id;
+
+    int32_t area = 0;
+    uint32_t level = 0;
+    bool hashed = true;
+
+    std::array<signal<Ntk>, Ntk::max_fanin_size> node_data;
+    db.foreach_fanin( n, [&]( auto const& f, auto i ) {
+      node<Ntk> g = db.get_node( f );
+      if ( db.is_constant( g ) )
+      {
+        node_data[i] = f;
+        return;
+      }
+      if ( db.is_pi( g ) )
+      {
+        node_data[i] = leaves[db.node_to_index( g ) - 1] ^ db.is_complemented( f );
+        if constexpr ( has_level_v<Ntk> )
+        {
+          level = std::max( level, ntk.level( ntk.get_node( leaves[db.node_to_index( g ) - 1] ) ) );
+        }
+        return;
+      }
+
+      auto [area_rec, level_rec] = evaluate_entry_local_rec( current_root, g, leaves, state );
+      area += area_rec;
+      level = std::max( level, level_rec );
+
+      /* check value */
+      if ( state.db_value[db.node_to_index( g )] != UINT64_MAX )
+      {
+        signal<Ntk> s;
+        s.data = state.db_value[db.node_to_index( g )];
+        node_data[i] = s ^ db.is_complemented( f );
+      }
+      else
+      {
+        hashed = false;
+      }
+    } );
+
+    if ( hashed )
+    {
+      std::optional<signal<Ntk>> val;
+      do
+      {
+        /* XAG */
+        if constexpr ( has_has_and_v<Ntk> && has_has_xor_v<Ntk> )
+        {
+          if ( db.is_and( n ) )
+            val = ntk.has_and( node_data[0], node_data[1] );
+          else
+            val = ntk.has_xor( node_data[0], node_data[1] );
+          break;
+        }
+
+        /* AIG */
+        if constexpr ( has_has_and_v<Ntk> )
+        {
+          val = ntk.has_and( node_data[0], node_data[1] );
+          break;
+        }
+
+        /* XMG */
+        if constexpr ( has_has_maj_v<Ntk> && has_has_xor3_v<Ntk> )
+        {
+          if ( db.is_maj( n ) )
+            val = ntk.has_maj( node_data[0], node_data[1], node_data[2] );
+          else
+            val = ntk.has_xor3( node_data[0], node_data[1], node_data[2] );
+          break;
+        }
+
+        /* MAJ */
+        if constexpr ( has_has_maj_v<Ntk> )
+        {
+          val = ntk.has_maj( node_data[0], node_data[1], node_data[2] );
+          break;
+        }
+      } while ( false );
+
+      if ( val.has_value() )
+      {
+        auto const g = ntk.get_node( *val );
+
+        /* bad condition (current root is contained in the DAG): return a very high cost */
+        if ( g == current_root )
+          return { UINT32_MAX / 2, level + 1 };
+
+        /* annotate hashing info */
+        state.db_value[db.node_to_index( n )] = val->data;
+        if ( !ntk.is_constant( g ) && !ntk.is_pi( g ) )
+          state.reused.push_back( g );
+        return { area + ( local_fanout_size( g, state ) > 0 ? 0 : cost_fn( ntk, n ) ), level + 1 };
+      }
+    }
+
+    state.db_value[db.node_to_index( n )] = UINT64_MAX;
+    return { area + cost_fn( ntk, n ), level + 1 };
+  }
+
   int32_t measure_mffc_ref( node<Ntk> const& n, cut_t const* cut )
   {
     /* reference cut leaves */
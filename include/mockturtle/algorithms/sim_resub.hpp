@@ -39,6 +39,7 @@
 #include "../networks/mig.hpp"
 #include "../utils/progress_bar.hpp"
 #include "../utils/stopwatch.hpp"
+#include "../utils/thread_pool.hpp"
 #include "circuit_validator.hpp"
 #include "pattern_generation.hpp"
 #include "resubstitution.hpp"
@@ -145,6 +146,12 @@ struct sim_resub_stats
  *
  * All classes implemented in `algorithms/resyn_engines/` are compatible.
  *
+ * Without ODCs, the engine supports batched validation: `propose` computes a
+ * candidate for each node of a batch, `validate_candidates` validates them
+ * concurrently with a pool of `num_validation_threads` validators, and the
+ * counter-examples are added to the simulation patterns in the order of the
+ * candidates with `found_candidate_cex`.
+ *
  * \tparam validator_t Specialization of `circuit_validator`.
  * \tparam ResynEngine A resynthesis solver to compute the resubstitution candidate.
  * \tparam MffcRes Typename of `potential_gain`.
@@ -154,21 +161,31 @@ class simulation_based_resub_engine
 {
 public:
   static constexpr bool require_leaves_and_mffc = false;
+  static constexpr bool supports_batch_validation = !validator_t::use_odc_ && !has_EXODC_interface_v<Ntk>;
   using stats = sim_resub_stats<typename ResynEngine::stats>;
   using mffc_result_t = MffcRes;
+  using index_list_t = typename ResynEngine::index_list_t;
 
   using node = typename Ntk::node;
   using signal = typename Ntk::signal;
   using TT = kitty::partial_truth_table;
 
   explicit simulation_based_resub_engine( Ntk& ntk, resubstitution_params const& ps, stats& st )
-      : ntk( ntk ), ps( ps ), st( st ), tts( ntk ), validator( ntk, { ps.max_clauses, ps.odc_levels, ps.conflict_limit, ps.random_seed } ), engine( st.resyn_st )
+      : ntk( ntk ), ps( ps ), st( st ), tts( ntk ), pool( ps.num_simulation_threads ), validator( ntk, { ps.max_clauses, ps.odc_levels, ps.conflict_limit, ps.random_seed } ), engine( st.resyn_st )
   {
     if constexpr ( !validator_t::use_odc_ )
     {
       assert( ps.odc_levels == 0 && "to consider ODCs, circuit_validator::use_odc (the last template parameter) has to be turned on" );
     }
 
+    if constexpr ( supports_batch_validation )
+    {
+      if ( ps.num_validation_threads != 1u )
+      {
+        validators.emplace( ntk, validator_params{ ps.max_clauses, ps.odc_levels, ps.conflict_limit, ps.random_seed }, ps.num_validation_threads );
+      }
+    }
+
     add_event = ntk.events().register_add_event( [&]( const auto& n ) {
       tts.resize();
       call_with_stopwatch( st.time_sim, [&]() {
@@ -190,6 +207,12 @@ public:
     {
       ntk.events().release_add_event( add_event );
     }
+
+    if ( validators )
+    {
+      st.num_cex += validators->num_cex();
+      st.num_timeout += validators->num_timeout();
+    }
   }
 
   void init()
@@ -216,7 +239,7 @@ public:
 
     /* first simulation: the whole circuit; from 0 bits. */
     call_with_stopwatch( st.time_sim, [&]() {
-      simulate_nodes<Ntk>( ntk, tts, sim, true );
+      simulate_nodes<Ntk>( ntk, tts, sim, true, pool );
     } );
   }
 
@@ -229,7 +252,7 @@ public:
       } );
       tts.reset();
       call_with_stopwatch( st.time_sim, [&]() {
-        simulate_nodes<Ntk>( ntk, tts, sim, true );
+        simulate_nodes<Ntk>( ntk, tts, sim, true, pool );
       } );
     }
   }
@@ -238,20 +261,7 @@ public:
   {
     for ( auto j = 0u; j < ps.max_trials; ++j )
     {
-      check_tts( n );
-      for ( auto const& d : divs )
-      {
-        check_tts( d );
-      }
-
-      TT const care = call_with_stopwatch( st.time_odc, [&]() {
-        return ( ps.odc_levels == 0 ) ? sim.compute_constant( true ) : ~observability_dont_cares( ntk, n, sim, tts, ps.odc_levels );
-      } );
-
-      const auto res = call_with_stopwatch( st.time_resyn, [&]() {
-        ++st.num_resyn;
-        return engine( tts[n], care, std::begin( divs ), std::end( divs ), tts, std::min( potential_gain - 1, ps.max_inserts ) );
-      } );
+      const auto res = resynthesize( n, divs, potential_gain );
 
       if ( res )
       {
@@ -265,18 +275,7 @@ public:
         {
           if ( *valid )
           {
-            ++st.num_resub;
-            signal out_sig;
-            call_with_stopwatch( st.time_interface, [&]() {
-              std::vector<signal> divs_sig( divs.size() );
-              std::transform( divs.begin(), divs.end(), divs_sig.begin(), [&]( const node n ) {
-                return ntk.make_signal( n );
-              } );
-              insert( ntk, divs_sig.begin(), divs_sig.end(), id_list, [&]( signal const& s ) {
-                out_sig = s;
-              } );
-            } );
-            return out_sig;
+            return insert_candidate( divs, id_list );
           }
           else
           {
@@ -297,11 +296,66 @@ public:
     return std::nullopt;
   }
 
+  /*! \brief Computes a candidate for `n` and queues it for `validate_candidates`.
+   *
+   * Returns whether a candidate was found.
+   */
+  bool propose( node const& n, std::vector<node> const& divs, mffc_result_t potential_gain, uint32_t& last_gain )
+  {
+    auto res = resynthesize( n, divs, potential_gain );
+    if ( !res )
+    {
+      return false;
+    }
+
+    last_gain = potential_gain - res->num_gates();
+    candidates.push_back( { n, divs, std::move( *res ) } );
+    return true;
+  }
+
+  /*! \brief Validates the queued candidates concurrently. */
+  std::vector<std::optional<bool>> validate_candidates()
+  {
+    return call_with_stopwatch( st.time_sat, [&]() {
+      return validators->validate( candidates.size(), [&]( auto& validator, uint32_t i ) {
+        return validator.validate( candidates[i].root, candidates[i].divs, candidates[i].id_list );
+      } );
+    } );
+  }
+
+  /*! \brief Adds the counter-example of the `i`-th queued candidate to the patterns. */
+  void found_candidate_cex( uint32_t i )
+  {
+    add_cex( validators->cex( i ) );
+  }
+
+  /*! \brief Inserts the `i`-th queued (and validated) candidate into the network. */
+  signal insert_candidate( uint32_t i )
+  {
+    return insert_candidate( candidates[i].divs, candidates[i].id_list );
+  }
+
+  void clear_candidates()
+  {
+    candidates.clear();
+  }
+
+  /*! \brief Number of candidates validated together. */
+  uint32_t batch_size() const
+  {
+    return 4u * validators->num_threads();
+  }
+
   void found_cex()
   {
     ++st.num_cex;
+    add_cex( validator.cex );
+  }
+
+  void add_cex( std::vector<bool> const& pattern )
+  {
     call_with_stopwatch( st.time_sim, [&]() {
-      sim.add_pattern( validator.cex );
+      sim.add_pattern( pattern );
     } );
 
     /* re-simulate the whole circuit (for the last block) when a block is full */
@@ -323,6 +377,48 @@ public:
     }
   }
 
+private:
+  std::optional<index_list_t> resynthesize( node const& n, std::vector<node> const& divs, mffc_result_t potential_gain )
+  {
+    check_tts( n );
+    for ( auto const& d : divs )
+    {
+      check_tts( d );
+    }
+
+    TT const care = call_with_stopwatch( st.time_odc, [&]() {
+      return ( ps.odc_levels == 0 ) ? sim.compute_constant( true ) : ~observability_dont_cares( ntk, n, sim, tts, ps.odc_levels );
+    } );
+
+    return call_with_stopwatch( st.time_resyn, [&]() {
+      ++st.num_resyn;
+      return engine( tts[n], care, std::begin( divs ), std::end( divs ), tts, std::min( potential_gain - 1, ps.max_inserts ) );
+    } );
+  }
+
+  signal insert_candidate( std::vector<node> const& divs, index_list_t const& id_list )
+  {
+    ++st.num_resub;
+    signal out_sig;
+    call_with_stopwatch( st.time_interface, [&]() {
+      std::vector<signal> divs_sig( divs.size() );
+      std::transform( divs.begin(), divs.end(), divs_sig.begin(), [&]( const node n ) {
+        return ntk.make_signal( n );
+      } );
+      insert( ntk, divs_sig.begin(), divs_sig.end(), id_list, [&]( signal const& s ) {
+        out_sig = s;
+      } );
+    } );
+    return out_sig;
+  }
+
+  struct candidate
+  {
+    node root;
+    std::vector<node> divs;
+    index_list_t id_list;
+  };
+
 private:
   Ntk& ntk;
   resubstitution_params const& ps;
@@ -330,10 +426,15 @@ private:
 
   incomplete_node_map<TT, Ntk> tts;
   partial_simulator sim;
+  thread_pool pool;
 
   validator_t validator;
   ResynEngine engine;
 
+  /* batched validation */
+  std::optional<validator_pool<validator_t>> validators;
+  std::vector<candidate> candidates;
+
   /* events */
   std::shared_ptr<typename network_events<Ntk>::add_event_type> add_event;
 }; /* simulation_based_resub_engine */
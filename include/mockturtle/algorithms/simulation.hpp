@@ -35,6 +35,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <fstream>
 #include <random>
@@ -42,6 +43,8 @@
 
 #include "../traits.hpp"
 #include "../utils/node_map.hpp"
+#include "../utils/thread_pool.hpp"
+#include "../utils/word_operations.hpp"
 
 #include <kitty/bit_operations.hpp>
 #include <kitty/constructors.hpp>
@@ -863,6 +866,261 @@ void simulate_nodes( Ntk const& ntk, Container& node_to_value, Simulator const&
   }
 }
 
+/*! \cond PRIVATE */
+namespace detail
+{
+
+enum class simulation_gate_type : uint8_t
+{
+  and2,
+  xor2,
+  maj3,
+  xor3,
+  generic
+};
+
+template<class Ntk, class Container>
+class block_simulation_impl
+{
+public:
+  using node = typename Ntk::node;
+
+  explicit block_simulation_impl( Ntk const& ntk, Container& node_to_value, uint32_t num_bits, thread_pool& pool )
+      : ntk( ntk ), node_to_value( node_to_value ), num_bits( num_bits ), num_words( ( num_bits + 63u ) >> 6 ), pool( pool )
+  {
+  }
+
+  void run()
+  {
+    collect_gates();
+    if ( gates.empty() )
+    {
+      return;
+    }
+    prepare_gates();
+
+    /* blocks of words, several blocks per thread for load balancing */
+    uint64_t const block_words = std::max<uint64_t>( 8u, ( num_words + 4u * pool.num_threads() - 1u ) / ( 4u * pool.num_threads() ) );
+    uint64_t const num_blocks = ( num_words + block_words - 1u ) / block_words;
+    scratch.resize( pool.num_threads() );
+
+    pool.parallel_for( 0u, num_blocks, [&]( uint64_t block, uint32_t thread_id ) {
+      auto const begin = block * block_words;
+      simulate_block( begin, std::min( begin + block_words, num_words ), thread_id );
+    } );
+  }
+
+private:
+  /* gates without (complete) simulation values in topological order */
+  void collect_gates()
+  {
+    std::vector<uint8_t> visited( ntk.size(), 0u );
+    std::vector<std::pair<node, bool>> stack;
+
+    auto const needs_value = [&]( node const& n ) {
+      return !node_to_value.has( n ) || node_to_value[n].num_bits() != num_bits;
+    };
+
+    ntk.foreach_gate( [&]( auto const& root ) {
+      if ( visited[ntk.node_to_index( root )] || !needs_value( root ) )
+      {
+        return;
+      }
+
+      stack.emplace_back( root, false );
+      while ( !stack.empty() )
+      {
+        auto const [n, expanded] = stack.back();
+        stack.pop_back();
+
+        auto const index = ntk.node_to_index( n );
+        if ( expanded )
+        {
+          gates.push_back( n );
+          continue;
+        }
+        if ( visited[index] )
+        {
+          continue;
+        }
+        visited[index] = 1u;
+
+        stack.emplace_back( n, true );
+        ntk.foreach_fanin( n, [&]( auto const& f ) {
+          auto const child = ntk.get_node( f );
+          if ( !ntk.is_constant( child ) && !ntk.is_ci( child ) && !visited[ntk.node_to_index( child )] && needs_value( child ) )
+          {
+            stack.emplace_back( child, false );
+          }
+        } );
+      }
+    } );
+  }
+
+  void prepare_gates()
+  {
+    for ( auto const& n : gates )
+    {
+      node_to_value[n].resize( num_bits );
+    }
+
+    offsets.reserve( gates.size() + 1u );
+    types.reserve( gates.size() );
+    outputs.reserve( gates.size() );
+    for ( auto const& n : gates )
+    {
+      offsets.push_back( static_cast<uint32_t>( fanins.size() ) );
+      types.push_back( gate_type( n ) );
+      outputs.push_back( node_to_value[n]._bits.data() );
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        fanins.push_back( node_to_value[ntk.get_node( f )]._bits.data() );
+        complements.push_back( ntk.is_complemented( f ) ? ~UINT64_C( 0 ) : UINT64_C( 0 ) );
+      } );
+    }
+    offsets.push_back( static_cast<uint32_t>( fanins.size() ) );
+  }
+
+  simulation_gate_type gate_type( node const& n ) const
+  {
+    if constexpr ( Ntk::max_fanin_size <= 3 )
+    {
+      auto const size = ntk.fanin_size( n );
+      if constexpr ( has_is_and_v<Ntk> )
+      {
+        if ( size == 2 && ntk.is_and( n ) )
+          return simulation_gate_type::and2;
+      }
+      if constexpr ( has_is_xor_v<Ntk> )
+      {
+        if ( size == 2 && ntk.is_xor( n ) )
+          return simulation_gate_type::xor2;
+      }
+      if constexpr ( has_is_maj_v<Ntk> )
+      {
+        if ( size == 3 && ntk.is_maj( n ) )
+          return simulation_gate_type::maj3;
+      }
+      if constexpr ( has_is_xor3_v<Ntk> )
+      {
+        if ( size == 3 && ntk.is_xor3( n ) )
+          return simulation_gate_type::xor3;
+      }
+    }
+    (void)n;
+    return simulation_gate_type::generic;
+  }
+
+  void simulate_block( uint64_t begin, uint64_t end, uint32_t thread_id )
+  {
+    auto const length = end - begin;
+    bool const last = end == num_words;
+    uint64_t const mask = ( num_bits & 63u ) ? ( ( UINT64_C( 1 ) << ( num_bits & 63u ) ) - 1u ) : ~UINT64_C( 0 );
+
+    for ( auto i = 0u; i < gates.size(); ++i )
+    {
+      auto const* in = fanins.data() + offsets[i];
+      auto const* cs = complements.data() + offsets[i];
+      auto* out = outputs[i] + begin;
+
+      switch ( types[i] )
+      {
+      case simulation_gate_type::and2:
+        and_words( out, in[0] + begin, cs[0], in[1] + begin, cs[1], length );
+        break;
+      case simulation_gate_type::xor2:
+        xor_words( out, in[0] + begin, cs[0], in[1] + begin, cs[1], length );
+        break;
+      case simulation_gate_type::maj3:
+        maj_words( out, in[0] + begin, cs[0], in[1] + begin, cs[1], in[2] + begin, cs[2], length );
+        break;
+      case simulation_gate_type::xor3:
+        xor3_words( out, in[0] + begin, cs[0], in[1] + begin, cs[1], in[2] + begin, cs[2], length );
+        break;
+      case simulation_gate_type::generic:
+        simulate_generic( i, begin, end, thread_id );
+        break;
+      }
+
+      if ( last )
+      {
+        outputs[i][num_words - 1u] &= mask;
+      }
+    }
+  }
+
+  /* slices the fanin values of the block and calls `compute` */
+  void simulate_generic( uint32_t i, uint64_t begin, uint64_t end, uint32_t thread_id )
+  {
+    auto const block_bits = static_cast<uint32_t>( std::min<uint64_t>( end * 64u, num_bits ) - begin * 64u );
+    auto& values = scratch[thread_id];
+    values.resize( offsets[i + 1] - offsets[i] );
+    for ( auto j = 0u; j < values.size(); ++j )
+    {
+      values[j].resize( block_bits );
+      std::copy( fanins[offsets[i] + j] + begin, fanins[offsets[i] + j] + end, values[j]._bits.begin() );
+    }
+
+    auto const result = ntk.compute( gates[i], values.begin(), values.end() );
+    std::copy( result._bits.begin(), result._bits.end(), outputs[i] + begin );
+  }
+
+private:
+  Ntk const& ntk;
+  Container& node_to_value;
+  uint32_t num_bits;
+  uint64_t num_words;
+  thread_pool& pool;
+
+  std::vector<node> gates;
+  std::vector<simulation_gate_type> types;
+  std::vector<uint32_t> offsets;
+  std::vector<uint64_t*> outputs;
+  std::vector<uint64_t const*> fanins;
+  std::vector<uint64_t> complements;
+  std::vector<std::vector<kitty::partial_truth_table>> scratch;
+};
+
+} // namespace detail
+/*! \endcond */
+
+/*! \brief Simulates a network with `partial_simulator` (or `bit_packed_simulator`) on a thread pool.
+ *
+ * This function computes the same simulation values as `simulate_nodes`
+ * without the thread pool, but splits the simulation patterns into blocks of
+ * 64-bit words which are simulated by the threads of `pool`.  Gates of AIGs,
+ * XAGs, MIGs, and XMGs are simulated with word-level kernels (see
+ * `word_operations.hpp`); other gates use `compute` on slices of the
+ * simulation values.
+ *
+ * \param simulate_whole_tt When this parameter is true, it is assumed that `node_to_value.has( n )` is false for every node.
+ * In contrast, when this parameter is false, only the last block of `partial_truth_table` will be re-computed
+ * (sequentially, if the network implements the in-place `compute`), and it is assumed that `node_to_value.has( n )`
+ * is true for every node.
+ * \param pool Thread pool used to simulate the blocks
+ */
+template<class Ntk, class Simulator = partial_simulator, class Container = unordered_node_map<kitty::partial_truth_table, Ntk>>
+void simulate_nodes( Ntk const& ntk, Container& node_to_value, Simulator const& sim, bool simulate_whole_tt, thread_pool& pool )
+{
+  static_assert( has_is_complemented_v<Ntk>, "Ntk does not implement the is_complemented method" );
+  static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+
+  static_assert( !is_crossed_network_type_v<Ntk>, "Crossed networks are not supported" );
+
+  /* re-simulating only the last block is cheaper, but requires the in-place `compute` */
+  if constexpr ( has_compute_inplace_v<Ntk, kitty::partial_truth_table> )
+  {
+    if ( !simulate_whole_tt )
+    {
+      simulate_nodes<Ntk, Simulator, Container>( ntk, node_to_value, sim, simulate_whole_tt );
+      return;
+    }
+  }
+
+  detail::update_const_pi( ntk, node_to_value, sim );
+  detail::block_simulation_impl<Ntk, Container> p( ntk, node_to_value, sim.num_bits(), pool );
+  p.run();
+}
+
 /*! \brief Simulates a network with a generic simulator.
  *
  * This is a generic simulation algorithm that can simulate arbitrary values.
@@ -39,6 +39,7 @@
 #include "../utils/network_utils.hpp"
 #include "../utils/node_map.hpp"
 #include "../utils/stopwatch.hpp"
+#include "../utils/trace.hpp"
 #include "../utils/window_utils.hpp"
 #include "../views/color_view.hpp"
 #include "../views/depth_view.hpp"
@@ -271,6 +272,7 @@ public:
   void run()
   {
     stopwatch t( st.time_total );
+    MOCKTURTLE_TRACE_SCOPE( "window_rewriting" );
 
     if constexpr ( std::is_same_v<TT, kitty::dynamic_truth_table> )
     {
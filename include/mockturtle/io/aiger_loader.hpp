@@ -0,0 +1,687 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2023  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file aiger_loader.hpp
+  \brief Fast loader for binary AIGER files
+
+  Unlike `aiger_reader`, which receives one callback from lorina per gate,
+  the loader maps the file into memory, decodes the delta-encoded AND
+  section in bulk (optionally with several threads), and then creates the
+  gates in one pass with pre-sized node and hash tables.
+
+  A description of the binary AIGER format is available at [1].
+
+  [1] http://fmv.jku.at/aiger/
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "../networks/aig.hpp"
+#include "../networks/sequential.hpp"
+#include "../traits.hpp"
+#include "../utils/mapped_file.hpp"
+#include "../utils/stopwatch.hpp"
+#include "../utils/thread_pool.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Parameters for load_aiger.
+ *
+ * The data structure `load_aiger_params` holds configurable parameters
+ * with default arguments for `load_aiger`.
+ */
+struct load_aiger_params
+{
+  /*! \brief Look up each gate in the structural hash table.
+   *
+   * If the file is known to be structurally hashed (e.g., it has been
+   * written by mockturtle or ABC), turning this off appends the gates of
+   * an AIG directly to the node array and inserts them into the hash
+   * table.  This only applies when loading into an empty `aig_network`
+   * (or a network derived from it) and when the file has no trivial gates
+   * (constant fanins or two fanins on the same variable) and no
+   * structurally equal gates; otherwise all gates are created with
+   * `create_and`.
+   */
+  bool strash{ true };
+
+  /*! \brief Read the names of inputs, outputs, and latches. */
+  bool read_names{ true };
+
+  /*! \brief Number of threads to decode the AND section (0 uses all hardware threads). */
+  uint32_t num_threads{ 1u };
+
+  /*! \brief Be verbose. */
+  bool verbose{ false };
+};
+
+/*! \brief Statistics for load_aiger. */
+struct load_aiger_stats
+{
+  /*! \brief Total runtime. */
+  stopwatch<>::duration time_total{ 0 };
+
+  /*! \brief Time to decode the AND section. */
+  stopwatch<>::duration time_decode{ 0 };
+
+  /*! \brief Time to create the network. */
+  stopwatch<>::duration time_construct{ 0 };
+
+  /*! \brief Number of AND gates in the file. */
+  uint64_t num_ands{ 0u };
+
+  /*! \brief Whether the gates were appended without structural hashing. */
+  bool direct{ false };
+
+  void report() const
+  {
+    // clang-format off
+    std::cout << fmt::format( "[i] #ANDs       = {:>10d}{}\n", num_ands, direct ? " (not hashed)" : "" );
+    std::cout << fmt::format( "[i] decoding    = {:>10.2f} secs\n", to_seconds( time_decode ) );
+    std::cout << fmt::format( "[i] construct   = {:>10.2f} secs\n", to_seconds( time_construct ) );
+    std::cout << fmt::format( "[i] total       = {:>10.2f} secs\n", to_seconds( time_total ) );
+    // clang-format on
+  }
+};
+
+namespace detail
+{
+
+template<class Ntk>
+class aiger_loader_impl
+{
+public:
+  using signal = typename Ntk::signal;
+
+  aiger_loader_impl( char const* data, std::size_t size, Ntk& ntk, load_aiger_params const& ps, load_aiger_stats& st )
+      : _data( data ), _size( size ), _ntk( ntk ), _ps( ps ), _st( st )
+  {
+  }
+
+  bool run()
+  {
+    stopwatch t( _st.time_total );
+
+    if ( !read_header() || !read_latches_and_outputs() )
+    {
+      return false;
+    }
+
+    if ( !call_with_stopwatch( _st.time_decode, [&]() { return decode_ands(); } ) )
+    {
+      return false;
+    }
+
+    call_with_stopwatch( _st.time_construct, [&]() { construct(); } );
+
+    if ( _ps.read_names )
+    {
+      read_symbols();
+    }
+    return true;
+  }
+
+private:
+  bool read_header()
+  {
+    if ( _size < 4u || std::string( _data, 4u ) != "aig " )
+    {
+      return false;
+    }
+    _pos = 4u;
+
+    uint64_t header[9] = { 0u };
+    uint32_t num_fields{ 0u };
+    while ( num_fields < 9u && read_number( header[num_fields] ) )
+    {
+      ++num_fields;
+    }
+    if ( num_fields < 5u || !read_newline() )
+    {
+      return false;
+    }
+
+    /* bad state, invariant constraint, justice, and fairness sections are not supported */
+    if ( header[5] != 0u || header[6] != 0u || header[7] != 0u || header[8] != 0u )
+    {
+      return false;
+    }
+
+    _num_vars = header[0];
+    _num_inputs = header[1];
+    _num_latches = header[2];
+    _num_outputs = header[3];
+    _num_ands = header[4];
+    _st.num_ands = _num_ands;
+
+    if ( _num_vars != _num_inputs + _num_latches + _num_ands || _num_vars >= ( UINT64_C( 1 ) << 31 ) )
+    {
+      return false;
+    }
+
+    if constexpr ( !has_create_ri_v<Ntk> || !has_create_ro_v<Ntk> )
+    {
+      if ( _num_latches != 0u )
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool read_latches_and_outputs()
+  {
+    uint64_t const max_literal = 2u * _num_vars + 1u;
+
+    _latches.reserve( _num_latches );
+    for ( auto i = 0u; i < _num_latches; ++i )
+    {
+      uint64_t next, init;
+      int8_t reset{ 0 };
+      if ( !read_number( next ) || next > max_literal )
+      {
+        return false;
+      }
+      if ( read_number( init ) )
+      {
+        /* the initial value is 0, 1, or the literal of the latch itself for an unknown value */
+        uint64_t const self = 2u * ( _num_inputs + 1u + i );
+        if ( init != 0u && init != 1u && init != self )
+        {
+          return false;
+        }
+        reset = init == self ? -1 : static_cast<int8_t>( init );
+      }
+      if ( !read_newline() )
+      {
+        return false;
+      }
+      _latches.emplace_back( static_cast<uint32_t>( next ), reset );
+    }
+
+    _outputs.reserve( _num_outputs );
+    for ( auto i = 0u; i < _num_outputs; ++i )
+    {
+      uint64_t lit;
+      if ( !read_number( lit ) || lit > max_literal || !read_newline() )
+      {
+        return false;
+      }
+      _outputs.push_back( static_cast<uint32_t>( lit ) );
+    }
+    return true;
+  }
+
+  /* decodes the AND section into the fanin literals of each gate */
+  bool decode_ands()
+  {
+    uint64_t const num_deltas = 2u * _num_ands;
+    _literals.resize( num_deltas );
+
+    /* each delta has at most 5 bytes */
+    uint64_t const begin = _pos;
+    uint64_t const end = std::min<uint64_t>( _size, begin + 5u * num_deltas );
+
+    uint32_t num_threads = _ps.num_threads;
+    std::unique_ptr<thread_pool> pool;
+    if ( num_threads != 1u )
+    {
+      pool = std::make_unique<thread_pool>( num_threads );
+      num_threads = pool->num_threads();
+    }
+
+    /* split the section into chunks, and count the deltas ending in each chunk (every byte without the continuation bit ends one) */
+    uint64_t const min_chunk_size = 1u << 16u;
+    uint64_t const num_chunks = pool ? std::max<uint64_t>( 1u, std::min<uint64_t>( 8u * num_threads, ( end - begin ) / min_chunk_size ) ) : 1u;
+    std::vector<uint64_t> bounds( num_chunks + 1u );
+    for ( auto k = 0u; k <= num_chunks; ++k )
+    {
+      bounds[k] = begin + ( end - begin ) * k / num_chunks;
+    }
+
+    std::vector<uint64_t> first_delta( num_chunks + 1u, 0u );
+    if ( num_chunks == 1u )
+    {
+      first_delta[1u] = num_deltas;
+    }
+    else
+    {
+      pool->parallel_for( 0u, num_chunks, [&]( uint64_t k, uint32_t ) {
+        first_delta[k + 1u] = std::count_if( _data + bounds[k], _data + bounds[k + 1u], []( char c ) {
+          return ( static_cast<uint8_t>( c ) & 0x80 ) == 0u;
+        } );
+      } );
+      for ( auto k = 0u; k < num_chunks; ++k )
+      {
+        first_delta[k + 1u] = std::min( num_deltas, first_delta[k] + first_delta[k + 1u] );
+      }
+    }
+    if ( first_delta[num_chunks] != num_deltas )
+    {
+      return false;
+    }
+
+    /* decode the deltas ending in each chunk; the first one may start in the previous chunk */
+    std::vector<uint8_t> chunk_error( num_chunks, 0u );
+    uint64_t section_end{ begin };
+    auto const decode_chunk = [&]( uint64_t k, uint32_t ) {
+      auto p = bounds[k];
+      while ( p > begin && ( static_cast<uint8_t>( _data[p - 1u] ) & 0x80 ) != 0u )
+      {
+        --p;
+      }
+      for ( auto j = first_delta[k]; j < first_delta[k + 1u]; ++j )
+      {
+        uint64_t value{ 0u };
+        for ( uint32_t shift = 0u;; shift += 7u )
+        {
+          if ( p == end || shift > 28u )
+          {
+            chunk_error[k] = 1u;
+            return;
+          }
+          auto const byte = static_cast<uint8_t>( _data[p++] );
+          value |= static_cast<uint64_t>( byte & 0x7f ) << shift;
+          if ( ( byte & 0x80 ) == 0u )
+          {
+            break;
+          }
+        }
+        _literals[j] = static_cast<uint32_t>( value );
+      }
+      if ( first_delta[k + 1u] == num_deltas && first_delta[k] < num_deltas )
+      {
+        section_end = p;
+      }
+    };
+
+    /* turn the deltas into literals, and check whether the gates are in the normal form of structural hashing */
+    std::vector<uint8_t> thread_error( num_threads, 0u );
+    std::vector<uint8_t> thread_trivial( num_threads, 0u );
+    uint64_t const first_and = _num_inputs + _num_latches + 1u;
+    auto const decode_gate = [&]( uint64_t i, uint32_t thread_id ) {
+      uint64_t const lhs = 2u * ( first_and + i );
+      uint64_t const delta0 = _literals[2u * i];
+      uint64_t const delta1 = _literals[2u * i + 1u];
+      if ( delta0 == 0u || delta0 > lhs || delta1 > lhs - delta0 )
+      {
+        thread_error[thread_id] = 1u;
+        return;
+      }
+
+      auto const rhs0 = static_cast<uint32_t>( lhs - delta0 );
+      auto const rhs1 = static_cast<uint32_t>( rhs0 - delta1 );
+      _literals[2u * i] = rhs0;
+      _literals[2u * i + 1u] = rhs1;
+      if ( ( rhs1 >> 1 ) == 0u || ( rhs1 >> 1 ) == ( rhs0 >> 1 ) )
+      {
+        thread_trivial[thread_id] = 1u;
+      }
+    };
+
+    if ( pool )
+    {
+      pool->parallel_for( 0u, num_chunks, decode_chunk );
+      pool->parallel_for( 0u, _num_ands, decode_gate, min_chunk_size );
+    }
+    else
+    {
+      decode_chunk( 0u, 0u );
+      for ( auto i = 0u; i < _num_ands; ++i )
+      {
+        decode_gate( i, 0u );
+      }
+    }
+
+    if ( std::any_of( chunk_error.begin(), chunk_error.end(), []( auto e ) { return e != 0u; } ) ||
+         std::any_of( thread_error.begin(), thread_error.end(), []( auto e ) { return e != 0u; } ) )
+    {
+      return false;
+    }
+    _has_trivial_gates = std::any_of( thread_trivial.begin(), thread_trivial.end(), []( auto e ) { return e != 0u; } );
+    _pos = _num_ands == 0u ? begin : section_end;
+    return true;
+  }
+
+  /* removes the gates added in direct mode, the network contained only `num_vars` nodes before */
+  void undo_direct( uint64_t num_vars )
+  {
+    auto& storage = *_ntk._storage;
+    for ( auto n = num_vars; n < storage.nodes.size(); ++n )
+    {
+      for ( auto const& child : storage.nodes[n].children )
+      {
+        storage.nodes[child.index].data[0].h1--;
+      }
+    }
+    storage.nodes.resize( num_vars );
+    storage.hash.clear();
+    _direct = false;
+    _st.direct = false;
+  }
+
+  void construct()
+  {
+    _signals.reserve( _num_inputs + _num_latches + 1u );
+    _signals.push_back( _ntk.get_constant( false ) );
+    for ( auto i = 0u; i < _num_inputs; ++i )
+    {
+      _signals.push_back( _ntk.create_pi() );
+    }
+    if constexpr ( has_create_ro_v<Ntk> )
+    {
+      for ( auto i = 0u; i < _num_latches; ++i )
+      {
+        _signals.push_back( _ntk.create_ro() );
+      }
+    }
+
+    if constexpr ( std::is_base_of_v<aig_network, Ntk> )
+    {
+      /* in an empty AIG, the node index of each variable equals its index in the file */
+      _direct = !_ps.strash && !_has_trivial_gates && _ntk.size() == _signals.size() && _ntk._events->on_add.empty();
+      _st.direct = _direct;
+
+      /* create_and grows the node array and rehashes when it is filled to 90% */
+      auto& storage = *_ntk._storage;
+      storage.nodes.reserve( static_cast<uint64_t>( ( storage.nodes.size() + _num_ands ) / 0.9 ) + 1u );
+      storage.hash.reserve( storage.hash.size() + _num_ands );
+
+      if ( _direct )
+      {
+        auto const num_vars = storage.nodes.size();
+        for ( auto i = 0u; i < _num_ands; ++i )
+        {
+          auto const rhs0 = _literals[2u * i];
+          auto const rhs1 = _literals[2u * i + 1u];
+
+          aig_storage::node_type node;
+          node.children[0] = aig_network::signal( rhs1 >> 1, rhs1 & 1 );
+          node.children[1] = aig_network::signal( rhs0 >> 1, rhs0 & 1 );
+
+          /* structurally equal gates are merged by create_and, which changes the node indices */
+          if ( storage.hash.find( node ) != storage.hash.end() )
+          {
+            undo_direct( num_vars );
+            break;
+          }
+
+          auto const index = storage.nodes.size();
+          storage.nodes.push_back( node );
+          storage.hash.insert_unique( node, index );
+
+          storage.nodes[rhs1 >> 1].data[0].h1++;
+          storage.nodes[rhs0 >> 1].data[0].h1++;
+        }
+      }
+    }
+
+    if ( !_direct )
+    {
+      _signals.reserve( _signals.size() + _num_ands );
+      for ( auto i = 0u; i < _num_ands; ++i )
+      {
+        auto const a = literal_to_signal( _literals[2u * i] );
+        auto const b = literal_to_signal( _literals[2u * i + 1u] );
+        _signals.push_back( _ntk.create_and( a, b ) );
+      }
+    }
+    _literals.clear();
+    _literals.shrink_to_fit();
+
+    for ( auto const lit : _outputs )
+    {
+      _ntk.create_po( literal_to_signal( lit ) );
+    }
+
+    if constexpr ( has_create_ri_v<Ntk> )
+    {
+      for ( auto i = 0u; i < _latches.size(); ++i )
+      {
+        _ntk.create_ri( literal_to_signal( _latches[i].first ) );
+        register_t reg;
+        reg.init = _latches[i].second;
+        _ntk.set_register( i, reg );
+      }
+    }
+  }
+
+  void read_symbols()
+  {
+    while ( _pos < _size && ( _data[_pos] == 'i' || _data[_pos] == 'o' || _data[_pos] == 'l' ) )
+    {
+      auto const type = _data[_pos++];
+      uint64_t index;
+      if ( !read_number( index ) || _pos == _size || _data[_pos] != ' ' )
+      {
+        return;
+      }
+      auto const first = ++_pos;
+      while ( _pos < _size && _data[_pos] != '\n' )
+      {
+        ++_pos;
+      }
+      std::string const name( _data + first, _pos - first );
+      if ( _pos < _size )
+      {
+        ++_pos;
+      }
+
+      if ( type == 'i' && index < _num_inputs )
+      {
+        if constexpr ( has_set_name_v<Ntk> )
+        {
+          _ntk.set_name( _signals[1u + index], name );
+        }
+      }
+      else if ( type == 'o' && index < _num_outputs )
+      {
+        if constexpr ( has_set_output_name_v<Ntk> )
+        {
+          _ntk.set_output_name( static_cast<uint32_t>( index ), name );
+        }
+      }
+      else if ( type == 'l' && index < _num_latches )
+      {
+        if constexpr ( has_set_name_v<Ntk> )
+        {
+          _ntk.set_name( _signals[1u + _num_inputs + index], name );
+          _ntk.set_name( literal_to_signal( _latches[index].first ), name + "_next" );
+        }
+      }
+    }
+  }
+
+  signal literal_to_signal( uint32_t lit ) const
+  {
+    auto const s = _direct ? _ntk.make_signal( _ntk.index_to_node( lit >> 1 ) ) : _signals[lit >> 1];
+    return ( lit & 1 ) ? _ntk.create_not( s ) : s;
+  }
+
+  /* reads an unsigned number after optional spaces */
+  bool read_number( uint64_t& value )
+  {
+    auto p = _pos;
+    while ( p < _size && _data[p] == ' ' )
+    {
+      ++p;
+    }
+    if ( p == _size || _data[p] < '0' || _data[p] > '9' )
+    {
+      return false;
+    }
+
+    value = 0u;
+    while ( p < _size && _data[p] >= '0' && _data[p] <= '9' )
+    {
+      value = 10u * value + static_cast<uint64_t>( _data[p++] - '0' );
+    }
+    _pos = p;
+    return true;
+  }
+
+  bool read_newline()
+  {
+    while ( _pos < _size && ( _data[_pos] == ' ' || _data[_pos] == '\r' ) )
+    {
+      ++_pos;
+    }
+    if ( _pos == _size || _data[_pos] != '\n' )
+    {
+      return false;
+    }
+    ++_pos;
+    return true;
+  }
+
+private:
+  char const* _data;
+  std::size_t _size;
+  Ntk& _ntk;
+  load_aiger_params const& _ps;
+  load_aiger_stats& _st;
+
+  uint64_t _pos{ 0u };
+  uint64_t _num_vars{ 0u };
+  uint64_t _num_inputs{ 0u };
+  uint64_t _num_latches{ 0u };
+  uint64_t _num_outputs{ 0u };
+  uint64_t _num_ands{ 0u };
+
+  std::vector<std::pair<uint32_t, int8_t>> _latches;
+  std::vector<uint32_t> _outputs;
+  std::vector<uint32_t> _literals;
+  std::vector<signal> _signals;
+  bool _has_trivial_gates{ false };
+  bool _direct{ false };
+};
+
+} // namespace detail
+
+/*! \brief Loads a binary AIGER file from memory.
+ *
+ * \param data Content of the file
+ * \param size Size of the content in bytes
+ * \param ntk Network to which the inputs, gates, and outputs are added
+ * \param ps Parameters
+ * \param pst Statistics
+ * \return Whether the content is a valid binary AIGER file
+ */
+template<class Ntk>
+bool load_aiger( char const* data, std::size_t size, Ntk& ntk, load_aiger_params const& ps = {}, load_aiger_stats* pst = nullptr )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_create_pi_v<Ntk>, "Ntk does not implement the create_pi function" );
+  static_assert( has_create_po_v<Ntk>, "Ntk does not implement the create_po function" );
+  static_assert( has_get_constant_v<Ntk>, "Ntk does not implement the get_constant function" );
+  static_assert( has_create_not_v<Ntk>, "Ntk does not implement the create_not function" );
+  static_assert( has_create_and_v<Ntk>, "Ntk does not implement the create_and function" );
+  static_assert( has_make_signal_v<Ntk>, "Ntk does not implement the make_signal function" );
+  static_assert( has_index_to_node_v<Ntk>, "Ntk does not implement the index_to_node function" );
+
+  load_aiger_stats st;
+  detail::aiger_loader_impl<Ntk> p( data, size, ntk, ps, st );
+  auto const success = p.run();
+
+  if ( ps.verbose )
+  {
+    st.report();
+  }
+  if ( pst )
+  {
+    *pst = st;
+  }
+  return success;
+}
+
+/*! \brief Loads a binary AIGER file.
+ *
+ * A faster alternative to reading binary AIGER files with
+ * `lorina::read_aiger` and `aiger_reader` for large files.  The file is
+ * mapped into memory, and the AND section is decoded in bulk before the
+ * gates are created.  ASCII AIGER files and the sections of AIGER 1.9
+ * (bad states, constraints, justice, and fairness properties) are not
+ * supported.
+ *
+ * **Required network functions:**
+ * - `create_pi`
+ * - `create_po`
+ * - `get_constant`
+ * - `create_not`
+ * - `create_and`
+ * - `make_signal`
+ * - `index_to_node`
+ *
+ * **Optional network functions to support sequential networks:**
+ * - `create_ri`
+ * - `create_ro`
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      aig_network aig;
+      load_aiger_params ps;
+      ps.num_threads = 4u;
+      if ( !load_aiger( "file.aig", aig, ps ) )
+      {
+        std::cerr << "[e] could not read file.aig\n";
+      }
+   \endverbatim
+ *
+ * \param filename Filename
+ * \param ntk Network to which the inputs, gates, and outputs are added
+ * \param ps Parameters
+ * \param pst Statistics
+ * \return Whether the file could be read and is a valid binary AIGER file
+ */
+template<class Ntk>
+bool load_aiger( std::string const& filename, Ntk& ntk, load_aiger_params const& ps = {}, load_aiger_stats* pst = nullptr )
+{
+  mapped_file file( filename );
+  if ( !file.is_open() )
+  {
+    return false;
+  }
+  return load_aiger( file.data(), file.size(), ntk, ps, pst );
+}
+
+} /* namespace mockturtle */
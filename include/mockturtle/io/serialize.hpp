@@ -32,16 +32,51 @@
   \author Siang-Yun (Sonia) Lee
 
   This file implements functions to serialize a (combinational)
-  `aig_network` into a file.  The serializer should be used for
-  debugging-purpose only.  It allows to store the current state of the
-  network (including dangling and dead nodes), but does not guarantee
-  platform-independence (use, e.g., `write_verilog` instead).
+  network into a binary snapshot.  A snapshot stores the current state
+  of the network storage (including dangling and dead nodes, the
+  structural hash table, and the storage data such as the truth table
+  cache of k-LUT networks) and, if the network is wrapped in the
+  corresponding views, its names and its bindings to a cell library.
+  Node arrays of fixed fan-in networks are written as raw memory, such
+  that loading them amounts to a `memcpy`.
+
+  Snapshots are versioned and checked against the storage layout when
+  loaded, but they are not platform-independent (use, e.g.,
+  `write_verilog` instead).  Files written by earlier releases, which
+  dumped the AIG storage without a header, cannot be read and are
+  rejected.
+
+  A snapshot consists of a header (`detail::snapshot_header`) followed
+  by the sections `nodes`, `inputs`, `outputs`, `hash`, `data`, and the
+  optional sections `names` and `bindings`.  All sections start at an
+  offset aligned to 8 bytes; the `hash` section and all later sections
+  are prefixed with their size in bytes, such that readers may skip them.
 */
 
 #pragma once
 
 #include "../networks/aig.hpp"
+#include "../networks/aqfp.hpp"
+#include "../networks/block.hpp"
+#include "../networks/cover.hpp"
+#include "../networks/generic.hpp"
+#include "../networks/klut.hpp"
+#include "../traits.hpp"
+#include "../utils/mapped_file.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+#include <kitty/cube.hpp>
+#include <kitty/dynamic_truth_table.hpp>
 #include <parallel_hashmap/phmap_dump.h>
 
 namespace mockturtle
@@ -50,265 +85,1215 @@ namespace mockturtle
 namespace detail
 {
 
-struct serializer
+/*! \brief Current version of the snapshot format. */
+static constexpr uint32_t snapshot_version = 1u;
+
+/*! \brief Magic number at the beginning of a snapshot. */
+static constexpr char snapshot_magic[8] = { 'M', 'T', 'S', 'N', 'A', 'P', '\0', '\0' };
+
+enum snapshot_flags : uint32_t
 {
-public:
-  using node_type = typename aig_network::storage::element_type::node_type;
-  using pointer_type = typename node_type::pointer_type;
+  snapshot_has_hash = 1u,
+  snapshot_has_names = 2u,
+  snapshot_has_bindings = 4u
+};
+
+enum snapshot_hash_kind : uint64_t
+{
+  snapshot_hash_none = 0u,
+  snapshot_hash_raw = 1u,
+  snapshot_hash_entries = 2u,
+  snapshot_hash_strash = 3u
+};
+
+struct snapshot_header
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t flags;
+
+  /*! \brief Hash of the network type and of its node layout. */
+  uint64_t type_id;
+
+  uint64_t num_nodes;
+  uint64_t num_inputs;
+  uint64_t num_outputs;
+  uint32_t trav_id;
+  uint32_t node_size;
+};
+
+template<class Storage, class = void>
+struct snapshot_storage_has_hash : std::false_type
+{
+};
+
+template<class Storage>
+struct snapshot_storage_has_hash<Storage, std::void_t<decltype( std::declval<Storage>().hash )>> : std::true_type
+{
+};
+
+template<class T>
+struct snapshot_is_vector : std::false_type
+{
+};
+
+template<class T>
+struct snapshot_is_vector<std::vector<T>> : std::true_type
+{
+};
+
+template<class Ntk>
+uint64_t snapshot_type_id()
+{
+  using storage_type = typename Ntk::storage::element_type;
+  using node_type = typename storage_type::node_type;
+
+  /* FNV-1a over the mangled name of the base network type */
+  uint64_t id = UINT64_C( 0xcbf29ce484222325 );
+  for ( char const* c = typeid( typename Ntk::base_type ).name(); *c; ++c )
+  {
+    id = ( id ^ static_cast<uint8_t>( *c ) ) * UINT64_C( 0x100000001b3 );
+  }
+  id = ( id ^ sizeof( node_type ) ) * UINT64_C( 0x100000001b3 );
+  id = ( id ^ sizeof( typename node_type::pointer_type ) ) * UINT64_C( 0x100000001b3 );
+  return id;
+}
 
+/* writes to any archive providing `dump( char const*, size_t )` and keeps track of the offset */
+template<class Archive>
+class snapshot_writer
+{
 public:
-  bool operator()( phmap::BinaryOutputArchive& os, uint64_t const& data ) const
+  explicit snapshot_writer( Archive& ar ) : ar( ar ) {}
+
+  bool dump( char const* p, size_t size )
   {
-    return os.dump( (char*)&data, sizeof( uint64_t ) );
+    offset += size;
+    return ar.dump( p, size );
   }
 
-  bool operator()( phmap::BinaryInputArchive& ar_input, uint64_t* data ) const
+  template<typename V>
+  bool dump( V const& v )
   {
-    return ar_input.load( (char*)data, sizeof( uint64_t ) );
+    static_assert( std::is_trivially_copyable_v<V>, "V is not trivially copyable" );
+    return dump( reinterpret_cast<char const*>( &v ), sizeof( V ) );
   }
 
-  template<int PointerFieldSize>
-  bool operator()( phmap::BinaryOutputArchive& os, node_pointer<PointerFieldSize> const& ptr ) const
+  template<typename V>
+  bool dump_array( V const* data, uint64_t size )
   {
-    return os.dump( (char*)&ptr.data, sizeof( ptr.data ) );
+    static_assert( std::is_trivially_copyable_v<V>, "V is not trivially copyable" );
+    return size == 0u || dump( reinterpret_cast<char const*>( data ), size * sizeof( V ) );
   }
 
-  template<int PointerFieldSize>
-  bool operator()( phmap::BinaryInputArchive& ar_input, node_pointer<PointerFieldSize>* ptr ) const
+  template<typename V>
+  bool dump_vector( std::vector<V> const& v )
   {
-    return ar_input.load( (char*)&ptr->data, sizeof( ptr->data ) );
+    return dump<uint64_t>( v.size() ) && dump_array( v.data(), v.size() );
   }
 
-  bool operator()( phmap::BinaryOutputArchive& os, cauint64_t const& data ) const
+  bool dump_string( std::string const& s )
   {
-    return os.dump( (char*)&data.n, sizeof( data.n ) );
+    return dump<uint64_t>( s.size() ) && dump( s.data(), s.size() );
+  }
+
+  bool align()
+  {
+    static constexpr char zeros[8] = {};
+    auto const padding = ( 8u - offset % 8u ) % 8u;
+    return padding == 0u || dump( zeros, padding );
+  }
+
+  uint64_t offset{ 0u };
+
+private:
+  Archive& ar;
+};
+
+/* only counts the bytes, used to prefix sections with their size */
+struct snapshot_counter
+{
+  bool dump( char const* p, size_t size )
+  {
+    (void)p;
+    (void)size;
+    return true;
   }
+};
 
-  bool operator()( phmap::BinaryInputArchive& ar_input, cauint64_t* data ) const
+template<class Archive, class = void>
+struct snapshot_archive_has_skip : std::false_type
+{
+};
+
+template<class Archive>
+struct snapshot_archive_has_skip<Archive, std::void_t<decltype( std::declval<Archive>().skip( uint64_t() ) )>> : std::true_type
+{
+};
+
+template<class Archive, class = void>
+struct snapshot_archive_has_remaining : std::false_type
+{
+};
+
+template<class Archive>
+struct snapshot_archive_has_remaining<Archive, std::void_t<decltype( std::declval<Archive>().remaining() )>> : std::true_type
+{
+};
+
+/* reads from any archive providing `load( char*, size_t )` and keeps track of the offset */
+template<class Archive>
+class snapshot_reader
+{
+public:
+  explicit snapshot_reader( Archive& ar ) : ar( ar ) {}
+
+  bool load( char* p, size_t size )
   {
-    return ar_input.load( (char*)&data->n, sizeof( data->n ) );
+    offset += size;
+    return ar.load( p, size );
   }
 
-  template<int Fanin, int Size, int PointerFieldSize>
-  bool operator()( phmap::BinaryOutputArchive& os, regular_node<Fanin, Size, PointerFieldSize> const& n ) const
+  template<typename V>
+  bool load( V* v )
   {
-    uint64_t size = n.children.size();
-    os.dump( (char*)&size, sizeof( uint64_t ) );
+    static_assert( std::is_trivially_copyable_v<V>, "V is not trivially copyable" );
+    return load( reinterpret_cast<char*>( v ), sizeof( V ) );
+  }
 
-    for ( const auto& c : n.children )
+  template<typename V>
+  bool load_array( V* data, uint64_t size )
+  {
+    static_assert( std::is_trivially_copyable_v<V>, "V is not trivially copyable" );
+    return size == 0u || load( reinterpret_cast<char*>( data ), size * sizeof( V ) );
+  }
+
+  /* reads `size` elements into a vector or string
+   *
+   * Sizes that exceed the remaining bytes are rejected before allocating.
+   * If the archive does not know its size, the container grows with the
+   * data read, such that a corrupt size fails at the end of the data. */
+  template<class Container>
+  bool load_elements( Container& v, uint64_t size )
+  {
+    using value_type = typename Container::value_type;
+    if ( !can_hold( size, sizeof( value_type ) ) )
+      return false;
+
+    if constexpr ( snapshot_archive_has_remaining<Archive>::value )
+    {
+      v.resize( size );
+      return load_array( v.data(), size );
+    }
+    else
     {
-      bool result = this->operator()( os, c );
-      if ( !result )
+      constexpr uint64_t chunk_size = std::max<uint64_t>( ( uint64_t( 1 ) << 20u ) / sizeof( value_type ), 1u );
+      v.clear();
+      while ( v.size() < size )
       {
-        return false;
+        uint64_t const begin = v.size();
+        v.resize( begin + std::min( chunk_size, size - begin ) );
+        if ( !load_array( v.data() + begin, v.size() - begin ) )
+          return false;
       }
+      return true;
     }
+  }
+
+  template<typename V>
+  bool load_vector( std::vector<V>& v )
+  {
+    uint64_t size;
+    return load( &size ) && load_elements( v, size );
+  }
 
-    size = n.data.size();
-    os.dump( (char*)&size, sizeof( uint64_t ) );
-    for ( const auto& d : n.data )
+  bool load_string( std::string& s )
+  {
+    uint64_t size;
+    return load( &size ) && load_elements( s, size );
+  }
+
+  /* number of bytes left, if the archive knows it */
+  uint64_t remaining() const
+  {
+    if constexpr ( snapshot_archive_has_remaining<Archive>::value )
     {
-      bool result = this->operator()( os, d );
-      if ( !result )
-      {
-        return false;
-      }
+      return ar.remaining();
+    }
+    else
+    {
+      return std::numeric_limits<uint64_t>::max();
     }
+  }
+
+  /* whether the remaining bytes can hold `count` elements of `element_size` bytes */
+  bool can_hold( uint64_t count, uint64_t element_size ) const
+  {
+    return count <= remaining() / element_size;
+  }
+
+  bool skip( uint64_t size )
+  {
+    if constexpr ( snapshot_archive_has_skip<Archive>::value )
+    {
+      offset += size;
+      return ar.skip( size );
+    }
+    else
+    {
+      std::vector<char> buffer( size );
+      return size == 0u || load( buffer.data(), size );
+    }
+  }
+
+  bool align()
+  {
+    return skip( ( 8u - offset % 8u ) % 8u );
+  }
+
+  uint64_t offset{ 0u };
+
+private:
+  Archive& ar;
+};
+
+/* adapters of standard streams to the archive interface of phmap */
+struct snapshot_ostream_archive
+{
+  bool dump( char const* p, size_t size )
+  {
+    os.write( p, size );
+    return os.good();
+  }
+
+  std::ostream& os;
+};
+
+struct snapshot_istream_archive
+{
+  bool load( char* p, size_t size )
+  {
+    is.read( p, size );
+    return is.good();
+  }
+
+  std::istream& is;
+};
+
+/* reads from a buffer, e.g., a memory-mapped file */
+struct snapshot_memory_archive
+{
+  bool load( char* p, size_t size )
+  {
+    if ( size > end - pos )
+      return false;
+    std::memcpy( p, data + pos, size );
+    pos += size;
+    return true;
+  }
 
+  bool skip( uint64_t size )
+  {
+    if ( size > end - pos )
+      return false;
+    pos += size;
     return true;
   }
 
-  template<int Fanin, int Size, int PointerFieldSize>
-  bool operator()( phmap::BinaryInputArchive& ar_input, const regular_node<Fanin, Size, PointerFieldSize>* n ) const
+  uint64_t remaining() const
   {
-    uint64_t size;
-    ar_input.load( (char*)&size, sizeof( uint64_t ) );
-    for ( uint64_t i = 0; i < size; ++i )
+    return end - pos;
+  }
+
+  char const* data;
+  uint64_t pos;
+  uint64_t end;
+};
+
+/* writes a section prefixed with its size */
+template<class Writer, class Fn>
+bool write_snapshot_section( Writer& w, Fn&& fn )
+{
+  snapshot_counter counter;
+  snapshot_writer<snapshot_counter> cw( counter );
+  if ( !fn( cw ) )
+    return false;
+  return w.template dump<uint64_t>( cw.offset ) && fn( w ) && w.align();
+}
+
+template<class Writer, class Node>
+bool write_snapshot_nodes( Writer& w, std::vector<Node> const& nodes )
+{
+  if constexpr ( std::is_trivially_copyable_v<Node> )
+  {
+    return w.dump_array( nodes.data(), nodes.size() );
+  }
+  else
+  {
+    /* nodes with a variable number of fanins are stored as flat arrays */
+    using pointer_type = typename Node::pointer_type;
+    std::vector<uint32_t> sizes;
+    std::vector<pointer_type> children;
+    std::vector<uint32_t> data_sizes;
+    std::vector<cauint64_t> data;
+    sizes.reserve( nodes.size() );
+    for ( auto const& n : nodes )
     {
-      pointer_type ptr;
-      bool result = this->operator()( ar_input, &ptr );
-      if ( !result )
+      sizes.push_back( static_cast<uint32_t>( n.children.size() ) );
+      children.insert( children.end(), n.children.begin(), n.children.end() );
+      if constexpr ( snapshot_is_vector<decltype( n.data )>::value )
       {
-        return false;
+        data_sizes.push_back( static_cast<uint32_t>( n.data.size() ) );
       }
-      const_cast<regular_node<Fanin, Size, PointerFieldSize>*>( n )->children[i] = ptr;
+      data.insert( data.end(), n.data.begin(), n.data.end() );
     }
 
-    ar_input.load( (char*)&size, sizeof( uint64_t ) );
-    for ( uint64_t i = 0; i < size; ++i )
+    return w.dump_vector( sizes ) && w.dump_vector( children ) && w.dump_vector( data_sizes ) && w.dump_vector( data );
+  }
+}
+
+template<class Reader, class Node>
+bool read_snapshot_nodes( Reader& r, std::vector<Node>& nodes, uint64_t num_nodes )
+{
+  if constexpr ( std::is_trivially_copyable_v<Node> )
+  {
+    return r.load_elements( nodes, num_nodes );
+  }
+  else
+  {
+    using pointer_type = typename Node::pointer_type;
+    constexpr bool has_data_sizes = snapshot_is_vector<decltype( Node::data )>::value;
+    std::vector<uint32_t> sizes;
+    std::vector<pointer_type> children;
+    std::vector<uint32_t> data_sizes;
+    std::vector<cauint64_t> data;
+    if ( !r.load_vector( sizes ) || !r.load_vector( children ) || !r.load_vector( data_sizes ) || !r.load_vector( data ) ||
+         sizes.size() != num_nodes || data_sizes.size() != ( has_data_sizes ? num_nodes : 0u ) )
     {
-      cauint64_t data;
-      bool result = this->operator()( ar_input, &data );
-      if ( !result )
-      {
+      return false;
+    }
+
+    nodes.resize( num_nodes );
+    uint64_t child = 0u, word = 0u;
+    for ( auto i = 0u; i < num_nodes; ++i )
+    {
+      auto& n = nodes[i];
+      if ( sizes[i] > children.size() - child )
         return false;
+      n.children.assign( children.begin() + child, children.begin() + child + sizes[i] );
+      child += sizes[i];
+
+      if constexpr ( has_data_sizes )
+      {
+        if ( data_sizes[i] > data.size() - word )
+          return false;
+        n.data.assign( data.begin() + word, data.begin() + word + data_sizes[i] );
+        word += data_sizes[i];
+      }
+      else
+      {
+        if ( n.data.size() > data.size() - word )
+          return false;
+        std::copy_n( data.begin() + word, n.data.size(), n.data.begin() );
+        word += n.data.size();
       }
-      const_cast<regular_node<Fanin, Size, PointerFieldSize>*>( n )->data[i] = data;
     }
+    return child == children.size() && word == data.size();
+  }
+}
 
-    return true;
+template<class Writer, class Node>
+bool write_snapshot_node( Writer& w, Node const& n )
+{
+  if constexpr ( std::is_trivially_copyable_v<Node> )
+  {
+    return w.dump( n );
   }
+  else
+  {
+    return w.dump_vector( std::vector<typename Node::pointer_type>( n.children.begin(), n.children.end() ) ) &&
+           w.dump_vector( std::vector<cauint64_t>( n.data.begin(), n.data.end() ) );
+  }
+}
 
-  bool operator()( phmap::BinaryOutputArchive& os, std::pair<const node_type, uint64_t> const& value ) const
+template<class Reader, class Node>
+bool read_snapshot_node( Reader& r, Node& n )
+{
+  if constexpr ( std::is_trivially_copyable_v<Node> )
   {
-    return this->operator()( os, value.first ) && this->operator()( os, value.second );
+    return r.load( &n );
+  }
+  else
+  {
+    std::vector<typename Node::pointer_type> children;
+    std::vector<cauint64_t> data;
+    if ( !r.load_vector( children ) || !r.load_vector( data ) )
+      return false;
+    n.children.assign( children.begin(), children.end() );
+    if constexpr ( snapshot_is_vector<decltype( n.data )>::value )
+    {
+      n.data = data;
+    }
+    else
+    {
+      if ( data.size() != n.data.size() )
+        return false;
+      std::copy( data.begin(), data.end(), n.data.begin() );
+    }
+    return true;
   }
+}
 
-  bool operator()( phmap::BinaryInputArchive& ar_input, std::pair<const node_type, uint64_t>* value ) const
+/* the hash table is dumped as raw memory if possible, and as a list of entries otherwise */
+template<class Writer, class Storage>
+bool write_snapshot_hash( Writer& w, Storage const& storage )
+{
+  if constexpr ( snapshot_storage_has_hash<Storage>::value )
   {
-    return this->operator()( ar_input, &value->first ) && this->operator()( ar_input, &value->second );
+    using value_type = typename decltype( storage.hash )::value_type;
+    if constexpr ( is_strash_table_v<std::decay_t<decltype( storage.hash )>> )
+    {
+      return w.template dump<uint64_t>( snapshot_hash_strash ) && write_snapshot_section( w, [&]( auto& sw ) {
+               return sw.dump_vector( storage.hash.slots() );
+             } );
+    }
+    else if constexpr ( std::is_trivially_copyable_v<value_type> )
+    {
+      return w.template dump<uint64_t>( snapshot_hash_raw ) && write_snapshot_section( w, [&]( auto& sw ) {
+               return storage.hash.dump( sw );
+             } );
+    }
+    else
+    {
+      return w.template dump<uint64_t>( snapshot_hash_entries ) && write_snapshot_section( w, [&]( auto& sw ) {
+               if ( !sw.template dump<uint64_t>( storage.hash.size() ) )
+                 return false;
+               for ( auto const& [key, value] : storage.hash )
+               {
+                 if ( !write_snapshot_node( sw, key ) || !sw.dump( value ) )
+                   return false;
+               }
+               return true;
+             } );
+    }
+  }
+  else
+  {
+    return w.template dump<uint64_t>( snapshot_hash_none ) && write_snapshot_section( w, []( auto& ) { return true; } );
   }
+}
+
+template<class Reader, class Storage>
+bool read_snapshot_hash( Reader& r, Storage& storage )
+{
+  uint64_t kind, size;
+  if ( !r.load( &kind ) || !r.load( &size ) )
+    return false;
 
-  bool operator()( phmap::BinaryOutputArchive& os, aig_storage const& storage ) const
+  if constexpr ( snapshot_storage_has_hash<Storage>::value )
   {
-    /* nodes */
-    uint64_t size = storage.nodes.size();
-    os.dump( (char*)&size, sizeof( uint64_t ) );
-    for ( const auto& n : storage.nodes )
+    using key_type = typename decltype( storage.hash )::key_type;
+    if constexpr ( is_strash_table_v<std::decay_t<decltype( storage.hash )>> )
     {
-      if ( !this->operator()( os, n ) )
+      std::vector<uint64_t> slots;
+      return kind == snapshot_hash_strash && r.load_vector( slots ) && storage.hash.assign_slots( std::move( slots ) ) && r.align();
+    }
+    else if ( kind == snapshot_hash_raw )
+    {
+      if constexpr ( std::is_trivially_copyable_v<typename decltype( storage.hash )::value_type> )
       {
+        return storage.hash.load( r ) && r.align();
+      }
+    }
+    else if ( kind == snapshot_hash_entries )
+    {
+      uint64_t num_entries;
+      if ( !r.load( &num_entries ) || !r.can_hold( num_entries, 3u * sizeof( uint64_t ) ) )
         return false;
+      storage.hash.clear();
+      storage.hash.reserve( num_entries );
+      for ( auto i = 0u; i < num_entries; ++i )
+      {
+        key_type key;
+        uint64_t value;
+        if ( !read_snapshot_node( r, key ) || !r.load( &value ) )
+          return false;
+        storage.hash.emplace( key, value );
       }
+      return r.align();
     }
+    return false;
+  }
+  else
+  {
+    return kind == snapshot_hash_none && r.skip( size ) && r.align();
+  }
+}
+
+template<class Writer>
+bool write_snapshot_truth_table( Writer& w, kitty::dynamic_truth_table const& tt )
+{
+  return w.template dump<uint32_t>( tt.num_vars() ) && w.dump_vector( tt._bits );
+}
 
-    /* inputs */
-    size = storage.inputs.size();
-    os.dump( (char*)&size, sizeof( uint64_t ) );
-    for ( const auto& i : storage.inputs )
+template<class Reader>
+bool read_snapshot_truth_table( Reader& r, kitty::dynamic_truth_table& tt )
+{
+  uint32_t num_vars;
+  std::vector<uint64_t> bits;
+  if ( !r.load( &num_vars ) || !r.load_vector( bits ) )
+    return false;
+
+  /* the number of variables is checked against the words read before allocating the truth table */
+  if ( num_vars >= 64u || bits.size() != ( num_vars <= 6u ? 1u : uint64_t( 1 ) << ( num_vars - 6u ) ) )
+    return false;
+  tt = kitty::dynamic_truth_table( num_vars );
+  std::copy( bits.begin(), bits.end(), tt.begin() );
+  return true;
+}
+
+template<class Writer, class Cache>
+bool write_snapshot_cache( Writer& w, Cache const& cache )
+{
+  if ( !w.template dump<uint64_t>( cache.size() ) )
+    return false;
+  for ( auto i = 0u; i < cache.size(); ++i )
+  {
+    if ( !write_snapshot_truth_table( w, cache[i << 1] ) )
+      return false;
+  }
+  return true;
+}
+
+template<class Reader, class Cache>
+bool read_snapshot_cache( Reader& r, Cache& cache )
+{
+  /* each entry has at least a number of variables and a size */
+  uint64_t size;
+  if ( !r.load( &size ) || !r.can_hold( size, sizeof( uint32_t ) + sizeof( uint64_t ) ) )
+    return false;
+
+  /* entries are normal and distinct, so inserting them in order reproduces the literals */
+  cache = Cache( static_cast<uint32_t>( size ) );
+  for ( auto i = 0u; i < size; ++i )
+  {
+    kitty::dynamic_truth_table tt;
+    if ( !read_snapshot_truth_table( r, tt ) || cache.insert( tt ) != ( i << 1 ) )
+      return false;
+  }
+  return true;
+}
+
+template<class Writer>
+bool write_snapshot_data( Writer& w, empty_storage_data const& data )
+{
+  (void)w;
+  (void)data;
+  return true;
+}
+
+template<class Reader>
+bool read_snapshot_data( Reader& r, empty_storage_data& data )
+{
+  (void)r;
+  (void)data;
+  return true;
+}
+
+template<class Writer>
+bool write_snapshot_data( Writer& w, klut_storage_data const& data )
+{
+  return write_snapshot_cache( w, data.cache );
+}
+
+template<class Reader>
+bool read_snapshot_data( Reader& r, klut_storage_data& data )
+{
+  return read_snapshot_cache( r, data.cache );
+}
+
+template<class Writer>
+bool write_snapshot_data( Writer& w, block_storage_data const& data )
+{
+  return write_snapshot_cache( w, data.cache );
+}
+
+template<class Reader>
+bool read_snapshot_data( Reader& r, block_storage_data& data )
+{
+  return read_snapshot_cache( r, data.cache );
+}
+
+template<class Writer>
+bool write_snapshot_data( Writer& w, generic_storage_data const& data )
+{
+  return write_snapshot_cache( w, data.cache ) && w.dump( data.num_pis ) && w.dump( data.num_pos ) &&
+         w.dump_vector( data.registers ) && w.dump( data.trav_id );
+}
+
+template<class Reader>
+bool read_snapshot_data( Reader& r, generic_storage_data& data )
+{
+  return read_snapshot_cache( r, data.cache ) && r.load( &data.num_pis ) && r.load( &data.num_pos ) &&
+         r.load_vector( data.registers ) && r.load( &data.trav_id );
+}
+
+template<class Writer>
+bool write_snapshot_data( Writer& w, cover_storage_data const& data )
+{
+  if ( !w.template dump<uint64_t>( data.covers.size() ) )
+    return false;
+  for ( auto const& [cubes, is_onset] : data.covers )
+  {
+    if ( !w.template dump<uint8_t>( is_onset ) || !w.template dump<uint64_t>( cubes.size() ) )
+      return false;
+    for ( auto const& c : cubes )
     {
-      if ( !this->operator()( os, i ) )
-      {
+      if ( !w.dump( c._bits ) || !w.dump( c._mask ) )
         return false;
-      }
     }
+  }
+  return true;
+}
+
+template<class Reader>
+bool read_snapshot_data( Reader& r, cover_storage_data& data )
+{
+  uint64_t size;
+  if ( !r.load( &size ) || !r.can_hold( size, sizeof( uint8_t ) + sizeof( uint64_t ) ) )
+    return false;
+  data.covers.resize( size );
+  for ( auto& [cubes, is_onset] : data.covers )
+  {
+    uint8_t onset;
+    uint64_t num_cubes;
+    if ( !r.load( &onset ) || !r.load( &num_cubes ) || !r.can_hold( num_cubes, 2u * sizeof( uint32_t ) ) )
+      return false;
+    is_onset = onset != 0u;
+    cubes.resize( num_cubes );
+    for ( auto& c : cubes )
+    {
+      uint32_t bits, mask;
+      if ( !r.load( &bits ) || !r.load( &mask ) )
+        return false;
+      c = kitty::cube( bits, mask );
+    }
+  }
+  return true;
+}
+
+template<class Writer>
+bool write_snapshot_data( Writer& w, aqfp_storage_data const& data )
+{
+  if ( !w.template dump<uint64_t>( data.node_fn_cache.size() ) )
+    return false;
+  for ( auto const& [key, tt] : data.node_fn_cache )
+  {
+    if ( !w.dump( key ) || !write_snapshot_truth_table( w, tt ) )
+      return false;
+  }
+  return true;
+}
+
+template<class Reader>
+bool read_snapshot_data( Reader& r, aqfp_storage_data& data )
+{
+  uint64_t size;
+  if ( !r.load( &size ) )
+    return false;
+  data.node_fn_cache.clear();
+  for ( auto i = 0u; i < size; ++i )
+  {
+    uint32_t key;
+    kitty::dynamic_truth_table tt;
+    if ( !r.load( &key ) || !read_snapshot_truth_table( r, tt ) )
+      return false;
+    data.node_fn_cache.emplace( key, tt );
+  }
+  return true;
+}
+
+/* names of the signals and outputs (`names_view`) */
+template<class Writer, class Ntk>
+bool write_snapshot_names( Writer& w, Ntk const& ntk )
+{
+  if ( !w.dump_string( ntk.get_network_name() ) )
+    return false;
 
-    /* outputs */
-    size = storage.outputs.size();
-    os.dump( (char*)&size, sizeof( uint64_t ) );
-    for ( const auto& o : storage.outputs )
+  std::vector<std::pair<uint64_t, std::string>> names;
+  ntk.foreach_node( [&]( auto const& n ) {
+    auto const s = ntk.make_signal( n );
+    if ( ntk.has_name( s ) )
     {
-      if ( !this->operator()( os, o ) )
+      names.emplace_back( ntk.node_to_index( n ) << 1, ntk.get_name( s ) );
+    }
+    if constexpr ( !std::is_same_v<typename Ntk::signal, typename Ntk::node> )
+    {
+      if ( ntk.has_name( !s ) )
       {
-        return false;
+        names.emplace_back( ( ntk.node_to_index( n ) << 1 ) | 1u, ntk.get_name( !s ) );
       }
     }
+  } );
 
-    /* hash */
-    if ( !const_cast<aig_storage&>( storage ).hash.dump( os ) )
-    {
+  if ( !w.template dump<uint64_t>( names.size() ) )
+    return false;
+  for ( auto const& [lit, name] : names )
+  {
+    if ( !w.dump( lit ) || !w.dump_string( name ) )
       return false;
+  }
+
+  std::vector<std::pair<uint32_t, std::string>> output_names;
+  for ( auto i = 0u; i < ntk.num_pos(); ++i )
+  {
+    if ( ntk.has_output_name( i ) )
+    {
+      output_names.emplace_back( i, ntk.get_output_name( i ) );
     }
+  }
 
-    os.dump( (char*)&storage.trav_id, sizeof( uint32_t ) );
+  if ( !w.template dump<uint64_t>( output_names.size() ) )
+    return false;
+  for ( auto const& [index, name] : output_names )
+  {
+    if ( !w.dump( index ) || !w.dump_string( name ) )
+      return false;
+  }
+  return true;
+}
 
-    return true;
+template<class Ntk, class = void>
+struct snapshot_has_clear_names : std::false_type
+{
+};
+
+template<class Ntk>
+struct snapshot_has_clear_names<Ntk, std::void_t<decltype( std::declval<Ntk>().clear_names() )>> : std::true_type
+{
+};
+
+/* names read from a snapshot, which are set once the whole snapshot is valid */
+struct snapshot_names
+{
+  std::string network_name;
+  std::vector<std::pair<uint64_t, std::string>> names;
+  std::vector<std::pair<uint32_t, std::string>> output_names;
+};
+
+template<class Reader>
+bool read_snapshot_names( Reader& r, snapshot_names& names, uint64_t num_nodes, uint64_t num_outputs )
+{
+  uint64_t size;
+  if ( !r.load_string( names.network_name ) || !r.load( &size ) )
+    return false;
+
+  for ( auto i = 0u; i < size; ++i )
+  {
+    uint64_t lit;
+    std::string name;
+    if ( !r.load( &lit ) || !r.load_string( name ) || ( lit >> 1 ) >= num_nodes )
+      return false;
+    names.names.emplace_back( lit, std::move( name ) );
   }
 
-  bool operator()( phmap::BinaryInputArchive& ar_input, aig_storage* storage ) const
+  if ( !r.load( &size ) )
+    return false;
+  for ( auto i = 0u; i < size; ++i )
   {
-    /* nodes */
-    uint64_t size;
-    ar_input.load( (char*)&size, sizeof( uint64_t ) );
-    for ( uint64_t i = 0; i < size; ++i )
+    uint32_t index;
+    std::string name;
+    if ( !r.load( &index ) || !r.load_string( name ) || index >= num_outputs )
+      return false;
+    names.output_names.emplace_back( index, std::move( name ) );
+  }
+  return true;
+}
+
+/* replaces the names of `ntk` */
+template<class Ntk>
+void set_snapshot_names( Ntk& ntk, snapshot_names const& names )
+{
+  if constexpr ( snapshot_has_clear_names<Ntk>::value )
+  {
+    ntk.clear_names();
+  }
+  ntk.set_network_name( names.network_name );
+  for ( auto const& [lit, name] : names.names )
+  {
+    auto const s = ntk.make_signal( ntk.index_to_node( lit >> 1 ) );
+    if constexpr ( !std::is_same_v<typename Ntk::signal, typename Ntk::node> )
     {
-      node_type n;
-      if ( !this->operator()( ar_input, &n ) )
-      {
-        return false;
-      }
-      storage->nodes.push_back( n );
+      ntk.set_name( ( lit & 1 ) ? !s : s, name );
+    }
+    else
+    {
+      ntk.set_name( s, name );
     }
+  }
+  for ( auto const& [index, name] : names.output_names )
+  {
+    ntk.set_output_name( index, name );
+  }
+}
 
-    /* inputs */
-    ar_input.load( (char*)&size, sizeof( uint64_t ) );
-    for ( uint64_t i = 0; i < size; ++i )
+/* bindings to the cell library (`binding_view`), checked by gate names when loading */
+template<class Writer, class Ntk>
+bool write_snapshot_bindings( Writer& w, Ntk const& ntk )
+{
+  auto const& library = ntk.get_library();
+  if ( !w.template dump<uint64_t>( library.size() ) )
+    return false;
+  for ( auto const& g : library )
+  {
+    if ( !w.dump_string( g.name ) )
+      return false;
+  }
+
+  std::vector<uint32_t> bindings( ntk.size(), std::numeric_limits<uint32_t>::max() );
+  ntk.foreach_node( [&]( auto const& n ) {
+    if ( ntk.has_binding( n ) )
     {
-      uint64_t value;
-      ar_input.load( (char*)&value, sizeof( uint64_t ) );
-      storage->inputs.push_back( value );
+      bindings[ntk.node_to_index( n )] = ntk.get_binding_index( n );
     }
+  } );
+  return w.dump_vector( bindings );
+}
+
+template<class Reader, class Library>
+bool read_snapshot_bindings( Reader& r, Library const& library, std::vector<uint32_t>& bindings, uint64_t num_nodes )
+{
+  uint64_t size;
+  if ( !r.load( &size ) || size != library.size() )
+    return false;
+  for ( auto i = 0u; i < size; ++i )
+  {
+    std::string name;
+    if ( !r.load_string( name ) || name != library[i].name )
+      return false;
+  }
 
-    /* outputs */
-    ar_input.load( (char*)&size, sizeof( uint64_t ) );
-    for ( uint64_t i = 0; i < size; ++i )
+  if ( !r.load_vector( bindings ) || bindings.size() != num_nodes )
+    return false;
+  return std::all_of( bindings.begin(), bindings.end(), [&]( auto binding ) {
+    return binding == std::numeric_limits<uint32_t>::max() || binding < library.size();
+  } );
+}
+
+/* replaces the bindings of `ntk`, whose storage has been replaced after `num_old_nodes` nodes were bound */
+template<class Ntk>
+void set_snapshot_bindings( Ntk& ntk, std::vector<uint32_t> const& bindings, uint64_t num_old_nodes )
+{
+  for ( auto i = 0u; i < num_old_nodes; ++i )
+  {
+    ntk.remove_binding( ntk.index_to_node( i ) );
+  }
+  for ( auto i = 0u; i < bindings.size(); ++i )
+  {
+    if ( bindings[i] != std::numeric_limits<uint32_t>::max() )
     {
-      pointer_type ptr;
-      if ( !this->operator()( ar_input, &ptr ) )
-      {
-        return false;
-      }
-      storage->outputs.push_back( ptr );
+      ntk.add_binding( ntk.index_to_node( i ), bindings[i] );
     }
+  }
+}
+
+template<class Ntk>
+static constexpr bool snapshot_has_names_v = has_has_name_v<Ntk> && has_get_name_v<Ntk> && has_set_name_v<Ntk> &&
+                                             has_has_output_name_v<Ntk> && has_get_output_name_v<Ntk> && has_set_output_name_v<Ntk> &&
+                                             has_get_network_name_v<Ntk> && has_set_network_name_v<Ntk>;
+
+template<class Ntk>
+static constexpr bool snapshot_has_bindings_v = has_has_binding_v<Ntk> && has_get_binding_index_v<Ntk> && has_add_binding_v<Ntk>;
+
+/* writes the snapshot with `w`, e.g., to embed it into another file; it starts and ends at an aligned offset */
+template<class Ntk, class Archive>
+bool write_snapshot( Ntk const& ntk, snapshot_writer<Archive>& w )
+{
+  auto const& storage = *ntk._storage;
+  if ( !w.align() )
+    return false;
+
+  snapshot_header header{};
+  std::copy_n( snapshot_magic, 8, header.magic );
+  header.version = snapshot_version;
+  header.flags = ( snapshot_storage_has_hash<std::decay_t<decltype( storage )>>::value ? snapshot_has_hash : 0u ) |
+                 ( snapshot_has_names_v<Ntk> ? snapshot_has_names : 0u ) |
+                 ( snapshot_has_bindings_v<Ntk> ? snapshot_has_bindings : 0u );
+  header.type_id = snapshot_type_id<Ntk>();
+  header.num_nodes = storage.nodes.size();
+  header.num_inputs = storage.inputs.size();
+  header.num_outputs = storage.outputs.size();
+  header.trav_id = storage.trav_id;
+  header.node_size = sizeof( typename std::decay_t<decltype( storage )>::node_type );
 
-    /* hash */
-    if ( !storage->hash.load( ar_input ) )
+  if ( !w.dump( header ) || !w.align() )
+    return false;
+
+  if ( !write_snapshot_nodes( w, storage.nodes ) || !w.align() ||
+       !w.dump_array( storage.inputs.data(), storage.inputs.size() ) || !w.align() ||
+       !w.dump_array( storage.outputs.data(), storage.outputs.size() ) || !w.align() )
+  {
+    return false;
+  }
+
+  if ( !write_snapshot_hash( w, storage ) )
+    return false;
+
+  if ( !write_snapshot_section( w, [&]( auto& sw ) { return write_snapshot_data( sw, storage.data ); } ) )
+    return false;
+
+  if constexpr ( snapshot_has_names_v<Ntk> )
+  {
+    if ( !write_snapshot_section( w, [&]( auto& sw ) { return write_snapshot_names( sw, ntk ); } ) )
+      return false;
+  }
+
+  if constexpr ( snapshot_has_bindings_v<Ntk> )
+  {
+    if ( !write_snapshot_section( w, [&]( auto& sw ) { return write_snapshot_bindings( sw, ntk ); } ) )
+      return false;
+  }
+
+  return w.align();
+}
+
+template<class Ntk, class Archive>
+bool write_snapshot( Ntk const& ntk, Archive& ar )
+{
+  snapshot_writer<Archive> w( ar );
+  return write_snapshot( ntk, w );
+}
+
+/* reads a snapshot with `r`, e.g., embedded into another file; if `hash_offset` is given, the hash section is skipped and its offset is stored instead */
+template<class Ntk, class Archive>
+bool read_snapshot( Ntk& ntk, snapshot_reader<Archive>& r, uint64_t* hash_offset = nullptr )
+{
+  using storage_type = typename Ntk::storage::element_type;
+
+  snapshot_header header;
+  if ( !r.align() || !r.load( &header ) || !r.align() )
+    return false;
+  if ( !std::equal( header.magic, header.magic + 8, snapshot_magic ) || header.version != snapshot_version ||
+       header.type_id != snapshot_type_id<Ntk>() || header.node_size != sizeof( typename storage_type::node_type ) )
+  {
+    return false;
+  }
+
+  auto storage = std::make_shared<storage_type>();
+  storage->trav_id = header.trav_id;
+  if ( !read_snapshot_nodes( r, storage->nodes, header.num_nodes ) || !r.align() )
+    return false;
+
+  if ( !r.load_elements( storage->inputs, header.num_inputs ) || !r.align() ||
+       !r.load_elements( storage->outputs, header.num_outputs ) || !r.align() )
+  {
+    return false;
+  }
+
+  uint64_t size;
+  if ( hash_offset != nullptr )
+  {
+    uint64_t kind;
+    *hash_offset = r.offset;
+    if ( !r.load( &kind ) || !r.load( &size ) || !r.skip( size ) || !r.align() )
+      return false;
+  }
+  else if ( !read_snapshot_hash( r, *storage ) )
+  {
+    return false;
+  }
+
+  if ( !r.load( &size ) || !read_snapshot_data( r, storage->data ) || !r.align() )
+    return false;
+
+  snapshot_names names;
+  if ( header.flags & snapshot_has_names )
+  {
+    if ( !r.load( &size ) )
+      return false;
+    if constexpr ( snapshot_has_names_v<Ntk> )
+    {
+      if ( !read_snapshot_names( r, names, header.num_nodes, header.num_outputs ) || !r.align() )
+        return false;
+    }
+    else
     {
+      if ( !r.skip( size ) || !r.align() )
+        return false;
+    }
+  }
+
+  std::vector<uint32_t> bindings;
+  if ( header.flags & snapshot_has_bindings )
+  {
+    if ( !r.load( &size ) )
       return false;
+    if constexpr ( snapshot_has_bindings_v<Ntk> )
+    {
+      if ( !read_snapshot_bindings( r, ntk.get_library(), bindings, header.num_nodes ) || !r.align() )
+        return false;
+    }
+    else
+    {
+      if ( !r.skip( size ) || !r.align() )
+        return false;
     }
+  }
 
-    ar_input.load( (char*)&storage->trav_id, sizeof( uint32_t ) );
+  /* the whole snapshot is valid, so the network can be replaced */
+  auto const num_old_nodes = ntk._storage->nodes.size();
+  *ntk._storage = std::move( *storage );
 
-    return true;
+  if constexpr ( snapshot_has_names_v<Ntk> )
+  {
+    set_snapshot_names( ntk, names );
+  }
+  if constexpr ( snapshot_has_bindings_v<Ntk> )
+  {
+    set_snapshot_bindings( ntk, bindings, num_old_nodes );
   }
-}; /* struct serializer */
+
+  return true;
+}
+
+template<class Ntk, class Archive>
+bool read_snapshot( Ntk& ntk, Archive& ar, uint64_t* hash_offset = nullptr )
+{
+  snapshot_reader<Archive> r( ar );
+  return read_snapshot( ntk, r, hash_offset );
+}
+
+/* loads the hash section at `offset` of a snapshot in memory into the storage of `ntk` */
+template<class Ntk>
+bool read_snapshot_hash_at( Ntk& ntk, char const* data, uint64_t size, uint64_t offset )
+{
+  snapshot_memory_archive ar{ data, offset, size };
+  snapshot_reader<snapshot_memory_archive> r( ar );
+  r.offset = offset;
+  return read_snapshot_hash( r, *ntk._storage );
+}
 
 } /* namespace detail */
 
-/*! \brief Serializes a combinational AIG network to a archive
+/*! \brief Serializes a combinational network to an archive
  *
- * \param aig Combinational AIG network
+ * \param ntk Network
  * \param os Output archive
  */
-inline void serialize_network( aig_network const& aig, phmap::BinaryOutputArchive& os )
+template<class Ntk>
+void serialize_network( Ntk const& ntk, phmap::BinaryOutputArchive& os )
 {
-  detail::serializer _serializer;
-  bool const okay = _serializer( os, *aig._storage );
+  bool const okay = detail::write_snapshot( ntk, os );
   (void)okay;
   assert( okay && "failed to serialize the network onto stream" );
 }
 
-/*! \brief Serializes a combinational AIG network in a file
+/*! \brief Serializes a combinational network to an output stream
  *
- * \param aig Combinational AIG network
+ * \param ntk Network
+ * \param os Output stream (opened in binary mode)
+ * \return Whether the snapshot has been written successfully
+ */
+template<class Ntk>
+bool serialize_network( Ntk const& ntk, std::ostream& os )
+{
+  detail::snapshot_ostream_archive ar{ os };
+  return detail::write_snapshot( ntk, ar );
+}
+
+/*! \brief Serializes a combinational network in a file
+ *
+ * \param ntk Network
  * \param filename Filename
  */
-inline void serialize_network( aig_network const& aig, std::string const& filename )
+template<class Ntk>
+void serialize_network( Ntk const& ntk, std::string const& filename )
 {
   phmap::BinaryOutputArchive ar_out( filename.c_str() );
-  serialize_network( aig, ar_out );
+  serialize_network( ntk, ar_out );
 }
 
-/*! \brief Deserializes a combinational AIG network from a input archive
+/*! \brief Deserializes a combinational network from an input archive
+ *
+ * The network `ntk` is overwritten by the content of the snapshot.  If
+ * `ntk` is a `names_view` or a `binding_view`, the names or the bindings
+ * are restored as well; in the latter case, the view must have been
+ * constructed with the same cell library.  If the snapshot is invalid,
+ * `ntk` is not changed.
  *
  * \param ar_input Input archive
- * \return Deserialized AIG network
+ * \param ntk Network
+ * \return Whether the snapshot is valid for the network type (files
+ *         written by releases before snapshots were versioned are not)
  */
-inline aig_network deserialize_network( phmap::BinaryInputArchive& ar_input )
+template<class Ntk>
+bool deserialize_network( phmap::BinaryInputArchive& ar_input, Ntk& ntk )
 {
-  detail::serializer _serializer;
-  auto storage = std::make_shared<aig_storage>();
-  storage->nodes.clear();
-  storage->inputs.clear();
-  storage->outputs.clear();
-  storage->hash.clear();
+  return detail::read_snapshot( ntk, ar_input );
+}
 
-  bool const okay = _serializer( ar_input, storage.get() );
+/*! \brief Deserializes a combinational network from an input stream
+ *
+ * \param is Input stream (opened in binary mode)
+ * \param ntk Network
+ * \return Whether the snapshot is valid for the network type (files
+ *         written by releases before snapshots were versioned are not)
+ */
+template<class Ntk>
+bool deserialize_network( std::istream& is, Ntk& ntk )
+{
+  detail::snapshot_istream_archive ar{ is };
+  return detail::read_snapshot( ntk, ar );
+}
+
+/*! \brief Deserializes a combinational network from a file
+ *
+ * \param filename Filename
+ * \param ntk Network
+ * \return Whether the snapshot is valid for the network type (files
+ *         written by releases before snapshots were versioned are not)
+ */
+template<class Ntk>
+bool deserialize_network( std::string const& filename, Ntk& ntk )
+{
+  mapped_file file( filename );
+  if ( !file.is_open() )
+  {
+    return false;
+  }
+
+  detail::snapshot_memory_archive ar{ file.data(), 0u, file.size() };
+  return detail::read_snapshot( ntk, ar );
+}
+
+/*! \brief Deserializes a combinational network from a input archive
+ *
+ * \param ar_input Input archive
+ * \return Deserialized network
+ */
+template<class Ntk = aig_network>
+Ntk deserialize_network( phmap::BinaryInputArchive& ar_input )
+{
+  Ntk ntk;
+  bool const okay = deserialize_network( ar_input, ntk );
   (void)okay;
   assert( okay && "failed to deserialize the network onto stream" );
-  return aig_network{ storage };
+  return ntk;
 }
 
-/*! \brief Deserializes a combinational AIG network from a file
+/*! \brief Deserializes a combinational network from a file
  *
  * \param filename Filename
- * \return Deserialized AIG network
+ * \return Deserialized network
  */
-inline aig_network deserialize_network( std::string const& filename )
+template<class Ntk = aig_network>
+Ntk deserialize_network( std::string const& filename )
 {
-  phmap::BinaryInputArchive ar_input( filename.c_str() );
-  auto aig = deserialize_network( ar_input );
-  return aig;
+  Ntk ntk;
+  bool const okay = deserialize_network( filename, ntk );
+  (void)okay;
+  assert( okay && "failed to deserialize the network from file" );
+  return ntk;
 }
 
-} /* namespace mockturtle */
\ No newline at end of file
+} /* namespace mockturtle */
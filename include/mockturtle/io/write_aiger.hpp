@@ -38,19 +38,40 @@
 #pragma once
 
 #include "../traits.hpp"
+#include "../utils/output_buffer.hpp"
+#include "../utils/thread_pool.hpp"
 
-#include <cstdio>
+#include <cassert>
 #include <fstream>
 #include <iostream>
-#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace mockturtle
 {
 
+/*! \brief Parameters for write_aiger.
+ *
+ * The data structure `write_aiger_params` holds configurable parameters
+ * with default arguments for `write_aiger`.
+ */
+struct write_aiger_params
+{
+  /*! \brief Number of threads (0 uses all hardware threads).
+   *
+   * The AND gates are encoded in parallel chunks, which are written in
+   * order, such that the file does not depend on the number of threads.
+   */
+  uint32_t num_threads{ 1u };
+};
+
 namespace detail
 {
 
-inline void encode( std::vector<unsigned char>& buffer, uint32_t lit )
+template<class Buffer>
+inline void encode( Buffer& buffer, uint32_t lit )
 {
   unsigned char ch;
   while ( lit & ~0x7f )
@@ -63,6 +84,25 @@ inline void encode( std::vector<unsigned char>& buffer, uint32_t lit )
   buffer.push_back( ch );
 }
 
+template<typename Ntk>
+inline void encode_and( Ntk const& aig, typename Ntk::node const& n, std::string& buffer )
+{
+  auto const lhs = 2 * static_cast<uint32_t>( aig.node_to_index( n ) );
+  uint32_t rhs0 = 0u, rhs1 = 0u;
+  aig.foreach_fanin( n, [&]( auto const& fi, auto i ) {
+    ( i == 0u ? rhs0 : rhs1 ) = 2 * static_cast<uint32_t>( aig.node_to_index( aig.get_node( fi ) ) ) + aig.is_complemented( fi );
+  } );
+
+  if ( rhs0 < rhs1 )
+  {
+    std::swap( rhs0, rhs1 );
+  }
+
+  assert( rhs0 < lhs );
+  encode( buffer, lhs - rhs0 );
+  encode( buffer, rhs0 - rhs1 );
+}
+
 } // namespace detail
 
 /*! \brief Writes a combinational AIG network in binary AIGER format into a file
@@ -82,9 +122,10 @@ inline void encode( std::vector<unsigned char>& buffer, uint32_t lit )
  *
  * \param aig Combinational AIG network
  * \param os Output stream
+ * \param ps Parameters
  */
 template<typename Ntk>
-inline void write_aiger( Ntk const& aig, std::ostream& os )
+inline void write_aiger( Ntk const& aig, std::ostream& os, write_aiger_params const& ps = {} )
 {
   static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
   static_assert( has_num_cis_v<Ntk>, "Ntk does not implement the num_cis method" );
@@ -100,44 +141,54 @@ inline void write_aiger( Ntk const& aig, std::ostream& os )
   using node = typename Ntk::node;
   using signal = typename Ntk::signal;
 
+  output_buffer out( os );
+
   uint32_t const M = aig.num_cis() + aig.num_gates();
 
   /* HEADER */
-  char string_buffer[1024];
-  sprintf( string_buffer, "aig %u %u %u %u %u\n", M, aig.num_pis(), /*latches*/ 0, aig.num_pos(), aig.num_gates() );
-  os.write( &string_buffer[0], sizeof( unsigned char ) * std::strlen( string_buffer ) );
+  out << "aig " << M << ' ' << aig.num_pis() << " 0 " << aig.num_pos() << ' ' << aig.num_gates() << '\n';
 
   /* POs */
   aig.foreach_po( [&]( signal const& f ) {
-    sprintf( string_buffer, "%u\n", uint32_t( 2 * aig.node_to_index( aig.get_node( f ) ) + aig.is_complemented( f ) ) );
-    os.write( &string_buffer[0], sizeof( unsigned char ) * std::strlen( string_buffer ) );
+    out << uint32_t( 2 * aig.node_to_index( aig.get_node( f ) ) + aig.is_complemented( f ) ) << '\n';
   } );
 
   /* GATES */
-  std::vector<unsigned char> buffer;
-  aig.foreach_gate( [&]( node const& n ) {
-    std::vector<uint32_t> lits;
-    lits.push_back( 2 * aig.node_to_index( n ) );
+  std::unique_ptr<thread_pool> pool;
+  if ( ps.num_threads != 1u )
+  {
+    pool = std::make_unique<thread_pool>( ps.num_threads );
+  }
 
-    aig.foreach_fanin( n, [&]( signal const& fi ) {
-      lits.push_back( 2 * aig.node_to_index( aig.get_node( fi ) ) + aig.is_complemented( fi ) );
+  if ( pool && pool->num_threads() > 1u )
+  {
+    std::vector<node> gates;
+    gates.reserve( aig.num_gates() );
+    aig.foreach_gate( [&]( node const& n ) {
+      gates.push_back( n );
     } );
 
-    if ( lits[1] > lits[2] )
-    {
-      auto const tmp = lits[1];
-      lits[1] = lits[2];
-      lits[2] = tmp;
-    }
-
-    assert( lits[2] < lits[0] );
-    detail::encode( buffer, lits[0] - lits[2] );
-    detail::encode( buffer, lits[2] - lits[1] );
-  } );
-
-  for ( const auto& b : buffer )
+    write_chunks(
+        out, gates.size(), 1u << 16u, [&]( uint64_t begin, uint64_t end, std::string& text ) {
+          for ( auto i = begin; i < end; ++i )
+          {
+            detail::encode_and( aig, gates[i], text );
+          }
+        },
+        pool.get() );
+  }
+  else
   {
-    os.put( b );
+    std::string text;
+    aig.foreach_gate( [&]( node const& n ) {
+      detail::encode_and( aig, n, text );
+      if ( text.size() >= ( 1u << 16u ) )
+      {
+        out << text;
+        text.clear();
+      }
+    } );
+    out << text;
   }
 
   /* symbol table */
@@ -147,33 +198,29 @@ inline void write_aiger( Ntk const& aig, std::ostream& os )
       if ( !aig.has_name( aig.make_signal( i ) ) )
         return;
 
-      sprintf( string_buffer, "i%u %s\n",
-               uint32_t( index ),
-               aig.get_name( aig.make_signal( i ) ).c_str() );
-      os.write( &string_buffer[0], sizeof( unsigned char ) * std::strlen( string_buffer ) );
+      out << 'i' << index << ' ' << aig.get_name( aig.make_signal( i ) ) << '\n';
     } );
   }
   if constexpr ( has_has_output_name_v<Ntk> && has_get_output_name_v<Ntk> )
   {
     aig.foreach_po( [&]( signal const& f, uint32_t index ) {
+      (void)f;
       if ( !aig.has_output_name( index ) )
         return;
 
-      sprintf( string_buffer, "o%u %s\n",
-               uint32_t( index ),
-               aig.get_output_name( index ).c_str() );
-      os.write( &string_buffer[0], sizeof( unsigned char ) * std::strlen( string_buffer ) );
+      out << 'o' << index << ' ' << aig.get_output_name( index ) << '\n';
     } );
   }
 
   /* COMMENT */
-  os.put( 'c' );
+  out.put( 'c' );
 }
 
 /*! \brief Writes a combinational AIG network in binary AIGER format into a file
  *
  * This function should be only called on "clean" aig_networks, e.g.,
- * immediately after `cleanup_dangling`.
+ * immediately after `cleanup_dangling`.  The file is compressed with
+ * gzip if its name ends with `.gz` (requires `MOCKTURTLE_ZLIB`).
  *
  * **Required network functions:**
  * - `num_cis`
@@ -187,13 +234,13 @@ inline void write_aiger( Ntk const& aig, std::ostream& os )
  *
  * \param aig Combinational AIG network
  * \param filename Filename
+ * \param ps Parameters
  */
 template<typename Ntk>
-inline void write_aiger( Ntk const& aig, std::string const& filename )
+inline void write_aiger( Ntk const& aig, std::string const& filename, write_aiger_params const& ps = {} )
 {
-  std::ofstream os( filename.c_str(), std::ofstream::out );
-  write_aiger( aig, os );
-  os.close();
+  output_file file( filename );
+  write_aiger( aig, file.stream(), ps );
 }
 
-} /* namespace mockturtle */
\ No newline at end of file
+} /* namespace mockturtle */
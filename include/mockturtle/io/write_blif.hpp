@@ -37,6 +37,8 @@
 
 #include "../networks/sequential.hpp"
 #include "../traits.hpp"
+#include "../utils/output_buffer.hpp"
+#include "../utils/thread_pool.hpp"
 #include "../views/topo_view.hpp"
 
 #include <kitty/constructors.hpp>
@@ -44,11 +46,13 @@
 #include <kitty/operations.hpp>
 #include <kitty/print.hpp>
 
-#include <fmt/format.h>
-
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_set>
+#include <vector>
 
 namespace mockturtle
 {
@@ -86,6 +90,17 @@ struct write_blif_params
     * ```
    */
   uint32_t rename_ri_using_node = 0u;
+
+  /**
+    * ## `ps.num_threads`
+    *
+    * Number of threads (0 uses all hardware threads) ( default: 1 )
+    *
+    * The `.names` blocks of the nodes are formatted in parallel chunks,
+    * which are written in topological order, such that the file does not
+    * depend on the number of threads.
+    */
+  uint32_t num_threads = 1u;
 };
 
 /*! \brief Writes network in BLIF format into output stream
@@ -124,6 +139,11 @@ void write_blif( Ntk const& ntk, std::ostream& os, write_blif_params const& ps =
   static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
   static_assert( has_node_function_v<Ntk>, "Ntk does not implement the node_function method" );
 
+  using node = typename Ntk::node;
+
+  constexpr bool has_names = has_has_name_v<Ntk> && has_get_name_v<Ntk>;
+  constexpr bool has_output_names = has_has_output_name_v<Ntk> && has_get_output_name_v<Ntk>;
+
   uint32_t num_latches{ 0 };
   if constexpr ( has_num_registers_v<Ntk> )
   {
@@ -131,274 +151,208 @@ void write_blif( Ntk const& ntk, std::ostream& os, write_blif_params const& ps =
   }
 
   topo_view topo_ntk{ ntk };
+  output_buffer out( os );
+
+  /* name of a node: its name in the view, or `pi<i>` and `new_n<i>` by default */
+  auto const append_node_name = [&]( std::string& text, node const& n ) {
+    if constexpr ( has_names )
+    {
+      auto const s = topo_ntk.make_signal( n );
+      if ( topo_ntk.has_name( s ) )
+      {
+        text += topo_ntk.get_name( s );
+        return;
+      }
+    }
+    text += topo_ntk.is_pi( n ) ? "pi" : "new_n";
+    append_number( text, n );
+  };
+  auto const node_name = [&]( node const& n ) {
+    std::string name;
+    append_node_name( name, n );
+    return name;
+  };
+
+  /* names of the POs and RIs in the order of the COs */
+  std::vector<std::string> co_names;
+  co_names.reserve( topo_ntk.num_cos() );
+  topo_ntk.foreach_co( [&]( auto const& f, auto index ) {
+    if constexpr ( has_output_names )
+    {
+      if ( topo_ntk.has_output_name( index ) )
+      {
+        co_names.push_back( topo_ntk.get_output_name( index ) );
+        return;
+      }
+    }
+
+    if ( index < topo_ntk.num_cos() - num_latches )
+    {
+      co_names.push_back( "po" + std::to_string( index ) );
+    }
+    else if ( ps.rename_ri_using_node )
+    {
+      co_names.push_back( node_name( topo_ntk.get_node( f ) ) );
+    }
+    else
+    {
+      co_names.push_back( "li" + std::to_string( index - ( topo_ntk.num_cos() - num_latches ) ) );
+    }
+  } );
+
+  /* a CO is bridged from its driver unless its name is already defined;
+     only the definitions of CO names need to be remembered */
+  std::unordered_set<std::string> const co_name_set( co_names.begin(), co_names.end() );
   std::unordered_set<std::string> defined_names;
+  std::mutex defined_names_mutex;
+  auto const define_name = [&]( std::string const& name ) {
+    if ( co_name_set.find( name ) != co_name_set.end() )
+    {
+      std::lock_guard<std::mutex> lock( defined_names_mutex );
+      defined_names.insert( name );
+    }
+  };
 
   /* write model */
-  os << ".model top\n";
+  out << ".model top\n";
 
   /* write inputs */
   if ( topo_ntk.num_pis() > 0u )
   {
-    os << ".inputs ";
+    out << ".inputs ";
     topo_ntk.foreach_ci( [&]( auto const& n, auto index ) {
       if ( ( ( index + 1 ) <= topo_ntk.num_cis() - num_latches ) )
       {
-        if constexpr ( has_has_name_v<Ntk> && has_get_name_v<Ntk> )
-        {
-          signal<Ntk> const s = topo_ntk.make_signal( topo_ntk.node_to_index( n ) );
-          std::string const input_name = topo_ntk.has_name( s ) ? topo_ntk.get_name( s ) : fmt::format( "pi{}", topo_ntk.get_node( s ) );
-          os << input_name << ' ';
-          defined_names.insert( input_name ); /* we should not have collision here */
-        }
-        else
-        {
-          std::string const input_name = fmt::format( "pi{}", topo_ntk.node_to_index( n ) );
-          os << input_name << ' ';
-          defined_names.insert( input_name ); /* we should not have collision here */
-        }
+        std::string const input_name = node_name( n );
+        out << input_name << ' ';
+        define_name( input_name ); /* we should not have collision here */
       }
     } );
-    os << "\n";
+    out << "\n";
   }
 
   /* write outputs */
   if ( topo_ntk.num_pos() > 0u )
   {
-    os << ".outputs ";
-    topo_ntk.foreach_co( [&]( auto const& f, auto index ) {
-      (void)f;
-      if ( index < topo_ntk.num_cos() - num_latches )
-      {
-        if constexpr ( has_has_output_name_v<Ntk> && has_get_output_name_v<Ntk> )
-        {
-          std::string const output_name = topo_ntk.has_output_name( index ) ? topo_ntk.get_output_name( index ) : fmt::format( "po{}", index );
-          os << output_name << ' ';
-        }
-        else
-        {
-          std::string const output_name = fmt::format( "po{}", index );
-          os << output_name << ' ';
-        }
-      }
-    } );
-    os << "\n";
+    out << ".outputs ";
+    for ( auto i = 0u; i < topo_ntk.num_cos() - num_latches; ++i )
+    {
+      out << co_names[i] << ' ';
+    }
+    out << "\n";
   }
 
   if constexpr ( has_num_registers_v<Ntk> )
   {
-    if ( num_latches > 0u )
+    for ( auto latch_idx = 0u; latch_idx < num_latches; ++latch_idx )
     {
-      uint32_t latch_idx = 0;
-      topo_ntk.foreach_co( [&]( auto const& f, auto index ) {
-        if ( index >= topo_ntk.num_cos() - num_latches )
-        {
-          os << ".latch ";
-          auto const ro_signal = topo_ntk.make_signal( topo_ntk.ro_at( latch_idx ) );
-          auto const ri_signal = topo_ntk.ri_at( latch_idx );
-          register_t latch_info = topo_ntk.register_at( latch_idx );
-          if constexpr ( has_has_name_v<Ntk> && has_get_name_v<Ntk> )
-          {
-            std::string const node_name = topo_ntk.has_name( ri_signal ) ? 
-                topo_ntk.get_name( ri_signal ) 
-              : fmt::format( "new_n{}", topo_ntk.get_node( ri_signal ) );
-            std::string const latch_name = ps.rename_ri_using_node ? 
-                node_name
-              : fmt::format( "li{}", latch_idx );
-            std::string const ri_name = topo_ntk.has_output_name( index ) ? 
-                topo_ntk.get_output_name( index ) 
-              : latch_name;
-            std::string const ro_name = topo_ntk.has_name( ro_signal ) ? topo_ntk.get_name( ro_signal ) : fmt::format( "new_n{}", topo_ntk.get_node( ro_signal ) );
-            os << fmt::format( "{} {} {} {} {}\n", ri_name, ro_name, latch_info.type, latch_info.control, latch_info.init );
-            defined_names.insert( ro_name ); /* we should not have collision here */
-          }
-          else
-          {
-            std::string const ri_name = ps.rename_ri_using_node? 
-                fmt::format( "new_n{}", topo_ntk.get_node( topo_ntk.ri_at( latch_idx ) ) )
-              : fmt::format( "li{}", latch_idx );
-            std::string const ro_name = fmt::format( "new_n{}", topo_ntk.get_node( ro_signal ) );
-            os << fmt::format( "{} {} {} {} {}\n", ri_name, ro_name, latch_info.type, latch_info.control, latch_info.init );
-            defined_names.insert( ro_name ); /* we should not have collision here */
-          }
-          latch_idx++;
-        }
-      } );
+      auto const ro_node = topo_ntk.ro_at( latch_idx );
+      register_t latch_info = topo_ntk.register_at( latch_idx );
+      std::string const ro_name = node_name( ro_node );
+
+      out << ".latch " << co_names[topo_ntk.num_cos() - num_latches + latch_idx] << ' ' << ro_name << ' ';
+      out << latch_info.type << ' ' << latch_info.control << ' ' << latch_info.init << '\n';
+      define_name( ro_name ); /* we should not have collision here */
     }
   }
 
   /* write constants */
-  os << ".names new_n0\n";
-  os << "0\n";
-  defined_names.insert( "new_n0" ); /* we should not have collision here */
+  out << ".names new_n0\n";
+  out << "0\n";
+  define_name( "new_n0" ); /* we should not have collision here */
 
   if ( topo_ntk.get_constant( false ) != topo_ntk.get_constant( true ) )
   {
-    os << ".names new_n1\n";
-    os << "1\n";
-    defined_names.insert( "new_n1" ); /* we should not have collision here */
+    out << ".names new_n1\n";
+    out << "1\n";
+    define_name( "new_n1" ); /* we should not have collision here */
   }
 
   /* write nodes */
+  std::vector<node> nodes;
+  nodes.reserve( topo_ntk.size() );
   topo_ntk.foreach_node( [&]( auto const& n ) {
-    if ( topo_ntk.is_constant( n ) || topo_ntk.is_ci( n ) )
-      return; /* continue */
+    if ( !topo_ntk.is_constant( n ) && !topo_ntk.is_ci( n ) )
+    {
+      nodes.push_back( n );
+    }
+  } );
 
+  auto const write_node = [&]( node const& n, std::string& text ) {
     /* write truth table of node */
-    auto func = topo_ntk.node_function( n );
+    auto const cubes = isop( topo_ntk.node_function( n ) );
 
-    if ( isop( func ).size() == 0 ) /* constants */
+    text += ".names ";
+    auto const name_begin = text.size();
+    if ( cubes.empty() ) /* constants */
     {
-      if constexpr ( has_has_name_v<Ntk> && has_get_name_v<Ntk> )
-      {
-        auto const s = topo_ntk.make_signal( n );
-        std::string const constant_name = topo_ntk.has_name( s ) ? topo_ntk.get_name( s ) : fmt::format( "new_n{}", topo_ntk.get_node( s ) );
-        os << fmt::format( ".names {}\n", constant_name );
-        os << "0" << '\n';
-        defined_names.insert( constant_name ); /* we should not have collision here */
-      }
-      else
-      {
-        std::string const constant_name = fmt::format( "new_n{}", n );
-        os << fmt::format( ".names {}\n", constant_name );
-        os << "0" << '\n';
-        defined_names.insert( constant_name ); /* we should not have collision here */
-      }
+      append_node_name( text, n );
+      define_name( text.substr( name_begin ) ); /* we should not have collision here */
+      text += "\n0\n";
       return;
     }
 
-    os << fmt::format( ".names " );
-
     /* write fanins of node */
     topo_ntk.foreach_fanin( n, [&]( auto const& f ) {
-      auto f_node = topo_ntk.get_node( f );
-      if constexpr ( has_has_name_v<Ntk> && has_get_name_v<Ntk> )
-      {
-        signal<Ntk> const s = topo_ntk.make_signal( f_node );
-        std::string const fanin_name = topo_ntk.has_name( s ) ? topo_ntk.get_name( s ) : topo_ntk.is_pi( f_node ) ? fmt::format( "pi{}", f_node ) : fmt::format( "new_n{}", f_node );
-        os << fanin_name << ' ';
-      }
-      else
-      {
-        std::string const fanin_name = topo_ntk.is_pi( f_node ) ? fmt::format( "pi{} ", f_node ) : fmt::format( "new_n{} ", f_node );
-        os << fanin_name;
-      }
+      append_node_name( text, topo_ntk.get_node( f ) );
+      text += ' ';
     } );
 
     /* write fanout of node */
-    if constexpr ( has_has_name_v<Ntk> && has_get_name_v<Ntk> )
+    auto const fanout_begin = text.size();
+    append_node_name( text, n );
+    if constexpr ( has_names )
     {
-      auto const s = topo_ntk.make_signal( n );
-      std::string const fanout_name = topo_ntk.has_name( s ) ? topo_ntk.get_name( s ) : fmt::format( "new_n{}", topo_ntk.get_node( s ) );
-      os << fanout_name << '\n';
-      defined_names.insert( fanout_name ); /* we should not have collision here */
-    }
-    else
-    {
-      std::string const fanout_name = fmt::format( "new_n{}", n );
-      os << fanout_name << '\n';
-      defined_names.insert( fanout_name ); /* we should not have collision here */
+      define_name( text.substr( fanout_begin ) ); /* we should not have collision here */
     }
+    /* without names, a default node name only coincides with the name of a
+       register input driven by the same node, which is not bridged anyway */
+    text += '\n';
 
-    int count = 0;
-    for ( auto cube : isop( func ) )
+    auto const num_fanins = topo_ntk.fanin_size( n );
+    for ( auto cube : cubes )
     {
       topo_ntk.foreach_fanin( n, [&]( auto const& f, auto index ) {
         if ( cube.get_mask( index ) && topo_ntk.is_complemented( f ) )
           cube.flip_bit( index );
       } );
 
-      cube.print( topo_ntk.fanin_size( n ), os );
-      os << " 1\n";
-      count++;
-    }
-  } );
-
-  auto latch_idx = 0;
-  topo_ntk.foreach_co( [&]( auto const& f, auto index ) {
-    auto f_node = topo_ntk.get_node( f );
-    auto const minterm_string = topo_ntk.is_complemented( f ) ? "0" : "1";
-
-    if ( index < topo_ntk.num_cos() - num_latches ) /* the signal f is a PO */
-    {
-      /* the default name depends on whether the signal is a PI or a regular signal */
-      std::string const node_default_name = topo_ntk.is_pi( f_node ) ? fmt::format( "pi{}", f_node ) : fmt::format( "new_n{}", f_node );
-
-      if constexpr ( has_has_name_v<Ntk> && has_get_name_v<Ntk> && has_has_output_name_v<Ntk> && has_get_output_name_v<Ntk> ) /* with name view */
-      {
-        signal<Ntk> const s = topo_ntk.make_signal( topo_ntk.get_node( f ) );
-
-        /* then we overwrite the default name if we assigned names from name_view */
-        std::string const node_name = topo_ntk.has_name( s ) ? topo_ntk.get_name( s ) : node_default_name;
-
-        /* get the default name of PO */
-        std::string default_output_name = fmt::format( "po{}", index );
-
-        /* over write the name if we have name view */
-        std::string const output_name = topo_ntk.has_output_name( index ) ? topo_ntk.get_output_name( index ) : default_output_name;
-
-        /* we need to bridge the nodes */
-        if ( node_name != output_name && defined_names.find( output_name ) == defined_names.end() )
-        {
-          os << fmt::format( ".names {} {}\n{} 1\n", node_name, output_name, minterm_string );
-          defined_names.insert( output_name );
-        }
-      }
-      else /* without name view */
+      for ( auto i = 0u; i < num_fanins; ++i )
       {
-        std::string const node_name = node_default_name;
-        std::string const output_name = fmt::format( "po{}", index );
-        if ( node_name != output_name && defined_names.find( output_name ) == defined_names.end() )
-        {
-          os << fmt::format( ".names {} {}\n{} 1\n", node_name, output_name, minterm_string );
-          defined_names.insert( output_name );
-        }
+        text += cube.get_mask( i ) ? ( cube.get_bit( i ) ? '1' : '0' ) : '-';
       }
+      text += " 1\n";
     }
-    else /* the signal f is a RI */
-    {
-      /* the default name depends on whether the signal is a PI or a regular signal */
-      std::string const node_default_name = topo_ntk.is_pi( f_node ) ? fmt::format( "pi{}", f_node ) : fmt::format( "new_n{}", f_node );
-
-      if constexpr ( has_has_name_v<Ntk> && has_get_name_v<Ntk> && has_has_output_name_v<Ntk> && has_get_output_name_v<Ntk> ) /* with name view */
-      {
-        signal<Ntk> const s = topo_ntk.make_signal( topo_ntk.get_node( f ) );
-
-        /* then we overwrite the default name if we assigned names from name_view */
-        std::string const node_name = topo_ntk.has_name( s ) ? topo_ntk.get_name( s ) : node_default_name;
+  };
 
-        /* get the default name of RI */
-        std::string default_ri_name = ps.rename_ri_using_node ? node_name : fmt::format( "li{}", latch_idx );
-
-        /* overwrite the name if we have name view */
-        std::string const ri_name = topo_ntk.has_output_name( index ) ? topo_ntk.get_output_name( index ) : default_ri_name;
+  std::unique_ptr<thread_pool> pool;
+  if ( ps.num_threads != 1u )
+  {
+    pool = std::make_unique<thread_pool>( ps.num_threads );
+  }
 
-        /* we need to bridge the nodes */
-        if ( node_name != ri_name && defined_names.find( ri_name ) == defined_names.end() )
+  write_chunks(
+      out, nodes.size(), 4096u, [&]( uint64_t begin, uint64_t end, std::string& text ) {
+        for ( auto i = begin; i < end; ++i )
         {
-          os << fmt::format( ".names {} {}\n{} 1\n", node_name, ri_name, minterm_string );
-          defined_names.insert( ri_name );
+          write_node( nodes[i], text );
         }
-      }
-      else /* without name view */
-      {
-        std::string const node_name = node_default_name;
-
-        /* get the default name of RI */
-        std::string ri_name = ps.rename_ri_using_node ? node_name : fmt::format( "li{}", latch_idx );
+      },
+      pool && pool->num_threads() > 1u ? pool.get() : nullptr );
 
-        if ( node_name != ri_name && defined_names.find( ri_name ) == defined_names.end() )
-        {
-          os << fmt::format( ".names {} {}\n{} 1\n", node_name, ri_name, minterm_string );
-          defined_names.insert( ri_name );
-        }
-      }
+  /* bridge the POs and RIs from their drivers */
+  topo_ntk.foreach_co( [&]( auto const& f, auto index ) {
+    std::string const driver_name = node_name( topo_ntk.get_node( f ) );
+    std::string const& co_name = co_names[index];
 
-      latch_idx++;
+    if ( driver_name != co_name && defined_names.insert( co_name ).second )
+    {
+      out << ".names " << driver_name << ' ' << co_name << '\n';
+      out << ( topo_ntk.is_complemented( f ) ? "0" : "1" ) << " 1\n";
     }
   } );
 
-  os << ".end\n";
-  os << std::flush;
+  out << ".end\n";
 }
 
 /*! \brief Writes network in BLIF format into a file
@@ -422,9 +376,8 @@ void write_blif( Ntk const& ntk, std::ostream& os, write_blif_params const& ps =
 template<class Ntk>
 void write_blif( Ntk const& ntk, std::string const& filename, write_blif_params const& ps = {} )
 {
-  std::ofstream os( filename.c_str(), std::ofstream::out );
-  write_blif( ntk, os, ps );
-  os.close();
+  output_file file( filename );
+  write_blif( ntk, file.stream(), ps );
 }
 
 } /* namespace mockturtle */
\ No newline at end of file
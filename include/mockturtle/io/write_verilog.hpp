@@ -37,6 +37,7 @@
 
 #include "../traits.hpp"
 #include "../utils/node_map.hpp"
+#include "../utils/output_buffer.hpp"
 #include "../utils/string_utils.hpp"
 #include "../views/binding_view.hpp"
 #include "../views/topo_view.hpp"
@@ -110,6 +111,206 @@ struct verilog_writer_signal_hash
   }
 };
 
+/*! \brief Verilog writer that formats into an output buffer.
+ *
+ * Produces the same text as `lorina::verilog_writer`, without a temporary
+ * string for each statement.
+ */
+class buffered_verilog_writer : public lorina::verilog_writer
+{
+public:
+  explicit buffered_verilog_writer( output_buffer& out )
+      : lorina::verilog_writer( out.stream() ), _out( out )
+  {
+  }
+
+  void on_module_begin( std::string const& name, std::vector<std::string> const& xs, std::vector<std::string> const& ys ) const override
+  {
+    _out << "module " << name << "( ";
+    join( xs );
+    if ( !xs.empty() && !ys.empty() )
+    {
+      _out << " , ";
+    }
+    join( ys );
+    _out << " );\n";
+  }
+
+  void on_input( std::string const& name ) const override
+  {
+    _out << "  input " << name << " ;\n";
+  }
+
+  void on_input( uint32_t width, std::string const& name ) const override
+  {
+    _out << "  input [" << ( width - 1 ) << ":0] " << name << " ;\n";
+  }
+
+  void on_input( std::vector<std::string> const& names ) const override
+  {
+    _out << "  input ";
+    join( names );
+    _out << " ;\n";
+  }
+
+  void on_input( uint32_t width, std::vector<std::string> const& names ) const override
+  {
+    _out << "  input [" << ( width - 1 ) << ":0] ";
+    join( names );
+    _out << " ;\n";
+  }
+
+  void on_output( std::string const& name ) const override
+  {
+    _out << "  output " << name << " ;\n";
+  }
+
+  void on_output( uint32_t width, std::string const& name ) const override
+  {
+    _out << "  output [" << ( width - 1 ) << ":0] " << name << " ;\n";
+  }
+
+  void on_output( std::vector<std::string> const& names ) const override
+  {
+    _out << "  output ";
+    join( names );
+    _out << " ;\n";
+  }
+
+  void on_output( uint32_t width, std::vector<std::string> const& names ) const override
+  {
+    _out << "  output [" << ( width - 1 ) << ":0] ";
+    join( names );
+    _out << " ;\n";
+  }
+
+  void on_wire( std::string const& name ) const override
+  {
+    _out << "  wire " << name << " ;\n";
+  }
+
+  void on_wire( uint32_t width, std::string const& name ) const override
+  {
+    _out << "  wire [" << ( width - 1 ) << ":0] " << name << " ;\n";
+  }
+
+  void on_wire( std::vector<std::string> const& names ) const override
+  {
+    _out << "  wire ";
+    join( names );
+    _out << " ;\n";
+  }
+
+  void on_wire( uint32_t width, std::vector<std::string> const& names ) const override
+  {
+    _out << "  wire [" << ( width - 1 ) << ":0] ";
+    join( names );
+    _out << " ;\n";
+  }
+
+  void on_module_end() const override
+  {
+    _out << "endmodule\n";
+    _out.flush();
+  }
+
+  void on_module_instantiation( std::string const& module_name, std::vector<std::string> const& params, std::string const& inst_name,
+                                std::vector<std::pair<std::string, std::string>> const& args ) const override
+  {
+    _out << "  " << module_name << ' ';
+    if ( params.size() > 0u )
+    {
+      _out << "#(";
+      join( params, ", " );
+      _out << ") ";
+    }
+
+    _out << inst_name << "( ";
+    for ( auto i = 0u; i < args.size(); ++i )
+    {
+      _out << '.' << args[i].first << " (" << args[i].second << ')';
+      if ( i + 1 < args.size() )
+        _out << ", ";
+    }
+    _out << " );\n";
+  }
+
+  void on_assign( std::string const& out, std::vector<std::pair<bool, std::string>> const& ins, std::string const& op ) const override
+  {
+    _out << "  assign " << out << " = ";
+    for ( auto i = 0u; i < ins.size(); ++i )
+    {
+      literal( ins[i] );
+      if ( i != ins.size() - 1 )
+        _out << ' ' << op << ' ';
+    }
+    _out << " ;\n";
+  }
+
+  void on_assign_maj3( std::string const& out, std::vector<std::pair<bool, std::string>> const& ins ) const override
+  {
+    assert( ins.size() == 3u );
+    _out << "  assign " << out << " = ( ";
+    literal( ins[0] );
+    _out << " & ";
+    literal( ins[1] );
+    _out << " ) | ( ";
+    literal( ins[0] );
+    _out << " & ";
+    literal( ins[2] );
+    _out << " ) | ( ";
+    literal( ins[1] );
+    _out << " & ";
+    literal( ins[2] );
+    _out << " ) ;\n";
+  }
+
+  void on_assign_mux21( std::string const& out, std::vector<std::pair<bool, std::string>> const& ins ) const override
+  {
+    assert( ins.size() == 3u );
+    _out << "  assign " << out << " = ";
+    literal( ins[0] );
+    _out << " ? ";
+    literal( ins[1] );
+    _out << " : ";
+    literal( ins[2] );
+    _out << " ;\n";
+  }
+
+  void on_assign_unknown_gate( std::string const& out ) const override
+  {
+    _out << "  assign " << out << " = unknown gate;\n";
+  }
+
+  void on_assign_po( std::string const& out, std::pair<bool, std::string> const& in ) const override
+  {
+    _out << "  assign " << out << " = ";
+    literal( in );
+    _out << " ;\n";
+  }
+
+private:
+  void join( std::vector<std::string> const& names, std::string_view separator = " , " ) const
+  {
+    for ( auto i = 0u; i < names.size(); ++i )
+    {
+      if ( i > 0u )
+        _out << separator;
+      _out << names[i];
+    }
+  }
+
+  void literal( std::pair<bool, std::string> const& lit ) const
+  {
+    if ( lit.first )
+      _out << '~';
+    _out << lit.second;
+  }
+
+private:
+  output_buffer& _out;
+};
+
 } // namespace detail
 
 struct write_verilog_params
@@ -168,7 +369,8 @@ void write_verilog( Ntk const& ntk, std::ostream& os, write_verilog_params const
 
   assert( ntk.is_combinational() && "Network has to be combinational" );
 
-  lorina::verilog_writer writer( os );
+  output_buffer out( os );
+  detail::buffered_verilog_writer writer( out );
 
   if constexpr ( is_buffered_network_type_v<Ntk> )
   {
@@ -543,7 +745,8 @@ void write_verilog_with_binding( Ntk const& ntk, std::ostream& os, write_verilog
 
   assert( ntk.is_combinational() && "Network has to be combinational" );
 
-  lorina::verilog_writer writer( os );
+  output_buffer out( os );
+  detail::buffered_verilog_writer writer( out );
 
   std::vector<std::string> xs, inputs;
   if ( ps.input_names.empty() )
@@ -840,7 +1043,8 @@ void write_verilog_with_cell( Ntk const& ntk, std::ostream& os, write_verilog_pa
 
   assert( ntk.is_combinational() && "Network has to be combinational" );
 
-  lorina::verilog_writer writer( os );
+  output_buffer out( os );
+  detail::buffered_verilog_writer writer( out );
 
   std::vector<std::string> xs, inputs;
   if ( ps.input_names.empty() )
@@ -1253,9 +1457,8 @@ void write_verilog_with_cell( Ntk const& ntk, std::ostream& os, write_verilog_pa
 template<class Ntk>
 void write_verilog( Ntk const& ntk, std::string const& filename, write_verilog_params const& ps = {} )
 {
-  std::ofstream os( filename.c_str(), std::ofstream::out );
-  write_verilog( ntk, os, ps );
-  os.close();
+  output_file file( filename );
+  write_verilog( ntk, file.stream(), ps );
 }
 
 /*! \brief Writes mapped network in structural Verilog format into a file
@@ -1280,9 +1483,8 @@ void write_verilog( Ntk const& ntk, std::string const& filename, write_verilog_p
 template<class Ntk>
 void write_verilog_with_binding( Ntk const& ntk, std::string const& filename, write_verilog_params const& ps = {} )
 {
-  std::ofstream os( filename.c_str(), std::ofstream::out );
-  write_verilog_with_binding( ntk, os, ps );
-  os.close();
+  output_file file( filename );
+  write_verilog_with_binding( ntk, file.stream(), ps );
 }
 
 /*! \brief Writes mapped network in structural Verilog format into a file
@@ -1307,9 +1509,8 @@ void write_verilog_with_binding( Ntk const& ntk, std::string const& filename, wr
 template<class Ntk>
 void write_verilog_with_cell( Ntk const& ntk, std::string const& filename, write_verilog_params const& ps = {} )
 {
-  std::ofstream os( filename.c_str(), std::ofstream::out );
-  write_verilog_with_cell( ntk, os, ps );
-  os.close();
+  output_file file( filename );
+  write_verilog_with_cell( ntk, file.stream(), ps );
 }
 
 } /* namespace mockturtle */
\ No newline at end of file
@@ -54,6 +54,7 @@
 #include "mockturtle/algorithms/balancing/sop_balancing.hpp"
 #include "mockturtle/algorithms/balancing/utils.hpp"
 #include "mockturtle/algorithms/bi_decomposition.hpp"
+#include "mockturtle/algorithms/cec.hpp"
 #include "mockturtle/algorithms/cell_window.hpp"
 #include "mockturtle/algorithms/circuit_validator.hpp"
 #include "mockturtle/algorithms/cleanup.hpp"
@@ -187,6 +188,7 @@
 #include "mockturtle/utils/include/percy.hpp"
 #include "mockturtle/utils/index_list.hpp"
 #include "mockturtle/utils/json_utils.hpp"
+#include "mockturtle/utils/mapped_file.hpp"
 #include "mockturtle/utils/mixed_radix.hpp"
 #include "mockturtle/utils/name_utils.hpp"
 #include "mockturtle/utils/network_cache.hpp"
@@ -198,12 +200,15 @@
 #include "mockturtle/utils/string_utils.hpp"
 #include "mockturtle/utils/super_utils.hpp"
 #include "mockturtle/utils/tech_library.hpp"
+#include "mockturtle/utils/thread_pool.hpp"
 #include "mockturtle/utils/truth_table_cache.hpp"
 #include "mockturtle/utils/truth_table_utils.hpp"
 #include "mockturtle/utils/window_utils.hpp"
+#include "mockturtle/utils/word_operations.hpp"
 #include "mockturtle/views/binding_view.hpp"
 #include "mockturtle/views/cnf_view.hpp"
 #include "mockturtle/views/color_view.hpp"
+#include "mockturtle/views/compact_fanout_view.hpp"
 #include "mockturtle/views/cost_view.hpp"
 #include "mockturtle/views/cut_view.hpp"
 #include "mockturtle/views/depth_view.hpp"
@@ -213,6 +218,7 @@
 #include "mockturtle/views/mapping_view.hpp"
 #include "mockturtle/views/mffc_view.hpp"
 #include "mockturtle/views/names_view.hpp"
+#include "mockturtle/views/snapshot_view.hpp"
 #include "mockturtle/views/topo_view.hpp"
 #include "mockturtle/views/window_view.hpp"
 #include "mockturtle/views/rank_view.hpp"
@@ -42,6 +42,7 @@
 
 #include "../traits.hpp"
 #include "../utils/algorithm.hpp"
+#include "../utils/trace.hpp"
 #include "detail/foreach.hpp"
 #include "events.hpp"
 #include "storage.hpp"
@@ -285,8 +286,10 @@ public:
 
     /* structural hashing */
     const auto it = _storage->hash.find( node );
+    MOCKTURTLE_TRACE_COUNT( "aig/strash_lookups", 1 );
     if ( it != _storage->hash.end() )
     {
+      MOCKTURTLE_TRACE_COUNT( "aig/strash_hits", 1 );
       assert( !is_dead( it->second ) );
       return { it->second, 0 };
     }
@@ -301,7 +304,7 @@ public:
 
     _storage->nodes.push_back( node );
 
-    _storage->hash[node] = index;
+    _storage->hash.insert_unique( node, index );
 
     /* increase ref-count to children */
     _storage->nodes[a.index].data[0].h1++;
@@ -502,10 +505,12 @@ public:
 
     // erase old node in hash table
     _storage->hash.erase( node );
+    _storage->fanout.erase( n, node );
 
     // insert updated node into hash table
     node.children[0] = child0;
     node.children[1] = child1;
+    _storage->fanout.insert( n, node );
     _storage->hash[node] = n;
 
     // update the reference counter of the new signal
@@ -556,10 +561,12 @@ public:
 
     // erase old node in hash table
     _storage->hash.erase( node );
+    _storage->fanout.erase( n, node );
 
     // insert updated node into the hash table
     node.children[0] = child0;
     node.children[1] = child1;
+    _storage->fanout.insert( n, node );
     if ( _storage->hash.find( node ) == _storage->hash.end() )
     {
       _storage->hash[node] = n;
@@ -657,6 +664,19 @@ public:
     return ( _storage->nodes[n].data[0].h1 >> 31 ) & 1;
   }
 
+  /*! \brief Enables or disables the built-in fanout index
+   *
+   * When the index is enabled (default), substitutions only visit the
+   * parents of the substituted node; the index is built on the first
+   * substitution.  Otherwise, they scan all nodes of the network.
+   * Disabling the index releases its memory.
+   */
+  void use_fanout_index( bool enable )
+  {
+    _storage->fanout.enabled = enable;
+    _storage->fanout.clear();
+  }
+
   void substitute_node( node const& old_node, signal const& new_signal )
   {
     std::unordered_map<node, signal> old_to_new;
@@ -665,7 +685,8 @@ public:
 
     while ( !to_substitute.empty() )
     {
-      const auto [_old, _curr] = to_substitute.top();
+      const auto _old = to_substitute.top().first;
+      const auto _curr = to_substitute.top().second;
       to_substitute.pop();
 
       signal _new = _curr;
@@ -685,16 +706,15 @@ public:
         revive_node( get_node( _new ) );
       }
 
-      for ( auto idx = 1u; idx < _storage->nodes.size(); ++idx )
-      {
+      detail::foreach_parent_candidate( *this, _old, [&]( auto const& idx ) {
         if ( is_ci( idx ) || is_dead( idx ) )
-          continue; /* ignore CIs */
+          return; /* ignore CIs */
 
         if ( const auto repl = replace_in_node( idx, _old, _new ); repl )
         {
           to_substitute.push( *repl );
         }
-      }
+      } );
 
       /* check outputs */
       replace_in_outputs( _old, _new );
@@ -715,13 +735,12 @@ public:
       revive_node( get_node( new_signal ) );
     }
 
-    for ( auto idx = 1u; idx < _storage->nodes.size(); ++idx )
-    {
+    detail::foreach_parent_candidate( *this, old_node, [&]( auto const& idx ) {
       if ( is_ci( idx ) || is_dead( idx ) )
-        continue; /* ignore CIs and dead nodes */
+        return; /* ignore CIs and dead nodes */
 
       replace_in_node_no_restrash( idx, old_node, new_signal );
-    }
+    } );
 
     /* check outputs */
     replace_in_outputs( old_node, new_signal );
@@ -775,19 +794,19 @@ public:
 
     while ( !substitutions.empty() )
     {
-      auto const [old_node, new_signal] = substitutions.front();
+      auto const old_node = substitutions.front().first;
+      auto const new_signal = substitutions.front().second;
       substitutions.pop_front();
 
-      for ( auto index = 1u; index < _storage->nodes.size(); ++index )
-      {
+      detail::foreach_parent_candidate( *this, old_node, [&]( auto const& index ) {
         /* skip CIs and dead nodes */
         if ( is_ci( index ) || is_dead( index ) )
-          continue;
+          return;
 
         /* skip nodes that will be deleted */
         if ( std::find_if( std::begin( substitutions ), std::end( substitutions ),
                            [&index]( auto s ) { return s.first == index; } ) != std::end( substitutions ) )
-          continue;
+          return;
 
         /* replace in node */
         if ( const auto repl = replace_in_node( index, old_node, new_signal ); repl )
@@ -795,7 +814,7 @@ public:
           incr_fanout_size( get_node( repl->second ) );
           substitutions.emplace_back( *repl );
         }
-      }
+      } );
 
       /* replace in outputs */
       replace_in_outputs( old_node, new_signal );
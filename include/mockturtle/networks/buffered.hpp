@@ -354,8 +354,10 @@ public:
     {
       assert( node.children[0].index == old_node );
       new_signal.complement ^= node.children[0].weight;
+      _storage->fanout.erase( n, node );
       node.children[0] = new_signal;
       node.children[1] = !new_signal;
+      _storage->fanout.insert( n, node );
       _storage->nodes[new_signal.index].data[0].h1++;
       return;
     }
@@ -388,9 +390,11 @@ public:
     }
 
     _storage->hash.erase( node );
+    _storage->fanout.erase( n, node );
     node.children[0] = child0;
     node.children[1] = child1;
     node.children[2] = child2;
+    _storage->fanout.insert( n, node );
     _storage->hash[node] = n;
 
     // update the reference counter of the new signal
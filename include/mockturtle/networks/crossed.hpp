@@ -762,7 +762,7 @@ public:
       index <<= 1;
       index ^= *begin++ ? 1 : 0;
     }
-    return kitty::get_bit( _storage->data.cache[_storage->nodes[n].data[1].h1], index );
+    return _storage->data.cache.get( _storage->nodes[n].data[1].h1 ).get_bit( index );
   }
 
   template<typename Iterator>
@@ -779,7 +779,7 @@ public:
 
     /* resulting truth table has the same size as any of the children */
     auto result = tts.front().construct();
-    const auto gate_tt = _storage->data.cache[_storage->nodes[n].data[1].h1];
+    const auto gate_tt = _storage->data.cache.get( _storage->nodes[n].data[1].h1 );
 
     for ( uint32_t i = 0u; i < static_cast<uint32_t>( result.num_bits() ); ++i )
     {
@@ -788,7 +788,7 @@ public:
       {
         pattern |= kitty::get_bit( tts[j], i ) << j;
       }
-      if ( kitty::get_bit( gate_tt, pattern ) )
+      if ( gate_tt.get_bit( pattern ) )
       {
         kitty::set_bit( result, i );
       }
@@ -51,6 +51,7 @@
 
 #include "../traits.hpp"
 #include "../utils/algorithm.hpp"
+#include "../utils/trace.hpp"
 #include "detail/foreach.hpp"
 #include "events.hpp"
 #include "storage.hpp"
@@ -290,8 +291,10 @@ public:
 
     /* structural hashing */
     const auto it = _storage->hash.find( node );
+    MOCKTURTLE_TRACE_COUNT( "mig/strash_lookups", 1 );
     if ( it != _storage->hash.end() )
     {
+      MOCKTURTLE_TRACE_COUNT( "mig/strash_hits", 1 );
       return { it->second, node_complement };
     }
 
@@ -541,11 +544,13 @@ public:
 
     // erase old node in hash table
     _storage->hash.erase( node );
+    _storage->fanout.erase( n, node );
 
     // insert updated node into hash table
     node.children[0] = child0;
     node.children[1] = child1;
     node.children[2] = child2;
+    _storage->fanout.insert( n, node );
     _storage->hash[node] = n;
 
     // update the reference counter of the new signal
@@ -611,11 +616,13 @@ public:
 
     // erase old node in hash table
     _storage->hash.erase( node );
+    _storage->fanout.erase( n, node );
 
     // insert updated node into hash table
     node.children[0] = child0;
     node.children[1] = child1;
     node.children[2] = child2;
+    _storage->fanout.insert( n, node );
     if ( _storage->hash.find( node ) == _storage->hash.end() )
     {
       _storage->hash[node] = n;
@@ -714,6 +721,19 @@ public:
     return ( _storage->nodes[n].data[0].h1 >> 31 ) & 1;
   }
 
+  /*! \brief Enables or disables the built-in fanout index
+   *
+   * When the index is enabled (default), substitutions only visit the
+   * parents of the substituted node; the index is built on the first
+   * substitution.  Otherwise, they scan all nodes of the network.
+   * Disabling the index releases its memory.
+   */
+  void use_fanout_index( bool enable )
+  {
+    _storage->fanout.enabled = enable;
+    _storage->fanout.clear();
+  }
+
   void substitute_node( node const& old_node, signal const& new_signal )
   {
     std::unordered_map<node, signal> old_to_new;
@@ -722,7 +742,8 @@ public:
 
     while ( !to_substitute.empty() )
     {
-      const auto [_old, _curr] = to_substitute.top();
+      const auto _old = to_substitute.top().first;
+      const auto _curr = to_substitute.top().second;
       to_substitute.pop();
 
       signal _new = _curr;
@@ -742,16 +763,15 @@ public:
         revive_node( get_node( _new ) );
       }
 
-      for ( auto idx = 1u; idx < _storage->nodes.size(); ++idx )
-      {
+      detail::foreach_parent_candidate( *this, _old, [&]( auto const& idx ) {
         if ( is_ci( idx ) || is_dead( idx ) )
-          continue; /* ignore CIs */
+          return; /* ignore CIs */
 
         if ( const auto repl = replace_in_node( idx, _old, _new ); repl )
         {
           to_substitute.push( *repl );
         }
-      }
+      } );
 
       /* check outputs */
       replace_in_outputs( _old, _new );
@@ -772,13 +792,12 @@ public:
       revive_node( get_node( new_signal ) );
     }
 
-    for ( auto idx = 1u; idx < _storage->nodes.size(); ++idx )
-    {
+    detail::foreach_parent_candidate( *this, old_node, [&]( auto const& idx ) {
       if ( is_ci( idx ) || is_dead( idx ) )
-        continue; /* ignore CIs and dead nodes */
+        return; /* ignore CIs and dead nodes */
 
       replace_in_node_no_restrash( idx, old_node, new_signal );
-    }
+    } );
 
     /* check outputs */
     replace_in_outputs( old_node, new_signal );
@@ -39,9 +39,15 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cassert>
+#include <cstdint>
 #include <iostream>
+#include <limits>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <parallel_hashmap/phmap.h>
@@ -205,6 +211,629 @@ struct node_hash
   }
 };
 
+/*! \brief Built-in fanout index
+ *
+ * The primary template is empty: a fanout index is only kept for nodes
+ * with a fixed number of fanins (see the specialization for
+ * `regular_node`).
+ */
+template<typename Node>
+struct fanout_index
+{
+};
+
+/*! \brief Built-in fanout index for nodes with a fixed fan-in size
+
+  The fanout of each node is stored as a doubly-linked list threaded
+  through the fanin slots of its parents, where slot `n * Fanin + i`
+  stands for the `i`-th fanin of node `n`.  Links are 32-bit slot
+  indices, which costs 4 bytes per node and 8 bytes per fanin slot, and
+  allows substitutions to only visit the actual parents of a node instead
+  of scanning the whole network.
+
+  The index is built lazily: no memory is used until the first
+  substitution calls `update`, which links all nodes that have been
+  appended to the storage since its last call, while `erase` and
+  `insert` keep already linked nodes up-to-date when their fanins are
+  modified.  Networks whose fanin slots do not fit into 32 bits are not
+  indexed.
+*/
+template<int Fanin, int Size, int PointerFieldSize>
+struct fanout_index<regular_node<Fanin, Size, PointerFieldSize>>
+{
+  using node_type = regular_node<Fanin, Size, PointerFieldSize>;
+
+  static constexpr uint32_t nil = std::numeric_limits<uint32_t>::max();
+
+  /*! \brief Links all nodes that are not indexed yet
+   *
+   * \param nodes Node array of the storage
+   * \param is_gate Predicate telling whether the fanins of a node are valid
+   * \return False if the network is too large to be indexed
+   */
+  template<typename IsGate>
+  bool update( std::vector<node_type> const& nodes, IsGate&& is_gate )
+  {
+    if ( nodes.size() * Fanin >= nil )
+    {
+      clear();
+      return false;
+    }
+
+    heads.resize( std::max<uint64_t>( heads.size(), nodes.size() ), nil );
+    next.resize( nodes.size() * Fanin, nil );
+    prev.resize( nodes.size() * Fanin, nil );
+
+    while ( num_nodes < nodes.size() )
+    {
+      auto const n = num_nodes++;
+      if ( is_gate( n ) )
+      {
+        insert( n, nodes[n] );
+      }
+    }
+    return true;
+  }
+
+  /*! \brief Links the fanin slots of an indexed node */
+  void insert( uint64_t n, node_type const& node )
+  {
+    if ( n >= num_nodes )
+      return;
+
+    for ( auto i = 0u; i < Fanin; ++i )
+    {
+      auto const child = node.children[i].index;
+      if ( child >= heads.size() )
+      {
+        heads.resize( child + 1, nil );
+      }
+
+      auto const slot = static_cast<uint32_t>( n * Fanin + i );
+      next[slot] = heads[child];
+      prev[slot] = nil;
+      if ( heads[child] != nil )
+      {
+        prev[heads[child]] = slot;
+      }
+      heads[child] = slot;
+    }
+  }
+
+  /*! \brief Unlinks the fanin slots of an indexed node */
+  void erase( uint64_t n, node_type const& node )
+  {
+    if ( n >= num_nodes )
+      return;
+
+    for ( auto i = 0u; i < Fanin; ++i )
+    {
+      auto const slot = static_cast<uint32_t>( n * Fanin + i );
+      if ( prev[slot] != nil )
+      {
+        next[prev[slot]] = next[slot];
+      }
+      else if ( heads[node.children[i].index] == slot )
+      {
+        heads[node.children[i].index] = next[slot];
+      }
+      else
+      {
+        continue; /* not linked */
+      }
+      if ( next[slot] != nil )
+      {
+        prev[next[slot]] = prev[slot];
+      }
+      next[slot] = prev[slot] = nil;
+    }
+  }
+
+  /*! \brief Stores the indexed parents of `n` in ascending order into `result` */
+  void parents( uint64_t n, std::vector<uint32_t>& result ) const
+  {
+    result.clear();
+    if ( n < heads.size() )
+    {
+      for ( auto slot = heads[n]; slot != nil; slot = next[slot] )
+      {
+        result.push_back( slot / Fanin );
+      }
+    }
+    std::sort( result.begin(), result.end() );
+    result.erase( std::unique( result.begin(), result.end() ), result.end() );
+  }
+
+  /*! \brief Drops all links and releases their memory (the index is rebuilt on the next `update`) */
+  void clear()
+  {
+    num_nodes = 0u;
+    heads = {};
+    next = {};
+    prev = {};
+  }
+
+  /*! \brief Whether substitutions should use the index */
+  bool enabled{ true };
+
+  /*! \brief Number of nodes that are linked into the index */
+  uint64_t num_nodes{ 0u };
+
+  std::vector<uint32_t> heads;
+  std::vector<uint32_t> next;
+  std::vector<uint32_t> prev;
+
+  /*! \brief Reused buffer for the parents visited by `foreach_parent_candidate` */
+  std::vector<uint32_t> buffer;
+};
+
+namespace detail
+{
+
+/*! \brief Calls `fn` on every node that may have `n` as a fanin
+ *
+ * Only the parents of `n` are visited (in ascending order) if the
+ * built-in fanout index of the storage is enabled.  Otherwise, `fn` is
+ * called on all non-constant nodes.  Callers must filter out CIs and
+ * dead nodes.  The parents are collected before `fn` is called, such
+ * that `fn` may replace the fanins of the visited nodes.
+ */
+template<class Ntk, typename Fn>
+void foreach_parent_candidate( Ntk& ntk, typename Ntk::node const& n, Fn&& fn )
+{
+  auto& storage = *ntk._storage;
+  auto& index = storage.fanout;
+  if ( index.enabled && index.update( storage.nodes, [&]( auto const& p ) { return !ntk.is_constant( p ) && !ntk.is_ci( p ); } ) )
+  {
+    /* the buffer is taken out of the index, in case that `fn` visits parents itself */
+    auto parents = std::move( index.buffer );
+    index.parents( n, parents );
+    for ( auto const& p : parents )
+    {
+      fn( p );
+    }
+    index.buffer = std::move( parents );
+    return;
+  }
+
+  for ( auto idx = 1u; idx < storage.nodes.size(); ++idx )
+  {
+    fn( idx );
+  }
+}
+
+} /* namespace detail */
+
+/*! \brief Structural hash table that stores node indices
+
+  The table maps the fanins of a node to its index, like a hash map from
+  `Node` to `uint64_t`, but it does not keep a copy of the node: each
+  slot only holds the node index, and lookups compare the fanins against
+  the node in the node array of the storage.  The hash value is computed
+  from the fanins with `NodeHasher`.
+
+  The table uses open addressing with linear probing.  Each slot packs a
+  24-bit tag of the hash value together with a 40-bit node index, such
+  that most probes with different fanins are rejected without accessing
+  the node array.  Slot 0 marks an empty slot (the constant node is never
+  hashed), and removed entries leave a tombstone, which is cleaned up
+  when the table is rehashed.
+
+  The table keeps a pointer to the node array, which is set by `bind`.
+  The owning storage rebinds it after being copied or moved.  A node
+  must be erased from the table before its fanins are modified.
+*/
+template<typename Node, typename NodeHasher = node_hash<Node>>
+class strash_table
+{
+public:
+  using key_type = Node;
+  using mapped_type = uint64_t;
+
+  /*! \brief Entry of the table, i.e., the node and its index */
+  struct value_type
+  {
+    Node const& first;
+    uint64_t second;
+  };
+
+  class iterator
+  {
+  public:
+    struct pointer
+    {
+      value_type const* operator->() const
+      {
+        return &value;
+      }
+
+      value_type value;
+    };
+
+    iterator( strash_table const* table, uint64_t pos ) : _table( table ), _pos( pos )
+    {
+      skip();
+    }
+
+    value_type operator*() const
+    {
+      auto const index = _table->_slots[_pos] & index_mask;
+      return { ( *_table->_nodes )[index], index };
+    }
+
+    pointer operator->() const
+    {
+      return { **this };
+    }
+
+    iterator& operator++()
+    {
+      ++_pos;
+      skip();
+      return *this;
+    }
+
+    bool operator==( iterator const& other ) const
+    {
+      return _pos == other._pos;
+    }
+
+    bool operator!=( iterator const& other ) const
+    {
+      return _pos != other._pos;
+    }
+
+  private:
+    friend class strash_table;
+
+    void skip()
+    {
+      while ( _pos < _table->_slots.size() && !is_entry( _table->_slots[_pos] ) )
+      {
+        ++_pos;
+      }
+    }
+
+    strash_table const* _table;
+    uint64_t _pos;
+  };
+
+  using const_iterator = iterator;
+
+  /*! \brief Assigns an index to a node with `table[node] = index` */
+  class reference
+  {
+  public:
+    reference( strash_table& table, Node const& node ) : _table( table ), _node( node ) {}
+
+    reference& operator=( uint64_t index )
+    {
+      _table.insert_or_assign( _node, index );
+      return *this;
+    }
+
+  private:
+    strash_table& _table;
+    Node const& _node;
+  };
+
+  strash_table() = default;
+
+  /*! \brief Sets the node array that is indexed by the table */
+  void bind( std::vector<Node> const& nodes )
+  {
+    _nodes = &nodes;
+  }
+
+  iterator begin() const
+  {
+    return { this, 0u };
+  }
+
+  iterator end() const
+  {
+    return { this, _slots.size() };
+  }
+
+  uint64_t size() const
+  {
+    return _size;
+  }
+
+  bool empty() const
+  {
+    return _size == 0u;
+  }
+
+  /*! \brief Number of slots */
+  uint64_t capacity() const
+  {
+    return _slots.size();
+  }
+
+  /*! \brief Removes all entries (keeps the memory of the slots) */
+  void clear()
+  {
+    std::fill( _slots.begin(), _slots.end(), empty_slot );
+    _size = 0u;
+    _used = 0u;
+  }
+
+  /*! \brief Makes room for `count` entries without rehashing */
+  void reserve( uint64_t count )
+  {
+    auto const capacity = capacity_for( count );
+    if ( capacity > _slots.size() )
+    {
+      rehash( capacity );
+    }
+  }
+
+  /*! \brief Returns the entry with the same fanins as `node`, or `end()` */
+  iterator find( Node const& node ) const
+  {
+    if ( _size == 0u )
+    {
+      return end();
+    }
+
+    auto const hash = mix( NodeHasher{}( node ) );
+    auto const tag = tag_of( hash );
+    auto const mask = _slots.size() - 1u;
+    for ( auto pos = hash & mask;; pos = ( pos + 1u ) & mask )
+    {
+      auto const slot = _slots[pos];
+      if ( slot == empty_slot )
+      {
+        return end();
+      }
+      if ( ( slot & ~index_mask ) == tag && slot != deleted_slot && ( *_nodes )[slot & index_mask] == node )
+      {
+        return { this, pos };
+      }
+    }
+  }
+
+  /*! \brief Returns an assignable reference to the entry for `node` */
+  reference operator[]( Node const& node )
+  {
+    return { *this, node };
+  }
+
+  /*! \brief Inserts `index` for the fanins of `node` unless there is such an entry */
+  std::pair<iterator, bool> emplace( Node const& node, uint64_t index )
+  {
+    if ( auto const it = find( node ); it != end() )
+    {
+      return { it, false };
+    }
+    return { iterator( this, insert_new( node, index ) ), true };
+  }
+
+  /*! \brief Inserts `index` for the fanins of `node`, which must not be in the table
+   *
+   * Skips the lookup of `emplace`, e.g., when building the table for a
+   * network that is known to be structurally hashed.
+   */
+  void insert_unique( Node const& node, uint64_t index )
+  {
+    assert( find( node ) == end() );
+    insert_new( node, index );
+  }
+
+  /*! \brief Sets the index for the fanins of `node` */
+  void insert_or_assign( Node const& node, uint64_t index )
+  {
+    if ( auto const it = find( node ); it != end() )
+    {
+      _slots[it._pos] = ( _slots[it._pos] & ~index_mask ) | index;
+      return;
+    }
+    insert_new( node, index );
+  }
+
+  /*! \brief Removes the entry for the fanins of `node` */
+  uint64_t erase( Node const& node )
+  {
+    auto const it = find( node );
+    if ( it == end() )
+    {
+      return 0u;
+    }
+    _slots[it._pos] = deleted_slot;
+    --_size;
+    return 1u;
+  }
+
+  /*! \brief Tables are equal if they map the same fanins to the same indexes */
+  bool operator==( strash_table const& other ) const
+  {
+    if ( _size != other._size )
+    {
+      return false;
+    }
+    for ( auto const& entry : *this )
+    {
+      auto const it = other.find( entry.first );
+      if ( it == other.end() || it->second != entry.second )
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool operator!=( strash_table const& other ) const
+  {
+    return !( *this == other );
+  }
+
+  /*! \brief Raw slots, e.g., to write them into a snapshot */
+  std::vector<uint64_t> const& slots() const
+  {
+    return _slots;
+  }
+
+  /*! \brief Restores the table from raw slots of a table with the same hash function
+   *
+   * The slots are rejected, leaving the table unchanged, if their number is
+   * not a power of two, if they contain no empty slot (such that lookups
+   * would not terminate), or if an entry refers to a node outside the
+   * bound node array.
+   */
+  bool assign_slots( std::vector<uint64_t> slots )
+  {
+    if ( !slots.empty() && ( slots.size() & ( slots.size() - 1u ) ) != 0u )
+    {
+      return false;
+    }
+
+    uint64_t const num_nodes = _nodes ? _nodes->size() : 0u;
+    uint64_t size = 0u, used = 0u;
+    for ( auto const slot : slots )
+    {
+      if ( slot != empty_slot )
+      {
+        ++used;
+        if ( slot != deleted_slot )
+        {
+          auto const index = slot & index_mask;
+          if ( index == 0u || index >= num_nodes )
+          {
+            return false;
+          }
+          ++size;
+        }
+      }
+    }
+    if ( !slots.empty() && used == slots.size() )
+    {
+      return false;
+    }
+
+    _slots = std::move( slots );
+    _size = size;
+    _used = used;
+    return true;
+  }
+
+private:
+  static constexpr uint64_t index_bits = 40u;
+  static constexpr uint64_t index_mask = ( UINT64_C( 1 ) << index_bits ) - 1u;
+  static constexpr uint64_t empty_slot = 0u;
+  static constexpr uint64_t deleted_slot = ~UINT64_C( 0 );
+
+  static bool is_entry( uint64_t slot )
+  {
+    return slot != empty_slot && slot != deleted_slot;
+  }
+
+  /* spread the bits of weak hash functions (such as the one of XAGs) over the whole word */
+  static uint64_t mix( uint64_t hash )
+  {
+    hash *= UINT64_C( 0x9e3779b97f4a7c15 );
+    return hash ^ ( hash >> 32 );
+  }
+
+  static uint64_t tag_of( uint64_t hash )
+  {
+    return hash & ~index_mask;
+  }
+
+  /* smallest power of two with a load factor of at most 3/4 */
+  static uint64_t capacity_for( uint64_t count )
+  {
+    uint64_t capacity = 16u;
+    while ( capacity / 4u * 3u < count )
+    {
+      capacity <<= 1u;
+    }
+    return capacity;
+  }
+
+  uint64_t insert_new( Node const& node, uint64_t index )
+  {
+    assert( index != 0u && index <= index_mask );
+
+    if ( _slots.size() / 4u * 3u < _used + 1u )
+    {
+      /* grow, or only remove the tombstones if most used slots are deleted */
+      rehash( std::max<uint64_t>( _slots.size(), capacity_for( 2u * ( _size + 1u ) ) ) );
+    }
+
+    auto const hash = mix( NodeHasher{}( node ) );
+    auto const mask = _slots.size() - 1u;
+    auto pos = hash & mask;
+    while ( is_entry( _slots[pos] ) )
+    {
+      pos = ( pos + 1u ) & mask;
+    }
+
+    if ( _slots[pos] == empty_slot )
+    {
+      ++_used;
+    }
+    _slots[pos] = tag_of( hash ) | index;
+    ++_size;
+    return pos;
+  }
+
+  void rehash( uint64_t capacity )
+  {
+    std::vector<uint64_t> slots( capacity, empty_slot );
+    auto const mask = capacity - 1u;
+    for ( auto const slot : _slots )
+    {
+      if ( !is_entry( slot ) )
+        continue;
+
+      auto pos = mix( NodeHasher{}( ( *_nodes )[slot & index_mask] ) ) & mask;
+      while ( slots[pos] != empty_slot )
+      {
+        pos = ( pos + 1u ) & mask;
+      }
+      slots[pos] = slot;
+    }
+    _slots.swap( slots );
+    _used = _size;
+  }
+
+  std::vector<Node> const* _nodes{ nullptr };
+  std::vector<uint64_t> _slots;
+  uint64_t _size{ 0u };
+  uint64_t _used{ 0u };
+};
+
+/*! \brief Hash table type of the storage
+ *
+ * Nodes with a fixed number of fanins are hashed by `strash_table`,
+ * all other nodes by a hash map from the node to its index.
+ */
+template<typename Node, typename NodeHasher>
+struct storage_hash
+{
+  using type = phmap::flat_hash_map<Node, uint64_t, NodeHasher>;
+};
+
+template<int Fanin, int Size, int PointerFieldSize, typename NodeHasher>
+struct storage_hash<regular_node<Fanin, Size, PointerFieldSize>, NodeHasher>
+{
+  using type = strash_table<regular_node<Fanin, Size, PointerFieldSize>, NodeHasher>;
+};
+
+template<typename Table>
+struct is_strash_table : std::false_type
+{
+};
+
+template<typename Node, typename NodeHasher>
+struct is_strash_table<strash_table<Node, NodeHasher>> : std::true_type
+{
+};
+
+template<typename Table>
+inline constexpr bool is_strash_table_v = is_strash_table<Table>::value;
+
 struct empty_storage_data
 {
 };
@@ -212,6 +841,9 @@ struct empty_storage_data
 template<typename Node, typename T = empty_storage_data, typename NodeHasher = node_hash<Node>>
 struct storage
 {
+  using node_type = Node;
+  using hash_type = typename storage_hash<Node, NodeHasher>::type;
+
   storage()
   {
     nodes.reserve( 10000u );
@@ -219,9 +851,40 @@ struct storage
 
     /* we generally reserve the first node for a constant */
     nodes.emplace_back();
+    bind_hash();
   }
 
-  using node_type = Node;
+  storage( storage const& other )
+      : trav_id( other.trav_id ), nodes( other.nodes ), inputs( other.inputs ), outputs( other.outputs ),
+        hash( other.hash ), fanout( other.fanout ), data( other.data )
+  {
+    bind_hash();
+  }
+
+  storage( storage&& other )
+      : trav_id( other.trav_id ), nodes( std::move( other.nodes ) ), inputs( std::move( other.inputs ) ), outputs( std::move( other.outputs ) ),
+        hash( std::move( other.hash ) ), fanout( std::move( other.fanout ) ), data( std::move( other.data ) )
+  {
+    bind_hash();
+  }
+
+  storage& operator=( storage const& other )
+  {
+    return *this = storage( other );
+  }
+
+  storage& operator=( storage&& other )
+  {
+    trav_id = other.trav_id;
+    nodes = std::move( other.nodes );
+    inputs = std::move( other.inputs );
+    outputs = std::move( other.outputs );
+    hash = std::move( other.hash );
+    fanout = std::move( other.fanout );
+    data = std::move( other.data );
+    bind_hash();
+    return *this;
+  }
 
   uint32_t trav_id = 0u;
 
@@ -229,9 +892,20 @@ struct storage
   std::vector<uint64_t> inputs;
   std::vector<typename node_type::pointer_type> outputs;
 
-  phmap::flat_hash_map<node_type, uint64_t, NodeHasher> hash;
+  hash_type hash;
+  fanout_index<node_type> fanout;
 
   T data;
+
+private:
+  /* the strash table refers to the node array of its storage */
+  void bind_hash()
+  {
+    if constexpr ( is_strash_table_v<hash_type> )
+    {
+      hash.bind( nodes );
+    }
+  }
 };
 
 template<typename Node, typename T = empty_storage_data>
@@ -462,11 +462,13 @@ public:
 
     // erase old node in hash table
     _storage->hash.erase( node );
+    _storage->fanout.erase( n, node );
 
     // insert updated node into hash table
     node.children[0] = child[0];
     node.children[1] = child[1];
     node.children[2] = child[2];
+    _storage->fanout.insert( n, node );
     _storage->hash[node] = n;
 
     // update the reference counter of the new signal
@@ -560,6 +562,19 @@ public:
     return ( _storage->nodes[n].data[0].h1 >> 31 ) & 1;
   }
 
+  /*! \brief Enables or disables the built-in fanout index
+   *
+   * When the index is enabled (default), substitutions only visit the
+   * parents of the substituted node; the index is built on the first
+   * substitution.  Otherwise, they scan all nodes of the network.
+   * Disabling the index releases its memory.
+   */
+  void use_fanout_index( bool enable )
+  {
+    _storage->fanout.enabled = enable;
+    _storage->fanout.clear();
+  }
+
   void substitute_node( node const& old_node, signal const& new_signal )
   {
     //if ( get_node( new_signal ) == old_node && !is_complemented( new_signal ) )
@@ -571,7 +586,8 @@ public:
 
     while ( !to_substitute.empty() )
     {
-      const auto [_old, _curr] = to_substitute.top();
+      const auto _old = to_substitute.top().first;
+      const auto _curr = to_substitute.top().second;
       to_substitute.pop();
 
       signal _new = _curr;
@@ -594,16 +610,15 @@ public:
       //if ( get_node( _new ) == _old && !is_complemented( _new ) )
       //  continue;
 
-      for ( auto idx = 1u; idx < _storage->nodes.size(); ++idx )
-      {
+      detail::foreach_parent_candidate( *this, _old, [&]( auto const& idx ) {
         if ( is_ci( idx ) || is_dead( idx ) )
-          continue; /* ignore CIs */
+          return; /* ignore CIs */
 
         if ( const auto repl = replace_in_node( idx, _old, _new ); repl )
         {
           to_substitute.push( *repl );
         }
-      }
+      } );
 
       /* check outputs */
       replace_in_outputs( _old, _new );
@@ -36,6 +36,8 @@
 #include "../networks/aig.hpp"
 #include "../networks/gia.hpp"
 
+#include <mutex>
+
 namespace mockturtle
 {
 
@@ -100,6 +102,10 @@ void gia_to_aig(aig_network aig, const gia_network &gia) {
 
 aig_network call_abc_script( aig_network const& aig, std::string const& script )
 {
+  /* ABC keeps its state in a global frame, so scripts of concurrent callers (e.g., `explorer` restarts) are serialized */
+  static std::mutex abc_mutex;
+  std::lock_guard<std::mutex> lock( abc_mutex );
+
   gia_network gia( aig.size() << 1 );
   aig_to_gia( gia, aig );
 
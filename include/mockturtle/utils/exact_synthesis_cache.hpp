@@ -0,0 +1,618 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2023  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file exact_synthesis_cache.hpp
+  \brief Shared cache of exact synthesis results
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/hash.hpp>
+#include <kitty/npn.hpp>
+#include <kitty/operations.hpp>
+#include <kitty/operators.hpp>
+
+#include "../io/serialize.hpp"
+#include "include/percy.hpp"
+#include "mapped_file.hpp"
+#include "thread_pool.hpp"
+
+namespace mockturtle
+{
+
+namespace detail
+{
+
+/*! \brief Current version of the format of exact synthesis cache files. */
+static constexpr uint32_t exact_synthesis_cache_version = 1u;
+
+struct exact_synthesis_cache_header
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t reserved;
+};
+
+struct exact_synthesis_cache_key
+{
+  uint32_t kind;
+  kitty::dynamic_truth_table function;
+
+  bool operator==( exact_synthesis_cache_key const& other ) const
+  {
+    return kind == other.kind && function == other.function;
+  }
+};
+
+struct exact_synthesis_cache_hash
+{
+  std::size_t operator()( exact_synthesis_cache_key const& key ) const
+  {
+    auto seed = kitty::hash<kitty::dynamic_truth_table>()( key.function );
+    kitty::hash_combine( seed, std::hash<uint32_t>()( key.kind ) );
+    return seed;
+  }
+};
+
+} // namespace detail
+
+/*! \brief Shared cache of exact synthesis results.
+ *
+ * The cache stores the optimum chains found by exact synthesis (see
+ * `exact_resynthesis` and `exact_aig_resynthesis`) for the NPN
+ * representatives of the synthesized functions, such that a chain is
+ * reused for all functions in the same NPN class.  Functions with more
+ * than 6 variables are not canonized.  The chains of different synthesis
+ * problems, e.g., of different gate bases, are kept apart by a `kind`
+ * chosen by the caller.
+ *
+ * Functions for which synthesis failed are recorded in a blacklist
+ * together with the conflict limit that was exceeded, such that they are
+ * synthesized again only with a larger conflict limit.
+ *
+ * The cache can be shared by several threads: the entries are distributed
+ * over independently locked shards.  It can be saved to and loaded from a
+ * binary file, which is not platform-independent.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      auto cache = std::make_shared<exact_synthesis_cache>();
+      cache->load( "exact.cache" );
+
+      exact_resynthesis_params ps;
+      ps.shared_cache = cache;
+      exact_resynthesis<klut_network> resyn( 3, ps );
+      klut = cut_rewriting( klut, resyn );
+
+      cache->save( "exact.cache" );
+   \endverbatim
+ */
+class exact_synthesis_cache
+{
+public:
+  /*! \brief Conflict limit of blacklist entries for which synthesis failed without reaching a conflict limit. */
+  static constexpr int32_t no_conflict_limit = 0;
+
+  exact_synthesis_cache() = default;
+
+  exact_synthesis_cache( exact_synthesis_cache const& ) = delete;
+  exact_synthesis_cache& operator=( exact_synthesis_cache const& ) = delete;
+
+  /*! \brief Returns a chain for `function`, synthesizing it if needed.
+   *
+   * If the cache contains a chain for the NPN representative of
+   * `function`, it is transformed into a chain computing `function`.
+   * Otherwise, `synthesize( representative, chain )` is called to
+   * synthesize the representative, which must return a `percy::synth_result`.
+   * Several threads may synthesize the same function at the same time, in
+   * which case the first result is kept.
+   *
+   * The returned chain is normalized, i.e., all operators map the all-zero
+   * input assignment to zero and the output may be complemented.
+   *
+   * \param kind Kind of the synthesis problem
+   * \param function Function to be synthesized
+   * \param conflict_limit Conflict limit of the synthesis (0 means no limit)
+   * \param synthesize Synthesis function
+   * \return Chain computing `function`, or `std::nullopt` if synthesis failed or the function is blacklisted
+   */
+  template<class Fn>
+  std::optional<percy::chain> get_or_synthesize( uint32_t kind, kitty::dynamic_truth_table const& function, int32_t conflict_limit, Fn&& synthesize )
+  {
+    auto [representative, phase, perm] = canonize( function );
+    auto const c = find_or_synthesize( { kind, std::move( representative ) }, conflict_limit, synthesize );
+    if ( !c )
+    {
+      return std::nullopt;
+    }
+    return transform( *c, phase, perm );
+  }
+
+  /*! \brief Synthesizes the NPN classes of several functions in parallel.
+   *
+   * Canonizes `functions` and calls `synthesize( representative, chain )`
+   * on the threads of `pool` for each NPN representative that is neither
+   * in the cache nor blacklisted for `conflict_limit`.  Each representative
+   * is synthesized once, and representatives are synthesized in the order
+   * of their first occurrence in `functions`.  The results are added to the
+   * cache, from which `get_or_synthesize` takes them later.
+   *
+   * \param kind Kind of the synthesis problem
+   * \param functions Functions to be synthesized
+   * \param conflict_limit Conflict limit of each synthesis (0 means no limit)
+   * \param pool Thread pool
+   * \param synthesize Synthesis function, called concurrently from several threads
+   */
+  template<class Fn>
+  void precompute( uint32_t kind, std::vector<kitty::dynamic_truth_table> const& functions, int32_t conflict_limit, thread_pool& pool, Fn&& synthesize )
+  {
+    std::vector<kitty::dynamic_truth_table> representatives( functions.size() );
+    pool.parallel_for( 0u, functions.size(), [&]( uint64_t i, uint32_t ) {
+      representatives[i] = std::get<0>( canonize( functions[i] ) );
+    } );
+
+    std::vector<detail::exact_synthesis_cache_key> keys;
+    std::unordered_set<kitty::dynamic_truth_table, kitty::hash<kitty::dynamic_truth_table>> visited;
+    for ( auto& representative : representatives )
+    {
+      if ( visited.insert( representative ).second )
+      {
+        keys.push_back( { kind, std::move( representative ) } );
+      }
+    }
+
+    pool.parallel_for( 0u, keys.size(), [&]( uint64_t i, uint32_t ) {
+      find_or_synthesize( std::move( keys[i] ), conflict_limit, synthesize );
+    } );
+  }
+
+  /*! \brief Number of cached chains. */
+  uint64_t size() const
+  {
+    uint64_t size = 0u;
+    for ( auto& s : _shards )
+    {
+      std::lock_guard<std::mutex> lock( s.mutex );
+      size += s.chains.size();
+    }
+    return size;
+  }
+
+  /*! \brief Number of blacklisted functions. */
+  uint64_t num_blacklisted() const
+  {
+    uint64_t size = 0u;
+    for ( auto& s : _shards )
+    {
+      std::lock_guard<std::mutex> lock( s.mutex );
+      size += s.blacklist.size();
+    }
+    return size;
+  }
+
+  /*! \brief Removes all entries. */
+  void clear()
+  {
+    for ( auto& s : _shards )
+    {
+      std::lock_guard<std::mutex> lock( s.mutex );
+      s.chains.clear();
+      s.blacklist.clear();
+    }
+  }
+
+  /*! \brief Saves the cache to a file.
+   *
+   * The file is written to a temporary file first and then renamed, such
+   * that other processes never read a partial file.
+   *
+   * \param filename Filename
+   * \return Whether the file has been written successfully
+   */
+  bool save( std::string const& filename ) const
+  {
+    auto const tmp_filename = fmt::format( "{}.{:08x}.tmp", filename, std::random_device{}() );
+
+    bool okay;
+    {
+      std::ofstream os( tmp_filename, std::ofstream::binary );
+      detail::snapshot_ostream_archive ar{ os };
+      detail::snapshot_writer<detail::snapshot_ostream_archive> w( ar );
+      okay = os.is_open() && write( w );
+    }
+
+    if ( !okay || std::rename( tmp_filename.c_str(), filename.c_str() ) != 0 )
+    {
+      std::remove( tmp_filename.c_str() );
+      return false;
+    }
+    return true;
+  }
+
+  /*! \brief Loads the entries of a file into the cache.
+   *
+   * The entries are merged into the cache: existing chains are kept, and
+   * blacklist entries keep the larger conflict limit.  Blacklist entries
+   * of functions with a chain are dropped.
+   *
+   * \param filename Filename
+   * \return Whether the file exists and is valid
+   */
+  bool load( std::string const& filename )
+  {
+    mapped_file file( filename );
+    if ( !file.is_open() )
+      return false;
+
+    detail::snapshot_memory_archive ar{ file.data(), 0u, file.size() };
+    detail::snapshot_reader<detail::snapshot_memory_archive> r( ar );
+    return read( r );
+  }
+
+  /*! \brief Reports cache statistics. */
+  void report() const
+  {
+    fmt::print( "[i] cache hits              = {}\n", _hits.load() );
+    fmt::print( "[i] blacklist hits          = {}\n", _blacklist_hits.load() );
+    fmt::print( "[i] cache misses            = {}\n", _misses.load() );
+    fmt::print( "[i] size of cache           = {}\n", size() );
+    fmt::print( "[i] size of blacklist cache = {}\n", num_blacklisted() );
+  }
+
+  /*! \brief Number of lookups that returned a cached chain. */
+  uint64_t num_hits() const
+  {
+    return _hits;
+  }
+
+  /*! \brief Number of lookups that called the synthesis function. */
+  uint64_t num_misses() const
+  {
+    return _misses;
+  }
+
+private:
+  static constexpr uint32_t num_shards = 64u;
+
+  struct cache_shard
+  {
+    mutable std::mutex mutex;
+    std::unordered_map<detail::exact_synthesis_cache_key, percy::chain, detail::exact_synthesis_cache_hash> chains;
+    std::unordered_map<detail::exact_synthesis_cache_key, int32_t, detail::exact_synthesis_cache_hash> blacklist;
+  };
+
+  cache_shard& shard( detail::exact_synthesis_cache_key const& key )
+  {
+    return _shards[detail::exact_synthesis_cache_hash()( key ) % num_shards];
+  }
+
+  /* chain of an NPN representative, synthesized if it is not in the cache */
+  template<class Fn>
+  std::optional<percy::chain> find_or_synthesize( detail::exact_synthesis_cache_key key, int32_t conflict_limit, Fn&& synthesize )
+  {
+    auto& s = shard( key );
+
+    {
+      std::lock_guard<std::mutex> lock( s.mutex );
+      if ( auto const it = s.chains.find( key ); it != s.chains.end() )
+      {
+        ++_hits;
+        return it->second;
+      }
+      if ( auto const it = s.blacklist.find( key ); it != s.blacklist.end() && !retry( it->second, conflict_limit ) )
+      {
+        ++_blacklist_hits;
+        return std::nullopt;
+      }
+    }
+
+    ++_misses;
+    percy::chain c;
+    auto const result = synthesize( key.function, c );
+
+    std::lock_guard<std::mutex> lock( s.mutex );
+    if ( result != percy::success )
+    {
+      add_to_blacklist( s, std::move( key ), result == percy::timeout ? conflict_limit : no_conflict_limit );
+      return std::nullopt;
+    }
+
+    s.blacklist.erase( key );
+    return s.chains.emplace( std::move( key ), std::move( c ) ).first->second;
+  }
+
+  /* keeps the larger conflict limit, where failing without a conflict limit is final */
+  static void add_to_blacklist( cache_shard& s, detail::exact_synthesis_cache_key key, int32_t limit )
+  {
+    auto [it, inserted] = s.blacklist.emplace( std::move( key ), limit );
+    if ( !inserted && it->second != no_conflict_limit && ( limit == no_conflict_limit || limit > it->second ) )
+    {
+      it->second = limit;
+    }
+  }
+
+  /* a failed synthesis is repeated only with a larger conflict limit */
+  static bool retry( int32_t blacklisted_limit, int32_t conflict_limit )
+  {
+    return blacklisted_limit != no_conflict_limit && ( conflict_limit == 0 || conflict_limit > blacklisted_limit );
+  }
+
+  static std::tuple<kitty::dynamic_truth_table, uint32_t, std::vector<uint8_t>> canonize( kitty::dynamic_truth_table const& function )
+  {
+    if ( function.num_vars() <= 6u )
+    {
+      return kitty::exact_npn_canonization( function );
+    }
+
+    std::vector<uint8_t> perm( function.num_vars() );
+    std::iota( perm.begin(), perm.end(), 0u );
+    return { function, 0u, perm };
+  }
+
+  /* transforms a chain of the representative into a normalized chain of the function
+   *
+   * The function is `f( x ) = r( y ) ^ out` with `y_i = x_{perm[i]} ^ phase_{perm[i]}`,
+   * see `kitty::exact_npn_canonization`.  Complemented inputs and steps are
+   * propagated into the operators of their fanouts. */
+  static percy::chain transform( percy::chain const& c, uint32_t phase, std::vector<uint8_t> const& perm )
+  {
+    auto const num_inputs = c.get_nr_inputs();
+    auto const num_steps = c.get_nr_steps();
+
+    percy::chain res;
+    res.reset( num_inputs, 1, num_steps, c.get_fanin() );
+
+    /* complementation of the inputs and steps of `c` in `res` */
+    std::vector<bool> complemented( num_inputs + num_steps );
+    std::vector<int> index( num_inputs + num_steps );
+    for ( auto i = 0; i < num_inputs; ++i )
+    {
+      index[i] = perm[i];
+      complemented[i] = ( phase >> perm[i] ) & 1;
+    }
+    for ( auto i = 0; i < num_steps; ++i )
+    {
+      index[num_inputs + i] = num_inputs + i;
+    }
+
+    std::vector<int> fanins( c.get_fanin() );
+    for ( auto i = 0; i < num_steps; ++i )
+    {
+      auto op = c.get_operator( i );
+      auto const& step = c.get_step( i );
+      for ( auto j = 0; j < c.get_fanin(); ++j )
+      {
+        fanins[j] = index[step[j]];
+        if ( complemented[step[j]] )
+        {
+          kitty::flip_inplace( op, j );
+        }
+      }
+      if ( kitty::get_bit( op, 0 ) )
+      {
+        op = ~op;
+        complemented[num_inputs + i] = true;
+      }
+      res.set_step( i, fanins, op );
+    }
+
+    auto const out = c.get_outputs()[0];
+    auto const var = out >> 1;
+    bool inv = ( out & 1 ) ^ ( ( phase >> num_inputs ) & 1 );
+    if ( var == 0 )
+    {
+      res.set_output( 0, inv );
+    }
+    else
+    {
+      inv ^= complemented[var - 1];
+      res.set_output( 0, ( ( index[var - 1] + 1 ) << 1 ) | inv );
+    }
+    return res;
+  }
+
+  template<class Writer>
+  static bool write_function( Writer& w, detail::exact_synthesis_cache_key const& key )
+  {
+    return w.dump( key.kind ) && w.template dump<uint32_t>( key.function.num_vars() ) && w.dump_array( key.function._bits.data(), key.function.num_blocks() );
+  }
+
+  template<class Reader>
+  static bool read_function( Reader& r, detail::exact_synthesis_cache_key& key )
+  {
+    uint32_t num_vars;
+    if ( !r.load( &key.kind ) || !r.load( &num_vars ) || num_vars > 16u )
+      return false;
+    key.function = kitty::dynamic_truth_table( num_vars );
+    return r.load_array( key.function._bits.data(), key.function.num_blocks() );
+  }
+
+  template<class Writer>
+  static bool write_chain( Writer& w, percy::chain const& c )
+  {
+    if ( !w.template dump<int32_t>( c.get_nr_inputs() ) || !w.template dump<int32_t>( c.get_fanin() ) ||
+         !w.template dump<int32_t>( c.get_nr_steps() ) || !w.template dump<int32_t>( c.get_outputs()[0] ) )
+    {
+      return false;
+    }
+    for ( auto i = 0; i < c.get_nr_steps(); ++i )
+    {
+      auto const& op = c.get_operator( i );
+      if ( !w.dump_array( c.get_step( i ).data(), c.get_fanin() ) || !w.dump_array( op._bits.data(), op.num_blocks() ) )
+        return false;
+    }
+    return true;
+  }
+
+  template<class Reader>
+  static bool read_chain( Reader& r, percy::chain& c )
+  {
+    int32_t num_inputs, fanin, num_steps, output;
+    if ( !r.load( &num_inputs ) || !r.load( &fanin ) || !r.load( &num_steps ) || !r.load( &output ) ||
+         num_inputs < 0 || fanin < 1 || fanin > percy::MAX_FANIN || num_steps < 0 || output < 0 || ( output >> 1 ) > num_inputs + num_steps )
+    {
+      return false;
+    }
+
+    c.reset( num_inputs, 1, num_steps, fanin );
+    std::vector<int> step( fanin );
+    kitty::dynamic_truth_table op( fanin );
+    for ( auto i = 0; i < num_steps; ++i )
+    {
+      if ( !r.load_array( step.data(), fanin ) || !r.load_array( op._bits.data(), op.num_blocks() ) )
+        return false;
+      for ( auto const f : step )
+      {
+        if ( f < 0 || f >= num_inputs + i )
+          return false;
+      }
+      c.set_step( i, step, op );
+    }
+    c.set_output( 0, output );
+    return true;
+  }
+
+  template<class Writer>
+  bool write( Writer& w ) const
+  {
+    detail::exact_synthesis_cache_header header{};
+    std::memcpy( header.magic, "MTEXSYN\0", 8 );
+    header.version = detail::exact_synthesis_cache_version;
+    if ( !w.dump( header ) )
+      return false;
+
+    /* copy the entries, such that no shard is locked while writing */
+    std::vector<std::pair<detail::exact_synthesis_cache_key, percy::chain>> chains;
+    std::vector<std::pair<detail::exact_synthesis_cache_key, int32_t>> blacklist;
+    for ( auto& s : _shards )
+    {
+      std::lock_guard<std::mutex> lock( s.mutex );
+      chains.insert( chains.end(), s.chains.begin(), s.chains.end() );
+      blacklist.insert( blacklist.end(), s.blacklist.begin(), s.blacklist.end() );
+    }
+
+    if ( !w.template dump<uint64_t>( chains.size() ) )
+      return false;
+    for ( auto const& [key, c] : chains )
+    {
+      if ( !write_function( w, key ) || !write_chain( w, c ) )
+        return false;
+    }
+
+    if ( !w.template dump<uint64_t>( blacklist.size() ) )
+      return false;
+    for ( auto const& [key, limit] : blacklist )
+    {
+      if ( !write_function( w, key ) || !w.dump( limit ) )
+        return false;
+    }
+    return true;
+  }
+
+  /* entries are added to the cache only after the file has been read completely */
+  template<class Reader>
+  bool read( Reader& r )
+  {
+    detail::exact_synthesis_cache_header header;
+    if ( !r.load( &header ) || std::memcmp( header.magic, "MTEXSYN\0", 8 ) != 0 ||
+         header.version != detail::exact_synthesis_cache_version )
+    {
+      return false;
+    }
+
+    std::vector<std::pair<detail::exact_synthesis_cache_key, percy::chain>> chains;
+    std::vector<std::pair<detail::exact_synthesis_cache_key, int32_t>> blacklist;
+    uint64_t size;
+    if ( !r.load( &size ) )
+      return false;
+    for ( auto i = 0u; i < size; ++i )
+    {
+      auto& [key, c] = chains.emplace_back();
+      if ( !read_function( r, key ) || !read_chain( r, c ) || c.get_nr_inputs() != static_cast<int>( key.function.num_vars() ) )
+        return false;
+    }
+
+    if ( !r.load( &size ) )
+      return false;
+    for ( auto i = 0u; i < size; ++i )
+    {
+      auto& [key, limit] = blacklist.emplace_back();
+      if ( !read_function( r, key ) || !r.load( &limit ) )
+        return false;
+    }
+
+    for ( auto& [key, c] : chains )
+    {
+      auto& s = shard( key );
+      std::lock_guard<std::mutex> lock( s.mutex );
+      s.blacklist.erase( key );
+      s.chains.emplace( std::move( key ), std::move( c ) );
+    }
+    for ( auto& [key, limit] : blacklist )
+    {
+      auto& s = shard( key );
+      std::lock_guard<std::mutex> lock( s.mutex );
+      if ( s.chains.count( key ) == 0u )
+      {
+        add_to_blacklist( s, std::move( key ), limit );
+      }
+    }
+    return true;
+  }
+
+private:
+  std::array<cache_shard, num_shards> _shards;
+
+  std::atomic<uint64_t> _hits{ 0u };
+  std::atomic<uint64_t> _blacklist_hits{ 0u };
+  std::atomic<uint64_t> _misses{ 0u };
+};
+
+} // namespace mockturtle
@@ -89,4 +89,29 @@ struct supergate
   uint16_t polarity{ 0 };
 };
 
+/*! \cond PRIVATE */
+namespace detail
+{
+
+/* writes a supergate, replacing the pointer to its root by `root_index` */
+template<class Writer, unsigned NInputs>
+bool write_supergate( Writer& w, supergate<NInputs> const& sg, uint32_t root_index )
+{
+  return w.dump( root_index ) && w.dump( sg.area ) && w.dump( sg.tdelay ) && w.dump_vector( sg.permutation ) && w.dump( sg.polarity );
+}
+
+/* reads a supergate, whose root is looked up by index in `roots` */
+template<class Reader, unsigned NInputs>
+bool read_supergate( Reader& r, supergate<NInputs>& sg, std::vector<composed_gate<NInputs> const*> const& roots )
+{
+  uint32_t root_index;
+  if ( !r.load( &root_index ) || root_index >= roots.size() )
+    return false;
+  sg.root = roots[root_index];
+  return r.load( &sg.area ) && r.load( &sg.tdelay ) && r.load_vector( sg.permutation ) && r.load( &sg.polarity );
+}
+
+} // namespace detail
+/*! \endcond */
+
 } // namespace mockturtle
\ No newline at end of file
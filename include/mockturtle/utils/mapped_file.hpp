@@ -0,0 +1,146 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2023  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file mapped_file.hpp
+  \brief Read-only memory mapping of a file
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#if defined( _WIN32 )
+#include <fstream>
+#include <iterator>
+#include <vector>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace mockturtle
+{
+
+/*! \brief Read-only view of the content of a file.
+ *
+ * On POSIX systems, the file is mapped into memory, such that its pages
+ * are only read from disk when they are accessed.  On other systems, the
+ * file is read into a buffer.  The content remains valid as long as the
+ * object is alive.
+ */
+class mapped_file
+{
+public:
+  explicit mapped_file( std::string const& filename )
+  {
+#if defined( _WIN32 )
+    std::ifstream in( filename, std::ios::binary );
+    if ( !in.good() )
+    {
+      return;
+    }
+    _buffer.assign( std::istreambuf_iterator<char>( in ), std::istreambuf_iterator<char>() );
+    _data = _buffer.data();
+    _size = _buffer.size();
+    _open = true;
+#else
+    int const fd = ::open( filename.c_str(), O_RDONLY );
+    if ( fd < 0 )
+    {
+      return;
+    }
+
+    struct stat st;
+    if ( ::fstat( fd, &st ) == 0 )
+    {
+      _size = static_cast<std::size_t>( st.st_size );
+      if ( _size == 0u )
+      {
+        _open = true;
+      }
+      else
+      {
+        void* p = ::mmap( nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0 );
+        if ( p != MAP_FAILED )
+        {
+          ::madvise( p, _size, MADV_SEQUENTIAL );
+          _data = static_cast<char const*>( p );
+          _open = true;
+        }
+        else
+        {
+          _size = 0u;
+        }
+      }
+    }
+    ::close( fd );
+#endif
+  }
+
+  ~mapped_file()
+  {
+#if !defined( _WIN32 )
+    if ( _data != nullptr )
+    {
+      ::munmap( const_cast<char*>( _data ), _size );
+    }
+#endif
+  }
+
+  mapped_file( mapped_file const& ) = delete;
+  mapped_file& operator=( mapped_file const& ) = delete;
+
+  /*! \brief Whether the file could be opened. */
+  bool is_open() const
+  {
+    return _open;
+  }
+
+  /*! \brief Pointer to the first byte of the file. */
+  char const* data() const
+  {
+    return _data;
+  }
+
+  /*! \brief Size of the file in bytes. */
+  std::size_t size() const
+  {
+    return _size;
+  }
+
+private:
+  char const* _data{ nullptr };
+  std::size_t _size{ 0u };
+  bool _open{ false };
+#if defined( _WIN32 )
+  std::vector<char> _buffer;
+#endif
+};
+
+} // namespace mockturtle
@@ -34,7 +34,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <memory>
 #include <unordered_map>
 #include <variant>
@@ -194,6 +196,29 @@ public:
     }
   }
 
+  /*! \brief Moves the values to new node indices.
+   *
+   * This function should be called after the nodes of the network have
+   * been renumbered, e.g., by `compact_network`.  The value of the node
+   * with index `i` is moved to index `old_to_new[i]`; values of indices
+   * that are out of range of the network are dropped.
+   *
+   * \param old_to_new New index of each node
+   * \param init_value Value of nodes without an old index
+   */
+  void remap( std::vector<uint64_t> const& old_to_new, T const& init_value = {} )
+  {
+    container_type remapped( ntk->size(), init_value );
+    for ( auto i = 0u; i < std::min<uint64_t>( old_to_new.size(), data->size() ); ++i )
+    {
+      if ( old_to_new[i] < remapped.size() )
+      {
+        remapped[old_to_new[i]] = std::move( ( *data )[i] );
+      }
+    }
+    *data = std::move( remapped );
+  }
+
 private:
   Ntk const* ntk;
   std::shared_ptr<container_type> data;
@@ -330,6 +355,29 @@ public:
   {
   }
 
+  /*! \brief Moves the values to new node indices.
+   *
+   * This function should be called after the nodes of the network have
+   * been renumbered, e.g., by `compact_network`.  The value of the node
+   * with index `i` is moved to index `old_to_new[i]`; values of indices
+   * that are out of range of the network are dropped.
+   *
+   * \param old_to_new New index of each node
+   */
+  void remap( std::vector<uint64_t> const& old_to_new )
+  {
+    container_type remapped;
+    remapped.reserve( data->size() );
+    for ( auto& [index, value] : *data )
+    {
+      if ( index < old_to_new.size() && old_to_new[index] < ntk->size() )
+      {
+        remapped.emplace( old_to_new[index], std::move( value ) );
+      }
+    }
+    *data = std::move( remapped );
+  }
+
 protected:
   Ntk const* ntk;
   std::shared_ptr<container_type> data;
@@ -0,0 +1,385 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2023  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file output_buffer.hpp
+  \brief Buffered and compressed output for the writers
+
+  The writers format large netlists into an `output_buffer`, which hands
+  the text to the output stream in large blocks.  Independent parts of a
+  netlist (e.g., the gates) can be formatted in parallel with
+  `write_chunks`, which bounds the memory by formatting only a few chunks
+  at a time.  Files whose name ends with `.gz` are compressed with gzip
+  when mockturtle is built with zlib (CMake option `MOCKTURTLE_ZLIB`).
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#if defined( MOCKTURTLE_ZLIB )
+#include <zlib.h>
+#endif
+
+#include "thread_pool.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Appends the decimal representation of `value` to `out`. */
+template<typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+inline void append_number( std::string& out, T value )
+{
+  char digits[24];
+  auto const end = std::to_chars( digits, digits + sizeof( digits ), value ).ptr;
+  out.append( digits, end );
+}
+
+/*! \brief Buffer in front of an output stream.
+ *
+ * Text and bytes are collected in a buffer of fixed capacity, which is
+ * written to the stream whenever it is full, and when the buffer is
+ * flushed or destroyed.  Numbers are formatted directly into the buffer
+ * without temporary strings.
+ */
+class output_buffer
+{
+public:
+  /*! \brief Creates a buffer with `capacity` bytes (1 MB by default). */
+  explicit output_buffer( std::ostream& os, std::size_t capacity = std::size_t( 1 ) << 20u )
+      : _os( os ), _data( std::max<std::size_t>( capacity, 64u ) )
+  {
+  }
+
+  ~output_buffer()
+  {
+    flush();
+  }
+
+  output_buffer( output_buffer const& ) = delete;
+  output_buffer& operator=( output_buffer const& ) = delete;
+
+  /*! \brief Appends a character. */
+  void put( char c )
+  {
+    if ( _size == _data.size() )
+    {
+      write_block();
+    }
+    _data[_size++] = c;
+  }
+
+  /*! \brief Appends `n` bytes. */
+  void write( char const* s, std::size_t n )
+  {
+    if ( n > _data.size() - _size )
+    {
+      write_block();
+      if ( n >= _data.size() )
+      {
+        _os.write( s, n );
+        return;
+      }
+    }
+    std::memcpy( _data.data() + _size, s, n );
+    _size += n;
+  }
+
+  /*! \brief Appends a string. */
+  void write( std::string_view s )
+  {
+    write( s.data(), s.size() );
+  }
+
+  output_buffer& operator<<( std::string_view s )
+  {
+    write( s );
+    return *this;
+  }
+
+  output_buffer& operator<<( char const* s )
+  {
+    write( std::string_view( s ) );
+    return *this;
+  }
+
+  output_buffer& operator<<( std::string const& s )
+  {
+    write( s.data(), s.size() );
+    return *this;
+  }
+
+  output_buffer& operator<<( char c )
+  {
+    put( c );
+    return *this;
+  }
+
+  /*! \brief Appends the decimal representation of an integer. */
+  template<typename T, typename = std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, char> && !std::is_same_v<T, bool>>>
+  output_buffer& operator<<( T value )
+  {
+    if ( _data.size() - _size < 24u )
+    {
+      write_block();
+    }
+    _size = std::to_chars( _data.data() + _size, _data.data() + _data.size(), value ).ptr - _data.data();
+    return *this;
+  }
+
+  /*! \brief Writes the buffered content and flushes the stream. */
+  void flush()
+  {
+    write_block();
+    _os.flush();
+  }
+
+  /*! \brief Output stream of the buffer. */
+  std::ostream& stream()
+  {
+    return _os;
+  }
+
+private:
+  void write_block()
+  {
+    if ( _size > 0u )
+    {
+      _os.write( _data.data(), _size );
+      _size = 0u;
+    }
+  }
+
+private:
+  std::ostream& _os;
+  std::vector<char> _data;
+  std::size_t _size{ 0u };
+};
+
+/*! \brief Formats items in chunks and writes them in order.
+ *
+ * Calls `fn( begin, end, out )` for consecutive ranges of at most
+ * `chunk_size` items in `[0, num_items)`, where `fn` appends the text of
+ * the items in `[begin, end)` to the string `out`.  If a thread pool is
+ * given, the chunks are formatted in parallel in rounds of two chunks per
+ * thread, such that at most that many chunks are kept in memory.
+ */
+template<class Fn>
+void write_chunks( output_buffer& buffer, uint64_t num_items, uint64_t chunk_size, Fn&& fn, thread_pool* pool = nullptr )
+{
+  uint64_t const num_slots = pool ? 2u * pool->num_threads() : 1u;
+  std::vector<std::string> texts( num_slots );
+
+  for ( uint64_t first = 0u; first < num_items; first += num_slots * chunk_size )
+  {
+    uint64_t const num_chunks = std::min( num_slots, ( num_items - first + chunk_size - 1u ) / chunk_size );
+    auto const format = [&]( uint64_t k, uint32_t ) {
+      auto const begin = first + k * chunk_size;
+      texts[k].clear();
+      fn( begin, std::min( begin + chunk_size, num_items ), texts[k] );
+    };
+
+    if ( pool && num_chunks > 1u )
+    {
+      pool->parallel_for( 0u, num_chunks, format );
+    }
+    else
+    {
+      for ( auto k = 0u; k < num_chunks; ++k )
+      {
+        format( k, 0u );
+      }
+    }
+
+    for ( auto k = 0u; k < num_chunks; ++k )
+    {
+      buffer.write( texts[k] );
+    }
+  }
+}
+
+#if defined( MOCKTURTLE_ZLIB )
+/*! \brief Stream buffer that compresses its content with gzip into another stream. */
+class gzip_streambuf : public std::streambuf
+{
+public:
+  explicit gzip_streambuf( std::ostream& os, int level = Z_DEFAULT_COMPRESSION )
+      : _os( os ), _in( 1u << 16u ), _out( 1u << 16u )
+  {
+    /* 15 window bits + 16 selects the gzip format */
+    _ok = deflateInit2( &_stream, level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY ) == Z_OK;
+    setp( _in.data(), _in.data() + _in.size() );
+  }
+
+  ~gzip_streambuf() override
+  {
+    if ( _ok )
+    {
+      deflate_input( Z_FINISH );
+      deflateEnd( &_stream );
+    }
+  }
+
+  gzip_streambuf( gzip_streambuf const& ) = delete;
+  gzip_streambuf& operator=( gzip_streambuf const& ) = delete;
+
+protected:
+  int_type overflow( int_type ch ) override
+  {
+    if ( !deflate_input( Z_NO_FLUSH ) )
+    {
+      return traits_type::eof();
+    }
+    if ( !traits_type::eq_int_type( ch, traits_type::eof() ) )
+    {
+      *pptr() = traits_type::to_char_type( ch );
+      pbump( 1 );
+    }
+    return traits_type::not_eof( ch );
+  }
+
+  int sync() override
+  {
+    return deflate_input( Z_SYNC_FLUSH ) && _os.flush() ? 0 : -1;
+  }
+
+private:
+  bool deflate_input( int flush )
+  {
+    if ( !_ok )
+    {
+      return false;
+    }
+
+    _stream.next_in = reinterpret_cast<Bytef*>( pbase() );
+    _stream.avail_in = static_cast<uInt>( pptr() - pbase() );
+    do
+    {
+      _stream.next_out = reinterpret_cast<Bytef*>( _out.data() );
+      _stream.avail_out = static_cast<uInt>( _out.size() );
+      if ( deflate( &_stream, flush ) == Z_STREAM_ERROR )
+      {
+        return _ok = false;
+      }
+      _os.write( _out.data(), _out.size() - _stream.avail_out );
+    } while ( _stream.avail_out == 0u );
+
+    setp( _in.data(), _in.data() + _in.size() );
+    return true;
+  }
+
+private:
+  std::ostream& _os;
+  std::vector<char> _in;
+  std::vector<char> _out;
+  z_stream _stream{};
+  bool _ok{ false };
+};
+#endif
+
+/*! \brief Output file that is compressed if its name ends with `.gz`.
+ *
+ * Compression requires building with zlib (CMake option
+ * `MOCKTURTLE_ZLIB`); otherwise, a file whose name ends with `.gz` is not
+ * created, `is_open` returns false, and writing into `stream` has no
+ * effect.
+ */
+class output_file
+{
+public:
+  explicit output_file( std::string const& filename )
+  {
+    bool const compressed = filename.size() >= 3u && filename.compare( filename.size() - 3u, 3u, ".gz" ) == 0;
+#if !defined( MOCKTURTLE_ZLIB )
+    if ( compressed )
+    {
+      std::cerr << "[e] cannot write " << filename << ", gzip compression requires MOCKTURTLE_ZLIB\n";
+      _file.setstate( std::ios::badbit );
+      return;
+    }
+#endif
+
+    _file.open( filename, std::ofstream::out | std::ofstream::binary );
+
+#if defined( MOCKTURTLE_ZLIB )
+    if ( compressed )
+    {
+      _gzip = std::make_unique<gzip_streambuf>( _file );
+      _gzip_stream = std::make_unique<std::ostream>( _gzip.get() );
+    }
+#endif
+  }
+
+  ~output_file()
+  {
+#if defined( MOCKTURTLE_ZLIB )
+    /* finish the compressed stream before the file is closed */
+    _gzip_stream.reset();
+    _gzip.reset();
+#endif
+  }
+
+  output_file( output_file const& ) = delete;
+  output_file& operator=( output_file const& ) = delete;
+
+  /*! \brief Whether the file could be opened. */
+  bool is_open() const
+  {
+    return _file.is_open();
+  }
+
+  /*! \brief Stream to write into the file. */
+  std::ostream& stream()
+  {
+#if defined( MOCKTURTLE_ZLIB )
+    if ( _gzip_stream )
+    {
+      return *_gzip_stream;
+    }
+#endif
+    return _file;
+  }
+
+private:
+  std::ofstream _file;
+#if defined( MOCKTURTLE_ZLIB )
+  std::unique_ptr<gzip_streambuf> _gzip;
+  std::unique_ptr<std::ostream> _gzip_stream;
+#endif
+};
+
+} // namespace mockturtle
@@ -0,0 +1,175 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2023  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file string_pool.hpp
+  \brief Pool of interned strings
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+namespace mockturtle
+{
+
+/*! \brief Pool of interned strings.
+ *
+ * The characters of all strings are stored back to back in one buffer,
+ * and each distinct string is identified by a dense index in the order of
+ * insertion.  Inserting a string that is already in the pool returns the
+ * index of the existing copy.  The lookup uses an open-addressing hash
+ * table that stores only the indexes of the strings.
+ *
+ * Strings are never removed from the pool; the string views returned by
+ * `operator[]` are invalidated when further strings are inserted.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      string_pool pool;
+      auto const a = pool.insert( "a" );   // index is 0
+      auto const b = pool.insert( "b" );   // index is 1
+      pool.insert( "a" );                  // index is 0
+      std::cout << pool[b] << "\n";        // prints b
+   \endverbatim
+ */
+class string_pool
+{
+public:
+  /*! \brief Marks a failed lookup. */
+  static constexpr uint32_t npos = std::numeric_limits<uint32_t>::max();
+
+public:
+  /*! \brief Inserts a string and returns its index. */
+  uint32_t insert( std::string_view s )
+  {
+    if ( 2u * ( size() + 1u ) > _table.size() )
+    {
+      rehash( std::max<std::size_t>( 2u * _table.size(), 64u ) );
+    }
+
+    auto slot = find_slot( s );
+    if ( _table[slot] == npos )
+    {
+      _table[slot] = size();
+      _chars.insert( _chars.end(), s.begin(), s.end() );
+      _offsets.push_back( _chars.size() );
+    }
+    return _table[slot];
+  }
+
+  /*! \brief Returns the index of a string, or `npos` if it is not in the pool. */
+  uint32_t find( std::string_view s ) const
+  {
+    return _table.empty() ? npos : _table[find_slot( s )];
+  }
+
+  /*! \brief Returns the string at an index. */
+  std::string_view operator[]( uint32_t index ) const
+  {
+    assert( index < size() );
+    return std::string_view( _chars.data() + _offsets[index], _offsets[index + 1u] - _offsets[index] );
+  }
+
+  /*! \brief Number of distinct strings. */
+  uint32_t size() const
+  {
+    return static_cast<uint32_t>( _offsets.size() - 1u );
+  }
+
+  /*! \brief Total number of characters of all strings. */
+  uint64_t num_chars() const
+  {
+    return _chars.size();
+  }
+
+  /*! \brief Reserves space for `num_strings` strings with `num_chars` characters in total. */
+  void reserve( uint32_t num_strings, uint64_t num_chars = 0u )
+  {
+    _offsets.reserve( num_strings + 1u );
+    _chars.reserve( num_chars );
+    if ( 2u * num_strings > _table.size() )
+    {
+      rehash( std::max<std::size_t>( next_power_of_two( 2u * num_strings ), 64u ) );
+    }
+  }
+
+  /*! \brief Removes all strings. */
+  void clear()
+  {
+    _chars.clear();
+    _offsets.assign( 1u, 0u );
+    _table.clear();
+  }
+
+private:
+  static std::size_t next_power_of_two( std::size_t n )
+  {
+    std::size_t p = 1u;
+    while ( p < n )
+    {
+      p <<= 1u;
+    }
+    return p;
+  }
+
+  /* slot of `s`, or the empty slot where `s` would be inserted */
+  std::size_t find_slot( std::string_view s ) const
+  {
+    auto const mask = _table.size() - 1u;
+    auto slot = std::hash<std::string_view>{}( s ) & mask;
+    while ( _table[slot] != npos && ( *this )[_table[slot]] != s )
+    {
+      slot = ( slot + 1u ) & mask;
+    }
+    return slot;
+  }
+
+  void rehash( std::size_t table_size )
+  {
+    _table.assign( table_size, npos );
+    for ( auto i = 0u; i < size(); ++i )
+    {
+      _table[find_slot( ( *this )[i] )] = i;
+    }
+  }
+
+private:
+  std::vector<char> _chars;
+  std::vector<uint64_t> _offsets{ 0u };
+  std::vector<uint32_t> _table;
+};
+
+} // namespace mockturtle
@@ -202,6 +202,59 @@ public:
     generate_library( min_vars );
   }
 
+  /*! \brief Writes the structural library.
+   *
+   * Writes the AND table and the gates of each label of a constructed
+   * library to a snapshot writer (see `tech_library_params::cache_directory`).
+   */
+  template<class Writer>
+  bool serialize( Writer& w ) const
+  {
+    if ( !w.dump( num_large_gates ) || !w.dump( static_cast<uint64_t>( _and_table.size() ) ) )
+      return false;
+
+    for ( auto const& [key, id] : _and_table )
+    {
+      if ( !w.dump( std::get<0>( key ).data ) || !w.dump( std::get<1>( key ).data ) || !w.dump( id ) )
+        return false;
+    }
+
+    if ( !w.dump( static_cast<uint64_t>( _label_to_gate.size() ) ) )
+      return false;
+
+    for ( auto const& [label, gates] : _label_to_gate )
+    {
+      if ( !w.dump( label ) || !w.dump( static_cast<uint64_t>( gates.size() ) ) )
+        return false;
+      for ( auto const& sg : gates )
+      {
+        if ( !detail::write_supergate( w, sg, sg.root->id ) )
+          return false;
+      }
+    }
+
+    return true;
+  }
+
+  /*! \brief Reads the structural library.
+   *
+   * Replaces `construct` by loading the tables written with `serialize`
+   * for the same gates.  Returns false if the data is invalid.
+   */
+  template<class Reader>
+  bool deserialize( Reader& r )
+  {
+    clear();
+    _supergates.reserve( _gates.size() );
+    generate_composed_gates();
+
+    if ( deserialize_tables( r ) )
+      return true;
+
+    clear();
+    return false;
+  }
+
   /*! \brief Construct the structural library.
    *
    * Generates the patterns for structural matching.
@@ -278,6 +331,60 @@ public:
   }
 
 private:
+  void clear()
+  {
+    num_large_gates = 0;
+    _supergates.clear();
+    _and_table.clear();
+    _label_to_gate.clear();
+  }
+
+  /* reads the tables written by `serialize` given the composed gates */
+  template<class Reader>
+  bool deserialize_tables( Reader& r )
+  {
+    std::vector<composed_gate<NInputs> const*> roots;
+    roots.reserve( _supergates.size() );
+    for ( auto const& g : _supergates )
+    {
+      roots.push_back( &g );
+    }
+
+    uint64_t size;
+    if ( !r.load( &num_large_gates ) || !r.load( &size ) )
+      return false;
+
+    for ( auto i = 0u; i < size; ++i )
+    {
+      signal s0, s1;
+      uint32_t id;
+      if ( !r.load( &s0.data ) || !r.load( &s1.data ) || !r.load( &id ) )
+        return false;
+      _and_table[std::make_tuple( s0, s1 )] = id;
+    }
+
+    if ( !r.load( &size ) )
+      return false;
+
+    for ( auto i = 0u; i < size; ++i )
+    {
+      uint32_t label;
+      uint64_t num_gates;
+      if ( !r.load( &label ) || !r.load( &num_gates ) )
+        return false;
+
+      auto& gates = _label_to_gate[label];
+      gates.resize( num_gates );
+      for ( auto& sg : gates )
+      {
+        if ( !detail::read_supergate( r, sg, roots ) )
+          return false;
+      }
+    }
+
+    return true;
+  }
+
   void generate_library( uint32_t min_vars )
   {
     /* select and load gates */
@@ -32,6 +32,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cassert>
 #include <deque>
 #include <unordered_map>
@@ -55,6 +56,13 @@ struct super_utils_params
 
   /*! \brief reports loaded supergates */
   bool verbose{ false };
+
+  /*! \brief generates the supergates on construction
+   *
+   * If false, the supergates are loaded with `deserialize` or
+   * generated with `generate`.
+   */
+  bool generate{ true };
 };
 
 /*! \brief Utilities to generate supergates
@@ -84,6 +92,22 @@ public:
         _supergates(),
         _multioutput_gates()
   {
+    if ( _ps.generate )
+    {
+      generate();
+    }
+  }
+
+  /*! \brief Generates the supergates.
+   *
+   * Creates the supergates from the gates and the supergates
+   * specifications. Called on construction unless
+   * `super_utils_params::generate` is false.
+   */
+  void generate()
+  {
+    clear();
+
     if ( _supergates_spec.supergates.size() == 0 )
     {
       generate_library_with_genlib();
@@ -94,6 +118,71 @@ public:
     }
   }
 
+  /*! \brief Writes the supergates.
+   *
+   * Writes the generated supergates and multi-output gates to a
+   * snapshot writer, replacing the pointers to the library gates
+   * and to the fanin supergates by their indices.
+   */
+  template<class Writer>
+  bool serialize( Writer& w ) const
+  {
+    auto const write_gate = [&]( composed_gate<NInputs> const& g ) {
+      uint32_t const root = g.root == nullptr ? UINT32_MAX : static_cast<uint32_t>( g.root - _gates.data() );
+      if ( !w.dump( g.id ) || !w.dump( g.is_super ) || !w.dump( root ) || !w.dump( g.num_vars ) ||
+           !w.dump( g.function.num_vars() ) || !w.dump_vector( g.function._bits ) || !w.dump( g.area ) ||
+           !w.dump( g.tdelay ) || !w.dump( static_cast<uint64_t>( g.fanin.size() ) ) )
+        return false;
+      for ( auto const* f : g.fanin )
+      {
+        if ( !w.dump( f->id ) )
+          return false;
+      }
+      return true;
+    };
+
+    if ( !w.dump( simple_gates_size ) || !w.dump( static_cast<uint64_t>( _supergates.size() ) ) )
+      return false;
+    for ( auto const& g : _supergates )
+    {
+      if ( !write_gate( g ) )
+        return false;
+    }
+
+    if ( !w.dump( static_cast<uint64_t>( _multioutput_gates.size() ) ) )
+      return false;
+    for ( auto const& multi_gate : _multioutput_gates )
+    {
+      if ( !w.dump( static_cast<uint64_t>( multi_gate.size() ) ) )
+        return false;
+      for ( auto const& g : multi_gate )
+      {
+        if ( !write_gate( g ) )
+          return false;
+      }
+    }
+
+    return true;
+  }
+
+  /*! \brief Reads the supergates.
+   *
+   * Replaces `generate` by loading the supergates written with
+   * `serialize` for the same gates.  Returns false if the data is
+   * invalid.
+   */
+  template<class Reader>
+  bool deserialize( Reader& r )
+  {
+    clear();
+
+    if ( deserialize_gates( r ) )
+      return true;
+
+    clear();
+    return false;
+  }
+
   /*! \brief Get the all the supergates.
    *
    * Returns a list of supergates created accordingly to
@@ -371,6 +460,70 @@ public:
   }
 
 private:
+  void clear()
+  {
+    simple_gates_size = 0;
+    _supergates.clear();
+    _multioutput_gates.clear();
+  }
+
+  template<class Reader>
+  bool deserialize_gates( Reader& r )
+  {
+    /* fanins always precede the gates in `_supergates` */
+    auto const read_gate = [&]( composed_gate<NInputs>& g ) {
+      uint32_t root, num_vars;
+      uint64_t num_fanins;
+      if ( !r.load( &g.id ) || !r.load( &g.is_super ) || !r.load( &root ) || !r.load( &g.num_vars ) ||
+           !r.load( &num_vars ) || num_vars > std::max( NInputs, truth_table_size ) || ( root != UINT32_MAX && root >= _gates.size() ) )
+        return false;
+
+      g.root = root == UINT32_MAX ? nullptr : &_gates[root];
+      g.function = kitty::dynamic_truth_table( num_vars );
+      if ( !r.load_vector( g.function._bits ) || g.function._bits.size() != g.function.num_blocks() ||
+           !r.load( &g.area ) || !r.load( &g.tdelay ) || !r.load( &num_fanins ) || num_fanins > NInputs )
+        return false;
+
+      for ( auto i = 0u; i < num_fanins; ++i )
+      {
+        uint32_t id;
+        if ( !r.load( &id ) || id >= _supergates.size() )
+          return false;
+        g.fanin.push_back( &_supergates[id] );
+      }
+      return true;
+    };
+
+    uint64_t size;
+    if ( !r.load( &simple_gates_size ) || !r.load( &size ) )
+      return false;
+    for ( auto i = 0u; i < size; ++i )
+    {
+      composed_gate<NInputs> g{};
+      if ( !read_gate( g ) )
+        return false;
+      _supergates.push_back( std::move( g ) );
+    }
+
+    if ( !r.load( &size ) )
+      return false;
+    _multioutput_gates.resize( size );
+    for ( auto& multi_gate : _multioutput_gates )
+    {
+      uint64_t num_outputs;
+      if ( !r.load( &num_outputs ) || num_outputs > _gates.size() )
+        return false;
+      multi_gate.resize( num_outputs );
+      for ( auto& g : multi_gate )
+      {
+        if ( !read_gate( g ) )
+          return false;
+      }
+    }
+
+    return true;
+  }
+
   inline float compute_area( uint32_t root_id, std::vector<composed_gate<NInputs>*> const& sub_gates )
   {
     float area = _gates[root_id].area;
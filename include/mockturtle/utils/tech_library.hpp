@@ -36,6 +36,12 @@
 
 #include <array>
 #include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
@@ -50,7 +56,9 @@
 #include <parallel_hashmap/phmap.h>
 
 #include "../io/genlib_reader.hpp"
+#include "../io/serialize.hpp"
 #include "../io/super_reader.hpp"
+#include "mapped_file.hpp"
 #include "include/supergate.hpp"
 #include "standard_cell.hpp"
 #include "struct_library.hpp"
@@ -118,6 +126,16 @@ struct tech_library_params
   /*! \brief Loads multioutput gates in single-output library */
   bool load_multioutput_gates_single{ false };
 
+  /*! \brief Directory of the persistent cache of matching tables.
+   *
+   * If not empty, the library looks in this directory for the supergates
+   * and matching tables built from the same gates, supergates, and
+   * parameters before generating them, and stores them there after
+   * generating them.  The cache files are keyed by a hash of the library
+   * content and are not platform-independent.
+   */
+  std::string cache_directory{};
+
   /*! \brief reports np enumerations */
   bool verbose{ false };
 
@@ -142,6 +160,87 @@ struct tuple_tt_hash
   }
 };
 
+/*! \brief Current version of the format of the library caches. */
+static constexpr uint32_t library_cache_version = 2u;
+
+struct library_cache_header
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t num_inputs;
+
+  /*! \brief Hash of the library content and parameters. */
+  uint64_t key;
+};
+
+/* FNV-1a hash of the content of a library */
+struct library_cache_hash
+{
+  template<typename T>
+  void operator()( T const& v )
+  {
+    if constexpr ( std::is_same_v<T, std::string> )
+    {
+      ( *this )( static_cast<uint64_t>( v.size() ) );
+      combine( v.data(), v.size() );
+    }
+    else if constexpr ( snapshot_is_vector<T>::value )
+    {
+      ( *this )( static_cast<uint64_t>( v.size() ) );
+      for ( auto const& e : v )
+      {
+        ( *this )( e );
+      }
+    }
+    else
+    {
+      static_assert( std::is_trivially_copyable_v<T>, "T is not trivially copyable" );
+      combine( reinterpret_cast<char const*>( &v ), sizeof( T ) );
+    }
+  }
+
+  void operator()( gate const& g )
+  {
+    ( *this )( g.id );
+    ( *this )( g.name );
+    ( *this )( g.expression );
+    ( *this )( g.num_vars );
+    ( *this )( g.function._bits );
+    ( *this )( g.area );
+    ( *this )( static_cast<uint64_t>( g.pins.size() ) );
+    for ( auto const& p : g.pins )
+    {
+      ( *this )( p.name );
+      ( *this )( p.phase );
+      ( *this )( p.input_load );
+      ( *this )( p.max_load );
+      ( *this )( p.rise_block_delay );
+      ( *this )( p.rise_fanout_delay );
+      ( *this )( p.fall_block_delay );
+      ( *this )( p.fall_fanout_delay );
+    }
+    ( *this )( g.output_name );
+  }
+
+  void operator()( supergate_spec const& sg )
+  {
+    ( *this )( sg.id );
+    ( *this )( sg.name );
+    ( *this )( sg.is_super );
+    ( *this )( sg.fanin_id );
+  }
+
+  void combine( char const* p, size_t size )
+  {
+    for ( auto i = 0u; i < size; ++i )
+    {
+      value = ( value ^ static_cast<uint8_t>( p[i] ) ) * UINT64_C( 0x100000001b3 );
+    }
+  }
+
+  uint64_t value{ UINT64_C( 0xcbf29ce484222325 ) };
+};
+
 } // namespace detail
 
 /*! \brief Library of gates for Boolean matching
@@ -200,7 +299,7 @@ public:
         _supergates_spec( supergates_spec ),
         _ps( ps ),
         _cells( get_standard_cells( _gates ) ),
-        _super( _gates, _supergates_spec, super_utils_params{ ps.load_multioutput_gates_single, ps.verbose } ),
+        _super( _gates, _supergates_spec, super_utils_params{ ps.load_multioutput_gates_single, ps.verbose, ps.cache_directory.empty() } ),
         _use_supergates( false ),
         _struct( _gates, struct_library_params{ ps.load_minimum_size_only, ps.very_verbose } ),
         _super_lib(),
@@ -209,15 +308,7 @@ public:
   {
     static_assert( NInputs < 16, "The technology library database supports NInputs up to 15\n" );
 
-    generate_library();
-
-    if ( ps.load_multioutput_gates )
-      generate_multioutput_library();
-
-    if ( ps.load_large_gates )
-    {
-      _struct.construct( 2 );
-    }
+    initialize();
   }
 
   explicit tech_library( std::vector<gate> const& gates, super_lib const& supergates_spec, tech_library_params const ps = {} )
@@ -225,7 +316,7 @@ public:
         _supergates_spec( supergates_spec ),
         _ps( ps ),
         _cells( get_standard_cells( _gates ) ),
-        _super( _gates, _supergates_spec, super_utils_params{ ps.load_multioutput_gates_single, ps.verbose } ),
+        _super( _gates, _supergates_spec, super_utils_params{ ps.load_multioutput_gates_single, ps.verbose, ps.cache_directory.empty() } ),
         _use_supergates( true ),
         _struct( _gates, struct_library_params{ ps.load_minimum_size_only, ps.very_verbose } ),
         _super_lib(),
@@ -234,15 +325,7 @@ public:
   {
     static_assert( NInputs < 16, "The technology library database supports NInputs up to 15\n" );
 
-    generate_library();
-
-    if ( ps.load_multioutput_gates )
-      generate_multioutput_library();
-
-    if ( ps.load_large_gates )
-    {
-      _struct.construct( 2 );
-    }
+    initialize();
   }
 
   /*! \brief Get the gates matching the function.
@@ -365,7 +448,277 @@ public:
     return _struct.get_struct_library().size();
   }
 
+  /*! \brief Returns whether the matching tables have been loaded from the cache. */
+  bool loaded_from_cache() const
+  {
+    return _loaded_from_cache;
+  }
+
 private:
+  void initialize()
+  {
+    if ( !_ps.cache_directory.empty() && load_cache() )
+    {
+      _loaded_from_cache = true;
+      return;
+    }
+
+    /* the supergates are not generated on construction when a cache is used */
+    if ( !_ps.cache_directory.empty() )
+    {
+      _super.generate();
+    }
+
+    generate_library();
+
+    if ( _ps.load_multioutput_gates )
+      generate_multioutput_library();
+
+    if ( _ps.load_large_gates )
+    {
+      _struct.construct( 2 );
+    }
+
+    if ( !_ps.cache_directory.empty() )
+    {
+      save_cache();
+    }
+  }
+
+#pragma region Cache
+  uint64_t cache_key() const
+  {
+    detail::library_cache_hash h;
+    h( detail::library_cache_version );
+    h( NInputs );
+    h( Configuration );
+    h( _ps.load_large_gates );
+    h( _ps.load_multioutput_gates );
+    h( _ps.load_minimum_size_only );
+    h( _ps.remove_dominated_gates );
+    h( _ps.load_multioutput_gates_single );
+
+    h( static_cast<uint64_t>( _gates.size() ) );
+    for ( auto const& g : _gates )
+    {
+      h( g );
+    }
+
+    h( _use_supergates );
+    h( _supergates_spec.max_num_vars );
+    h( _supergates_spec.num_supergates );
+    h( static_cast<uint64_t>( _supergates_spec.supergates.size() ) );
+    for ( auto const& sg : _supergates_spec.supergates )
+    {
+      h( sg );
+    }
+
+    return h.value;
+  }
+
+  std::string cache_filename() const
+  {
+    return fmt::format( "{}/tech_library_{:016x}.bin", _ps.cache_directory, cache_key() );
+  }
+
+  /* composed gates referenced by the matching tables, identified by their position */
+  std::vector<composed_gate<NInputs> const*> cache_roots() const
+  {
+    std::vector<composed_gate<NInputs> const*> roots;
+    for ( auto const& g : _super.get_super_library() )
+    {
+      roots.push_back( &g );
+    }
+    for ( auto const& multi_gate : _super.get_multioutput_library() )
+    {
+      for ( auto const& g : multi_gate )
+      {
+        roots.push_back( &g );
+      }
+    }
+    return roots;
+  }
+
+  template<class Writer>
+  bool write_cache( Writer& w ) const
+  {
+    detail::library_cache_header header{};
+    std::memcpy( header.magic, "MTTLIB\0\0", 8 );
+    header.version = detail::library_cache_version;
+    header.num_inputs = NInputs;
+    header.key = cache_key();
+
+    std::unordered_map<composed_gate<NInputs> const*, uint32_t> root_index;
+    for ( auto const* g : cache_roots() )
+    {
+      root_index.emplace( g, static_cast<uint32_t>( root_index.size() ) );
+    }
+
+    auto const write_list = [&]( supergates_list_t const& list ) {
+      if ( !w.dump( static_cast<uint64_t>( list.size() ) ) )
+        return false;
+      for ( auto const& sg : list )
+      {
+        if ( !detail::write_supergate( w, sg, root_index.at( sg.root ) ) )
+          return false;
+      }
+      return true;
+    };
+
+    if ( !w.dump( header ) || !_super.serialize( w ) || !w.dump( _inv_area ) || !w.dump( _inv_delay ) || !w.dump( _inv_id ) ||
+         !w.dump( _buf_area ) || !w.dump( _buf_delay ) || !w.dump( _buf_id ) || !w.dump( _max_size ) )
+    {
+      return false;
+    }
+
+    if ( !w.dump( static_cast<uint64_t>( _super_lib.size() ) ) )
+      return false;
+    for ( auto const& [tt, list] : _super_lib )
+    {
+      if ( !w.dump( tt._bits ) || !write_list( list ) )
+        return false;
+    }
+
+    if ( !w.dump( static_cast<uint64_t>( _multi_lib.size() ) ) )
+      return false;
+    for ( auto const& [tts, lists] : _multi_lib )
+    {
+      for ( auto i = 0u; i < max_multi_outputs; ++i )
+      {
+        if ( !w.dump( tts[i]._bits ) || !write_list( lists[i] ) )
+          return false;
+      }
+    }
+
+    if ( !w.dump( static_cast<uint64_t>( _multi_funcs.size() ) ) )
+      return false;
+    for ( auto const& [tt, func] : _multi_funcs )
+    {
+      if ( !w.dump( tt ) || !w.dump( func ) )
+        return false;
+    }
+
+    return !_ps.load_large_gates || _struct.serialize( w );
+  }
+
+  template<class Reader>
+  bool read_cache( Reader& r )
+  {
+    detail::library_cache_header header;
+    if ( !r.load( &header ) || std::memcmp( header.magic, "MTTLIB\0\0", 8 ) != 0 ||
+         header.version != detail::library_cache_version || header.num_inputs != NInputs || header.key != cache_key() )
+    {
+      return false;
+    }
+
+    /* the supergates are loaded first, as the matching tables refer to them */
+    if ( !_super.deserialize( r ) )
+      return false;
+
+    auto const roots = cache_roots();
+    auto const read_list = [&]( supergates_list_t& list ) {
+      uint64_t size;
+      if ( !r.load( &size ) )
+        return false;
+      list.resize( size );
+      for ( auto& sg : list )
+      {
+        if ( !detail::read_supergate( r, sg, roots ) )
+          return false;
+      }
+      return true;
+    };
+
+    if ( !r.load( &_inv_area ) || !r.load( &_inv_delay ) || !r.load( &_inv_id ) ||
+         !r.load( &_buf_area ) || !r.load( &_buf_delay ) || !r.load( &_buf_id ) || !r.load( &_max_size ) )
+    {
+      return false;
+    }
+
+    uint64_t size;
+    if ( !r.load( &size ) )
+      return false;
+    _super_lib.reserve( size );
+    for ( auto i = 0u; i < size; ++i )
+    {
+      TT tt;
+      if ( !r.load( &tt._bits ) || !read_list( _super_lib[tt] ) )
+        return false;
+    }
+
+    if ( !r.load( &size ) )
+      return false;
+    _multi_lib.reserve( size );
+    for ( auto i = 0u; i < size; ++i )
+    {
+      multi_relation_t tts;
+      multi_supergates_list_t lists;
+      for ( auto j = 0u; j < max_multi_outputs; ++j )
+      {
+        if ( !r.load( &tts[j]._bits ) || !read_list( lists[j] ) )
+          return false;
+      }
+      _multi_lib[tts] = std::move( lists );
+    }
+
+    if ( !r.load( &size ) )
+      return false;
+    _multi_funcs.reserve( size );
+    for ( auto i = 0u; i < size; ++i )
+    {
+      uint64_t tt, func;
+      if ( !r.load( &tt ) || !r.load( &func ) )
+        return false;
+      _multi_funcs[tt] = func;
+    }
+
+    return !_ps.load_large_gates || _struct.deserialize( r );
+  }
+
+  bool load_cache()
+  {
+    mapped_file file( cache_filename() );
+    if ( !file.is_open() )
+      return false;
+
+    detail::snapshot_memory_archive ar{ file.data(), 0u, file.size() };
+    detail::snapshot_reader<detail::snapshot_memory_archive> r( ar );
+    if ( read_cache( r ) )
+      return true;
+
+    /* invalid cache file: the tables are generated again */
+    _super_lib.clear();
+    _multi_lib.clear();
+    _multi_funcs.clear();
+    _max_size = 0;
+    return false;
+  }
+
+  void save_cache() const
+  {
+    /* write to a temporary file first, such that concurrent processes never read a partial cache */
+    auto const filename = cache_filename();
+    auto const tmp_filename = fmt::format( "{}.{:08x}.tmp", filename, std::random_device{}() );
+
+    bool okay;
+    {
+      std::ofstream os( tmp_filename, std::ofstream::binary );
+      detail::snapshot_ostream_archive ar{ os };
+      detail::snapshot_writer<detail::snapshot_ostream_archive> w( ar );
+      okay = os.is_open() && write_cache( w );
+    }
+
+    if ( !okay || std::rename( tmp_filename.c_str(), filename.c_str() ) != 0 )
+    {
+      std::remove( tmp_filename.c_str() );
+      if ( _ps.verbose )
+      {
+        std::cerr << fmt::format( "[i] WARNING: could not write the library cache {}\n", filename );
+      }
+    }
+  }
+#pragma endregion
+
   void generate_library()
   {
     bool inv = false;
@@ -1158,6 +1511,7 @@ private:
   unsigned _max_size{ 0 }; /* max #fanins of the gates in the library */
 
   bool _use_supergates;
+  bool _loaded_from_cache{ false };
 
   std::vector<gate> const _gates;    /* collection of gates */
   super_lib const& _supergates_spec; /* collection of supergates declarations */
@@ -1351,7 +1705,208 @@ public:
     return std::make_pair( _ps.area_inverter, _ps.delay_inverter );
   }
 
+  /*! \brief Writes the library to an output stream.
+   *
+   * Writes the database and the matching tables, such that the library
+   * can be restored by `deserialize` without running the resynthesis
+   * again.
+   *
+   * \param os Output stream (opened in binary mode)
+   * \return Whether the library has been written successfully
+   */
+  bool serialize( std::ostream& os ) const
+  {
+    detail::snapshot_ostream_archive ar{ os };
+    return write_library( ar );
+  }
+
+  /*! \brief Writes the library to a file. */
+  bool serialize( std::string const& filename ) const
+  {
+    std::ofstream os( filename, std::ofstream::binary );
+    return os.is_open() && serialize( os );
+  }
+
+  /*! \brief Reads the library from an input stream.
+   *
+   * Replaces the content of the library by the one written by `serialize`.
+   * Libraries written with different parameters, network types, or
+   * numbers of inputs are rejected.
+   *
+   * \param is Input stream (opened in binary mode)
+   * \return Whether the library has been read successfully
+   */
+  bool deserialize( std::istream& is )
+  {
+    detail::snapshot_istream_archive ar{ is };
+    return read_library( ar );
+  }
+
+  /*! \brief Reads the library from a file. */
+  bool deserialize( std::string const& filename )
+  {
+    mapped_file file( filename );
+    if ( !file.is_open() )
+      return false;
+
+    detail::snapshot_memory_archive ar{ file.data(), 0u, file.size() };
+    return read_library( ar );
+  }
+
 private:
+#pragma region Serialization
+  uint64_t library_key() const
+  {
+    detail::library_cache_hash h;
+    h( detail::library_cache_version );
+    h( detail::snapshot_type_id<Ntk>() );
+    h( NInputs );
+    h( _ps.area_gate );
+    h( _ps.area_inverter );
+    h( _ps.delay_gate );
+    h( _ps.delay_inverter );
+    h( _ps.np_classification );
+    h( _ps.compute_dc_classes );
+    return h.value;
+  }
+
+  template<class Archive>
+  bool write_library( Archive& ar ) const
+  {
+    detail::snapshot_writer<Archive> w( ar );
+
+    detail::library_cache_header header{};
+    std::memcpy( header.magic, "MTEXLIB\0", 8 );
+    header.version = detail::library_cache_version;
+    header.num_inputs = NInputs;
+    header.key = library_key();
+
+    /* the embedded snapshot is written through `w`, such that its arrays are aligned relative to the file */
+    if ( !w.dump( header ) || !detail::write_snapshot( _database, w ) )
+      return false;
+
+    if ( !w.dump( static_cast<uint64_t>( _super_lib.size() ) ) )
+      return false;
+
+    std::unordered_map<supergates_list_t const*, TT> list_keys;
+    for ( auto const& [tt, list] : _super_lib )
+    {
+      list_keys.emplace( &list, tt );
+      if ( !w.dump( tt._bits ) || !w.dump( static_cast<uint64_t>( list.size() ) ) )
+        return false;
+      for ( auto const& sg : list )
+      {
+        if ( !w.dump( sg.root ) || !w.dump( sg.n_inputs ) || !w.dump( sg.polarity ) ||
+             !w.dump( sg.area ) || !w.dump( sg.worstDelay ) || !w.dump( sg.tdelay ) )
+          return false;
+      }
+    }
+
+    if ( !w.dump( static_cast<uint64_t>( _dc_lib.size() ) ) )
+      return false;
+
+    for ( auto const& [tt, transformations] : _dc_lib )
+    {
+      if ( !w.dump( tt._bits ) || !w.dump( static_cast<uint64_t>( transformations.size() ) ) )
+        return false;
+      for ( auto const& [dc, transformation] : transformations )
+      {
+        auto const& [list, phase, perm] = transformation;
+        if ( !w.dump( dc._bits ) || !w.dump( list_keys.at( list )._bits ) || !w.dump( phase ) || !w.dump( perm ) )
+          return false;
+      }
+    }
+
+    return w.align();
+  }
+
+  template<class Archive>
+  bool read_library( Archive& ar )
+  {
+    _database = Ntk();
+    _super_lib.clear();
+    _dc_lib.clear();
+
+    if ( read_library_tables( ar ) )
+      return true;
+
+    _database = Ntk();
+    _super_lib.clear();
+    _dc_lib.clear();
+    return false;
+  }
+
+  template<class Archive>
+  bool read_library_tables( Archive& ar )
+  {
+    detail::snapshot_reader<Archive> r( ar );
+
+    detail::library_cache_header header;
+    if ( !r.load( &header ) || std::memcmp( header.magic, "MTEXLIB\0", 8 ) != 0 ||
+         header.version != detail::library_cache_version || header.num_inputs != NInputs || header.key != library_key() )
+    {
+      return false;
+    }
+
+    if ( !detail::read_snapshot( _database, r ) )
+      return false;
+
+    uint64_t size;
+    if ( !r.load( &size ) )
+      return false;
+
+    for ( auto i = 0u; i < size; ++i )
+    {
+      TT tt;
+      uint64_t num_supergates;
+      if ( !r.load( &tt._bits ) || !r.load( &num_supergates ) )
+        return false;
+
+      auto& list = _super_lib[tt];
+      for ( auto j = 0u; j < num_supergates; ++j )
+      {
+        signal<Ntk> root;
+        if ( !r.load( &root ) )
+          return false;
+
+        exact_supergate<Ntk, NInputs> sg( root );
+        if ( !r.load( &sg.n_inputs ) || !r.load( &sg.polarity ) || !r.load( &sg.area ) ||
+             !r.load( &sg.worstDelay ) || !r.load( &sg.tdelay ) )
+          return false;
+        list.push_back( sg );
+      }
+    }
+
+    if ( !r.load( &size ) )
+      return false;
+
+    for ( auto i = 0u; i < size; ++i )
+    {
+      TT tt;
+      uint64_t num_transformations;
+      if ( !r.load( &tt._bits ) || !r.load( &num_transformations ) )
+        return false;
+
+      auto& transformations = _dc_lib[tt];
+      for ( auto j = 0u; j < num_transformations; ++j )
+      {
+        TT dc, list_key;
+        uint32_t phase;
+        std::array<uint8_t, NInputs> perm;
+        if ( !r.load( &dc._bits ) || !r.load( &list_key._bits ) || !r.load( &phase ) || !r.load( &perm ) )
+          return false;
+
+        auto const list = _super_lib.find( list_key );
+        if ( list == _super_lib.end() )
+          return false;
+        transformations.emplace_back( dc, std::make_tuple( &list->second, phase, perm ) );
+      }
+    }
+
+    return r.align();
+  }
+#pragma endregion
+
   template<class RewritingFn>
   void generate_library( RewritingFn const& rewriting_fn )
   {
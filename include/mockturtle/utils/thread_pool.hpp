@@ -0,0 +1,243 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2023  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file thread_pool.hpp
+  \brief A pool of worker threads for data-parallel loops
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace mockturtle
+{
+
+/*! \brief Pool of worker threads.
+ *
+ * The pool keeps `num_threads - 1` worker threads alive between jobs; the
+ * calling thread participates in every job as thread 0.  Jobs are executed
+ * one at a time and `run` and `parallel_for` block until all threads have
+ * finished.  Exceptions thrown by a job are rethrown in the calling thread.
+ *
+ * Each thread is identified by an id in `[0, num_threads())`, which
+ * algorithms use to index per-thread state without locking.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      thread_pool pool( 4u );
+      std::vector<uint64_t> sums( pool.num_threads(), 0u );
+      pool.parallel_for( 0u, values.size(), [&]( uint64_t i, uint32_t thread_id ) {
+        sums[thread_id] += values[i];
+      } );
+   \endverbatim
+ */
+class thread_pool
+{
+public:
+  /*! \brief Creates a pool.
+   *
+   * \param num_threads Total number of threads including the calling thread
+   *                    (0 uses the hardware concurrency)
+   */
+  explicit thread_pool( uint32_t num_threads = 0u )
+  {
+    if ( num_threads == 0u )
+    {
+      num_threads = std::max( 1u, std::thread::hardware_concurrency() );
+    }
+
+    _workers.reserve( num_threads - 1u );
+    for ( auto i = 1u; i < num_threads; ++i )
+    {
+      _workers.emplace_back( [this, i]() { worker_loop( i ); } );
+    }
+  }
+
+  ~thread_pool()
+  {
+    {
+      std::lock_guard<std::mutex> lock( _mutex );
+      _stop = true;
+    }
+    _start.notify_all();
+    for ( auto& w : _workers )
+    {
+      w.join();
+    }
+  }
+
+  thread_pool( thread_pool const& ) = delete;
+  thread_pool& operator=( thread_pool const& ) = delete;
+
+  /*! \brief Returns the number of threads including the calling thread. */
+  uint32_t num_threads() const
+  {
+    return static_cast<uint32_t>( _workers.size() ) + 1u;
+  }
+
+  /*! \brief Runs `fn( thread_id )` once on every thread of the pool. */
+  template<typename Fn>
+  void run( Fn&& fn )
+  {
+    if ( _workers.empty() )
+    {
+      fn( 0u );
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock( _mutex );
+      _job = std::ref( fn );
+      _pending = static_cast<uint32_t>( _workers.size() );
+      _error = nullptr;
+      ++_generation;
+    }
+    _start.notify_all();
+
+    execute( 0u );
+
+    std::unique_lock<std::mutex> lock( _mutex );
+    _done.wait( lock, [this]() { return _pending == 0u; } );
+    _job = nullptr;
+
+    if ( _error )
+    {
+      std::rethrow_exception( std::exchange( _error, nullptr ) );
+    }
+  }
+
+  /*! \brief Calls `fn( i, thread_id )` for all `i` in `[begin, end)`.
+   *
+   * Indices are handed out dynamically in chunks of `grain_size`
+   * consecutive indices.
+   */
+  template<typename Fn>
+  void parallel_for( uint64_t begin, uint64_t end, Fn&& fn, uint64_t grain_size = 1u )
+  {
+    if ( begin >= end )
+    {
+      return;
+    }
+
+    grain_size = std::max<uint64_t>( grain_size, 1u );
+    if ( _workers.empty() || end - begin <= grain_size )
+    {
+      for ( auto i = begin; i < end; ++i )
+      {
+        fn( i, 0u );
+      }
+      return;
+    }
+
+    std::atomic<uint64_t> next{ begin };
+    run( [&]( uint32_t thread_id ) {
+      while ( true )
+      {
+        auto const first = next.fetch_add( grain_size, std::memory_order_relaxed );
+        if ( first >= end )
+        {
+          break;
+        }
+        auto const last = std::min( first + grain_size, end );
+        for ( auto i = first; i < last; ++i )
+        {
+          fn( i, thread_id );
+        }
+      }
+    } );
+  }
+
+private:
+  void execute( uint32_t thread_id )
+  {
+    try
+    {
+      _job( thread_id );
+    }
+    catch ( ... )
+    {
+      std::lock_guard<std::mutex> lock( _mutex );
+      if ( !_error )
+      {
+        _error = std::current_exception();
+      }
+    }
+  }
+
+  void worker_loop( uint32_t thread_id )
+  {
+    uint64_t generation{ 0 };
+    while ( true )
+    {
+      {
+        std::unique_lock<std::mutex> lock( _mutex );
+        _start.wait( lock, [&]() { return _stop || _generation != generation; } );
+        if ( _stop )
+        {
+          return;
+        }
+        generation = _generation;
+      }
+
+      execute( thread_id );
+
+      {
+        std::lock_guard<std::mutex> lock( _mutex );
+        if ( --_pending == 0u )
+        {
+          _done.notify_one();
+        }
+      }
+    }
+  }
+
+private:
+  std::vector<std::thread> _workers;
+  std::function<void( uint32_t )> _job;
+  std::exception_ptr _error;
+
+  std::mutex _mutex;
+  std::condition_variable _start;
+  std::condition_variable _done;
+  uint64_t _generation{ 0 };
+  uint32_t _pending{ 0 };
+  bool _stop{ false };
+};
+
+} /* namespace mockturtle */
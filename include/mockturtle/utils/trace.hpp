@@ -0,0 +1,603 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2023  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file trace.hpp
+  \brief Lightweight tracing of algorithms
+
+  Algorithms report scoped timers, counters, and histograms (e.g., cut set
+  sizes, SAT call latencies, or structural hashing hit rates) into the
+  global `trace_recorder`, which can export them as a Chrome trace (to be
+  opened in `chrome://tracing` or Perfetto) or as flat JSON.  This makes
+  it possible to profile a whole optimization flow without collecting the
+  statistics objects of each algorithm.
+
+  The instrumentation in the library uses the `MOCKTURTLE_TRACE_*` macros,
+  which expand to nothing unless `MOCKTURTLE_TRACE` is defined (e.g., with
+  the CMake option `MOCKTURTLE_TRACE`), such that tracing has no overhead
+  when it is disabled.  The classes in this file are always available and
+  may also be used directly.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace mockturtle
+{
+
+/*! \brief Histogram with power-of-two buckets.
+ *
+ * Bucket 0 counts the value 0, and bucket `i > 0` counts the values in
+ * [2^(i-1), 2^i).  All updates are atomic.
+ */
+class trace_histogram
+{
+public:
+  static constexpr uint32_t num_buckets = 65u;
+
+  explicit trace_histogram( std::string name ) : _name( std::move( name ) )
+  {
+    clear();
+  }
+
+  void add( uint64_t value )
+  {
+    uint32_t bucket{ 0u };
+    while ( bucket < 64u && ( value >> bucket ) != 0u )
+    {
+      ++bucket;
+    }
+    _buckets[bucket].fetch_add( 1u, std::memory_order_relaxed );
+    _count.fetch_add( 1u, std::memory_order_relaxed );
+    _sum.fetch_add( value, std::memory_order_relaxed );
+
+    auto min = _min.load( std::memory_order_relaxed );
+    while ( value < min && !_min.compare_exchange_weak( min, value, std::memory_order_relaxed ) )
+    {
+    }
+    auto max = _max.load( std::memory_order_relaxed );
+    while ( value > max && !_max.compare_exchange_weak( max, value, std::memory_order_relaxed ) )
+    {
+    }
+  }
+
+  void clear()
+  {
+    for ( auto& b : _buckets )
+    {
+      b.store( 0u, std::memory_order_relaxed );
+    }
+    _count.store( 0u, std::memory_order_relaxed );
+    _sum.store( 0u, std::memory_order_relaxed );
+    _min.store( std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed );
+    _max.store( 0u, std::memory_order_relaxed );
+  }
+
+  std::string const& name() const
+  {
+    return _name;
+  }
+
+  uint64_t count() const
+  {
+    return _count.load( std::memory_order_relaxed );
+  }
+
+  uint64_t sum() const
+  {
+    return _sum.load( std::memory_order_relaxed );
+  }
+
+  uint64_t min() const
+  {
+    return count() == 0u ? 0u : _min.load( std::memory_order_relaxed );
+  }
+
+  uint64_t max() const
+  {
+    return _max.load( std::memory_order_relaxed );
+  }
+
+  uint64_t bucket( uint32_t index ) const
+  {
+    return _buckets[index].load( std::memory_order_relaxed );
+  }
+
+private:
+  std::string _name;
+  std::array<std::atomic<uint64_t>, num_buckets> _buckets;
+  std::atomic<uint64_t> _count;
+  std::atomic<uint64_t> _sum;
+  std::atomic<uint64_t> _min;
+  std::atomic<uint64_t> _max;
+};
+
+class trace_recorder;
+
+/*! \brief Counter with one slot per thread.
+ *
+ * Each thread adds to its own slot, such that counters on hot paths (e.g.,
+ * structural hashing) do not contend across threads.  The slots are summed
+ * when the value is read or exported.
+ */
+class trace_counter
+{
+public:
+  trace_counter( std::string name, uint32_t index ) : _name( std::move( name ) ), _index( index ) {}
+
+  /*! \brief Adds `value` to the slot of the calling thread. */
+  void add( uint64_t value );
+
+  /*! \brief Sum of the slots of all threads. */
+  uint64_t value() const;
+
+  std::string const& name() const
+  {
+    return _name;
+  }
+
+private:
+  friend class trace_recorder;
+
+  std::string _name;
+  uint32_t _index;
+};
+
+/*! \brief Global recorder of trace events, counters, and histograms.
+ *
+ * Counters and histograms are created on first use and live as long as
+ * the program, such that call sites may keep references to them.  Timed
+ * scopes and counter increments are kept in a buffer of the calling
+ * thread and merged when exported.  When a thread exits, its buffer keeps
+ * the recorded data and is handed to the next thread that starts tracing,
+ * such that the number of buffers does not exceed the number of threads
+ * that trace at the same time.  The recorded scopes are kept until
+ * `clear` is called.
+ *
+ * Exporting and clearing must not run concurrently with traced code.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      // compile with -DMOCKTURTLE_TRACE
+      aig_network aig = ...;
+      functional_reduction( aig );
+      rewrite( aig, library );
+
+      std::ofstream os( "flow.trace.json" );
+      trace_recorder::instance().write_chrome_trace( os );
+   \endverbatim
+ */
+class trace_recorder
+{
+public:
+  using clock = std::chrono::steady_clock;
+
+  static trace_recorder& instance()
+  {
+    static trace_recorder recorder;
+    return recorder;
+  }
+
+  /*! \brief Returns the counter `name` (created on first use). */
+  trace_counter& counter( std::string const& name )
+  {
+    std::lock_guard<std::mutex> lock( _mutex );
+    auto it = _counter_index.find( name );
+    if ( it == _counter_index.end() )
+    {
+      _counters.emplace_back( name, static_cast<uint32_t>( _counters.size() ) );
+      it = _counter_index.emplace( name, &_counters.back() ).first;
+    }
+    return *it->second;
+  }
+
+  /*! \brief Returns the histogram `name` (created on first use). */
+  trace_histogram& histogram( std::string const& name )
+  {
+    std::lock_guard<std::mutex> lock( _mutex );
+    auto it = _histogram_index.find( name );
+    if ( it == _histogram_index.end() )
+    {
+      _histograms.emplace_back( name );
+      it = _histogram_index.emplace( name, &_histograms.back() ).first;
+    }
+    return *it->second;
+  }
+
+  /*! \brief Records a scope `name` that ran from `start` to `end` in the calling thread. */
+  void record( char const* name, clock::time_point start, clock::time_point end )
+  {
+    local_buffer().events.push_back( { name, start, end } );
+  }
+
+  /*! \brief Resets all counters and histograms and drops all recorded scopes. */
+  void clear()
+  {
+    std::lock_guard<std::mutex> lock( _mutex );
+    for ( auto& h : _histograms )
+    {
+      h.clear();
+    }
+    for ( auto& b : _buffers )
+    {
+      b->events.clear();
+      std::fill( b->counters.begin(), b->counters.end(), 0u );
+    }
+    _epoch = clock::now();
+  }
+
+  /*! \brief Number of thread buffers (see the class description). */
+  uint64_t num_buffers() const
+  {
+    std::lock_guard<std::mutex> lock( _mutex );
+    return _buffers.size();
+  }
+
+  /*! \brief Number of recorded scopes with the given name. */
+  uint64_t num_scopes( std::string const& name ) const
+  {
+    std::lock_guard<std::mutex> lock( _mutex );
+    uint64_t count{ 0u };
+    for ( auto const& b : _buffers )
+    {
+      count += std::count_if( b->events.begin(), b->events.end(), [&]( auto const& e ) { return name == e.name; } );
+    }
+    return count;
+  }
+
+  /*! \brief Writes all scopes and counters in the Chrome trace event format. */
+  void write_chrome_trace( std::ostream& os ) const
+  {
+    std::lock_guard<std::mutex> lock( _mutex );
+    os << "{\"traceEvents\":[";
+    bool first{ true };
+    auto const separator = [&]() -> std::ostream& {
+      os << ( first ? "\n" : ",\n" );
+      first = false;
+      return os;
+    };
+
+    auto end = _epoch;
+    for ( auto const& b : _buffers )
+    {
+      for ( auto const& e : b->events )
+      {
+        separator() << "{\"name\":";
+        write_string( os, e.name ) << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << b->id
+                    << ",\"ts\":" << microseconds( e.start - _epoch ) << ",\"dur\":" << microseconds( e.end - e.start ) << "}";
+        end = std::max( end, e.end );
+      }
+    }
+
+    /* counters are shown with their final value at the end of the trace */
+    for ( auto const& [name, c] : _counter_index )
+    {
+      separator() << "{\"name\":";
+      write_string( os, name ) << ",\"ph\":\"C\",\"pid\":0,\"tid\":0,\"ts\":" << microseconds( end - _epoch )
+                               << ",\"args\":{\"value\":" << counter_value( c->_index ) << "}}";
+    }
+    os << "\n]}\n";
+  }
+
+  /*! \brief Writes a summary of scopes (count and time), counters, and histograms as JSON. */
+  void write_json( std::ostream& os ) const
+  {
+    std::lock_guard<std::mutex> lock( _mutex );
+
+    struct scope_summary
+    {
+      uint64_t count{ 0u };
+      double total{ 0.0 };
+      double max{ 0.0 };
+    };
+    std::map<std::string, scope_summary> scopes;
+    for ( auto const& b : _buffers )
+    {
+      for ( auto const& e : b->events )
+      {
+        auto& s = scopes[e.name];
+        auto const t = microseconds( e.end - e.start );
+        ++s.count;
+        s.total += t;
+        s.max = std::max( s.max, t );
+      }
+    }
+
+    os << "{\n  \"scopes\": {";
+    bool first{ true };
+    for ( auto const& [name, s] : scopes )
+    {
+      write_string( os << ( first ? "\n" : ",\n" ) << "    ", name ) << ": {\"count\": " << s.count << ", \"total_us\": " << s.total << ", \"max_us\": " << s.max << "}";
+      first = false;
+    }
+
+    os << "\n  },\n  \"counters\": {";
+    first = true;
+    for ( auto const& [name, c] : _counter_index )
+    {
+      write_string( os << ( first ? "\n" : ",\n" ) << "    ", name ) << ": " << counter_value( c->_index );
+      first = false;
+    }
+
+    os << "\n  },\n  \"histograms\": {";
+    first = true;
+    for ( auto const& [name, h] : _histogram_index )
+    {
+      write_string( os << ( first ? "\n" : ",\n" ) << "    ", name ) << ": {\"count\": " << h->count() << ", \"sum\": " << h->sum()
+         << ", \"min\": " << h->min() << ", \"max\": " << h->max() << ", \"buckets\": [";
+      /* trailing empty buckets are omitted */
+      auto last = trace_histogram::num_buckets;
+      while ( last > 0u && h->bucket( last - 1u ) == 0u )
+      {
+        --last;
+      }
+      for ( auto i = 0u; i < last; ++i )
+      {
+        os << ( i ? ", " : "" ) << h->bucket( i );
+      }
+      os << "]}";
+      first = false;
+    }
+    os << "\n  }\n}\n";
+  }
+
+private:
+  friend class trace_counter;
+
+  struct event
+  {
+    char const* name;
+    clock::time_point start;
+    clock::time_point end;
+  };
+
+  struct thread_buffer
+  {
+    uint32_t id;
+    std::vector<event> events;
+    std::vector<uint64_t> counters;
+  };
+
+  /* returns the buffer of a thread to the recorder when the thread exits */
+  struct buffer_owner
+  {
+    ~buffer_owner()
+    {
+      trace_recorder::instance().release_buffer( id );
+    }
+
+    uint32_t id;
+  };
+
+  trace_recorder() : _epoch( clock::now() ) {}
+
+  thread_buffer& local_buffer()
+  {
+    thread_local thread_buffer* buffer = nullptr;
+    if ( buffer == nullptr )
+    {
+      buffer = &acquire_buffer();
+      thread_local buffer_owner owner{ buffer->id };
+    }
+    return *buffer;
+  }
+
+  thread_buffer& acquire_buffer()
+  {
+    std::lock_guard<std::mutex> lock( _mutex );
+    if ( !_free_buffers.empty() )
+    {
+      auto const id = _free_buffers.back();
+      _free_buffers.pop_back();
+      return *_buffers[id];
+    }
+    _buffers.push_back( std::make_unique<thread_buffer>() );
+    _buffers.back()->id = static_cast<uint32_t>( _buffers.size() - 1u );
+    return *_buffers.back();
+  }
+
+  void release_buffer( uint32_t id )
+  {
+    std::lock_guard<std::mutex> lock( _mutex );
+    _free_buffers.push_back( id );
+  }
+
+  uint64_t counter_value( uint32_t index ) const
+  {
+    uint64_t value{ 0u };
+    for ( auto const& b : _buffers )
+    {
+      value += index < b->counters.size() ? b->counters[index] : 0u;
+    }
+    return value;
+  }
+
+  /* writes `s` as a JSON string literal */
+  static std::ostream& write_string( std::ostream& os, std::string_view s )
+  {
+    static constexpr char hex[] = "0123456789abcdef";
+    os << '"';
+    for ( unsigned char const c : s )
+    {
+      switch ( c )
+      {
+      case '"':
+        os << "\\\"";
+        break;
+      case '\\':
+        os << "\\\\";
+        break;
+      case '\n':
+        os << "\\n";
+        break;
+      case '\r':
+        os << "\\r";
+        break;
+      case '\t':
+        os << "\\t";
+        break;
+      default:
+        if ( c < 0x20u )
+        {
+          os << "\\u00" << hex[c >> 4u] << hex[c & 0xfu];
+        }
+        else
+        {
+          os << static_cast<char>( c );
+        }
+      }
+    }
+    return os << '"';
+  }
+
+  static double microseconds( clock::duration d )
+  {
+    return std::chrono::duration<double, std::micro>( d ).count();
+  }
+
+  mutable std::mutex _mutex;
+  std::deque<trace_counter> _counters;
+  std::map<std::string, trace_counter*> _counter_index;
+  std::deque<trace_histogram> _histograms;
+  std::map<std::string, trace_histogram*> _histogram_index;
+  std::vector<std::unique_ptr<thread_buffer>> _buffers;
+  std::vector<uint32_t> _free_buffers; /* buffers of threads that have exited */
+  clock::time_point _epoch;
+};
+
+inline void trace_counter::add( uint64_t value )
+{
+  auto& counters = trace_recorder::instance().local_buffer().counters;
+  if ( _index >= counters.size() )
+  {
+    counters.resize( _index + 1u, 0u );
+  }
+  counters[_index] += value;
+}
+
+inline uint64_t trace_counter::value() const
+{
+  auto const& recorder = trace_recorder::instance();
+  std::lock_guard<std::mutex> lock( recorder._mutex );
+  return recorder.counter_value( _index );
+}
+
+/*! \brief Records the lifetime of the scope as an event in the trace. */
+class trace_scope
+{
+public:
+  explicit trace_scope( char const* name ) : _name( name ), _start( trace_recorder::clock::now() ) {}
+
+  ~trace_scope()
+  {
+    trace_recorder::instance().record( _name, _start, trace_recorder::clock::now() );
+  }
+
+  trace_scope( trace_scope const& ) = delete;
+  trace_scope& operator=( trace_scope const& ) = delete;
+
+private:
+  char const* _name;
+  trace_recorder::clock::time_point _start;
+};
+
+/*! \brief Adds the lifetime of the scope in microseconds to a histogram. */
+class trace_latency
+{
+public:
+  explicit trace_latency( trace_histogram& histogram ) : _histogram( histogram ), _start( trace_recorder::clock::now() ) {}
+
+  ~trace_latency()
+  {
+    auto const d = trace_recorder::clock::now() - _start;
+    _histogram.add( std::chrono::duration_cast<std::chrono::microseconds>( d ).count() );
+  }
+
+  trace_latency( trace_latency const& ) = delete;
+  trace_latency& operator=( trace_latency const& ) = delete;
+
+private:
+  trace_histogram& _histogram;
+  trace_recorder::clock::time_point _start;
+};
+
+} // namespace mockturtle
+
+#define MOCKTURTLE_TRACE_CONCAT_( a, b ) a##b
+#define MOCKTURTLE_TRACE_CONCAT( a, b ) MOCKTURTLE_TRACE_CONCAT_( a, b )
+
+#if defined( MOCKTURTLE_TRACE )
+
+/*! \brief Records the enclosing scope as an event `name` (a string literal). */
+#define MOCKTURTLE_TRACE_SCOPE( name ) ::mockturtle::trace_scope MOCKTURTLE_TRACE_CONCAT( _mockturtle_trace_scope_, __LINE__ )( name )
+
+/*! \brief Adds the runtime of the enclosing scope in microseconds to the histogram `name`. */
+#define MOCKTURTLE_TRACE_LATENCY( name )                                                                                               \
+  static auto& MOCKTURTLE_TRACE_CONCAT( _mockturtle_trace_histogram_, __LINE__ ) = ::mockturtle::trace_recorder::instance().histogram( name ); \
+  ::mockturtle::trace_latency MOCKTURTLE_TRACE_CONCAT( _mockturtle_trace_latency_, __LINE__ )( MOCKTURTLE_TRACE_CONCAT( _mockturtle_trace_histogram_, __LINE__ ) )
+
+/*! \brief Adds `value` to the counter `name`. */
+#define MOCKTURTLE_TRACE_COUNT( name, value )                                                                  \
+  do                                                                                                           \
+  {                                                                                                            \
+    static auto& _mockturtle_trace_counter = ::mockturtle::trace_recorder::instance().counter( name );       \
+    _mockturtle_trace_counter.add( static_cast<uint64_t>( value ) );                                          \
+  } while ( false )
+
+/*! \brief Adds `value` to the histogram `name`. */
+#define MOCKTURTLE_TRACE_HISTOGRAM( name, value )                                                        \
+  do                                                                                                     \
+  {                                                                                                      \
+    static auto& _mockturtle_trace_histogram = ::mockturtle::trace_recorder::instance().histogram( name ); \
+    _mockturtle_trace_histogram.add( static_cast<uint64_t>( value ) );                                   \
+  } while ( false )
+
+#else
+
+#define MOCKTURTLE_TRACE_SCOPE( name ) static_cast<void>( 0 )
+#define MOCKTURTLE_TRACE_LATENCY( name ) static_cast<void>( 0 )
+#define MOCKTURTLE_TRACE_COUNT( name, value ) static_cast<void>( 0 )
+#define MOCKTURTLE_TRACE_HISTOGRAM( name, value ) static_cast<void>( 0 )
+
+#endif
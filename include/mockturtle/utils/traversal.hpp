@@ -0,0 +1,255 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2023  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file traversal.hpp
+  \brief Non-recursive traversal kernels
+
+  The recursive formulation of a depth-first traversal uses one stack
+  frame per logic level, which overflows the call stack on very deep
+  networks (e.g., ripple-carry arithmetic).  The kernels in this file
+  keep their state in heap-allocated containers instead.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace mockturtle
+{
+
+/*! \brief Depth-first traversal with an explicit stack.
+ *
+ * Emulates the recursive traversal that calls `enter( n )`, skips `n` if
+ * it returns `false`, recursively visits all successors of `n`, and
+ * finally calls `leave( n )`.  The visiting order is the same as the one
+ * of the recursion, i.e., `enter` of a successor is called only after all
+ * previous successors have been left.  This makes it a
+ * drop-in replacement for the recursive helpers that mark nodes in
+ * `enter` and collect them in topological order in `leave`.
+ *
+ * The stack is kept between calls to `run` so that repeated traversals,
+ * e.g., from all outputs of a network, do not reallocate it.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      aig_network aig = ...;
+      std::vector<aig_network::node> order;
+
+      aig.incr_trav_id();
+      iterative_dfs<aig_network::node> dfs;
+      aig.foreach_po( [&]( auto const& f ) {
+        dfs.run( aig.get_node( f ),
+                 [&]( auto const& n, auto&& push ) {
+                   aig.foreach_fanin( n, [&]( auto const& fi ) { push( aig.get_node( fi ) ); } );
+                 },
+                 [&]( auto const& n ) {
+                   if ( aig.visited( n ) == aig.trav_id() )
+                     return false;
+                   aig.set_visited( n, aig.trav_id() );
+                   return true;
+                 },
+                 [&]( auto const& n ) { order.push_back( n ); } );
+      } );
+   \endverbatim
+ */
+template<class Node>
+class iterative_dfs
+{
+public:
+  /*! \brief Traverses from `root`.
+   *
+   * \param root Start node
+   * \param foreach_successor Called as `foreach_successor( n, push )` and
+   *                          must call `push( m )` for each successor `m`
+   *                          of `n` in visiting order
+   * \param enter Called before visiting the successors of a node; the node
+   *              is skipped if it returns `false`
+   * \param leave Called after all successors of a node have been visited
+   */
+  template<class SuccessorFn, class EnterFn, class LeaveFn>
+  void run( Node const& root, SuccessorFn&& foreach_successor, EnterFn&& enter, LeaveFn&& leave )
+  {
+    assert( _stack.empty() );
+
+    _stack.emplace_back( root, false );
+    while ( !_stack.empty() )
+    {
+      auto const [n, expanded] = _stack.back();
+      _stack.pop_back();
+
+      if ( expanded )
+      {
+        leave( n );
+        continue;
+      }
+
+      if ( !enter( n ) )
+        continue;
+
+      _stack.emplace_back( n, true );
+
+      /* successors are pushed in visiting order and reversed, such that the first one is on top */
+      auto const first = _stack.size();
+      foreach_successor( n, [&]( Node const& m ) {
+        _stack.emplace_back( m, false );
+      } );
+      std::reverse( _stack.begin() + first, _stack.end() );
+    }
+  }
+
+  /*! \brief Traverses from `root` without a post-order callback. */
+  template<class SuccessorFn, class EnterFn>
+  void run( Node const& root, SuccessorFn&& foreach_successor, EnterFn&& enter )
+  {
+    run( root, foreach_successor, enter, []( Node const& ) {} );
+  }
+
+  /*! \brief Traverses the transitive fanin of `root` in `ntk`. */
+  template<class Ntk, class EnterFn, class LeaveFn>
+  void run_fanin( Ntk const& ntk, Node const& root, EnterFn&& enter, LeaveFn&& leave )
+  {
+    run(
+        root, [&]( Node const& n, auto&& push ) {
+          ntk.foreach_fanin( n, [&]( auto const& f ) {
+            push( ntk.get_node( f ) );
+          } );
+        },
+        enter, leave );
+  }
+
+  /*! \brief Traverses the transitive fanout of `root` in `ntk`.
+   *
+   * Requires `ntk` to implement `foreach_fanout`, e.g., by wrapping it
+   * in a `fanout_view`.
+   */
+  template<class Ntk, class EnterFn, class LeaveFn>
+  void run_fanout( Ntk const& ntk, Node const& root, EnterFn&& enter, LeaveFn&& leave )
+  {
+    run(
+        root, [&]( Node const& n, auto&& push ) {
+          ntk.foreach_fanout( n, [&]( auto const& g ) {
+            push( g );
+          } );
+        },
+        enter, leave );
+  }
+
+  /*! \brief Releases the memory of the stack. */
+  void clear()
+  {
+    _stack.clear();
+    _stack.shrink_to_fit();
+  }
+
+private:
+  std::vector<std::pair<Node, bool>> _stack;
+};
+
+/*! \brief Priority queue with small integer keys.
+ *
+ * Elements are stored in one bucket per key, e.g., per logic level, and
+ * are popped in non-decreasing order of keys.  Pushing and popping take
+ * amortized constant time, plus the number of empty buckets skipped.
+ * Keys smaller than the key of the last popped element may be pushed;
+ * they are popped next.
+ *
+ * This is the building block for level-by-level (breadth-first)
+ * propagation in the transitive fanout or fanin of a set of nodes.
+ */
+template<class T>
+class bucket_queue
+{
+public:
+  /*! \brief Inserts `value` with priority `key`. */
+  void push( uint32_t key, T const& value )
+  {
+    if ( key >= _buckets.size() )
+    {
+      _buckets.resize( key + 1u );
+    }
+    _buckets[key].push_back( value );
+    _first = std::min( _first, key );
+    ++_size;
+  }
+
+  /*! \brief Returns whether the queue is empty. */
+  bool empty() const
+  {
+    return _size == 0u;
+  }
+
+  /*! \brief Returns the number of elements. */
+  uint64_t size() const
+  {
+    return _size;
+  }
+
+  /*! \brief Removes an element with the smallest key and returns it with its key. */
+  std::pair<uint32_t, T> pop()
+  {
+    assert( !empty() );
+    while ( _buckets[_first].empty() )
+    {
+      ++_first;
+    }
+
+    auto& bucket = _buckets[_first];
+    std::pair<uint32_t, T> element{ _first, bucket.back() };
+    bucket.pop_back();
+
+    if ( --_size == 0u )
+    {
+      _first = UINT32_MAX;
+    }
+    return element;
+  }
+
+  /*! \brief Removes all elements (keeps the memory of the buckets). */
+  void clear()
+  {
+    for ( auto& bucket : _buckets )
+    {
+      bucket.clear();
+    }
+    _first = UINT32_MAX;
+    _size = 0u;
+  }
+
+private:
+  std::vector<std::vector<T>> _buckets;
+  uint32_t _first{ UINT32_MAX };
+  uint64_t _size{ 0u };
+};
+
+} /* namespace mockturtle */
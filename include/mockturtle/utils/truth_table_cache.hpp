@@ -34,9 +34,15 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <tuple>
 #include <vector>
 
+#include <kitty/dynamic_truth_table.hpp>
 #include <kitty/hash.hpp>
+#include <kitty/npn.hpp>
 #include <kitty/operations.hpp>
 #include <kitty/operators.hpp>
 
@@ -169,4 +175,296 @@ void truth_table_cache<TT>::resize( uint32_t capacity )
   _data.reserve( capacity );
 }
 
+/*! \brief Read-only reference to a truth table in a `compact_truth_table_cache`.
+ *
+ * The reference points into the storage of the cache and complements the
+ * stored words on the fly, i.e., it does not copy the truth table.  It is
+ * invalidated by inserting new truth tables into the cache.
+ */
+class cached_truth_table
+{
+public:
+  cached_truth_table( uint64_t const* words, uint32_t num_vars, bool complemented )
+      : _words( words ), _num_vars( num_vars ), _complemented( complemented )
+  {
+  }
+
+  /*! \brief Returns the number of variables. */
+  uint32_t num_vars() const
+  {
+    return _num_vars;
+  }
+
+  /*! \brief Returns the number of 64-bit blocks. */
+  uint64_t num_blocks() const
+  {
+    return _num_vars <= 6u ? 1u : ( UINT64_C( 1 ) << ( _num_vars - 6u ) );
+  }
+
+  /*! \brief Returns the number of bits. */
+  uint64_t num_bits() const
+  {
+    return UINT64_C( 1 ) << _num_vars;
+  }
+
+  /*! \brief Returns the block at position `index`. */
+  uint64_t block( uint64_t index ) const
+  {
+    auto const word = _complemented ? ~_words[index] : _words[index];
+    return _num_vars < 6u ? word & ( ( UINT64_C( 1 ) << ( UINT64_C( 1 ) << _num_vars ) ) - 1u ) : word;
+  }
+
+  /*! \brief Returns the bit at position `index`. */
+  bool get_bit( uint64_t index ) const
+  {
+    return ( ( _words[index >> 6] >> ( index & 0x3f ) ) & 1u ) != static_cast<uint64_t>( _complemented );
+  }
+
+  /*! \brief Returns a copy of the truth table. */
+  kitty::dynamic_truth_table to_truth_table() const
+  {
+    kitty::dynamic_truth_table tt( _num_vars );
+    for ( auto i = 0u; i < tt.num_blocks(); ++i )
+    {
+      tt._bits[i] = block( i );
+    }
+    return tt;
+  }
+
+private:
+  uint64_t const* _words;
+  uint32_t _num_vars;
+  bool _complemented;
+};
+
+/*! \brief Truth table cache with contiguous storage.
+ *
+ * This cache has the same interface and the same literal convention as
+ * `truth_table_cache<kitty::dynamic_truth_table>`, but it stores the words
+ * of all truth tables contiguously in a single arena.  The hash table only
+ * holds entry indexes and compares truth tables in place, so each function
+ * is stored once and no memory is allocated per entry.  In addition to
+ * `operator[]`, which returns a copy, `get` returns a reference into the
+ * arena.
+ *
+ * The method `insert_npn` inserts only the NPN representative of a function,
+ * such that all functions of an NPN class share the same entry.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      compact_truth_table_cache cache;
+
+      kitty::dynamic_truth_table maj( 3 );
+      kitty::create_majority( maj );
+      auto l1 = cache.insert( maj );  // index is 0
+
+      auto ref = cache.get( l1 ^ 1 ); // reference to ~maj
+      auto b = ref.get_bit( 7 );      // b is false
+   \endverbatim
+ */
+class compact_truth_table_cache
+{
+public:
+  /*! \brief Creates a truth table cache and reserves memory. */
+  compact_truth_table_cache( uint32_t capacity = 1000u )
+      : _arena( std::make_unique<arena>() ),
+        _indexes( 0u, entry_hash{ _arena.get() }, entry_equal{ _arena.get() } )
+  {
+    resize( capacity );
+  }
+
+  compact_truth_table_cache( compact_truth_table_cache const& other )
+      : _arena( std::make_unique<arena>( *other._arena ) ),
+        _indexes( 0u, entry_hash{ _arena.get() }, entry_equal{ _arena.get() } )
+  {
+    rebuild_indexes();
+  }
+
+  compact_truth_table_cache& operator=( compact_truth_table_cache const& other )
+  {
+    if ( this != &other )
+    {
+      *_arena = *other._arena;
+      rebuild_indexes();
+    }
+    return *this;
+  }
+
+  /* the hash functions point to the arena, which stays in place when the arena pointer and the index are swapped */
+  compact_truth_table_cache( compact_truth_table_cache&& other )
+      : _arena( std::make_unique<arena>() ),
+        _indexes( 0u, entry_hash{ _arena.get() }, entry_equal{ _arena.get() } )
+  {
+    swap( other );
+  }
+
+  compact_truth_table_cache& operator=( compact_truth_table_cache&& other )
+  {
+    swap( other );
+    return *this;
+  }
+
+  /*! \brief Inserts a truth table and returns a literal.
+   *
+   * Only normal functions are stored (see `truth_table_cache::insert`).
+   *
+   * \param tt Truth table to insert
+   * \return Literal of position in cache
+   */
+  uint32_t insert( kitty::dynamic_truth_table const& tt )
+  {
+    uint32_t const is_compl = kitty::get_bit( tt, 0 ) ? 1u : 0u;
+
+    /* append the normal function to the arena and remove it again if it is already in the cache */
+    auto& words = _arena->words;
+    auto const index = static_cast<uint32_t>( _arena->offsets.size() );
+    auto const offset = words.size();
+    for ( auto i = 0u; i < tt.num_blocks(); ++i )
+    {
+      auto word = is_compl ? ~tt._bits[i] : tt._bits[i];
+      if ( tt.num_vars() < 6u )
+      {
+        word &= ( UINT64_C( 1 ) << tt.num_bits() ) - 1u;
+      }
+      words.push_back( word );
+    }
+    _arena->offsets.push_back( offset );
+    _arena->num_vars.push_back( static_cast<uint8_t>( tt.num_vars() ) );
+
+    auto const [it, inserted] = _indexes.insert( index );
+    if ( !inserted )
+    {
+      words.resize( offset );
+      _arena->offsets.pop_back();
+      _arena->num_vars.pop_back();
+    }
+    return 2u * *it + is_compl;
+  }
+
+  /*! \brief Inserts the NPN representative of a truth table.
+   *
+   * Returns the literal of the representative together with the NPN
+   * transformation as computed by `kitty::exact_npn_canonization` (for up
+   * to 6 variables) or `kitty::sifting_npn_canonization` (otherwise).
+   * The function can be restored from the representative by
+   * `kitty::create_from_npn_config`.
+   *
+   * \param tt Truth table to insert
+   * \return Literal of the representative, phase, and permutation
+   */
+  std::tuple<uint32_t, uint32_t, std::vector<uint8_t>> insert_npn( kitty::dynamic_truth_table const& tt )
+  {
+    auto [repr, phase, perm] = tt.num_vars() <= 6u ? kitty::exact_npn_canonization( tt ) : kitty::sifting_npn_canonization( tt );
+    return { insert( repr ), phase, perm };
+  }
+
+  /*! \brief Returns a copy of the truth table for a given literal. */
+  kitty::dynamic_truth_table operator[]( uint32_t lit ) const
+  {
+    return get( lit ).to_truth_table();
+  }
+
+  /*! \brief Returns a reference to the truth table for a given literal.
+   *
+   * The reference is invalidated by inserting truth tables.
+   */
+  cached_truth_table get( uint32_t lit ) const
+  {
+    return _arena->get( lit );
+  }
+
+  /*! \brief Returns number of normalized truth tables in the cache. */
+  auto size() const { return _arena->offsets.size(); }
+
+  /*! \brief Resizes the cache.
+   *
+   * Reserve additional space for the index and for `capacity` truth tables
+   * of up to 6 variables.
+   */
+  void resize( uint32_t capacity )
+  {
+    _indexes.reserve( capacity );
+    _arena->words.reserve( capacity );
+    _arena->offsets.reserve( capacity );
+    _arena->num_vars.reserve( capacity );
+  }
+
+  /*! \brief Returns the number of bytes allocated by the cache. */
+  uint64_t memory_usage() const
+  {
+    return sizeof( arena ) + _arena->words.capacity() * sizeof( uint64_t ) + _arena->offsets.capacity() * sizeof( uint64_t ) +
+           _arena->num_vars.capacity() * sizeof( uint8_t ) + _indexes.capacity() * ( sizeof( uint32_t ) + 1u );
+  }
+
+  /*! \brief Swaps the contents of two caches. */
+  void swap( compact_truth_table_cache& other )
+  {
+    std::swap( _arena, other._arena );
+    _indexes.swap( other._indexes );
+  }
+
+private:
+  struct arena
+  {
+    cached_truth_table get( uint32_t lit ) const
+    {
+      auto const index = lit >> 1;
+      return cached_truth_table( words.data() + offsets[index], num_vars[index], ( lit & 1 ) != 0 );
+    }
+
+    std::vector<uint64_t> words;   /* words of all normal truth tables */
+    std::vector<uint64_t> offsets; /* first word of each entry */
+    std::vector<uint8_t> num_vars; /* number of variables of each entry */
+  };
+
+  struct entry_hash
+  {
+    arena const* entries;
+
+    uint64_t operator()( uint32_t index ) const
+    {
+      auto const ref = entries->get( 2u * index );
+      uint64_t hash = ref.num_vars();
+      for ( auto i = 0u; i < ref.num_blocks(); ++i )
+      {
+        hash ^= entries->words[entries->offsets[index] + i] + UINT64_C( 0x9e3779b97f4a7c15 ) + ( hash << 6 ) + ( hash >> 2 );
+      }
+      return hash;
+    }
+  };
+
+  struct entry_equal
+  {
+    arena const* entries;
+
+    bool operator()( uint32_t a, uint32_t b ) const
+    {
+      if ( entries->num_vars[a] != entries->num_vars[b] )
+        return false;
+
+      auto const begin = entries->words.begin();
+      auto const num_blocks = entries->get( 2u * a ).num_blocks();
+      return std::equal( begin + entries->offsets[a], begin + entries->offsets[a] + num_blocks, begin + entries->offsets[b] );
+    }
+  };
+
+  void rebuild_indexes()
+  {
+    _indexes = index_set( _arena->offsets.size(), entry_hash{ _arena.get() }, entry_equal{ _arena.get() } );
+    for ( auto i = 0u; i < _arena->offsets.size(); ++i )
+    {
+      _indexes.insert( i );
+    }
+  }
+
+  using index_set = phmap::flat_hash_set<uint32_t, entry_hash, entry_equal>;
+
+  std::unique_ptr<arena> _arena; /* heap-allocated, such that the index stays valid when the cache is moved */
+  index_set _indexes;
+};
+
 } /* namespace mockturtle */
@@ -0,0 +1,346 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2023  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file word_operations.hpp
+  \brief Bitwise operations over arrays of 64-bit words
+
+  The functions compute one gate over many simulation patterns at once,
+  or check and count the bits of such a gate without storing it.  Each
+  operand can be complemented by passing an all-ones mask.  The checks
+  return as soon as a non-zero word is found.  When the compiler targets
+  AVX2 or AVX-512 (e.g., with `-march=native`, which the CMake option
+  `MOCKTURTLE_NATIVE` adds), the loops are implemented with the
+  corresponding intrinsics; otherwise they are plain loops.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <iterator>
+
+#include <kitty/detail/mscfix.hpp>
+
+#if defined( __AVX512F__ ) || defined( __AVX2__ )
+#include <immintrin.h>
+#endif
+
+namespace mockturtle
+{
+
+/*! \brief Computes `out[i] = ( a[i] ^ ca ) & ( b[i] ^ cb )`. */
+inline void and_words( uint64_t* out, uint64_t const* a, uint64_t ca, uint64_t const* b, uint64_t cb, uint64_t num_words )
+{
+  uint64_t i{ 0 };
+#if defined( __AVX512F__ )
+  __m512i const va = _mm512_set1_epi64( static_cast<long long>( ca ) );
+  __m512i const vb = _mm512_set1_epi64( static_cast<long long>( cb ) );
+  for ( ; i + 8u <= num_words; i += 8u )
+  {
+    __m512i const x = _mm512_xor_si512( _mm512_loadu_si512( a + i ), va );
+    __m512i const y = _mm512_xor_si512( _mm512_loadu_si512( b + i ), vb );
+    _mm512_storeu_si512( out + i, _mm512_and_si512( x, y ) );
+  }
+#elif defined( __AVX2__ )
+  __m256i const va = _mm256_set1_epi64x( static_cast<long long>( ca ) );
+  __m256i const vb = _mm256_set1_epi64x( static_cast<long long>( cb ) );
+  for ( ; i + 4u <= num_words; i += 4u )
+  {
+    __m256i const x = _mm256_xor_si256( _mm256_loadu_si256( reinterpret_cast<__m256i const*>( a + i ) ), va );
+    __m256i const y = _mm256_xor_si256( _mm256_loadu_si256( reinterpret_cast<__m256i const*>( b + i ) ), vb );
+    _mm256_storeu_si256( reinterpret_cast<__m256i*>( out + i ), _mm256_and_si256( x, y ) );
+  }
+#endif
+  for ( ; i < num_words; ++i )
+  {
+    out[i] = ( a[i] ^ ca ) & ( b[i] ^ cb );
+  }
+}
+
+/*! \brief Computes `out[i] = ( a[i] ^ ca ) ^ ( b[i] ^ cb )`. */
+inline void xor_words( uint64_t* out, uint64_t const* a, uint64_t ca, uint64_t const* b, uint64_t cb, uint64_t num_words )
+{
+  uint64_t const c = ca ^ cb;
+  uint64_t i{ 0 };
+#if defined( __AVX512F__ )
+  __m512i const vc = _mm512_set1_epi64( static_cast<long long>( c ) );
+  for ( ; i + 8u <= num_words; i += 8u )
+  {
+    __m512i const x = _mm512_loadu_si512( a + i );
+    __m512i const y = _mm512_loadu_si512( b + i );
+    _mm512_storeu_si512( out + i, _mm512_ternarylogic_epi64( x, y, vc, 0x96 ) );
+  }
+#elif defined( __AVX2__ )
+  __m256i const vc = _mm256_set1_epi64x( static_cast<long long>( c ) );
+  for ( ; i + 4u <= num_words; i += 4u )
+  {
+    __m256i const x = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( a + i ) );
+    __m256i const y = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( b + i ) );
+    _mm256_storeu_si256( reinterpret_cast<__m256i*>( out + i ), _mm256_xor_si256( _mm256_xor_si256( x, y ), vc ) );
+  }
+#endif
+  for ( ; i < num_words; ++i )
+  {
+    out[i] = a[i] ^ b[i] ^ c;
+  }
+}
+
+/*! \brief Computes `out[i] = ( a[i] ^ ca ) ^ ( b[i] ^ cb ) ^ ( c[i] ^ cc )`. */
+inline void xor3_words( uint64_t* out, uint64_t const* a, uint64_t ca, uint64_t const* b, uint64_t cb, uint64_t const* c, uint64_t cc, uint64_t num_words )
+{
+  uint64_t const m = ca ^ cb ^ cc;
+  uint64_t i{ 0 };
+#if defined( __AVX512F__ )
+  __m512i const vm = _mm512_set1_epi64( static_cast<long long>( m ) );
+  for ( ; i + 8u <= num_words; i += 8u )
+  {
+    __m512i const x = _mm512_loadu_si512( a + i );
+    __m512i const y = _mm512_loadu_si512( b + i );
+    __m512i const z = _mm512_xor_si512( _mm512_loadu_si512( c + i ), vm );
+    _mm512_storeu_si512( out + i, _mm512_ternarylogic_epi64( x, y, z, 0x96 ) );
+  }
+#elif defined( __AVX2__ )
+  __m256i const vm = _mm256_set1_epi64x( static_cast<long long>( m ) );
+  for ( ; i + 4u <= num_words; i += 4u )
+  {
+    __m256i const x = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( a + i ) );
+    __m256i const y = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( b + i ) );
+    __m256i const z = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( c + i ) );
+    _mm256_storeu_si256( reinterpret_cast<__m256i*>( out + i ), _mm256_xor_si256( _mm256_xor_si256( x, y ), _mm256_xor_si256( z, vm ) ) );
+  }
+#endif
+  for ( ; i < num_words; ++i )
+  {
+    out[i] = a[i] ^ b[i] ^ c[i] ^ m;
+  }
+}
+
+/*! \brief Computes `out[i] = MAJ( a[i] ^ ca, b[i] ^ cb, c[i] ^ cc )`. */
+inline void maj_words( uint64_t* out, uint64_t const* a, uint64_t ca, uint64_t const* b, uint64_t cb, uint64_t const* c, uint64_t cc, uint64_t num_words )
+{
+  uint64_t i{ 0 };
+#if defined( __AVX512F__ )
+  __m512i const va = _mm512_set1_epi64( static_cast<long long>( ca ) );
+  __m512i const vb = _mm512_set1_epi64( static_cast<long long>( cb ) );
+  __m512i const vc = _mm512_set1_epi64( static_cast<long long>( cc ) );
+  for ( ; i + 8u <= num_words; i += 8u )
+  {
+    __m512i const x = _mm512_xor_si512( _mm512_loadu_si512( a + i ), va );
+    __m512i const y = _mm512_xor_si512( _mm512_loadu_si512( b + i ), vb );
+    __m512i const z = _mm512_xor_si512( _mm512_loadu_si512( c + i ), vc );
+    _mm512_storeu_si512( out + i, _mm512_ternarylogic_epi64( x, y, z, 0xe8 ) );
+  }
+#elif defined( __AVX2__ )
+  __m256i const va = _mm256_set1_epi64x( static_cast<long long>( ca ) );
+  __m256i const vb = _mm256_set1_epi64x( static_cast<long long>( cb ) );
+  __m256i const vc = _mm256_set1_epi64x( static_cast<long long>( cc ) );
+  for ( ; i + 4u <= num_words; i += 4u )
+  {
+    __m256i const x = _mm256_xor_si256( _mm256_loadu_si256( reinterpret_cast<__m256i const*>( a + i ) ), va );
+    __m256i const y = _mm256_xor_si256( _mm256_loadu_si256( reinterpret_cast<__m256i const*>( b + i ) ), vb );
+    __m256i const z = _mm256_xor_si256( _mm256_loadu_si256( reinterpret_cast<__m256i const*>( c + i ) ), vc );
+    __m256i const r = _mm256_or_si256( _mm256_and_si256( x, _mm256_or_si256( y, z ) ), _mm256_and_si256( y, z ) );
+    _mm256_storeu_si256( reinterpret_cast<__m256i*>( out + i ), r );
+  }
+#endif
+  for ( ; i < num_words; ++i )
+  {
+    uint64_t const x = a[i] ^ ca;
+    uint64_t const y = b[i] ^ cb;
+    uint64_t const z = c[i] ^ cc;
+    out[i] = ( x & ( y | z ) ) | ( y & z );
+  }
+}
+
+namespace detail
+{
+
+inline uint64_t count_word( uint64_t word )
+{
+  return __builtin_popcount( static_cast<uint32_t>( word ) ) + __builtin_popcount( static_cast<uint32_t>( word >> 32u ) );
+}
+
+} /* namespace detail */
+
+/*! \brief Returns a pointer to the words of a truth table. */
+template<class TT>
+inline uint64_t const* truth_table_words( TT const& tt )
+{
+  return &*std::cbegin( tt );
+}
+
+/*! \brief Checks whether `( a[i] ^ ca ) & ( b[i] ^ cb )` is zero for all words. */
+inline bool and_is_zero_words( uint64_t const* a, uint64_t ca, uint64_t const* b, uint64_t cb, uint64_t num_words )
+{
+  uint64_t i{ 0 };
+#if defined( __AVX512F__ )
+  __m512i const va = _mm512_set1_epi64( static_cast<long long>( ca ) );
+  __m512i const vb = _mm512_set1_epi64( static_cast<long long>( cb ) );
+  for ( ; i + 8u <= num_words; i += 8u )
+  {
+    __m512i const x = _mm512_xor_si512( _mm512_loadu_si512( a + i ), va );
+    __m512i const y = _mm512_xor_si512( _mm512_loadu_si512( b + i ), vb );
+    if ( _mm512_test_epi64_mask( x, y ) != 0 )
+    {
+      return false;
+    }
+  }
+#elif defined( __AVX2__ )
+  __m256i const va = _mm256_set1_epi64x( static_cast<long long>( ca ) );
+  __m256i const vb = _mm256_set1_epi64x( static_cast<long long>( cb ) );
+  for ( ; i + 4u <= num_words; i += 4u )
+  {
+    __m256i const x = _mm256_xor_si256( _mm256_loadu_si256( reinterpret_cast<__m256i const*>( a + i ) ), va );
+    __m256i const y = _mm256_xor_si256( _mm256_loadu_si256( reinterpret_cast<__m256i const*>( b + i ) ), vb );
+    if ( !_mm256_testz_si256( x, y ) )
+    {
+      return false;
+    }
+  }
+#endif
+  for ( ; i < num_words; ++i )
+  {
+    if ( ( ( a[i] ^ ca ) & ( b[i] ^ cb ) ) != 0u )
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*! \brief Checks whether `( a[i] ^ ca ) & ( b[i] ^ cb ) & ( c[i] ^ cc )` is zero for all words. */
+inline bool and3_is_zero_words( uint64_t const* a, uint64_t ca, uint64_t const* b, uint64_t cb, uint64_t const* c, uint64_t cc, uint64_t num_words )
+{
+  uint64_t i{ 0 };
+#if defined( __AVX512F__ )
+  __m512i const va = _mm512_set1_epi64( static_cast<long long>( ca ) );
+  __m512i const vb = _mm512_set1_epi64( static_cast<long long>( cb ) );
+  __m512i const vc = _mm512_set1_epi64( static_cast<long long>( cc ) );
+  for ( ; i + 8u <= num_words; i += 8u )
+  {
+    __m512i const x = _mm512_xor_si512( _mm512_loadu_si512( a + i ), va );
+    __m512i const y = _mm512_xor_si512( _mm512_loadu_si512( b + i ), vb );
+    __m512i const z = _mm512_xor_si512( _mm512_loadu_si512( c + i ), vc );
+    if ( _mm512_test_epi64_mask( _mm512_and_si512( x, y ), z ) != 0 )
+    {
+      return false;
+    }
+  }
+#elif defined( __AVX2__ )
+  __m256i const va = _mm256_set1_epi64x( static_cast<long long>( ca ) );
+  __m256i const vb = _mm256_set1_epi64x( static_cast<long long>( cb ) );
+  __m256i const vc = _mm256_set1_epi64x( static_cast<long long>( cc ) );
+  for ( ; i + 4u <= num_words; i += 4u )
+  {
+    __m256i const x = _mm256_xor_si256( _mm256_loadu_si256( reinterpret_cast<__m256i const*>( a + i ) ), va );
+    __m256i const y = _mm256_xor_si256( _mm256_loadu_si256( reinterpret_cast<__m256i const*>( b + i ) ), vb );
+    __m256i const z = _mm256_xor_si256( _mm256_loadu_si256( reinterpret_cast<__m256i const*>( c + i ) ), vc );
+    if ( !_mm256_testz_si256( _mm256_and_si256( x, y ), z ) )
+    {
+      return false;
+    }
+  }
+#endif
+  for ( ; i < num_words; ++i )
+  {
+    if ( ( ( a[i] ^ ca ) & ( b[i] ^ cb ) & ( c[i] ^ cc ) ) != 0u )
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*! \brief Checks whether `( a[i] ^ b[i] ^ cab ) & c[i]` is zero for all words. */
+inline bool xor_and_is_zero_words( uint64_t const* a, uint64_t const* b, uint64_t cab, uint64_t const* c, uint64_t num_words )
+{
+  uint64_t i{ 0 };
+#if defined( __AVX512F__ )
+  __m512i const vm = _mm512_set1_epi64( static_cast<long long>( cab ) );
+  for ( ; i + 8u <= num_words; i += 8u )
+  {
+    __m512i const x = _mm512_ternarylogic_epi64( _mm512_loadu_si512( a + i ), _mm512_loadu_si512( b + i ), vm, 0x96 );
+    if ( _mm512_test_epi64_mask( x, _mm512_loadu_si512( c + i ) ) != 0 )
+    {
+      return false;
+    }
+  }
+#elif defined( __AVX2__ )
+  __m256i const vm = _mm256_set1_epi64x( static_cast<long long>( cab ) );
+  for ( ; i + 4u <= num_words; i += 4u )
+  {
+    __m256i const x = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( a + i ) );
+    __m256i const y = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( b + i ) );
+    __m256i const z = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( c + i ) );
+    if ( !_mm256_testz_si256( _mm256_xor_si256( _mm256_xor_si256( x, y ), vm ), z ) )
+    {
+      return false;
+    }
+  }
+#endif
+  for ( ; i < num_words; ++i )
+  {
+    if ( ( ( a[i] ^ b[i] ^ cab ) & c[i] ) != 0u )
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*! \brief Counts the ones in `( a[i] ^ ca ) & ( b[i] ^ cb )`. */
+inline uint64_t count_and_words( uint64_t const* a, uint64_t ca, uint64_t const* b, uint64_t cb, uint64_t num_words )
+{
+  uint64_t count{ 0 };
+  for ( uint64_t i = 0u; i < num_words; ++i )
+  {
+    count += detail::count_word( ( a[i] ^ ca ) & ( b[i] ^ cb ) );
+  }
+  return count;
+}
+
+/*! \brief Counts the ones in `( a[i] ^ ca ) & ( b[i] ^ cb ) & ( c[i] ^ cc )`. */
+inline uint64_t count_and3_words( uint64_t const* a, uint64_t ca, uint64_t const* b, uint64_t cb, uint64_t const* c, uint64_t cc, uint64_t num_words )
+{
+  uint64_t count{ 0 };
+  for ( uint64_t i = 0u; i < num_words; ++i )
+  {
+    count += detail::count_word( ( a[i] ^ ca ) & ( b[i] ^ cb ) & ( c[i] ^ cc ) );
+  }
+  return count;
+}
+
+/*! \brief Counts the ones in `( a[i] ^ b[i] ^ cab ) & c[i]`. */
+inline uint64_t count_xor_and_words( uint64_t const* a, uint64_t const* b, uint64_t cab, uint64_t const* c, uint64_t num_words )
+{
+  uint64_t count{ 0 };
+  for ( uint64_t i = 0u; i < num_words; ++i )
+  {
+    count += detail::count_word( ( a[i] ^ b[i] ^ cab ) & c[i] );
+  }
+  return count;
+}
+
+} /* namespace mockturtle */
@@ -0,0 +1,462 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2023  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file compact_fanout_view.hpp
+  \brief Implements fanout for a network using a flat CSR layout
+*/
+
+#pragma once
+
+#include "../networks/detail/foreach.hpp"
+#include "../networks/events.hpp"
+#include "../traits.hpp"
+#include "fanout_view.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <stack>
+#include <unordered_map>
+#include <vector>
+
+namespace mockturtle
+{
+
+struct compact_fanout_view_params : fanout_view_params
+{
+  /*! \brief Number of free slots reserved per node when (re)building. */
+  uint32_t slack{ 1u };
+};
+
+/*! \brief Implements `foreach_fanout` methods for networks.
+ *
+ * This view computes the fanout of each node of the network and
+ * provides the same interface as `fanout_view`.  Instead of one vector
+ * per node, the fanouts are stored in a compressed-sparse-row layout:
+ * all fanout lists are kept in a single array, in which each node owns
+ * a segment described by an offset, a size, and a capacity.  Each
+ * segment has some free slots (`slack`) to absorb incremental updates
+ * triggered by network events.  A segment that overflows is moved to
+ * the end of the array with twice its capacity, and the array is
+ * compacted when more than half of it is unused.
+ *
+ * **Required network functions:**
+ * - `foreach_node`
+ * - `foreach_fanin`
+ * - `node_to_index`
+ *
+ */
+template<typename Ntk, bool has_fanout_interface = has_foreach_fanout_v<Ntk>>
+class compact_fanout_view
+{
+};
+
+template<typename Ntk>
+class compact_fanout_view<Ntk, true> : public Ntk
+{
+public:
+  compact_fanout_view( Ntk const& ntk, compact_fanout_view_params const& ps = {} ) : Ntk( ntk )
+  {
+    (void)ps;
+  }
+};
+
+template<typename Ntk>
+class compact_fanout_view<Ntk, false> : public Ntk
+{
+public:
+  using storage = typename Ntk::storage;
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+  explicit compact_fanout_view( compact_fanout_view_params const& ps = {} )
+      : Ntk(), _ps( ps )
+  {
+    static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+    static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
+    static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+    static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+
+    update_fanout();
+
+    register_events();
+  }
+
+  explicit compact_fanout_view( Ntk const& ntk, compact_fanout_view_params const& ps = {} )
+      : Ntk( ntk ), _ps( ps )
+  {
+    static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+    static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
+    static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+    static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+
+    update_fanout();
+
+    register_events();
+  }
+
+  /*! \brief Copy constructor. */
+  compact_fanout_view( compact_fanout_view<Ntk, false> const& other )
+      : Ntk( other ), _ps( other._ps ), _offsets( other._offsets ), _sizes( other._sizes ), _capacities( other._capacities ), _data( other._data ), _num_unused( other._num_unused )
+  {
+    register_events();
+  }
+
+  compact_fanout_view<Ntk, false>& operator=( compact_fanout_view<Ntk, false> const& other )
+  {
+    release_events();
+
+    /* update the base class */
+    this->_storage = other._storage;
+    this->_events = other._events;
+
+    /* copy */
+    _ps = other._ps;
+    _offsets = other._offsets;
+    _sizes = other._sizes;
+    _capacities = other._capacities;
+    _data = other._data;
+    _num_unused = other._num_unused;
+
+    register_events();
+
+    return *this;
+  }
+
+  ~compact_fanout_view()
+  {
+    release_events();
+  }
+
+  template<typename Fn>
+  void foreach_fanout( node const& n, Fn&& fn ) const
+  {
+    auto const index = this->node_to_index( n );
+    assert( index < _sizes.size() );
+
+    /* `fn` must not modify the network, as this may move or shrink the
+       segment; iterate over a copy returned by `fanout` instead */
+    auto const begin = _data.begin() + _offsets[index];
+    detail::foreach_element( begin, begin + _sizes[index], fn );
+  }
+
+  void update_fanout()
+  {
+    compute_fanout();
+  }
+
+  std::vector<node> fanout( node const& n ) const
+  {
+    auto const index = this->node_to_index( n );
+    auto const begin = _data.begin() + _offsets[index];
+    return std::vector<node>( begin, begin + _sizes[index] );
+  }
+
+  void substitute_node( node const& old_node, signal const& new_signal )
+  {
+    if ( Ntk::get_node( new_signal ) == old_node && !Ntk::is_complemented( new_signal ) )
+      return;
+
+    if ( Ntk::is_dead( Ntk::get_node( new_signal ) ) )
+    {
+      Ntk::revive_node( Ntk::get_node( new_signal ) );
+    }
+
+    std::unordered_map<node, signal> old_to_new;
+    std::stack<std::pair<node, signal>> to_substitute;
+    to_substitute.push( { old_node, new_signal } );
+
+    while ( !to_substitute.empty() )
+    {
+      const auto [_old, _curr] = to_substitute.top();
+      to_substitute.pop();
+
+      signal _new = _curr;
+      /* find the real new node */
+      if ( Ntk::is_dead( Ntk::get_node( _new ) ) )
+      {
+        auto it = old_to_new.find( Ntk::get_node( _new ) );
+        while ( it != old_to_new.end() )
+        {
+          _new = Ntk::is_complemented( _new ) ? Ntk::create_not( it->second ) : it->second;
+          it = old_to_new.find( Ntk::get_node( _new ) );
+        }
+      }
+      /* revive */
+      if ( Ntk::is_dead( Ntk::get_node( _new ) ) )
+      {
+        Ntk::revive_node( Ntk::get_node( _new ) );
+      }
+
+      if ( Ntk::get_node( _new ) == _old && !Ntk::is_complemented( _new ) )
+        continue;
+
+      const auto parents = fanout( _old );
+      for ( auto n : parents )
+      {
+        if ( const auto repl = Ntk::replace_in_node( n, _old, _new ); repl )
+        {
+          to_substitute.push( *repl );
+        }
+      }
+
+      /* check outputs */
+      Ntk::replace_in_outputs( _old, _new );
+
+      /* reset fan-in of old node */
+      if ( _old != Ntk::get_node( _new ) ) /* substitute a node using itself*/
+      {
+        old_to_new.insert( { _old, _new } );
+        Ntk::take_out_node( _old );
+      }
+    }
+  }
+
+  void substitute_node_no_restrash( node const& old_node, signal const& new_signal )
+  {
+    if ( Ntk::get_node( new_signal ) == old_node && !Ntk::is_complemented( new_signal ) )
+      return;
+
+    if ( Ntk::is_dead( Ntk::get_node( new_signal ) ) )
+    {
+      Ntk::revive_node( Ntk::get_node( new_signal ) );
+    }
+
+    const auto parents = fanout( old_node );
+    for ( auto n : parents )
+    {
+      Ntk::replace_in_node_no_restrash( n, old_node, new_signal );
+    }
+
+    /* check outputs */
+    Ntk::replace_in_outputs( old_node, new_signal );
+
+    /* recursively reset old node */
+    if ( old_node != new_signal.index )
+    {
+      Ntk::take_out_node( old_node );
+    }
+  }
+
+private:
+  void register_events()
+  {
+    if ( _ps.update_on_add )
+    {
+      add_event = Ntk::events().register_add_event( [this]( auto const& n ) {
+        resize();
+        Ntk::foreach_fanin( n, [&, this]( auto const& f ) {
+          insert( this->node_to_index( Ntk::get_node( f ) ), n );
+        } );
+      } );
+    }
+
+    if ( _ps.update_on_modified )
+    {
+      modified_event = Ntk::events().register_modified_event( [this]( auto const& n, auto const& previous ) {
+        for ( auto const& f : previous )
+        {
+          erase( this->node_to_index( Ntk::get_node( f ) ), n );
+        }
+        Ntk::foreach_fanin( n, [&, this]( auto const& f ) {
+          insert( this->node_to_index( Ntk::get_node( f ) ), n );
+        } );
+      } );
+    }
+
+    if ( _ps.update_on_delete )
+    {
+      delete_event = Ntk::events().register_delete_event( [this]( auto const& n ) {
+        _sizes[this->node_to_index( n )] = 0u;
+        Ntk::foreach_fanin( n, [&, this]( auto const& f ) {
+          erase( this->node_to_index( Ntk::get_node( f ) ), n );
+        } );
+      } );
+    }
+  }
+
+  void release_events()
+  {
+    if ( add_event )
+    {
+      Ntk::events().release_add_event( add_event );
+    }
+
+    if ( modified_event )
+    {
+      Ntk::events().release_modified_event( modified_event );
+    }
+
+    if ( delete_event )
+    {
+      Ntk::events().release_delete_event( delete_event );
+    }
+  }
+
+  template<typename Fn>
+  void foreach_parent( Fn&& fn )
+  {
+    /* Compute fanout also for buffers in buffered networks */
+    if constexpr ( is_buffered_network_type_v<Ntk> )
+    {
+      this->foreach_node( [&]( auto const& n ) {
+        if ( this->is_pi( n ) || this->is_constant( n ) )
+          return true;
+        fn( n );
+        return true;
+      } );
+    }
+    else
+    {
+      this->foreach_gate( [&]( auto const& n ) {
+        fn( n );
+      } );
+    }
+  }
+
+  void compute_fanout()
+  {
+    auto const num_nodes = this->size();
+
+    /* first pass: count (possibly repeated) fanins to size the segments */
+    _sizes.assign( num_nodes, 0u );
+    foreach_parent( [&]( auto const& n ) {
+      this->foreach_fanin( n, [&]( auto const& f ) {
+        ++_sizes[this->node_to_index( Ntk::get_node( f ) )];
+      } );
+    } );
+
+    _offsets.resize( num_nodes );
+    _capacities.resize( num_nodes );
+    uint64_t offset = 0u;
+    for ( auto i = 0u; i < num_nodes; ++i )
+    {
+      _offsets[i] = offset;
+      _capacities[i] = _sizes[i] + _ps.slack;
+      offset += _capacities[i];
+      _sizes[i] = 0u;
+    }
+    _data.assign( offset, node{} );
+    _num_unused = 0u;
+
+    /* second pass: fill the segments, parents are visited in order so repeated fanins are adjacent */
+    foreach_parent( [&]( auto const& n ) {
+      this->foreach_fanin( n, [&]( auto const& f ) {
+        auto const index = this->node_to_index( Ntk::get_node( f ) );
+        if ( _sizes[index] == 0u || _data[_offsets[index] + _sizes[index] - 1u] != n )
+        {
+          _data[_offsets[index] + _sizes[index]++] = n;
+        }
+      } );
+    } );
+  }
+
+  void resize()
+  {
+    auto const num_nodes = this->size();
+    if ( num_nodes > _sizes.size() )
+    {
+      _offsets.resize( num_nodes, _data.size() );
+      _sizes.resize( num_nodes, 0u );
+      _capacities.resize( num_nodes, 0u );
+    }
+  }
+
+  void insert( uint64_t index, node const& n )
+  {
+    if ( _sizes[index] == _capacities[index] )
+    {
+      relocate( index, std::max<uint32_t>( 2u * _capacities[index], _ps.slack + 1u ) );
+    }
+    _data[_offsets[index] + _sizes[index]++] = n;
+  }
+
+  void erase( uint64_t index, node const& n )
+  {
+    auto const begin = _data.begin() + _offsets[index];
+    auto const end = std::remove( begin, begin + _sizes[index], n );
+    _sizes[index] = static_cast<uint32_t>( std::distance( begin, end ) );
+  }
+
+  /* moves the segment of a node to the end of the array */
+  void relocate( uint64_t index, uint32_t capacity )
+  {
+    _num_unused += _capacities[index];
+    if ( _num_unused > _data.size() / 2u )
+    {
+      _capacities[index] = capacity;
+      compact();
+      return;
+    }
+
+    auto const offset = _data.size();
+    _data.resize( offset + capacity );
+    std::copy_n( _data.begin() + _offsets[index], _sizes[index], _data.begin() + offset );
+    _offsets[index] = offset;
+    _capacities[index] = capacity;
+  }
+
+  /* rebuilds the array without unused segments */
+  void compact()
+  {
+    std::vector<node> data;
+    uint64_t size = 0u;
+    for ( auto i = 0u; i < _sizes.size(); ++i )
+    {
+      _capacities[i] = std::max( _capacities[i], _sizes[i] + _ps.slack );
+      size += _capacities[i];
+    }
+    data.resize( size );
+
+    uint64_t offset = 0u;
+    for ( auto i = 0u; i < _sizes.size(); ++i )
+    {
+      std::copy_n( _data.begin() + _offsets[i], _sizes[i], data.begin() + offset );
+      _offsets[i] = offset;
+      offset += _capacities[i];
+    }
+
+    _data = std::move( data );
+    _num_unused = 0u;
+  }
+
+  compact_fanout_view_params _ps;
+
+  std::vector<uint64_t> _offsets;
+  std::vector<uint32_t> _sizes;
+  std::vector<uint32_t> _capacities;
+  std::vector<node> _data;
+  uint64_t _num_unused{ 0u };
+
+  std::shared_ptr<typename network_events<Ntk>::add_event_type> add_event;
+  std::shared_ptr<typename network_events<Ntk>::modified_event_type> modified_event;
+  std::shared_ptr<typename network_events<Ntk>::delete_event_type> delete_event;
+};
+
+template<class T>
+compact_fanout_view( T const&, compact_fanout_view_params const& ps = {} ) -> compact_fanout_view<T>;
+
+} // namespace mockturtle
@@ -43,6 +43,7 @@
 
 #include "../networks/detail/foreach.hpp"
 #include "../traits.hpp"
+#include "../utils/traversal.hpp"
 #include "immutable_view.hpp"
 
 namespace mockturtle
@@ -204,15 +205,16 @@ private:
 
   void traverse( node const& n )
   {
-    if ( this->visited( n ) == this->trav_id() )
-      return;
-
-    this->foreach_fanin( n, [&]( const auto& f ) {
-      traverse( this->get_node( f ) );
-    } );
-
-    add_node( n );
-    this->set_visited( n, this->trav_id() );
+    iterative_dfs<node> dfs;
+    dfs.run_fanin(
+        *this, n,
+        [&]( node const& m ) {
+          return this->visited( m ) != this->trav_id();
+        },
+        [&]( node const& m ) {
+          add_node( m );
+          this->set_visited( m, this->trav_id() );
+        } );
   }
 
 public:
@@ -39,6 +39,7 @@
 #include "../traits.hpp"
 #include "../utils/cost_functions.hpp"
 #include "../utils/node_map.hpp"
+#include "../utils/traversal.hpp"
 #include "immutable_view.hpp"
 
 #include <cstdint>
@@ -232,42 +233,53 @@ public:
   }
 
 private:
-  uint32_t compute_levels( node const& n )
+  uint32_t compute_levels( node const& n, iterative_dfs<node>& dfs )
   {
-    if ( this->visited( n ) == this->trav_id() )
-    {
-      return _levels[n];
-    }
-    this->set_visited( n, this->trav_id() );
-
-    if ( this->is_constant( n ) )
-    {
-      return _levels[n] = 0;
-    }
-    if ( this->is_ci( n ) )
-    {
-      assert( !_ps.pi_cost || _cost_fn( *this, n ) >= 1 );
-      return _levels[n] = _ps.pi_cost ? _cost_fn( *this, n ) - 1 : 0;
-    }
-
-    uint32_t level{ 0 };
-    this->foreach_fanin( n, [&]( auto const& f ) {
-      auto clevel = compute_levels( this->get_node( f ) );
-      if ( _ps.count_complements && this->is_complemented( f ) )
-      {
-        clevel++;
-      }
-      level = std::max( level, clevel );
-    } );
+    /* iterative, since the recursion depth would be the depth of the network */
+    dfs.run_fanin(
+        *this, n,
+        [&]( node const& m ) {
+          if ( this->visited( m ) == this->trav_id() )
+            return false;
+          this->set_visited( m, this->trav_id() );
+
+          if ( this->is_constant( m ) )
+          {
+            _levels[m] = 0;
+            return false;
+          }
+          if ( this->is_ci( m ) )
+          {
+            assert( !_ps.pi_cost || _cost_fn( *this, m ) >= 1 );
+            _levels[m] = _ps.pi_cost ? _cost_fn( *this, m ) - 1 : 0;
+            return false;
+          }
+          return true;
+        },
+        [&]( node const& m ) {
+          uint32_t level{ 0 };
+          this->foreach_fanin( m, [&]( auto const& f ) {
+            auto clevel = _levels[f];
+            if ( _ps.count_complements && this->is_complemented( f ) )
+            {
+              clevel++;
+            }
+            level = std::max( level, clevel );
+          } );
+
+          _levels[m] = level + _cost_fn( *this, m );
+        } );
 
-    return _levels[n] = level + _cost_fn( *this, n );
+    return _levels[n];
   }
 
   void compute_levels()
   {
+    iterative_dfs<node> dfs;
+
     _depth = 0;
     this->foreach_po( [&]( auto const& f ) {
-      auto clevel = compute_levels( this->get_node( f ) );
+      auto clevel = compute_levels( this->get_node( f ), dfs );
       if ( _ps.count_complements && this->is_complemented( f ) )
       {
         clevel++;
@@ -278,7 +290,7 @@ private:
     if constexpr ( has_foreach_ri_v<Ntk> )
     {
       this->foreach_ri( [&]( auto const& f ) {
-        auto clevel = compute_levels( this->get_node( f ) );
+        auto clevel = compute_levels( this->get_node( f ), dfs );
         if ( _ps.count_complements && this->is_complemented( f ) )
         {
           clevel++;
@@ -291,7 +303,7 @@ private:
       const auto n = this->get_node( f );
       if ( _levels[n] == _depth )
       {
-        set_critical_path( n );
+        set_critical_path( n, dfs );
       }
     } );
 
@@ -301,31 +313,39 @@ private:
         const auto n = this->get_node( f );
         if ( _levels[n] == _depth )
         {
-          set_critical_path( n );
+          set_critical_path( n, dfs );
         }
       } );
     }
   }
 
-  void set_critical_path( node const& n )
+  void set_critical_path( node const& n, iterative_dfs<node>& dfs )
   {
-    _crit_path[n] = true;
-    if ( !this->is_constant( n ) && !( _ps.pi_cost && this->is_pi( n ) ) )
-    {
-      const auto lvl = _levels[n];
-      this->foreach_fanin( n, [&]( auto const& f ) {
-        const auto cn = this->get_node( f );
-        auto offset = _cost_fn( *this, n );
-        if ( _ps.count_complements && this->is_complemented( f ) )
-        {
-          offset++;
-        }
-        if ( _levels[cn] + offset == lvl && !_crit_path[cn] )
-        {
-          set_critical_path( cn );
-        }
-      } );
-    }
+    dfs.run(
+        n, [&]( node const& m, auto&& push ) {
+          if ( this->is_constant( m ) || ( _ps.pi_cost && this->is_pi( m ) ) )
+            return;
+
+          const auto lvl = _levels[m];
+          this->foreach_fanin( m, [&]( auto const& f ) {
+            const auto cn = this->get_node( f );
+            auto offset = _cost_fn( *this, m );
+            if ( _ps.count_complements && this->is_complemented( f ) )
+            {
+              offset++;
+            }
+            if ( _levels[cn] + offset == lvl )
+            {
+              push( cn );
+            }
+          } );
+        },
+        [&]( node const& m ) {
+          if ( _crit_path[m] )
+            return false;
+          _crit_path[m] = true;
+          return true;
+        } );
   }
 
   void on_add( node const& n )
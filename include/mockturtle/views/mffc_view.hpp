@@ -43,6 +43,7 @@
 
 #include "../networks/detail/foreach.hpp"
 #include "../traits.hpp"
+#include "../utils/traversal.hpp"
 #include "immutable_view.hpp"
 
 namespace mockturtle
@@ -266,32 +267,38 @@ private:
     {
       _colors[i] = 2u;
     }
-    topo_sort_rec( _root );
+    topo_sort( _root );
 
     assert( _inner.size() == _topo.size() );
     _inner = _topo;
   }
 
-  void topo_sort_rec( node const& n )
+  void topo_sort( node const& n )
   {
-    const auto idx = _node_to_index[n];
-
-    /* is permanently marked? */
-    if ( _colors[idx] == 2u )
-      return;
-
-    /* mark node temporarily */
-    _colors[idx] = 1u;
-
-    /* mark children */
-    Ntk::foreach_fanin( n, [&]( auto const& f ) {
-      topo_sort_rec( Ntk::get_node( f ) );
-    } );
-
-    /* mark node n permanently */
-    _colors[idx] = 2u;
-
-    _topo.push_back( n );
+    iterative_dfs<node> dfs;
+    dfs.run(
+        n, [this]( node const& m, auto&& push ) {
+          Ntk::foreach_fanin( m, [&]( signal const& f ) {
+            push( Ntk::get_node( f ) );
+          } );
+        },
+        [&]( node const& m ) {
+          const auto idx = _node_to_index[m];
+
+          /* is permanently marked? */
+          if ( _colors[idx] == 2u )
+            return false;
+
+          /* mark node temporarily */
+          _colors[idx] = 1u;
+          return true;
+        },
+        [&]( node const& m ) {
+          /* mark node permanently */
+          _colors[_node_to_index[m]] = 2u;
+
+          _topo.push_back( m );
+        } );
   }
 
 public:
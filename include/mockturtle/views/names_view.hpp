@@ -36,13 +36,32 @@
 #pragma once
 
 #include "../traits.hpp"
+#include "../utils/string_pool.hpp"
 
+#include <cstdint>
 #include <map>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace mockturtle
 {
 
+/*! \brief Names for the signals and primary outputs of a network.
+ *
+ * The names are interned in a `string_pool`.  The name of the regular
+ * signal of a node is found by the node index in a vector, which grows up
+ * to the largest named node index, and the names of the primary outputs
+ * are found by their index.  Only the names of other signals, i.e.,
+ * complemented signals and further outputs of multi-output nodes, are
+ * kept in a map.
+ *
+ * Names can be exported in bulk with `foreach_name` and
+ * `foreach_output_name`, which visit the names as string views without
+ * copying them.  Before importing many names, `reserve_names` allocates
+ * the pool at once.
+ */
 template<class Ntk>
 class names_view : public Ntk
 {
@@ -59,7 +78,7 @@ public:
   }
 
   names_view( names_view<Ntk> const& named_ntk )
-      : Ntk( named_ntk ), _network_name( named_ntk._network_name ), _signal_names( named_ntk._signal_names ), _output_names( named_ntk._output_names )
+      : Ntk( named_ntk ), _network_name( named_ntk._network_name ), _names( named_ntk._names ), _node_names( named_ntk._node_names ), _other_signal_names( named_ntk._other_signal_names ), _output_names( named_ntk._output_names )
   {
   }
 
@@ -68,8 +87,10 @@ public:
     if ( this != &named_ntk ) // Check for self-assignment
     {
       Ntk::operator=( named_ntk );
-      _signal_names = named_ntk._signal_names;
       _network_name = named_ntk._network_name;
+      _names = named_ntk._names;
+      _node_names = named_ntk._node_names;
+      _other_signal_names = named_ntk._other_signal_names;
       _output_names = named_ntk._output_names;
     }
     return *this;
@@ -132,7 +153,7 @@ public:
    */
   bool has_name( signal const& s ) const
   {
-    return ( _signal_names.find( s ) != _signal_names.end() );
+    return find_name( s ) != no_name;
   }
 
   /*! \brief Sets the name for a signal.
@@ -142,9 +163,21 @@ public:
    * \param s Signal to be set a name
    * \param name Name of the signal
    */
-  void set_name( signal const& s, std::string const& name )
+  void set_name( signal const& s, std::string_view name )
   {
-    _signal_names[s] = name;
+    auto const id = _names.insert( name ) + 1u;
+    if ( !( Ntk::make_signal( Ntk::get_node( s ) ) == s ) )
+    {
+      _other_signal_names[s] = id;
+      return;
+    }
+
+    auto const index = Ntk::node_to_index( Ntk::get_node( s ) );
+    if ( index >= _node_names.size() )
+    {
+      _node_names.resize( index + 1u, no_name );
+    }
+    _node_names[index] = id;
   }
 
   /*! \brief Gets signal name.
@@ -156,7 +189,24 @@ public:
    */
   std::string get_name( signal const& s ) const
   {
-    return _signal_names.at( s );
+    return std::string( get_name_view( s ) );
+  }
+
+  /*! \brief Gets signal name without copying it.
+   *
+   * The returned string view is invalidated when further names are set.
+   *
+   * \param s Signal to be queried
+   * \return Name of the signal
+   */
+  std::string_view get_name_view( signal const& s ) const
+  {
+    auto const id = find_name( s );
+    if ( id == no_name )
+    {
+      throw std::out_of_range( "names_view: signal has no name" );
+    }
+    return _names[id - 1u];
   }
 
   /*! \brief Checks if a primary output has a name.
@@ -166,7 +216,7 @@ public:
    */
   bool has_output_name( uint32_t index ) const
   {
-    return ( _output_names.find( index ) != _output_names.end() );
+    return index < _output_names.size() && _output_names[index] != no_name;
   }
 
   /*! \brief Sets the name for a primary output.
@@ -177,9 +227,13 @@ public:
    * \param index Index of the primary output to set a name
    * \param name Name of the primary output
    */
-  void set_output_name( uint32_t index, std::string const& name )
+  void set_output_name( uint32_t index, std::string_view name )
   {
-    _output_names[index] = name;
+    if ( index >= _output_names.size() )
+    {
+      _output_names.resize( index + 1u, no_name );
+    }
+    _output_names[index] = _names.insert( name ) + 1u;
   }
 
   /*! \brief Gets the name of a primary output.
@@ -192,13 +246,100 @@ public:
    */
   std::string get_output_name( uint32_t index ) const
   {
-    return _output_names.at( index );
+    return std::string( get_output_name_view( index ) );
+  }
+
+  /*! \brief Gets the name of a primary output without copying it.
+   *
+   * The returned string view is invalidated when further names are set.
+   *
+   * \param index Index of the primary output to be queried
+   * \return Name of the primary output
+   */
+  std::string_view get_output_name_view( uint32_t index ) const
+  {
+    if ( !has_output_name( index ) )
+    {
+      throw std::out_of_range( "names_view: primary output has no name" );
+    }
+    return _names[_output_names[index] - 1u];
+  }
+
+  /*! \brief Calls `fn( s, name )` for all named signals.
+   *
+   * The regular signals of the nodes are visited in the order of their
+   * node indexes, followed by the other named signals.
+   */
+  template<typename Fn>
+  void foreach_name( Fn&& fn ) const
+  {
+    for ( auto index = 0u; index < _node_names.size(); ++index )
+    {
+      if ( _node_names[index] != no_name )
+      {
+        fn( Ntk::make_signal( Ntk::index_to_node( index ) ), _names[_node_names[index] - 1u] );
+      }
+    }
+    for ( auto const& [s, id] : _other_signal_names )
+    {
+      fn( s, _names[id - 1u] );
+    }
+  }
+
+  /*! \brief Calls `fn( index, name )` for all named primary outputs. */
+  template<typename Fn>
+  void foreach_output_name( Fn&& fn ) const
+  {
+    for ( auto index = 0u; index < _output_names.size(); ++index )
+    {
+      if ( _output_names[index] != no_name )
+      {
+        fn( index, _names[_output_names[index] - 1u] );
+      }
+    }
+  }
+
+  /*! \brief Removes the names of all signals and primary outputs. */
+  void clear_names()
+  {
+    _names.clear();
+    _node_names.clear();
+    _other_signal_names.clear();
+    _output_names.clear();
+  }
+
+  /*! \brief Reserves space for names.
+   *
+   * \param num_names Number of names to be set
+   * \param num_chars Total number of characters of the names
+   */
+  void reserve_names( uint32_t num_names, uint64_t num_chars = 0u )
+  {
+    _names.reserve( _names.size() + num_names, _names.num_chars() + num_chars );
+  }
+
+private:
+  /* entries of the name indexes are shifted by one, such that zero marks an unnamed signal */
+  static constexpr uint32_t no_name = 0u;
+
+  uint32_t find_name( signal const& s ) const
+  {
+    if ( !( Ntk::make_signal( Ntk::get_node( s ) ) == s ) )
+    {
+      auto const it = _other_signal_names.find( s );
+      return it == _other_signal_names.end() ? no_name : it->second;
+    }
+
+    auto const index = Ntk::node_to_index( Ntk::get_node( s ) );
+    return index < _node_names.size() ? _node_names[index] : no_name;
   }
 
 private:
   std::string _network_name;
-  std::map<signal, std::string> _signal_names;
-  std::map<uint32_t, std::string> _output_names;
+  string_pool _names;
+  std::vector<uint32_t> _node_names;
+  std::map<signal, uint32_t> _other_signal_names;
+  std::vector<uint32_t> _output_names;
 }; /* names_view */
 
 template<class T>
@@ -0,0 +1,199 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2023  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file snapshot_view.hpp
+  \brief Read-only network loaded from a memory-mapped snapshot
+*/
+
+#pragma once
+
+#include "../io/serialize.hpp"
+#include "../utils/mapped_file.hpp"
+#include "immutable_view.hpp"
+
+#include <list>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <kitty/cube.hpp>
+
+namespace mockturtle
+{
+
+/*! \brief Read-only network loaded from a snapshot file.
+ *
+ * The snapshot (see `serialize_network`) is mapped into memory and the
+ * node arrays are copied into the storage in one block each, without
+ * going through a stream.  The structural hash table is not loaded, which
+ * is the dominant cost when loading large snapshots; this is fine for
+ * analysis passes, since the view deletes all methods that change the
+ * network (as `immutable_view`) or that query the hash table (such as
+ * `has_and`).
+ *
+ * The hash table is loaded from the mapped file when `unlock` is called,
+ * which returns the underlying network, ready to be modified.  Copies of
+ * the underlying network taken from the view otherwise (e.g., by passing
+ * the view to a function taking an `Ntk` by value) share the storage
+ * without the hash table and must not be modified before `unlock` has
+ * been called.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      serialize_network( aig, std::string( "design.snap" ) );
+
+      snapshot_view<aig_network> snap{ "design.snap" };
+      if ( snap.is_valid() )
+      {
+        depth_view depth_snap{ snap };
+        std::cout << depth_snap.depth() << "\n";
+
+        if ( auto aig2 = snap.unlock() )
+        {
+          aig2->create_and( aig2->pi_at( 0 ), aig2->pi_at( 1 ) );
+        }
+      }
+   \endverbatim
+ */
+template<typename Ntk>
+class snapshot_view : public immutable_view<Ntk>
+{
+public:
+  using storage = typename Ntk::storage;
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+  /*! \brief Maps and loads a snapshot file.
+   *
+   * \param filename Filename of the snapshot
+   * \param ntk Empty network used to load the snapshot (e.g., a
+   *            `binding_view` constructed with its library)
+   */
+  explicit snapshot_view( std::string const& filename, Ntk const& ntk = Ntk() )
+      : immutable_view<Ntk>( ntk ),
+        _state( std::make_shared<lazy_state>( filename ) )
+  {
+    if ( !_state->file->is_open() )
+    {
+      return;
+    }
+
+    detail::snapshot_memory_archive ar{ _state->file->data(), 0u, _state->file->size() };
+    _valid = detail::read_snapshot( static_cast<Ntk&>( *this ), ar, &_state->hash_offset );
+  }
+
+  /*! \brief Whether the snapshot has been loaded successfully. */
+  bool is_valid() const
+  {
+    return _valid;
+  }
+
+  /*! \brief Whether the hash table has been loaded. */
+  bool has_hash() const
+  {
+    return _state->hash_loaded;
+  }
+
+  /*! \brief Returns the underlying network after loading its hash table.
+   *
+   * The returned network shares the storage with this view.  The hash
+   * table is loaded at the first call, after which the mapping of the
+   * file is released.
+   *
+   * \return The network, or `std::nullopt` if the snapshot is invalid or
+   *         its hash table cannot be loaded
+   */
+  std::optional<Ntk> unlock()
+  {
+    if ( !_valid )
+    {
+      return std::nullopt;
+    }
+
+    if ( !_state->hash_loaded )
+    {
+      Ntk& ntk = *this;
+      if ( !detail::read_snapshot_hash_at( ntk, _state->file->data(), _state->file->size(), _state->hash_offset ) )
+      {
+        if constexpr ( detail::snapshot_storage_has_hash<typename storage::element_type>::value )
+        {
+          ntk._storage->hash.clear();
+        }
+        return std::nullopt;
+      }
+      _state->hash_loaded = true;
+      _state->file.reset();
+    }
+    return static_cast<Ntk const&>( *this );
+  }
+
+  std::optional<signal> has_and( signal const& a, signal const& b ) = delete;
+  std::optional<signal> has_xor( signal const& a, signal const& b ) = delete;
+  std::optional<signal> has_maj( signal const& a, signal const& b, signal const& c ) = delete;
+  std::optional<signal> has_xor3( signal const& a, signal const& b, signal const& c ) = delete;
+
+  /* methods changing the network that are not deleted by `immutable_view` */
+  signal create_xor3( signal const& a, signal const& b, signal const& c ) = delete;
+  signal create_nary_and( std::vector<signal> const& fs ) = delete;
+  signal create_nary_or( std::vector<signal> const& fs ) = delete;
+  signal create_nary_xor( std::vector<signal> const& fs ) = delete;
+  signal create_ha( signal const& a, signal const& b ) = delete;
+  signal create_hai( signal const& a, signal const& b ) = delete;
+  signal create_fa( signal const& a, signal const& b, signal const& c ) = delete;
+  signal create_fai( signal const& a, signal const& b, signal const& c ) = delete;
+  signal create_cover_node( std::vector<signal> const& fanin, std::pair<std::vector<kitty::cube>, bool> const& cover ) = delete;
+  void substitute_nodes( std::list<std::pair<node, signal>> substitutions ) = delete;
+  void substitute_node_no_restrash( node const& old_node, signal const& new_signal ) = delete;
+  void replace_in_node( node const& n, node const& old_node, signal new_signal ) = delete;
+  void replace_in_node_no_restrash( node const& n, node const& old_node, signal new_signal ) = delete;
+  void replace_in_outputs( node const& old_node, signal const& new_signal ) = delete;
+  void take_out_node( node const& n ) = delete;
+  void revive_node( node const& n ) = delete;
+
+private:
+  struct lazy_state
+  {
+    explicit lazy_state( std::string const& filename ) : file( std::make_unique<mapped_file>( filename ) ) {}
+
+    std::unique_ptr<mapped_file> file;
+    uint64_t hash_offset{ 0u };
+    bool hash_loaded{ false };
+  };
+
+  std::shared_ptr<lazy_state> _state;
+  bool _valid{ false };
+};
+
+template<class T>
+snapshot_view( std::string const&, T const& ) -> snapshot_view<T>;
+
+} // namespace mockturtle
@@ -0,0 +1,576 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file timing_view.hpp
+  \brief Incremental arrival and required times for a network
+*/
+
+#pragma once
+
+#include "../networks/events.hpp"
+#include "../traits.hpp"
+#include "../utils/cost_functions.hpp"
+#include "../utils/traversal.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace mockturtle
+{
+
+/*! \brief Maintains arrival times, required times, and slacks incrementally.
+ *
+ * This view computes the arrival time (level) of each node, the longest
+ * delay from each node to the outputs, and the depth of the network.  In
+ * contrast to `depth_view`, which recomputes all levels when calling
+ * `update_levels`, this view listens to the network events for adding,
+ * modifying, and deleting nodes and only propagates the changes.  The
+ * propagation processes nodes in buckets ordered by their previous
+ * arrival (or output) time and stops at nodes whose times do not change.
+ *
+ * Changes are propagated lazily, i.e., the first query after a modification
+ * updates the times.  Afterwards, `depth` is answered in constant time and
+ * `level`, `required`, and `slack` are answered in constant time per node.
+ *
+ * The view implements the interface methods `depth`, `level`, and
+ * `update_levels` of `depth_view`, such that algorithms requiring a depth
+ * interface can be run on it without recomputing all levels after each
+ * change.  The delay of a gate is given by `NodeCostFn`; CIs and constants
+ * have arrival time 0.  Complemented edges are not taken into account.
+ *
+ * The required time of the outputs is the depth of the network, unless a
+ * required time is set with `set_required_time`.
+ *
+ * **Required network functions:**
+ * - `size`
+ * - `get_node`
+ * - `node_to_index`
+ * - `foreach_node`
+ * - `foreach_fanin`
+ * - `foreach_fanout`
+ * - `foreach_po`
+ * - `is_dead`
+ *
+ * Example
+ *
+   \verbatim embed:rst
+
+   .. code-block:: c++
+
+      // create network somehow
+      aig_network aig = ...;
+
+      // fanouts are required to propagate arrival times
+      fanout_view aig_fanout{aig};
+      timing_view aig_timing{aig_fanout};
+
+      // optimize
+      ...
+      aig_timing.substitute_node( n, f );
+
+      // queries only update the affected nodes
+      std::cout << "Depth: " << aig_timing.depth() << "\n";
+   \endverbatim
+ */
+template<class Ntk, class NodeCostFn = unit_cost<Ntk>>
+class timing_view : public Ntk
+{
+public:
+  using storage = typename Ntk::storage;
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+  /*! \brief Standard constructor.
+   *
+   * \param ntk Base network
+   * \param cost_fn Delay of the nodes
+   */
+  explicit timing_view( Ntk const& ntk, NodeCostFn const& cost_fn = {} )
+      : Ntk( ntk ), _cost_fn( cost_fn )
+  {
+    static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+    static_assert( has_size_v<Ntk>, "Ntk does not implement the size method" );
+    static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+    static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+    static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
+    static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+    static_assert( has_foreach_fanout_v<Ntk>, "Ntk does not implement the foreach_fanout method" );
+    static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
+    static_assert( has_is_dead_v<Ntk>, "Ntk does not implement the is_dead method" );
+
+    compute_times();
+    register_events();
+  }
+
+  /*! \brief Copy constructor. */
+  timing_view( timing_view<Ntk, NodeCostFn> const& other )
+      : Ntk( other ), _cost_fn( other._cost_fn )
+  {
+    copy_times( other );
+    register_events();
+  }
+
+  timing_view<Ntk, NodeCostFn>& operator=( timing_view<Ntk, NodeCostFn> const& other )
+  {
+    /* delete the events of this network */
+    release_events();
+
+    /* update the base class */
+    Ntk::operator=( other );
+
+    /* copy */
+    _cost_fn = other._cost_fn;
+    copy_times( other );
+
+    /* register new events in the other network */
+    register_events();
+
+    return *this;
+  }
+
+  ~timing_view()
+  {
+    release_events();
+  }
+
+  /*! \brief Returns the depth of the network. */
+  uint32_t depth() const
+  {
+    update_times();
+    return _depth;
+  }
+
+  /*! \brief Returns the arrival time of a node. */
+  uint32_t level( node const& n ) const
+  {
+    update_times();
+    return _arrival[this->node_to_index( n )];
+  }
+
+  /*! \brief Returns the arrival time of a node (same as `level`). */
+  uint32_t arrival( node const& n ) const
+  {
+    return level( n );
+  }
+
+  /*! \brief Returns the required time of a node.
+   *
+   * The required time is negative if the node cannot meet the required
+   * time of the outputs.
+   */
+  int32_t required( node const& n ) const
+  {
+    update_times();
+    return static_cast<int32_t>( required_time() ) - static_cast<int32_t>( _tail[this->node_to_index( n )] );
+  }
+
+  /*! \brief Returns the slack of a node (required time minus arrival time). */
+  int32_t slack( node const& n ) const
+  {
+    update_times();
+    auto const index = this->node_to_index( n );
+    return static_cast<int32_t>( required_time() ) - static_cast<int32_t>( _arrival[index] + _tail[index] );
+  }
+
+  /*! \brief Returns true if the node is on a path of length `depth`. */
+  bool is_on_critical_path( node const& n ) const
+  {
+    update_times();
+    auto const index = this->node_to_index( n );
+    return _arrival[index] + _tail[index] == _depth;
+  }
+
+  /*! \brief Sets the required time of the outputs.
+   *
+   * By default, the required time is the depth of the network.
+   */
+  void set_required_time( uint32_t required_time )
+  {
+    _required_time = required_time;
+  }
+
+  /*! \brief Uses the depth of the network as required time of the outputs. */
+  void reset_required_time()
+  {
+    _required_time = UINT32_MAX;
+  }
+
+  /*! \brief Propagates pending changes.
+   *
+   * Unlike `depth_view::update_levels`, only the nodes affected by the
+   * changes since the last update are visited.
+   */
+  void update_levels()
+  {
+    update_times();
+  }
+
+  /*! \brief Number of nodes whose arrival or output time was recomputed. */
+  uint64_t num_updates() const
+  {
+    return _num_updates;
+  }
+
+  auto create_po( signal const& f )
+  {
+    update_times();
+    auto const po = Ntk::create_po( f );
+    if ( !_outputs_dirty )
+    {
+      add_output( this->get_node( f ) );
+    }
+    return po;
+  }
+
+private:
+  uint32_t required_time() const
+  {
+    return _required_time == UINT32_MAX ? _depth : _required_time;
+  }
+
+  uint32_t compute_arrival( node const& n ) const
+  {
+    if ( this->is_constant( n ) || this->is_ci( n ) )
+      return 0u;
+
+    uint32_t arrival{ 0u };
+    this->foreach_fanin( n, [&]( auto const& f ) {
+      arrival = std::max( arrival, _arrival[this->node_to_index( this->get_node( f ) )] );
+    } );
+    return arrival + _cost_fn( *this, n );
+  }
+
+  uint32_t compute_tail( node const& n ) const
+  {
+    uint32_t tail{ 0u };
+    this->foreach_fanout( n, [&]( auto const& g ) {
+      if ( !this->is_dead( g ) )
+      {
+        tail = std::max( tail, _tail[this->node_to_index( g )] + _cost_fn( *this, g ) );
+      }
+    } );
+    return tail;
+  }
+
+  /* computes all times in topological order */
+  void compute_times()
+  {
+    _arrival.assign( this->size(), 0u );
+    _tail.assign( this->size(), 0u );
+    _queued.assign( this->size(), 0u );
+    _output_refs.assign( this->size(), 0u );
+
+    std::vector<node> order;
+    order.reserve( this->size() );
+
+    /* DFS, since node indices are not topologically sorted after substitutions */
+    std::vector<uint8_t> visited( this->size(), 0u );
+    iterative_dfs<node> dfs;
+    this->foreach_node( [&]( auto const& n ) {
+      if ( this->is_dead( n ) )
+        return;
+
+      dfs.run(
+          n, [&]( node const& m, auto&& push ) {
+            if ( this->is_constant( m ) || this->is_ci( m ) )
+              return;
+            this->foreach_fanin( m, [&]( auto const& f ) {
+              push( this->get_node( f ) );
+            } );
+          },
+          [&]( node const& m ) {
+            auto& mark = visited[this->node_to_index( m )];
+            if ( mark != 0u )
+              return false;
+            mark = 1u;
+            return true;
+          },
+          [&]( node const& m ) {
+            order.push_back( m );
+          } );
+    } );
+
+    for ( auto const& n : order )
+    {
+      _arrival[this->node_to_index( n )] = compute_arrival( n );
+    }
+    for ( auto it = order.rbegin(); it != order.rend(); ++it )
+    {
+      _tail[this->node_to_index( *it )] = compute_tail( *it );
+    }
+    _num_updates += 2u * order.size();
+
+    compute_outputs();
+  }
+
+  /* collects the output drivers and their arrival times */
+  void compute_outputs() const
+  {
+    for ( auto const& n : _outputs )
+    {
+      _output_refs[this->node_to_index( n )] = 0u;
+    }
+    _outputs.clear();
+    _output_levels.clear();
+    _depth = 0u;
+
+    this->foreach_po( [&]( auto const& f ) {
+      add_output( this->get_node( f ) );
+    } );
+    if constexpr ( has_foreach_ri_v<Ntk> )
+    {
+      this->foreach_ri( [&]( auto const& f ) {
+        add_output( this->get_node( f ) );
+      } );
+    }
+
+    _outputs_dirty = false;
+  }
+
+  void add_output( node const& n ) const
+  {
+    auto const index = this->node_to_index( n );
+    if ( _output_refs[index]++ == 0u )
+    {
+      _outputs.push_back( n );
+    }
+    add_output_level( _arrival[index], 1u );
+  }
+
+  void add_output_level( uint32_t level, uint32_t count ) const
+  {
+    if ( level >= _output_levels.size() )
+    {
+      _output_levels.resize( level + 1u, 0u );
+    }
+    _output_levels[level] += count;
+    _depth = std::max( _depth, level );
+  }
+
+  void remove_output_level( uint32_t level, uint32_t count ) const
+  {
+    assert( _output_levels[level] >= count );
+    _output_levels[level] -= count;
+    while ( _depth > 0u && _output_levels[_depth] == 0u )
+    {
+      --_depth;
+    }
+  }
+
+  void resize_times() const
+  {
+    if ( this->size() > _arrival.size() )
+    {
+      _arrival.resize( this->size(), 0u );
+      _tail.resize( this->size(), 0u );
+      _queued.resize( this->size(), 0u );
+      _output_refs.resize( this->size(), 0u );
+    }
+  }
+
+  void push_arrival( node const& n ) const
+  {
+    auto const index = this->node_to_index( n );
+    if ( _queued[index] & 1u )
+      return;
+    _queued[index] |= 1u;
+    _arrival_queue.push( _arrival[index], n );
+  }
+
+  void push_tail( node const& n ) const
+  {
+    auto const index = this->node_to_index( n );
+    if ( _queued[index] & 2u )
+      return;
+    _queued[index] |= 2u;
+    _tail_queue.push( _tail[index], n );
+  }
+
+  void update_times() const
+  {
+    if ( _arrival_queue.empty() && _tail_queue.empty() && !_outputs_dirty )
+      return;
+
+    resize_times();
+
+    /* forward propagation of arrival times, in order of previous arrival time */
+    while ( !_arrival_queue.empty() )
+    {
+      auto const n = _arrival_queue.pop().second;
+
+      auto const index = this->node_to_index( n );
+      _queued[index] &= ~1u;
+      if ( this->is_dead( n ) )
+        continue;
+
+      ++_num_updates;
+      auto const arrival = compute_arrival( n );
+      if ( arrival == _arrival[index] )
+        continue;
+
+      if ( _output_refs[index] > 0u && !_outputs_dirty )
+      {
+        add_output_level( arrival, _output_refs[index] );
+        remove_output_level( _arrival[index], _output_refs[index] );
+      }
+      _arrival[index] = arrival;
+
+      this->foreach_fanout( n, [&]( auto const& g ) {
+        push_arrival( g );
+      } );
+    }
+
+    /* backward propagation of output times, in order of previous output time */
+    while ( !_tail_queue.empty() )
+    {
+      auto const n = _tail_queue.pop().second;
+
+      auto const index = this->node_to_index( n );
+      _queued[index] &= ~2u;
+      if ( this->is_dead( n ) )
+        continue;
+
+      ++_num_updates;
+      auto const tail = compute_tail( n );
+      if ( tail == _tail[index] )
+        continue;
+      _tail[index] = tail;
+
+      if ( this->is_constant( n ) || this->is_ci( n ) )
+        continue;
+
+      this->foreach_fanin( n, [&]( auto const& f ) {
+        push_tail( this->get_node( f ) );
+      } );
+    }
+
+    if ( _outputs_dirty )
+    {
+      compute_outputs();
+    }
+  }
+
+  void on_add( node const& n )
+  {
+    resize_times();
+    push_arrival( n );
+    this->foreach_fanin( n, [&]( auto const& f ) {
+      push_tail( this->get_node( f ) );
+    } );
+  }
+
+  void on_modified( node const& n, std::vector<signal> const& previous )
+  {
+    resize_times();
+    push_arrival( n );
+    for ( auto const& f : previous )
+    {
+      push_tail( this->get_node( f ) );
+    }
+    this->foreach_fanin( n, [&]( auto const& f ) {
+      push_tail( this->get_node( f ) );
+    } );
+  }
+
+  void on_delete( node const& n )
+  {
+    resize_times();
+
+    /* outputs driven by a deleted node have been redirected */
+    if ( _output_refs[this->node_to_index( n )] > 0u )
+    {
+      _outputs_dirty = true;
+    }
+
+    this->foreach_fanin( n, [&]( auto const& f ) {
+      push_tail( this->get_node( f ) );
+    } );
+  }
+
+  void copy_times( timing_view<Ntk, NodeCostFn> const& other )
+  {
+    other.update_times();
+
+    _arrival = other._arrival;
+    _tail = other._tail;
+    _queued = other._queued;
+    _output_refs = other._output_refs;
+    _outputs = other._outputs;
+    _output_levels = other._output_levels;
+    _depth = other._depth;
+    _required_time = other._required_time;
+    _outputs_dirty = other._outputs_dirty;
+    _num_updates = other._num_updates;
+  }
+
+  void register_events()
+  {
+    add_event = Ntk::events().register_add_event( [this]( auto const& n ) { on_add( n ); } );
+    modified_event = Ntk::events().register_modified_event( [this]( auto const& n, auto const& previous ) { on_modified( n, previous ); } );
+    delete_event = Ntk::events().register_delete_event( [this]( auto const& n ) { on_delete( n ); } );
+  }
+
+  void release_events()
+  {
+    Ntk::events().release_add_event( add_event );
+    Ntk::events().release_modified_event( modified_event );
+    Ntk::events().release_delete_event( delete_event );
+  }
+
+private:
+  NodeCostFn _cost_fn;
+
+  mutable std::vector<uint32_t> _arrival;     /* arrival time of each node */
+  mutable std::vector<uint32_t> _tail;        /* longest delay from each node to an output */
+  mutable std::vector<uint8_t> _queued;       /* pending in the arrival (1) or output time (2) buckets */
+  mutable std::vector<uint32_t> _output_refs; /* number of outputs driven by each node */
+  mutable std::vector<node> _outputs;         /* nodes driving outputs */
+  mutable std::vector<uint32_t> _output_levels; /* number of outputs for each arrival time */
+
+  mutable bucket_queue<node> _arrival_queue; /* nodes to update, by previous arrival time */
+  mutable bucket_queue<node> _tail_queue;    /* nodes to update, by previous output time */
+
+  mutable uint32_t _depth{ 0u };
+  mutable bool _outputs_dirty{ false };
+  mutable uint64_t _num_updates{ 0u };
+  uint32_t _required_time{ UINT32_MAX };
+
+  std::shared_ptr<typename network_events<Ntk>::add_event_type> add_event;
+  std::shared_ptr<typename network_events<Ntk>::modified_event_type> modified_event;
+  std::shared_ptr<typename network_events<Ntk>::delete_event_type> delete_event;
+};
+
+template<class T>
+timing_view( T const& ) -> timing_view<T>;
+
+template<class T, class NodeCostFn>
+timing_view( T const&, NodeCostFn const& ) -> timing_view<T, NodeCostFn>;
+
+} // namespace mockturtle
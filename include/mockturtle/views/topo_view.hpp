@@ -41,6 +41,7 @@
 
 #include "../networks/detail/foreach.hpp"
 #include "../traits.hpp"
+#include "../utils/traversal.hpp"
 #include "immutable_view.hpp"
 
 namespace mockturtle
@@ -262,7 +263,7 @@ public:
     {
       if ( this->visited( this->get_node( *start_signal ) ) == this->trav_id() )
         return;
-      create_topo_rec( this->get_node( *start_signal ) );
+      create_topo( this->get_node( *start_signal ) );
     }
     else
     {
@@ -271,39 +272,46 @@ public:
         if ( this->visited( this->get_node( f ) ) == this->trav_id() )
           return;
 
-        create_topo_rec( this->get_node( f ) );
+        create_topo( this->get_node( f ) );
       } );
     }
   }
 
 private:
-  void create_topo_rec( node const& n )
+  void create_topo( node const& n )
   {
-    /* is permanently marked? */
-    if ( this->visited( n ) == this->trav_id() )
-      return;
-
-    /* ensure that the node is not temporarily marked */
-    assert( this->visited( n ) != this->trav_id() - 1 );
-
-    /* mark node temporarily */
-    this->set_visited( n, this->trav_id() - 1 );
-
-    /* mark children */
-    this->foreach_fanin( n, [this]( signal const& f ) {
-      create_topo_rec( this->get_node( f ) );
-    } );
-
-    /* mark node n permanently */
-    this->set_visited( n, this->trav_id() );
-
-    /* visit node */
-    topo_order.push_back( n );
+    /* iterative, since the recursion depth would be the depth of the network */
+    dfs.run(
+        n, [this]( node const& m, auto&& push ) {
+          this->foreach_fanin( m, [&]( signal const& f ) {
+            push( this->get_node( f ) );
+          } );
+        },
+        [this]( node const& m ) {
+          /* is permanently marked? */
+          if ( this->visited( m ) == this->trav_id() )
+            return false;
+
+          /* ensure that the node is not temporarily marked */
+          assert( this->visited( m ) != this->trav_id() - 1 );
+
+          /* mark node temporarily */
+          this->set_visited( m, this->trav_id() - 1 );
+          return true;
+        },
+        [this]( node const& m ) {
+          /* mark node permanently */
+          this->set_visited( m, this->trav_id() );
+
+          /* visit node */
+          topo_order.push_back( m );
+        } );
   }
 
 private:
   std::vector<node> topo_order;
   std::optional<signal> start_signal;
+  iterative_dfs<node> dfs;
 };
 
 template<typename Ntk>
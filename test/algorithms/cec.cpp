@@ -0,0 +1,151 @@
+#include <catch.hpp>
+
+#include <vector>
+
+#include <mockturtle/algorithms/cec.hpp>
+#include <mockturtle/algorithms/miter.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
+
+using namespace mockturtle;
+
+template<class Ntk>
+Ntk create_adder( uint32_t bitwidth, bool lookahead, bool bug = false )
+{
+  Ntk ntk;
+  std::vector<typename Ntk::signal> a( bitwidth ), b( bitwidth );
+  std::generate( a.begin(), a.end(), [&]() { return ntk.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return ntk.create_pi(); } );
+  auto carry = ntk.get_constant( false );
+
+  auto const all_ones = ntk.create_nary_and( a );
+  if ( lookahead )
+  {
+    carry_lookahead_adder_inplace( ntk, a, b, carry );
+  }
+  else
+  {
+    carry_ripple_adder_inplace( ntk, a, b, carry );
+  }
+
+  for ( auto i = 0u; i < a.size(); ++i )
+  {
+    /* the bug only shows when all bits of the first operand are set */
+    ntk.create_po( bug && i == bitwidth / 2 ? ntk.create_xor( a[i], all_ones ) : a[i] );
+  }
+  ntk.create_po( carry );
+  return ntk;
+}
+
+TEST_CASE( "SAT sweeping CEC on two XAGs", "[cec]" )
+{
+  xag_network xag1, xag2;
+
+  const auto a = xag1.create_pi();
+  const auto b = xag1.create_pi();
+
+  const auto f1 = xag1.create_nand( a, b );
+  const auto f2 = xag1.create_nand( a, f1 );
+  const auto f3 = xag1.create_nand( b, f1 );
+  const auto f4 = xag1.create_nand( f2, f3 );
+
+  xag1.create_po( f4 );
+
+  const auto a_ = xag2.create_pi();
+  const auto b_ = xag2.create_pi();
+
+  const auto f1_ = xag2.create_xor( a_, b_ );
+
+  xag2.create_po( f1_ );
+
+  const auto result = cec( *miter<xag_network>( xag1, xag2 ) );
+
+  CHECK( result );
+  CHECK( *result );
+}
+
+TEST_CASE( "SAT sweeping CEC on two non-equivalent AIGs", "[cec]" )
+{
+  aig_network aig1, aig2;
+
+  const auto a = aig1.create_pi();
+  const auto b = aig1.create_pi();
+
+  const auto f1 = aig1.create_nand( a, b );
+  const auto f2 = aig1.create_nand( a, f1 );
+  const auto f3 = aig1.create_nand( b, f1 );
+  const auto f4 = aig1.create_nand( f2, f3 );
+
+  aig1.create_po( f4 );
+
+  const auto a_ = aig2.create_pi();
+  const auto b_ = aig2.create_pi();
+
+  const auto f1_ = aig2.create_or( a_, b_ );
+
+  aig2.create_po( f1_ );
+
+  cec_stats st;
+  const auto result = cec( *miter<aig_network>( aig1, aig2 ), {}, &st );
+
+  CHECK( result );
+  CHECK( !*result );
+  CHECK( st.counter_example == std::vector<bool>( { true, true } ) );
+}
+
+TEST_CASE( "SAT sweeping CEC on adders", "[cec]" )
+{
+  const auto ripple = create_adder<aig_network>( 32u, false );
+  const auto lookahead = create_adder<aig_network>( 32u, true );
+
+  cec_params ps;
+  ps.num_patterns = 256u;
+  ps.num_simulation_threads = 2u;
+  cec_stats st;
+  const auto result = cec( *miter<xag_network>( ripple, lookahead ), ps, &st );
+
+  CHECK( result );
+  CHECK( *result );
+  CHECK( st.num_classes > 0u );
+  CHECK( st.num_equ_proved > 0u );
+  CHECK( st.counter_example.empty() );
+
+  /* networks of different types */
+  const auto mig_ripple = create_adder<mig_network>( 32u, false );
+  const auto result_mig = cec( *miter<xag_network>( mig_ripple, lookahead ) );
+  CHECK( result_mig );
+  CHECK( *result_mig );
+}
+
+TEST_CASE( "SAT sweeping CEC finds rare counter-examples", "[cec]" )
+{
+  const auto ripple = create_adder<aig_network>( 32u, false );
+  const auto buggy = create_adder<aig_network>( 32u, true, true );
+
+  cec_stats st;
+  const auto result = cec( *miter<aig_network>( ripple, buggy ), {}, &st );
+
+  CHECK( result );
+  CHECK( !*result );
+  REQUIRE( st.counter_example.size() == 64u );
+
+  /* the counter-example distinguishes the two networks */
+  default_simulator<bool> sim( st.counter_example );
+  CHECK( simulate<bool>( ripple, sim ) != simulate<bool>( buggy, sim ) );
+}
+
+TEST_CASE( "SAT sweeping CEC with resource limits", "[cec]" )
+{
+  const auto ripple = create_adder<aig_network>( 32u, false );
+  const auto lookahead = create_adder<aig_network>( 32u, true );
+
+  cec_params ps;
+  ps.max_rounds = 0u;
+  ps.output_conflict_limit = 1u;
+  const auto result = cec( *miter<aig_network>( ripple, lookahead ), ps );
+
+  CHECK( !result );
+}
@@ -0,0 +1,234 @@
+#include <catch.hpp>
+
+#include <random>
+#include <vector>
+
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/operations.hpp>
+#include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/algorithms/compaction.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/sequential.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/networks/xmg.hpp>
+#include <mockturtle/utils/node_map.hpp>
+
+using namespace mockturtle;
+
+namespace
+{
+
+template<class Ntk>
+std::vector<kitty::dynamic_truth_table> simulate_outputs( Ntk const& ntk )
+{
+  return simulate<kitty::dynamic_truth_table>( ntk, default_simulator<kitty::dynamic_truth_table>( ntk.num_pis() ) );
+}
+
+/* random network with dead and dangling nodes, a PI created after some
+   gates, and a gate with a fanin of larger index */
+template<class Ntk>
+Ntk build_fragmented_network( uint32_t seed )
+{
+  std::mt19937 rng( seed );
+  Ntk ntk;
+  std::vector<signal<Ntk>> fs;
+  for ( auto i = 0u; i < 6u; ++i )
+  {
+    fs.push_back( ntk.create_pi() );
+  }
+
+  auto const random_signal = [&]() { return fs[rng() % fs.size()] ^ ( rng() % 2 == 0 ); };
+  auto const add_gate = [&]() {
+    auto const a = random_signal();
+    auto const b = random_signal();
+    fs.push_back( rng() % 3 == 0 ? ntk.create_xor( a, b ) : ntk.create_and( a, b ) );
+  };
+
+  /* x is later replaced by a gate that is created after its fanout p */
+  auto const x = ntk.create_and( ntk.create_pi(), !ntk.create_pi() );
+  auto const p = ntk.create_and( x, ntk.create_pi() );
+  ntk.create_po( p );
+
+  for ( auto i = 0u; i < 60u; ++i )
+  {
+    add_gate();
+  }
+  fs.push_back( ntk.create_pi() );
+  for ( auto i = 0u; i < 60u; ++i )
+  {
+    add_gate();
+  }
+  ntk.substitute_node( ntk.get_node( x ), ntk.create_xor( fs.back(), fs[0] ) );
+
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    ntk.create_po( fs[fs.size() - 1u - 2u * i] );
+  }
+
+  /* substitutions by signals of smaller index kill the MFFCs of the substituted gates */
+  for ( auto i = 0u; i < 10u; ++i )
+  {
+    auto const n = ntk.get_node( fs[fs.size() - 1u - ( rng() % 100u )] );
+    if ( ntk.is_dead( n ) || ntk.is_ci( n ) )
+    {
+      continue;
+    }
+    auto const s = fs[rng() % 6u];
+    if ( ntk.get_node( s ) < n )
+    {
+      ntk.substitute_node( n, s ^ ( rng() % 2 == 0 ) );
+    }
+  }
+
+  return ntk;
+}
+
+template<class Ntk>
+void check_compacted( Ntk const& ntk )
+{
+  std::vector<uint32_t> fanout_sizes( ntk.size(), 0u );
+  ntk.foreach_node( [&]( auto const& n ) {
+    CHECK( !ntk.is_dead( n ) );
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      CHECK( ntk.get_node( f ) < n );
+      ++fanout_sizes[ntk.get_node( f )];
+    } );
+  } );
+  ntk.foreach_co( [&]( auto const& f ) {
+    ++fanout_sizes[ntk.get_node( f )];
+  } );
+  ntk.foreach_node( [&]( auto const& n ) {
+    CHECK( ntk.fanout_size( n ) == fanout_sizes[n] );
+  } );
+  CHECK( ntk.num_gates() == ntk.size() - ntk.num_cis() - 1u );
+}
+
+template<class Ntk>
+void test_compact_network()
+{
+  for ( auto seed = 1u; seed <= 5u; ++seed )
+  {
+    auto ntk = build_fragmented_network<Ntk>( seed );
+    auto const cleaned = cleanup_dangling( ntk );
+    auto const expected = simulate_outputs( cleaned );
+
+    std::vector<node<Ntk>> outputs;
+    ntk.foreach_po( [&]( auto const& f ) {
+      outputs.push_back( ntk.get_node( f ) );
+    } );
+    node_map<uint64_t, Ntk> old_index( ntk );
+    ntk.foreach_node( [&]( auto const& n ) {
+      old_index[n] = n;
+    } );
+
+    compact_network_stats st;
+    auto const old_to_new = compact_network( ntk, {}, &st );
+
+    CHECK( st.num_dead > 0u );
+    CHECK( st.num_reordered > 0u );
+    CHECK( simulate_outputs( ntk ) == expected );
+    CHECK( ntk.size() == cleaned.size() );
+    check_compacted( ntk );
+
+    ntk.foreach_po( [&]( auto const& f, auto i ) {
+      CHECK( old_to_new[outputs[i]] == ntk.get_node( f ) );
+    } );
+
+    old_index.remap( old_to_new );
+    ntk.foreach_node( [&]( auto const& n ) {
+      CHECK( old_to_new[old_index[n]] == n );
+    } );
+
+    /* the structural hash table finds all gates */
+    auto const& storage = *ntk._storage;
+    ntk.foreach_gate( [&]( auto const& n ) {
+      auto const it = storage.hash.find( storage.nodes[n] );
+      REQUIRE( it != storage.hash.end() );
+      CHECK( it->second == n );
+    } );
+    if constexpr ( std::is_same_v<Ntk, aig_network> )
+    {
+      auto const size = ntk.size();
+      ntk.foreach_gate( [&]( auto const& n ) {
+        CHECK( ntk.create_and( ntk._storage->nodes[n].children[0], ntk._storage->nodes[n].children[1] ) == ntk.make_signal( n ) );
+      } );
+      CHECK( ntk.size() == size );
+    }
+  }
+}
+
+} // namespace
+
+TEST_CASE( "compact AIG in place", "[compaction]" )
+{
+  test_compact_network<aig_network>();
+}
+
+TEST_CASE( "compact XAG in place", "[compaction]" )
+{
+  test_compact_network<xag_network>();
+}
+
+TEST_CASE( "compact MIG in place", "[compaction]" )
+{
+  test_compact_network<mig_network>();
+}
+
+TEST_CASE( "compact XMG in place", "[compaction]" )
+{
+  test_compact_network<xmg_network>();
+}
+
+TEST_CASE( "compact network and keep dangling nodes", "[compaction]" )
+{
+  aig_network aig;
+  auto const a = aig.create_pi();
+  auto const b = aig.create_pi();
+  auto const f1 = aig.create_and( a, b );
+  auto const f2 = aig.create_and( !a, b ); /* dangling */
+  auto const f3 = aig.create_and( f1, !b );
+  aig.create_po( f3 );
+  aig.substitute_node( aig.get_node( f3 ), f1 ); /* f3 becomes dead */
+
+  compact_network_params ps;
+  ps.remove_dangling = false;
+  compact_network_stats st;
+  auto const old_to_new = compact_network( aig, ps, &st );
+
+  CHECK( st.num_dead == 1u );
+  CHECK( st.num_dangling == 0u );
+  CHECK( aig.size() == 5u );
+  CHECK( aig.num_gates() == 2u );
+  CHECK( old_to_new[aig.get_node( f3 )] == compact_removed_node );
+  CHECK( old_to_new[aig.get_node( f2 )] == 4u );
+  CHECK( aig.fanout_size( 4u ) == 0u );
+
+  compact_network( aig, {}, &st );
+  CHECK( st.num_dangling == 1u );
+  CHECK( aig.size() == 4u );
+  CHECK( aig.num_gates() == 1u );
+  CHECK( aig.fanout_size( aig.pi_at( 1 ) ) == 1u );
+}
+
+TEST_CASE( "compact sequential AIG in place", "[compaction]" )
+{
+  sequential<aig_network> aig;
+  auto const a = aig.create_pi();
+  auto const dangling = aig.create_and( a, a ^ true );
+  (void)dangling;
+  auto const r = aig.create_ro();
+  auto const f = aig.create_xor( a, r );
+  aig.create_po( f );
+  aig.create_ri( !f );
+
+  auto const num_gates = aig.num_gates();
+  compact_network( aig );
+
+  CHECK( aig.num_gates() == num_gates );
+  CHECK( aig.num_registers() == 1u );
+  CHECK( aig.is_ro( aig.ro_at( 0 ) ) );
+  CHECK( aig.ro_at( 0 ) == 2u );
+  check_compacted( aig );
+}
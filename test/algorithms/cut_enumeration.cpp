@@ -2,15 +2,43 @@
 
 #include <iostream>
 
+#include <kitty/bit_operations.hpp>
 #include <kitty/constructors.hpp>
 #include <kitty/dynamic_truth_table.hpp>
 #include <mockturtle/algorithms/cut_enumeration.hpp>
+#include <mockturtle/algorithms/cut_enumeration/mf_cut.hpp>
+#include <mockturtle/algorithms/cut_enumeration/spectr_cut.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/networks/klut.hpp>
+#include <mockturtle/networks/mig.hpp>
 #include <mockturtle/networks/sequential.hpp>
 
 using namespace mockturtle;
 
+struct ones_cut
+{
+  uint32_t ones{ 0u };
+};
+
+namespace mockturtle
+{
+
+/* written against `network_cuts`, as before the parallel enumeration */
+template<>
+struct cut_enumeration_update_cut<ones_cut>
+{
+  template<typename Cut>
+  static void apply( Cut& cut, network_cuts<aig_network, true, ones_cut> const& cuts, aig_network const& ntk, aig_network::node const& n )
+  {
+    (void)ntk;
+    (void)n;
+    cut->data.ones = static_cast<uint32_t>( kitty::count_ones( cuts.truth_table( cut ) ) );
+  }
+};
+
+} // namespace mockturtle
+
 TEST_CASE( "enumerate cuts for an AIG", "[cut_enumeration]" )
 {
   aig_network aig;
@@ -181,6 +209,100 @@ TEST_CASE( "compute XOR network cuts in 2-LUT network", "[cut_enumeration]" )
   }
 }
 
+template<class Ntk, class NetworkCuts>
+void check_identical_cuts( Ntk const& ntk, NetworkCuts const& cuts1, NetworkCuts const& cuts2 )
+{
+  CHECK( cuts1.total_tuples() == cuts2.total_tuples() );
+  CHECK( cuts1.total_cuts() == cuts2.total_cuts() );
+
+  ntk.foreach_node( [&]( auto const& n ) {
+    auto const& set1 = cuts1.cuts( ntk.node_to_index( n ) );
+    auto const& set2 = cuts2.cuts( ntk.node_to_index( n ) );
+    REQUIRE( set1.size() == set2.size() );
+    for ( auto i = 0u; i < set1.size(); ++i )
+    {
+      CHECK( std::vector<uint32_t>( set1[i].begin(), set1[i].end() ) == std::vector<uint32_t>( set2[i].begin(), set2[i].end() ) );
+      if constexpr ( NetworkCuts::compute_truth )
+      {
+        CHECK( set1[i]->func_id == set2[i]->func_id );
+        CHECK( cuts1.truth_table( set1[i] ) == cuts2.truth_table( set2[i] ) );
+      }
+    }
+  } );
+}
+
+TEST_CASE( "enumerate cuts in parallel", "[cut_enumeration]" )
+{
+  aig_network aig;
+  mig_network mig;
+  {
+    std::vector<aig_network::signal> a( 16u ), b( 16u );
+    std::generate( a.begin(), a.end(), [&]() { return aig.create_pi(); } );
+    std::generate( b.begin(), b.end(), [&]() { return aig.create_pi(); } );
+    for ( auto const& f : carry_ripple_multiplier( aig, a, b ) )
+    {
+      aig.create_po( f );
+    }
+  }
+  {
+    std::vector<mig_network::signal> a( 16u ), b( 16u );
+    std::generate( a.begin(), a.end(), [&]() { return mig.create_pi(); } );
+    std::generate( b.begin(), b.end(), [&]() { return mig.create_pi(); } );
+    for ( auto const& f : carry_ripple_multiplier( mig, a, b ) )
+    {
+      mig.create_po( f );
+    }
+  }
+
+  cut_enumeration_params ps, ps_parallel;
+  ps.cut_size = ps_parallel.cut_size = 5u;
+  ps.cut_limit = ps_parallel.cut_limit = 10u;
+  ps_parallel.num_threads = 2u;
+
+  check_identical_cuts( aig, cut_enumeration( aig, ps ), cut_enumeration( aig, ps_parallel ) );
+  check_identical_cuts( aig, cut_enumeration<aig_network, true>( aig, ps ), cut_enumeration<aig_network, true>( aig, ps_parallel ) );
+  check_identical_cuts( mig, cut_enumeration<mig_network, true>( mig, ps ), cut_enumeration<mig_network, true>( mig, ps_parallel ) );
+  check_identical_cuts( aig, fast_cut_enumeration<aig_network, 6, true>( aig, ps ), fast_cut_enumeration<aig_network, 6, true>( aig, ps_parallel ) );
+
+  /* cut data computed from the truth tables of the cuts */
+  auto const spectr_cuts = cut_enumeration<aig_network, true, cut_enumeration_spectr_cut>( aig, ps );
+  auto const spectr_cuts_parallel = cut_enumeration<aig_network, true, cut_enumeration_spectr_cut>( aig, ps_parallel );
+  check_identical_cuts( aig, spectr_cuts, spectr_cuts_parallel );
+  aig.foreach_gate( [&]( auto const& n ) {
+    auto const& set1 = spectr_cuts.cuts( aig.node_to_index( n ) );
+    auto const& set2 = spectr_cuts_parallel.cuts( aig.node_to_index( n ) );
+    for ( auto i = 0u; i < set1.size(); ++i )
+    {
+      CHECK( set1[i]->data.cost == set2[i]->data.cost );
+      CHECK( set1[i]->data.delay == set2[i]->data.delay );
+      CHECK( set1[i]->data.flow == set2[i]->data.flow );
+    }
+  } );
+
+  /* cut data of an update function that takes `network_cuts` */
+  auto const ones_cuts = cut_enumeration<aig_network, true, ones_cut>( aig, ps );
+  auto const ones_cuts_parallel = cut_enumeration<aig_network, true, ones_cut>( aig, ps_parallel );
+  check_identical_cuts( aig, ones_cuts, ones_cuts_parallel );
+  aig.foreach_gate( [&]( auto const& n ) {
+    auto const& set1 = ones_cuts.cuts( aig.node_to_index( n ) );
+    auto const& set2 = ones_cuts_parallel.cuts( aig.node_to_index( n ) );
+    for ( auto i = 0u; i < set1.size(); ++i )
+    {
+      CHECK( set1[i]->data.ones == set2[i]->data.ones );
+    }
+
+    /* the unit cut at the end is not updated */
+    for ( auto i = 0u; i + 1u < set2.size(); ++i )
+    {
+      CHECK( set2[i]->data.ones == kitty::count_ones( ones_cuts_parallel.truth_table( set2[i] ) ) );
+    }
+  } );
+
+  ps.minimize_truth_table = ps_parallel.minimize_truth_table = true;
+  ps_parallel.num_threads = 4u;
+  check_identical_cuts( mig, cut_enumeration<mig_network, true, cut_enumeration_mf_cut>( mig, ps ), cut_enumeration<mig_network, true, cut_enumeration_mf_cut>( mig, ps_parallel ) );
+}
+
 TEST_CASE( "enumerate cuts for an AIG (small graph version)", "[fast_small_cut_enumeration]" )
 {
   aig_network aig;
@@ -0,0 +1,88 @@
+#include <catch.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include <kitty/static_truth_table.hpp>
+#include <mockturtle/algorithms/aig_balancing.hpp>
+#include <mockturtle/algorithms/aig_resub.hpp>
+#include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/algorithms/explorer.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
+#include <mockturtle/networks/aig.hpp>
+
+using namespace mockturtle;
+
+static aig_network lookahead_adder()
+{
+  aig_network aig;
+  std::vector<aig_network::signal> a( 4u ), b( 4u );
+  std::generate( a.begin(), a.end(), [&]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return aig.create_pi(); } );
+
+  auto carry = aig.get_constant( false );
+  carry_lookahead_adder_inplace( aig, a, b, carry );
+  std::for_each( a.begin(), a.end(), [&]( auto const& f ) { aig.create_po( f ); } );
+  aig.create_po( carry );
+  return aig;
+}
+
+static aig_network explore_aig( aig_network const& aig, explorer_params const& ps )
+{
+  explorer_stats st;
+  explorer<aig_network> expl( ps, st );
+
+  expl.add_decompressing_script( []( aig_network& ntk, uint32_t, uint32_t rand ) {
+    aig_balancing_params bps;
+    bps.minimize_levels = rand & 0x1;
+    aig_balance( ntk, bps );
+  } );
+  expl.add_compressing_script( []( aig_network& ntk, uint32_t, uint32_t rand ) {
+    resubstitution_params rps;
+    rps.max_inserts = rand % 3;
+    aig_resubstitution( ntk, rps );
+    ntk = cleanup_dangling( ntk );
+  } );
+
+  return expl.run( aig );
+}
+
+TEST_CASE( "deterministic explorer with concurrent restarts", "[explorer]" )
+{
+  auto const aig = lookahead_adder();
+  auto const tts = simulate<kitty::static_truth_table<8u>>( aig );
+
+  explorer_params ps;
+  ps.num_restarts = 4u;
+  ps.max_steps = 6u;
+  ps.num_threads = 2u;
+  ps.migration_interval = 2u;
+  ps.deterministic = true;
+  ps.random_seed = 7u;
+
+  auto const opt1 = explore_aig( aig, ps );
+  auto const opt2 = explore_aig( aig, ps );
+
+  CHECK( opt1.num_gates() < aig.num_gates() );
+  CHECK( opt1.num_gates() == opt2.num_gates() );
+  CHECK( tts == simulate<kitty::static_truth_table<8u>>( opt1 ) );
+  CHECK( tts == simulate<kitty::static_truth_table<8u>>( opt2 ) );
+}
+
+TEST_CASE( "portfolio explorer sharing the best network", "[explorer]" )
+{
+  auto const aig = lookahead_adder();
+  auto const tts = simulate<kitty::static_truth_table<8u>>( aig );
+
+  explorer_params ps;
+  ps.num_restarts = 4u;
+  ps.max_steps = 6u;
+  ps.num_threads = 2u;
+  ps.migration_interval = 2u;
+
+  auto const opt = explore_aig( aig, ps );
+
+  CHECK( opt.num_gates() < aig.num_gates() );
+  CHECK( tts == simulate<kitty::static_truth_table<8u>>( opt ) );
+}
@@ -1,10 +1,14 @@
 #include <catch.hpp>
 
+#include <algorithm>
+#include <vector>
+
 #include <kitty/static_truth_table.hpp>
 
 #include <mockturtle/algorithms/cleanup.hpp>
 #include <mockturtle/algorithms/functional_reduction.hpp>
 #include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/networks/mig.hpp>
 #include <mockturtle/networks/xag.hpp>
@@ -129,3 +133,42 @@ TEST_CASE( "functional reduction on XMG", "[functional_reduction]" )
   CHECK( ntk.size() == 9 );
   CHECK( vals == simulate<kitty::static_truth_table<4>>( ntk ) );
 }
+
+TEST_CASE( "functional reduction with concurrent validation", "[functional_reduction]" )
+{
+  aig_network ntk;
+
+  /* two different adders over the same operands */
+  std::vector<aig_network::signal> a( 6u ), b( 6u );
+  std::generate( a.begin(), a.end(), [&]() { return ntk.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return ntk.create_pi(); } );
+
+  auto sum1 = a;
+  auto carry1 = ntk.get_constant( false );
+  carry_ripple_adder_inplace( ntk, sum1, b, carry1 );
+
+  auto sum2 = a;
+  auto carry2 = ntk.get_constant( false );
+  carry_lookahead_adder_inplace( ntk, sum2, b, carry2 );
+
+  for ( auto i = 0u; i < a.size(); ++i )
+  {
+    ntk.create_po( sum1[i] );
+    ntk.create_po( sum2[i] );
+  }
+  ntk.create_po( carry1 );
+  ntk.create_po( carry2 );
+
+  auto const vals = simulate<kitty::static_truth_table<12>>( ntk );
+  auto const size_before = ntk.num_gates();
+
+  functional_reduction_params ps;
+  ps.num_validation_threads = 4u;
+  functional_reduction_stats st;
+  functional_reduction( ntk, ps, &st );
+  ntk = cleanup_dangling( ntk );
+
+  CHECK( st.num_equ_accepts > 0u );
+  CHECK( ntk.num_gates() < size_before );
+  CHECK( vals == simulate<kitty::static_truth_table<12>>( ntk ) );
+}
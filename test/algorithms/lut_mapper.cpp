@@ -4,6 +4,7 @@
 #include <mockturtle/algorithms/equivalence_checking.hpp>
 #include <mockturtle/algorithms/lut_mapper.hpp>
 #include <mockturtle/algorithms/miter.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
 #include <mockturtle/generators/arithmetic.hpp>
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/networks/klut.hpp>
@@ -334,3 +335,66 @@ TEST_CASE( "LUT map remapping LUT network", "[lut_mapper]" )
   CHECK( mapped_ntk.num_cells() == 1 );
   CHECK( *equivalence_checking( miter_ntk ) == true );
 }
+
+TEST_CASE( "Multi-threaded LUT map", "[lut_mapper]" )
+{
+  aig_network aig;
+
+  /* the 1024 partial products share a level, so the levels are large enough to be mapped in parallel */
+  std::vector<aig_network::signal> a( 32 ), b( 32 );
+  std::generate( a.begin(), a.end(), [&aig]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&aig]() { return aig.create_pi(); } );
+  auto const product = carry_ripple_multiplier( aig, a, b );
+
+  std::for_each( product.begin(), product.end(), [&]( auto f ) { aig.create_po( f ); } );
+
+  lut_map_params ps;
+  ps.cut_enumeration_ps.cut_size = 6u;
+  ps.cut_enumeration_ps.cut_limit = 8u;
+  ps.cut_expansion = true;
+
+  const auto check_same_mapping = []( klut_network const& klut, klut_network const& expected ) {
+    REQUIRE( klut.size() == expected.size() );
+    CHECK( klut.num_gates() == expected.num_gates() );
+    klut.foreach_gate( [&]( auto const& n ) {
+      std::vector<klut_network::node> fanins, expected_fanins;
+      klut.foreach_fanin( n, [&]( auto const& f ) { fanins.push_back( klut.get_node( f ) ); } );
+      expected.foreach_fanin( n, [&]( auto const& f ) { expected_fanins.push_back( expected.get_node( f ) ); } );
+      CHECK( fanins == expected_fanins );
+      CHECK( klut.node_function( n ) == expected.node_function( n ) );
+    } );
+    klut.foreach_po( [&]( auto const& f, auto i ) {
+      CHECK( f == expected.po_at( i ) );
+    } );
+  };
+
+  partial_simulator sim( aig.num_pis(), 256u );
+  auto const expected_values = simulate<kitty::partial_truth_table>( aig, sim );
+
+  /* the delay rounds are the same as the sequential ones */
+  ps.recompute_cuts = false;
+  ps.area_flow_rounds = 0u;
+  ps.num_threads = 1u;
+  auto const serial = lut_map( aig, ps );
+  CHECK( simulate<kitty::partial_truth_table>( serial, sim ) == expected_values );
+
+  for ( auto num_threads : { 2u, 4u, 8u } )
+  {
+    ps.num_threads = num_threads;
+    check_same_mapping( lut_map( aig, ps ), serial );
+  }
+
+  /* area flow rounds do not update the references while visiting the gates,
+     but the mapping does not depend on the number of threads */
+  ps.recompute_cuts = true;
+  ps.area_flow_rounds = 1u;
+  ps.num_threads = 2u;
+  auto const parallel = lut_map( aig, ps );
+  CHECK( simulate<kitty::partial_truth_table>( parallel, sim ) == expected_values );
+
+  for ( auto num_threads : { 4u, 8u } )
+  {
+    ps.num_threads = num_threads;
+    check_same_mapping( lut_map( aig, ps ), parallel );
+  }
+}
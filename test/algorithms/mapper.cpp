@@ -466,6 +466,50 @@ TEST_CASE( "Exact map should avoid cycles", "[mapper]" )
   CHECK( st.delay == 3.0f );
 }
 
+TEST_CASE( "Exact map with serialized library", "[mapper]" )
+{
+  using resyn_fn = xag_npn_resynthesis<aig_network>;
+
+  resyn_fn resyn;
+
+  exact_library_params eps;
+  eps.np_classification = true;
+  eps.compute_dc_classes = true;
+  exact_library<aig_network> lib( resyn, eps );
+
+  std::stringstream ss;
+  CHECK( lib.serialize( ss ) );
+
+  exact_library<aig_network> lib_loaded( eps );
+  CHECK( lib_loaded.deserialize( ss ) );
+  CHECK( lib_loaded.get_database().size() == lib.get_database().size() );
+
+  /* libraries with different parameters are rejected */
+  exact_library<aig_network> lib_rejected;
+  ss.clear();
+  ss.seekg( 0 );
+  CHECK( !lib_rejected.deserialize( ss ) );
+
+  aig_network aig;
+  std::vector<aig_network::signal> a( 4 ), b( 4 );
+  std::generate( a.begin(), a.end(), [&aig]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&aig]() { return aig.create_pi(); } );
+  auto carry = aig.create_pi();
+  carry_ripple_adder_inplace( aig, a, b, carry );
+  std::for_each( a.begin(), a.end(), [&]( auto f ) { aig.create_po( f ); } );
+  aig.create_po( carry );
+
+  map_params ps;
+  ps.use_dont_cares = true;
+  map_stats st1, st2;
+  aig_network res1 = map( aig, lib, ps, &st1 );
+  aig_network res2 = map( aig, lib_loaded, ps, &st2 );
+
+  CHECK( res1.num_gates() == res2.num_gates() );
+  CHECK( st1.area == st2.area );
+  CHECK( st1.delay == st2.delay );
+}
+
 TEST_CASE( "Exact map with logic sharing", "[mapper]" )
 {
   using resyn_fn = xag_npn_resynthesis<aig_network>;
@@ -1,10 +1,13 @@
 #include <catch.hpp>
 
 #include <algorithm>
+#include <memory>
+#include <random>
 
 #include <mockturtle/algorithms/node_resynthesis.hpp>
 #include <mockturtle/algorithms/node_resynthesis/akers.hpp>
 #include <mockturtle/algorithms/node_resynthesis/direct.hpp>
+#include <mockturtle/algorithms/node_resynthesis/exact.hpp>
 #include <mockturtle/algorithms/node_resynthesis/mig_npn.hpp>
 #include <mockturtle/algorithms/node_resynthesis/xmg_npn.hpp>
 #include <mockturtle/algorithms/simulation.hpp>
@@ -13,9 +16,11 @@
 #include <mockturtle/networks/mig.hpp>
 #include <mockturtle/networks/xag.hpp>
 #include <mockturtle/networks/xmg.hpp>
+#include <mockturtle/utils/exact_synthesis_cache.hpp>
 
 #include <kitty/constructors.hpp>
 #include <kitty/dynamic_truth_table.hpp>
+#include <kitty/operations.hpp>
 
 using namespace mockturtle;
 
@@ -360,3 +365,108 @@ TEST_CASE( "Node resynthesis with direct synthesis", "[node_resynthesis]" )
     CHECK( simulate<kitty::dynamic_truth_table>( xmg, { 3u } )[0] == tt );
   }
 }
+
+TEST_CASE( "Node resynthesis with parallel exact synthesis", "[node_resynthesis]" )
+{
+  /* random network of 3-LUTs whose functions depend on all their fanins */
+  std::mt19937 rng( 5u );
+  klut_network klut;
+  std::vector<klut_network::signal> signals( 6u );
+  std::generate( signals.begin(), signals.end(), [&]() { return klut.create_pi(); } );
+  for ( auto i = 0u; i < 30u; ++i )
+  {
+    auto const num_vars = 3u;
+    std::vector<klut_network::signal> fanins;
+    while ( fanins.size() < num_vars )
+    {
+      auto const s = signals[rng() % signals.size()];
+      if ( std::find( fanins.begin(), fanins.end(), s ) == fanins.end() )
+      {
+        fanins.push_back( s );
+      }
+    }
+
+    kitty::dynamic_truth_table function( num_vars );
+    do
+    {
+      kitty::create_random( function, rng() );
+    } while ( kitty::min_base_inplace( function ).size() != num_vars );
+    signals.push_back( klut.create_node( fanins, function ) );
+  }
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    klut.create_po( signals[signals.size() - 1u - i] );
+  }
+  auto const tts = simulate<kitty::dynamic_truth_table>( klut, { 6u } );
+
+  {
+    /* serial and parallel synthesis find the same chains */
+    exact_resynthesis_params eps;
+    eps.shared_cache = std::make_shared<exact_synthesis_cache>();
+    exact_resynthesis<klut_network> serial_resyn( 2u, eps );
+    auto const serial = node_resynthesis<klut_network>( klut, serial_resyn );
+
+    node_resynthesis_params ps;
+    ps.num_threads = 4u;
+    node_resynthesis_stats st;
+    exact_resynthesis<klut_network> parallel_resyn( 2u );
+    auto const parallel = node_resynthesis<klut_network>( klut, parallel_resyn, ps, &st );
+
+    CHECK( st.num_precomputed_functions > 0u );
+    CHECK( simulate<kitty::dynamic_truth_table>( parallel, { 6u } ) == tts );
+    CHECK( parallel.num_gates() == serial.num_gates() );
+  }
+
+  {
+    exact_resynthesis_params eps;
+    eps.shared_cache = std::make_shared<exact_synthesis_cache>();
+    exact_aig_resynthesis<aig_network> serial_resyn( false, eps );
+    auto const serial = node_resynthesis<aig_network>( klut, serial_resyn );
+
+    /* the rebuild takes all chains from the cache */
+    auto const cache = std::make_shared<exact_synthesis_cache>();
+    eps.shared_cache = cache;
+    node_resynthesis_params ps;
+    ps.num_threads = 4u;
+    exact_aig_resynthesis<aig_network> parallel_resyn( false, eps );
+    auto const parallel = node_resynthesis<aig_network>( klut, parallel_resyn, ps );
+
+    CHECK( cache->num_misses() == cache->size() );
+    CHECK( simulate<kitty::dynamic_truth_table>( parallel, { 6u } ) == tts );
+    CHECK( parallel.num_gates() == serial.num_gates() );
+  }
+  {
+    /* the parameters of the resynthesis function are not changed, and its cache is filled */
+    exact_resynthesis_params eps;
+    eps.cache = std::make_shared<exact_resynthesis_params::cache_map_t>();
+    eps.blacklist_cache = std::make_shared<exact_resynthesis_params::blacklist_cache_map_t>();
+    exact_resynthesis<klut_network> resyn( 2u, eps );
+
+    node_resynthesis_params ps;
+    ps.num_threads = 4u;
+    node_resynthesis_stats st;
+    auto const parallel = node_resynthesis<klut_network>( klut, resyn, ps, &st );
+    CHECK( st.num_precomputed_functions > 0u );
+    CHECK( simulate<kitty::dynamic_truth_table>( parallel, { 6u } ) == tts );
+    CHECK( !eps.cache->empty() );
+
+    /* the serial run takes all chains from the cache */
+    auto const num_chains = eps.cache->size();
+    auto const serial = node_resynthesis<klut_network>( klut, resyn );
+    CHECK( eps.cache->size() == num_chains );
+    CHECK( serial.num_gates() == parallel.num_gates() );
+  }
+
+  {
+    /* const resynthesis functions are precomputed as well */
+    exact_aig_resynthesis<aig_network> const resyn;
+    static_assert( has_precompute_functions_v<exact_aig_resynthesis<aig_network> const&> );
+
+    node_resynthesis_params ps;
+    ps.num_threads = 4u;
+    node_resynthesis_stats st;
+    auto const parallel = node_resynthesis<aig_network>( klut, resyn, ps, &st );
+    CHECK( st.num_precomputed_functions > 0u );
+    CHECK( simulate<kitty::dynamic_truth_table>( parallel, { 6u } ) == tts );
+  }
+}
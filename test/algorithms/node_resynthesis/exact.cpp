@@ -2,11 +2,14 @@
 
 #include <kitty/constructors.hpp>
 #include <kitty/dynamic_truth_table.hpp>
+#include <kitty/operations.hpp>
 
 #include <mockturtle/algorithms/node_resynthesis/exact.hpp>
 #include <mockturtle/algorithms/simulation.hpp>
 #include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
 #include <mockturtle/networks/xag.hpp>
+#include <mockturtle/utils/exact_synthesis_cache.hpp>
 
 using namespace mockturtle;
 
@@ -170,3 +173,54 @@ TEST_CASE( "Exact XMG for XOR3", "[exact]" )
   CHECK( xmg.num_gates() == 1u );
   CHECK( simulate<kitty::dynamic_truth_table>( xmg, sim )[0] == _xor );
 }
+
+template<class Ntk, class ResynFn>
+uint32_t synthesize_with( ResynFn const& resyn, kitty::dynamic_truth_table const& function )
+{
+  Ntk ntk;
+  std::vector<typename Ntk::signal> pis;
+  for ( auto i = 0u; i < function.num_vars(); ++i )
+  {
+    pis.push_back( ntk.create_pi() );
+  }
+  resyn( ntk, function, pis.begin(), pis.end(), [&]( auto const& f ) {
+    ntk.create_po( f );
+  } );
+  REQUIRE( ntk.num_pos() == 1u );
+
+  default_simulator<kitty::dynamic_truth_table> sim( function.num_vars() );
+  CHECK( simulate<kitty::dynamic_truth_table>( ntk, sim )[0] == function );
+  return ntk.num_gates();
+}
+
+TEST_CASE( "Exact AIG and LUT resynthesis with a shared cache", "[exact]" )
+{
+  exact_resynthesis_params ps;
+  ps.shared_cache = std::make_shared<exact_synthesis_cache>();
+
+  exact_aig_resynthesis<aig_network> aig_resyn;
+  exact_aig_resynthesis<aig_network> cached_aig_resyn( false, ps );
+  exact_aig_resynthesis<xag_network> cached_xag_resyn( true, ps );
+  exact_resynthesis<klut_network> lut_resyn( 2u );
+  exact_resynthesis<klut_network> cached_lut_resyn( 2u, ps );
+
+  /* all functions that depend on all three inputs */
+  uint32_t num_functions{ 0u };
+  kitty::dynamic_truth_table function( 3u );
+  do
+  {
+    if ( kitty::has_var( function, 0 ) && kitty::has_var( function, 1 ) && kitty::has_var( function, 2 ) )
+    {
+      CHECK( synthesize_with<aig_network>( cached_aig_resyn, function ) == synthesize_with<aig_network>( aig_resyn, function ) );
+      synthesize_with<xag_network>( cached_xag_resyn, function );
+      CHECK( synthesize_with<klut_network>( cached_lut_resyn, function ) == synthesize_with<klut_network>( lut_resyn, function ) );
+      ++num_functions;
+    }
+    kitty::next_inplace( function );
+  } while ( !kitty::is_const0( function ) );
+
+  /* one chain for each of the 10 NPN classes of 3-input functions with full support and each of the three kinds */
+  CHECK( ps.shared_cache->size() == 3u * 10u );
+  CHECK( ps.shared_cache->num_misses() == ps.shared_cache->size() );
+  CHECK( ps.shared_cache->num_hits() == 3u * num_functions - ps.shared_cache->num_misses() );
+}
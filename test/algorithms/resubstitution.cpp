@@ -1,11 +1,16 @@
 #include <catch.hpp>
 
+#include <algorithm>
+#include <vector>
+
 #include <mockturtle/algorithms/cleanup.hpp>
 #include <mockturtle/algorithms/resubstitution.hpp>
 #include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
 #include <mockturtle/io/write_verilog.hpp>
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
 #include <mockturtle/networks/xmg.hpp>
 #include <mockturtle/traits.hpp>
 #include <mockturtle/views/depth_view.hpp>
@@ -433,3 +438,39 @@ TEST_CASE( "Simulation-guided resubstitution", "[resubstitution]" )
   CHECK( aig.num_pos() == 1 );
   CHECK( aig.num_gates() == 1 );
 }
+
+TEST_CASE( "Simulation-guided resubstitution with concurrent validation", "[resubstitution]" )
+{
+  xag_network xag;
+
+  /* two different adders over the same operands */
+  std::vector<xag_network::signal> a( 6u ), b( 6u );
+  std::generate( a.begin(), a.end(), [&]() { return xag.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return xag.create_pi(); } );
+
+  auto sum1 = a;
+  auto carry1 = xag.get_constant( false );
+  carry_ripple_adder_inplace( xag, sum1, b, carry1 );
+
+  auto sum2 = a;
+  auto carry2 = xag.get_constant( false );
+  carry_lookahead_adder_inplace( xag, sum2, b, carry2 );
+
+  for ( auto i = 0u; i < a.size(); ++i )
+  {
+    xag.create_po( xag.create_xor( sum1[i], sum2[i] ) );
+  }
+  xag.create_po( xag.create_and( carry1, carry2 ) );
+
+  auto const tts = simulate<kitty::static_truth_table<12u>>( xag );
+  auto const size_before = xag.num_gates();
+
+  resubstitution_params ps;
+  ps.max_inserts = 1u;
+  ps.num_validation_threads = 4u;
+  sim_resubstitution( xag, ps );
+  xag = cleanup_dangling( xag );
+
+  CHECK( xag.num_gates() < size_before );
+  CHECK( tts == simulate<kitty::static_truth_table<12u>>( xag ) );
+}
@@ -4,6 +4,8 @@
 #include <mockturtle/algorithms/node_resynthesis/mig_npn.hpp>
 #include <mockturtle/algorithms/node_resynthesis/xag_npn.hpp>
 #include <mockturtle/algorithms/node_resynthesis/xmg3_npn.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/generators/random_network.hpp>
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/networks/xag.hpp>
 #include <mockturtle/networks/mig.hpp>
@@ -216,3 +218,37 @@ TEST_CASE( "Rewrite depth-preserving", "[rewrite]" )
   CHECK( aig.num_pos() == 2 );
   CHECK( aig.num_gates() == 8 );
 }
+
+TEST_CASE( "Rewrite with multiple threads", "[rewrite]" )
+{
+  random_network_generator_params_size gps;
+  gps.num_pis = 12u;
+  gps.num_gates = 300u;
+  auto gen = random_aig_generator( gps );
+  aig_network aig = gen.generate();
+
+  xag_npn_resynthesis<aig_network, aig_network, xag_npn_db_kind::aig_complete> resyn;
+  exact_library<aig_network> exact_lib( resyn );
+
+  default_simulator<kitty::dynamic_truth_table> sim( aig.num_pis() );
+  auto const tts = simulate<kitty::dynamic_truth_table>( aig, sim );
+
+  std::vector<aig_network> results;
+  for ( auto num_threads : { 1u, 2u, 4u } )
+  {
+    aig_network res = aig.clone();
+
+    rewrite_params ps;
+    ps.num_threads = num_threads;
+    rewrite_stats st;
+    rewrite( res, exact_lib, ps, &st );
+
+    CHECK( res.num_gates() < aig.num_gates() );
+    CHECK( ( st.rounds > 0u ) == ( num_threads > 1u ) );
+    CHECK( simulate<kitty::dynamic_truth_table>( res, sim ) == tts );
+    results.push_back( res );
+  }
+
+  /* the parallel engine does not depend on the number of threads */
+  CHECK( results[1].num_gates() == results[2].num_gates() );
+}
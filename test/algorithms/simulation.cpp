@@ -1,8 +1,13 @@
 #include <catch.hpp>
 
 #include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
 #include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/networks/mig.hpp>
 #include <mockturtle/networks/xag.hpp>
+#include <mockturtle/networks/xmg.hpp>
+#include <mockturtle/utils/thread_pool.hpp>
 
 #include <kitty/static_truth_table.hpp>
 
@@ -197,6 +202,51 @@ TEST_CASE( "Incremental simulation with partial_simulator", "[simulation]" )
   CHECK( ( aig.is_complemented( f5 ) ? ~node_to_value[f5] : node_to_value[f5] ) == kitty::partial_truth_table( 65 ) );
 }
 
+template<class Ntk>
+void test_simulation_on_thread_pool()
+{
+  Ntk ntk;
+  std::vector<typename Ntk::signal> a( 8u ), b( 8u );
+  std::generate( a.begin(), a.end(), [&]() { return ntk.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return ntk.create_pi(); } );
+  for ( auto const& f : carry_ripple_multiplier( ntk, a, b ) )
+  {
+    ntk.create_po( f );
+  }
+  if constexpr ( has_create_maj_v<Ntk> )
+  {
+    ntk.create_po( ntk.create_maj( a[0], !b[1], ntk.create_xor( a[2], !b[3] ) ) );
+  }
+
+  thread_pool pool1( 1u ), pool3( 3u );
+  for ( auto num_patterns : { 1u, 64u, 100u, 3000u } )
+  {
+    partial_simulator sim( ntk.num_pis(), num_patterns );
+
+    auto const expected = simulate_nodes<kitty::partial_truth_table>( ntk, sim );
+
+    unordered_node_map<kitty::partial_truth_table, Ntk> values1( ntk );
+    simulate_nodes<Ntk>( ntk, values1, sim, true, pool1 );
+
+    incomplete_node_map<kitty::partial_truth_table, Ntk> values3( ntk );
+    simulate_nodes<Ntk>( ntk, values3, sim, true, pool3 );
+
+    ntk.foreach_node( [&]( auto const& n ) {
+      CHECK( values1[n] == expected[n] );
+      CHECK( values3[n] == expected[n] );
+    } );
+  }
+}
+
+TEST_CASE( "Simulate with partial_simulator on a thread pool", "[simulation]" )
+{
+  test_simulation_on_thread_pool<aig_network>();
+  test_simulation_on_thread_pool<xag_network>();
+  test_simulation_on_thread_pool<mig_network>();
+  test_simulation_on_thread_pool<xmg_network>();
+  test_simulation_on_thread_pool<klut_network>();
+}
+
 TEST_CASE( "Bit packing", "[simulation]" )
 {
   std::vector<kitty::partial_truth_table> pats( 5 );
@@ -0,0 +1,217 @@
+#include <catch.hpp>
+
+#include <mockturtle/io/aiger_loader.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/io/write_aiger.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/sequential.hpp>
+#include <mockturtle/views/names_view.hpp>
+
+#include <lorina/aiger.hpp>
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace mockturtle;
+
+namespace
+{
+
+aig_network random_aig( uint32_t num_pis, uint32_t num_gates, uint32_t seed )
+{
+  std::mt19937 rng( seed );
+  aig_network aig;
+  std::vector<aig_network::signal> fs;
+  for ( auto i = 0u; i < num_pis; ++i )
+  {
+    fs.push_back( aig.create_pi() );
+  }
+  while ( aig.num_gates() < num_gates )
+  {
+    auto const a = fs[rng() % fs.size()] ^ ( rng() & 1 );
+    auto const b = fs[rng() % fs.size()] ^ ( rng() & 1 );
+    fs.push_back( aig.create_and( a, b ) );
+  }
+  for ( auto i = 0u; i < 16u; ++i )
+  {
+    aig.create_po( fs[fs.size() - 1u - i] ^ ( i & 1 ) );
+  }
+  return aig;
+}
+
+template<class Ntk>
+std::string to_aiger( Ntk const& ntk )
+{
+  std::ostringstream os;
+  write_aiger( ntk, os );
+  return os.str();
+}
+
+} // namespace
+
+TEST_CASE( "load binary AIGER file into an AIG", "[aiger_loader]" )
+{
+  auto const aig = random_aig( 64u, 2000u, 1u );
+  auto const file = to_aiger( aig );
+
+  aig_network expected;
+  std::istringstream in( file );
+  CHECK( lorina::read_aiger( in, aiger_reader( expected ) ) == lorina::return_code::success );
+
+  aig_network loaded;
+  load_aiger_stats st;
+  CHECK( load_aiger( file.data(), file.size(), loaded, {}, &st ) );
+  CHECK( st.num_ands == aig.num_gates() );
+  CHECK( !st.direct );
+  CHECK( loaded.num_pis() == expected.num_pis() );
+  CHECK( loaded.num_pos() == expected.num_pos() );
+  CHECK( loaded.num_gates() == expected.num_gates() );
+  CHECK( to_aiger( loaded ) == to_aiger( expected ) );
+}
+
+TEST_CASE( "load binary AIGER file without structural hashing", "[aiger_loader]" )
+{
+  auto const aig = random_aig( 16u, 500u, 2u );
+  auto const file = to_aiger( aig );
+
+  load_aiger_params ps;
+  ps.strash = false;
+
+  aig_network loaded;
+  load_aiger_stats st;
+  CHECK( load_aiger( file.data(), file.size(), loaded, ps, &st ) );
+  CHECK( st.direct );
+  CHECK( to_aiger( loaded ) == file );
+
+  /* the hash table is complete */
+  auto const size = loaded.size();
+  loaded.foreach_gate( [&]( auto const& n ) {
+    std::vector<aig_network::signal> fanins;
+    loaded.foreach_fanin( n, [&]( auto const& f ) {
+      fanins.push_back( f );
+    } );
+    CHECK( loaded.create_and( fanins[0], fanins[1] ) == loaded.make_signal( n ) );
+  } );
+  CHECK( loaded.size() == size );
+
+  /* fanout counts */
+  aig_network hashed;
+  CHECK( load_aiger( file.data(), file.size(), hashed ) );
+  loaded.foreach_node( [&]( auto const& n ) {
+    CHECK( loaded.fanout_size( n ) == hashed.fanout_size( n ) );
+  } );
+
+  /* not applied to files with trivial gates: a constant fanin, and an AND of a variable and its complement */
+  std::string const trivial{ "aig 4 2 0 1 2\n"
+                             "8\n"
+                             "\x05\x01"
+                             "\x05\x01" };
+  aig_network aig2;
+  CHECK( load_aiger( trivial.data(), trivial.size(), aig2, ps, &st ) );
+  CHECK( !st.direct );
+  CHECK( aig2.num_gates() == 0u );
+
+  /* nor to files with structurally equal gates */
+  std::string const duplicate{ "aig 4 2 0 1 2\n"
+                               "8\n"
+                               "\x02\x02"
+                               "\x04\x02" };
+  aig_network aig3;
+  CHECK( load_aiger( duplicate.data(), duplicate.size(), aig3, ps, &st ) );
+  CHECK( !st.direct );
+  CHECK( aig3.size() == 4u );
+  CHECK( aig3.num_gates() == 1u );
+  CHECK( aig3.fanout_size( 1 ) == 1u );
+  CHECK( aig3.fanout_size( 3 ) == 1u );
+}
+
+TEST_CASE( "load large binary AIGER file with several threads", "[aiger_loader]" )
+{
+  auto const aig = random_aig( 1000u, 100000u, 3u );
+  auto const file = to_aiger( aig );
+
+  aig_network sequential_load;
+  CHECK( load_aiger( file.data(), file.size(), sequential_load ) );
+
+  for ( auto num_threads : { 2u, 4u } )
+  {
+    load_aiger_params ps;
+    ps.num_threads = num_threads;
+
+    aig_network parallel_load;
+    CHECK( load_aiger( file.data(), file.size(), parallel_load, ps ) );
+    CHECK( to_aiger( parallel_load ) == to_aiger( sequential_load ) );
+  }
+  CHECK( to_aiger( sequential_load ) == file );
+}
+
+TEST_CASE( "load binary AIGER file with latches and names", "[aiger_loader]" )
+{
+  /* one input, one latch with unknown initial value, and one AND gate driving the latch and the output */
+  std::string const file{ "aig 3 1 1 1 1\n"
+                          "6 4\n"
+                          "6\n"
+                          "\x02\x02"
+                          "i0 x\n"
+                          "l0 s\n"
+                          "o0 y\n"
+                          "c\n"
+                          "comment\n" };
+
+  sequential<aig_network> aig;
+  names_view<sequential<aig_network>> named_aig{ aig };
+  CHECK( load_aiger( file.data(), file.size(), named_aig ) );
+
+  CHECK( aig.num_pis() == 1u );
+  CHECK( aig.num_registers() == 1u );
+  CHECK( aig.num_pos() == 1u );
+  CHECK( aig.num_gates() == 1u );
+  CHECK( aig.register_at( 0 ).init == static_cast<uint8_t>( -1 ) ); /* as in aiger_reader */
+  CHECK( named_aig.get_name( aig.make_signal( aig.pi_at( 0 ) ) ) == "x" );
+  CHECK( named_aig.get_name( aig.make_signal( aig.ro_at( 0 ) ) ) == "s" );
+  CHECK( named_aig.get_name( aig.ri_at( 0 ) ) == "s_next" );
+  CHECK( named_aig.get_output_name( 0 ) == "y" );
+
+  /* combinational networks cannot load latches */
+  aig_network comb;
+  CHECK( !load_aiger( file.data(), file.size(), comb ) );
+}
+
+TEST_CASE( "load binary AIGER file into an MIG", "[aiger_loader]" )
+{
+  auto const aig = random_aig( 32u, 300u, 4u );
+  auto const file = to_aiger( aig );
+
+  mig_network expected;
+  std::istringstream in( file );
+  CHECK( lorina::read_aiger( in, aiger_reader( expected ) ) == lorina::return_code::success );
+
+  load_aiger_params ps;
+  ps.strash = false;
+  mig_network loaded;
+  CHECK( load_aiger( file.data(), file.size(), loaded, ps ) );
+  CHECK( loaded.num_gates() == expected.num_gates() );
+  CHECK( loaded.num_pos() == expected.num_pos() );
+}
+
+TEST_CASE( "reject malformed binary AIGER files", "[aiger_loader]" )
+{
+  auto const check_invalid = []( std::string const& file ) {
+    aig_network aig;
+    return !load_aiger( file.data(), file.size(), aig );
+  };
+
+  CHECK( check_invalid( "aag 1 1 0 1 0\n2\n2\n" ) );   /* ASCII format */
+  CHECK( check_invalid( "aig 2 1 0 1 0\n2\n" ) );      /* M != I + L + A */
+  CHECK( check_invalid( "aig 2 1 0 1 1\n7\n" ) );      /* output literal out of range */
+  CHECK( check_invalid( "aig 2 1 0 1 1 1\n4\n" ) );    /* bad state properties */
+  CHECK( check_invalid( "aig 2 1 0 1 1\n4\n\x02" ) );  /* truncated AND section */
+  CHECK( check_invalid( std::string( "aig 2 1 0 1 1\n4\n\x05\x00", 18u ) ) ); /* fanin larger than the gate */
+  CHECK( check_invalid( std::string( "aig 2 1 0 1 1\n4\n\x00\x00", 18u ) ) ); /* fanin equal to the gate */
+
+  aig_network aig;
+  CHECK( !load_aiger( "/nonexistent/file.aig", aig ) );
+}
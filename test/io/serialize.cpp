@@ -1,6 +1,24 @@
 #include <catch.hpp>
 
+#include <cstring>
+#include <sstream>
+
+#if __GNUC__ == 7
+#include <experimental/filesystem>
+#else
+#include <filesystem>
+#endif
+
+#include <kitty/constructors.hpp>
+#include <lorina/genlib.hpp>
+#include <mockturtle/io/genlib_reader.hpp>
 #include <mockturtle/io/serialize.hpp>
+#include <mockturtle/networks/block.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/views/binding_view.hpp>
+#include <mockturtle/views/names_view.hpp>
 
 using namespace mockturtle;
 
@@ -18,11 +36,19 @@ TEST_CASE( "serialize aig_network into a file", "[serialize]" )
   const auto f5 = aig.create_nand( f4, f3 );
   aig.create_po( f5 );
 
+#if __GNUC__ == 7
+  namespace fs = std::experimental::filesystem::v1;
+#else
+  namespace fs = std::filesystem;
+#endif
+  auto const filename = ( fs::temp_directory_path() / "mockturtle-test-serialize-aig.dmp" ).string();
+
   /* serialize */
-  serialize_network( aig, "aig.dmp" );
+  serialize_network( aig, filename );
 
   /* deserialize */
-  aig_network aig2 = deserialize_network( "aig.dmp" );
+  aig_network aig2 = deserialize_network( filename );
+  fs::remove( filename );
 
   CHECK( aig.size() == aig2.size() );
   CHECK( aig.num_cis() == aig2.num_cis() );
@@ -46,3 +72,349 @@ TEST_CASE( "serialize aig_network into a file", "[serialize]" )
   CHECK( aig2._storage->nodes[f5.index].children[0u].index == f4.index );
   CHECK( aig2._storage->nodes[f5.index].children[1u].index == f3.index );
 }
+
+TEST_CASE( "serialize xag_network and mig_network into a stream", "[serialize]" )
+{
+  xag_network xag;
+  const auto a = xag.create_pi();
+  const auto b = xag.create_pi();
+  const auto c = xag.create_pi();
+  xag.create_po( xag.create_xor( xag.create_and( a, b ), !c ) );
+  xag.create_po( xag.create_or( a, c ) );
+
+  std::stringstream ss;
+  CHECK( serialize_network( xag, ss ) );
+
+  xag_network xag2;
+  CHECK( deserialize_network( ss, xag2 ) );
+  CHECK( xag._storage->nodes == xag2._storage->nodes );
+  CHECK( xag._storage->inputs == xag2._storage->inputs );
+  CHECK( xag._storage->outputs == xag2._storage->outputs );
+  CHECK( xag._storage->hash == xag2._storage->hash );
+
+  /* structural hashing works on the loaded network */
+  CHECK( xag2.create_and( a, b ) == xag.create_and( a, b ) );
+  CHECK( xag2.size() == xag.size() );
+
+  /* snapshots are rejected for a different network type */
+  ss.clear();
+  ss.seekg( 0 );
+  mig_network mig;
+  CHECK( !deserialize_network( ss, mig ) );
+
+  const auto x = mig.create_pi();
+  const auto y = mig.create_pi();
+  const auto z = mig.create_pi();
+  mig.create_po( mig.create_maj( x, !y, z ) );
+
+  std::stringstream ss_mig;
+  CHECK( serialize_network( mig, ss_mig ) );
+  mig_network mig2;
+  CHECK( deserialize_network( ss_mig, mig2 ) );
+  CHECK( mig._storage->nodes == mig2._storage->nodes );
+  CHECK( mig._storage->hash == mig2._storage->hash );
+}
+
+TEST_CASE( "serialize klut_network with its truth table cache", "[serialize]" )
+{
+  klut_network klut;
+  const auto a = klut.create_pi();
+  const auto b = klut.create_pi();
+  const auto c = klut.create_pi();
+
+  kitty::dynamic_truth_table tt( 3u );
+  kitty::create_from_hex_string( tt, "e8" );
+  const auto f1 = klut.create_node( { a, b, c }, tt );
+  const auto f2 = klut.create_xor( f1, c );
+  const auto f3 = klut.create_and( a, b );
+  klut.create_po( f2 );
+  klut.create_po( klut.create_not( f3 ) );
+
+  std::stringstream ss;
+  CHECK( serialize_network( klut, ss ) );
+
+  klut_network klut2;
+  CHECK( deserialize_network( ss, klut2 ) );
+  CHECK( klut2.size() == klut.size() );
+  CHECK( klut2.num_pis() == klut.num_pis() );
+  CHECK( klut2.num_pos() == klut.num_pos() );
+  CHECK( klut._storage->data.cache.size() == klut2._storage->data.cache.size() );
+  klut.foreach_node( [&]( auto const& n ) {
+    CHECK( klut.node_function( n ) == klut2.node_function( n ) );
+    CHECK( klut.fanin_size( n ) == klut2.fanin_size( n ) );
+  } );
+  klut.foreach_po( [&]( auto const& f, auto i ) {
+    CHECK( f == klut2.po_at( i ) );
+  } );
+
+  /* new nodes reuse the hash table of the loaded network */
+  CHECK( klut2.create_xor( f1, c ) == f2 );
+}
+
+TEST_CASE( "serialize block_network", "[serialize]" )
+{
+  block_network blk;
+  const auto a = blk.create_pi();
+  const auto b = blk.create_pi();
+  const auto c = blk.create_pi();
+  const auto ha = blk.create_ha( a, b );
+  const auto fa = blk.create_fa( blk.make_signal( blk.get_node( ha ), 1 ), c, a );
+  blk.create_po( blk.make_signal( blk.get_node( fa ), 0 ) );
+  blk.create_po( blk.make_signal( blk.get_node( fa ), 1 ) );
+
+  std::stringstream ss;
+  CHECK( serialize_network( blk, ss ) );
+
+  block_network blk2;
+  CHECK( deserialize_network( ss, blk2 ) );
+  CHECK( blk2.size() == blk.size() );
+  CHECK( blk2.num_gates() == blk.num_gates() );
+  blk.foreach_node( [&]( auto const& n ) {
+    CHECK( blk.num_outputs( n ) == blk2.num_outputs( n ) );
+    CHECK( blk.fanout_size( n ) == blk2.fanout_size( n ) );
+    for ( auto i = 0u; i < blk.num_outputs( n ); ++i )
+    {
+      CHECK( blk.node_function_pin( n, i ) == blk2.node_function_pin( n, i ) );
+    }
+  } );
+  blk.foreach_po( [&]( auto const& f, auto i ) {
+    CHECK( f == blk2.po_at( i ) );
+  } );
+}
+
+TEST_CASE( "serialize names_view and binding_view", "[serialize]" )
+{
+  names_view<xag_network> xag;
+  xag.set_network_name( "top" );
+  const auto a = xag.create_pi();
+  const auto b = xag.create_pi();
+  const auto f = xag.create_and( a, !b );
+  xag.set_name( a, "a" );
+  xag.set_name( b, "b" );
+  xag.set_name( !f, "nf" );
+  xag.create_po( !f );
+  xag.set_output_name( 0, "y" );
+
+  std::stringstream ss;
+  CHECK( serialize_network( xag, ss ) );
+
+  names_view<xag_network> xag2;
+  CHECK( deserialize_network( ss, xag2 ) );
+  CHECK( xag2.get_network_name() == "top" );
+  CHECK( xag2.get_name( a ) == "a" );
+  CHECK( xag2.get_name( b ) == "b" );
+  CHECK( xag2.get_name( !f ) == "nf" );
+  CHECK( !xag2.has_name( f ) );
+  CHECK( xag2.get_output_name( 0 ) == "y" );
+
+  /* names are skipped when the target has no names */
+  ss.clear();
+  ss.seekg( 0 );
+  xag_network xag3;
+  CHECK( deserialize_network( ss, xag3 ) );
+  CHECK( xag3.size() == xag.size() );
+
+  std::vector<gate> gates;
+  std::istringstream in( "GATE zero 0 O=CONST0;\n"
+                         "GATE one 0 O=CONST1;\n"
+                         "GATE inv1 1 O=!a; PIN * INV 1 999 1.0 1.0 1.0 1.0\n"
+                         "GATE and2 1 O=a*b; PIN * INV 1 999 1.0 1.0 1.0 1.0\n" );
+  CHECK( lorina::read_genlib( in, genlib_reader( gates ) ) == lorina::return_code::success );
+
+  binding_view<klut_network> klut( gates );
+  const auto x = klut.create_pi();
+  const auto y = klut.create_pi();
+  const auto g1 = klut.create_and( x, y );
+  const auto g2 = klut.create_not( g1 );
+  klut.create_po( g2 );
+  klut.add_binding( klut.get_node( g1 ), 3 );
+  klut.add_binding( klut.get_node( g2 ), 2 );
+
+  std::stringstream ss_bound;
+  CHECK( serialize_network( klut, ss_bound ) );
+
+  binding_view<klut_network> klut2( gates );
+  CHECK( deserialize_network( ss_bound, klut2 ) );
+  CHECK( klut2.has_binding( klut.get_node( g1 ) ) );
+  CHECK( klut2.get_binding_index( klut.get_node( g1 ) ) == 3 );
+  CHECK( klut2.get_binding_index( klut.get_node( g2 ) ) == 2 );
+  CHECK( !klut2.has_binding( klut.get_node( x ) ) );
+
+  /* bindings are rejected for a different library */
+  ss_bound.clear();
+  ss_bound.seekg( 0 );
+  std::vector<gate> other( gates.begin(), gates.begin() + 3 );
+  binding_view<klut_network> klut3( other );
+  CHECK( !deserialize_network( ss_bound, klut3 ) );
+}
+
+TEST_CASE( "reject truncated and corrupt snapshots", "[serialize]" )
+{
+  klut_network klut;
+  const auto a = klut.create_pi();
+  const auto b = klut.create_pi();
+  const auto c = klut.create_pi();
+  klut.create_po( klut.create_maj( a, b, c ) );
+  klut.create_po( klut.create_xor( a, klut.create_and( b, c ) ) );
+
+  std::stringstream ss;
+  CHECK( serialize_network( klut, ss ) );
+  std::string const data = ss.str();
+
+  const auto read = [&]( std::string const& bytes ) {
+    klut_network from_memory;
+    detail::snapshot_memory_archive ar{ bytes.data(), 0u, bytes.size() };
+    bool const memory_okay = detail::read_snapshot( from_memory, ar );
+
+    std::istringstream is( bytes );
+    klut_network from_stream;
+    bool const stream_okay = deserialize_network( is, from_stream );
+    CHECK( memory_okay == stream_okay );
+    return memory_okay;
+  };
+
+  CHECK( read( data ) );
+  for ( auto size = 0u; size < data.size(); ++size )
+  {
+    CHECK( !read( data.substr( 0u, size ) ) );
+  }
+
+  /* number of nodes in the header */
+  auto corrupt = data;
+  uint64_t const num_nodes = uint64_t( 1 ) << 60u;
+  std::memcpy( corrupt.data() + 24u, &num_nodes, sizeof( num_nodes ) );
+  CHECK( !read( corrupt ) );
+
+  /* number of fanins of a node, stored after the header and the size of the array */
+  corrupt = data;
+  uint32_t const fanin_size = 0xffffffffu;
+  std::memcpy( corrupt.data() + 64u + 5u * sizeof( uint32_t ), &fanin_size, sizeof( fanin_size ) );
+  CHECK( !read( corrupt ) );
+
+  /* size of the array of fanin sizes */
+  corrupt = data;
+  std::memcpy( corrupt.data() + 56u, &num_nodes, sizeof( num_nodes ) );
+  CHECK( !read( corrupt ) );
+}
+
+TEST_CASE( "reject unversioned AIG dumps of earlier releases", "[serialize]" )
+{
+  /* the earlier layout started with the number of nodes and had no header */
+  std::string data;
+  const auto append = [&]( uint64_t value ) {
+    data.append( reinterpret_cast<char const*>( &value ), sizeof( value ) );
+  };
+  append( 1u ); /* number of nodes */
+  append( 2u ); /* size of the fanins of the constant */
+  append( 0u );
+  append( 0u );
+  append( 1u ); /* size of the node data */
+  append( 0u );
+  append( 0u ); /* number of inputs */
+  append( 0u ); /* number of outputs */
+
+  aig_network aig;
+  aig.create_po( aig.create_pi() );
+
+  std::istringstream is( data );
+  CHECK( !deserialize_network( is, aig ) );
+  CHECK( aig.num_pis() == 1u );
+  CHECK( aig.num_pos() == 1u );
+}
+
+TEST_CASE( "keep the network when a snapshot is invalid", "[serialize]" )
+{
+  names_view<xag_network> xag;
+  const auto a = xag.create_pi();
+  const auto b = xag.create_pi();
+  xag.create_po( xag.create_and( a, b ) );
+  xag.set_name( a, "a" );
+  xag.set_output_name( 0, "y" );
+
+  std::stringstream ss;
+  CHECK( serialize_network( xag, ss ) );
+  std::string const data = ss.str();
+
+  names_view<xag_network> target;
+  const auto x = target.create_pi();
+  target.create_po( !x );
+  target.set_name( x, "x" );
+  target.set_network_name( "old" );
+
+  /* a snapshot that fails in the names section leaves the network unchanged */
+  std::istringstream truncated( data.substr( 0u, data.size() - 8u ) );
+  CHECK( !deserialize_network( truncated, target ) );
+  CHECK( target.size() == 2u );
+  CHECK( target.num_pis() == 1u );
+  CHECK( target.get_name( x ) == "x" );
+  CHECK( target.get_network_name() == "old" );
+
+  /* a valid snapshot replaces all old names */
+  std::istringstream valid( data );
+  CHECK( deserialize_network( valid, target ) );
+  CHECK( target.size() == xag.size() );
+  CHECK( target.get_name( a ) == "a" );
+  CHECK( !target.has_name( b ) );
+  CHECK( target.get_output_name( 0 ) == "y" );
+  CHECK( target.get_network_name() == "" );
+}
+
+TEST_CASE( "validate the structural hash table of a snapshot", "[serialize]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+  const auto f1 = aig.create_and( a, b );
+  const auto f2 = aig.create_and( f1, c );
+  aig.create_po( aig.create_or( f2, a ) );
+
+  std::stringstream ss;
+  CHECK( serialize_network( aig, ss ) );
+  std::string const data = ss.str();
+
+  /* the hash section holds its kind, its size, the number of slots, and the slots */
+  aig_network tmp;
+  uint64_t offset;
+  detail::snapshot_memory_archive ar{ data.data(), 0u, data.size() };
+  CHECK( detail::read_snapshot( tmp, ar, &offset ) );
+  uint64_t num_slots;
+  std::memcpy( &num_slots, data.data() + offset + 16u, sizeof( num_slots ) );
+  CHECK( num_slots == aig._storage->hash.slots().size() );
+
+  const auto read = [&]( std::string const& bytes, aig_network& ntk ) {
+    std::istringstream is( bytes );
+    return deserialize_network( is, ntk );
+  };
+
+  /* a slot that refers to a node outside of the network */
+  auto corrupt = data;
+  for ( auto i = 0u; i < num_slots; ++i )
+  {
+    uint64_t slot;
+    std::memcpy( &slot, corrupt.data() + offset + 24u + 8u * i, sizeof( slot ) );
+    if ( slot != 0u )
+    {
+      slot |= 0xffffffu;
+      std::memcpy( corrupt.data() + offset + 24u + 8u * i, &slot, sizeof( slot ) );
+      break;
+    }
+  }
+  aig_network ntk;
+  CHECK( !read( corrupt, ntk ) );
+
+  /* a table without empty slots */
+  corrupt = data;
+  for ( auto i = 0u; i < num_slots; ++i )
+  {
+    uint64_t const slot = ( uint64_t( 1 ) << 40u ) | 4u;
+    std::memcpy( corrupt.data() + offset + 24u + 8u * i, &slot, sizeof( slot ) );
+  }
+  CHECK( !read( corrupt, ntk ) );
+
+  /* snapshots of other versions are rejected */
+  corrupt = data;
+  uint32_t const version = detail::snapshot_version + 1u;
+  std::memcpy( corrupt.data() + 8u, &version, sizeof( version ) );
+  CHECK( !read( corrupt, ntk ) );
+}
@@ -3,6 +3,15 @@
 #include <mockturtle/io/write_aiger.hpp>
 #include <mockturtle/networks/aig.hpp>
 
+#include <random>
+#include <sstream>
+
+#if __GNUC__ == 7
+#include <experimental/filesystem>
+#else
+#include <filesystem>
+#endif
+
 template<
     typename T,
     typename Traits = std::char_traits<T>,
@@ -78,7 +87,16 @@ TEST_CASE( "write AIG for XOR into AIGERfile", "[write_aiger]" )
   seq_buffer<char> buffer;
   std::ostream os( &buffer );
   write_aiger( aig, os );
-  write_aiger( aig, "test.aig" );
+
+#if __GNUC__ == 7
+  namespace fs = std::experimental::filesystem::v1;
+#else
+  namespace fs = std::filesystem;
+#endif
+  auto const filename = ( fs::temp_directory_path() / "mockturtle-test-write-aiger.aig" ).string();
+  write_aiger( aig, filename );
+  CHECK( fs::file_size( filename ) == 26u );
+  fs::remove( filename );
 
   CHECK( buffer.data() ==
          std::vector<char>{
@@ -96,3 +114,29 @@ TEST_CASE( "write AIG for XOR into AIGERfile", "[write_aiger]" )
              0x63 // comment
          } );
 }
+
+TEST_CASE( "write large AIG into AIGER file with several threads", "[write_aiger]" )
+{
+  std::mt19937 rng( 1u );
+  aig_network aig;
+  std::vector<aig_network::signal> fs;
+  for ( auto i = 0u; i < 100u; ++i )
+  {
+    fs.push_back( aig.create_pi() );
+  }
+  while ( aig.num_gates() < 100000u )
+  {
+    fs.push_back( aig.create_and( fs[rng() % fs.size()] ^ ( rng() & 1 ), fs[rng() % fs.size()] ^ ( rng() & 1 ) ) );
+  }
+  aig.create_po( fs.back() );
+
+  std::ostringstream sequential;
+  write_aiger( aig, sequential );
+
+  write_aiger_params ps;
+  ps.num_threads = 4u;
+  std::ostringstream parallel;
+  write_aiger( aig, parallel, ps );
+
+  CHECK( parallel.str() == sequential.str() );
+}
@@ -1,6 +1,7 @@
 #include <catch.hpp>
 
 #include <algorithm>
+#include <random>
 #include <sstream>
 #include <vector>
 
@@ -547,4 +548,76 @@ TEST_CASE( "write a sequential k-LUT with name view and rename ris", "[write_bli
   blif_read_after_write_test( klut, ps );
   ps.rename_ri_using_node = false;
   blif_read_after_write_test( klut, ps );
-}
\ No newline at end of file
+}
+
+TEST_CASE( "write a sequential k-LUT with register input driven by a PI and rename ris", "[write_blif]" )
+{
+  sequential<klut_network> klut;
+
+  const auto a = klut.create_pi();
+  const auto b = klut.create_pi();
+  const auto f1 = klut.create_ro(); // f1 <- a
+  const auto f2 = klut.create_and( b, f1 );
+
+  klut.create_po( f2 );
+  klut.create_ri( a ); // f1 <- a
+
+  std::ostringstream out;
+  write_blif_params ps;
+  ps.rename_ri_using_node = true;
+  write_blif( klut, out, ps );
+
+  /* the latch input is the name of the PI */
+  CHECK( out.str() == ".model top\n"
+                      ".inputs pi2 pi3 \n"
+                      ".outputs po0 \n"
+                      ".latch pi2 new_n4   3\n"
+                      ".names new_n0\n"
+                      "0\n"
+                      ".names new_n1\n"
+                      "1\n"
+                      ".names pi3 new_n4 new_n5\n"
+                      "11 1\n"
+                      ".names new_n5 po0\n"
+                      "1 1\n"
+                      ".end\n" );
+
+  blif_read_after_write_test( klut, ps );
+}
+
+TEST_CASE( "write a large k-LUT into BLIF file with several threads", "[write_blif]" )
+{
+  std::mt19937 rng( 1u );
+  names_view<klut_network> klut;
+  std::vector<klut_network::signal> fs;
+  for ( auto i = 0u; i < 20u; ++i )
+  {
+    fs.push_back( klut.create_pi( "x" + std::to_string( i ) ) );
+  }
+  while ( klut.num_gates() < 20000u )
+  {
+    auto const a = fs[rng() % fs.size()];
+    auto const b = fs[rng() % fs.size()];
+    auto const c = fs[rng() % fs.size()];
+    fs.push_back( rng() % 2 ? klut.create_maj( a, b, c ) : klut.create_xor( a, b ) );
+    if ( rng() % 10 == 0 )
+    {
+      klut.set_name( fs.back(), "y" + std::to_string( fs.size() ) );
+    }
+  }
+  for ( auto i = 0u; i < 10u; ++i )
+  {
+    klut.create_po( fs[fs.size() - 1u - i] );
+  }
+  klut.create_po( fs[0], "x5" );
+
+  std::ostringstream sequential;
+  write_blif( klut, sequential );
+
+  write_blif_params ps;
+  ps.num_threads = 4u;
+  std::ostringstream parallel;
+  write_blif( klut, parallel, ps );
+
+  CHECK( parallel.str() == sequential.str() );
+}
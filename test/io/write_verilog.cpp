@@ -535,3 +535,55 @@ TEST_CASE( "write buffered_crossed_klut into Verilog file", "[write_verilog]" )
                       "  assign y2 = n13 ;\n"
                       "endmodule\n" );
 }
+
+TEST_CASE( "buffered Verilog writer matches lorina's writer", "[write_verilog]" )
+{
+  const auto write = []( lorina::verilog_writer const& writer ) {
+    std::vector<std::string> const none;
+    std::vector<std::string> const one{ "a" };
+    std::vector<std::string> const names{ "a", "b", "c" };
+
+    writer.on_module_begin( "top", names, { "y", "z" } );
+    writer.on_module_begin( "top", names, none );
+    writer.on_module_begin( "top", none, one );
+    writer.on_module_begin( "top", none, none );
+    for ( auto const& xs : { none, one, names } )
+    {
+      writer.on_input( xs );
+      writer.on_input( 4u, xs );
+      writer.on_output( xs );
+      writer.on_output( 4u, xs );
+      writer.on_wire( xs );
+      writer.on_wire( 4u, xs );
+    }
+    writer.on_input( "x" );
+    writer.on_input( 8u, "x" );
+    writer.on_output( "y" );
+    writer.on_output( 8u, "y" );
+    writer.on_wire( "w" );
+    writer.on_wire( 8u, "w" );
+    writer.on_module_instantiation( "and2", {}, "g1", { { "A", "a" }, { "B", "b" }, { "Y", "w" } } );
+    writer.on_module_instantiation( "ram", { "8", "16" }, "m", { { "D", "d" } } );
+    writer.on_module_instantiation( "tie", { "1" }, "t", {} );
+    writer.on_assign( "n", { { false, "a" } }, "&" );
+    writer.on_assign( "n", { { true, "a" }, { false, "b" }, { true, "c" } }, "^" );
+    writer.on_assign( "n", {}, "|" );
+    writer.on_assign_maj3( "m", { { false, "a" }, { true, "b" }, { false, "c" } } );
+    writer.on_assign_mux21( "m", { { true, "a" }, { false, "b" }, { true, "c" } } );
+    writer.on_assign_unknown_gate( "u" );
+    writer.on_assign_po( "y", { false, "n" } );
+    writer.on_assign_po( "z", { true, "n" } );
+    writer.on_module_end();
+  };
+
+  std::ostringstream expected;
+  write( lorina::verilog_writer( expected ) );
+
+  std::ostringstream buffered;
+  {
+    output_buffer out( buffered );
+    write( detail::buffered_verilog_writer( out ) );
+  }
+
+  CHECK( buffered.str() == expected.str() );
+}
@@ -9,6 +9,8 @@
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/traits.hpp>
 
+#include "test_substitute.hpp"
+
 using namespace mockturtle;
 
 TEST_CASE( "create and use constants in an AIG", "[aig]" )
@@ -1081,3 +1083,78 @@ TEST_CASE( "substitute node without re-strashing case 3", "[aig]" )
   CHECK( aig.num_gates() == 2 );
   CHECK( simulate<kitty::static_truth_table<3u>>( aig )[0]._bits == 0x80 );
 }
+
+TEST_CASE( "substitute nodes with and without fanout index in AIGs", "[aig]" )
+{
+  auto const build = []() {
+    aig_network aig;
+    auto const x1 = aig.create_pi();
+    auto const x2 = aig.create_pi();
+    auto const x3 = aig.create_pi();
+    auto const n4 = aig.create_and( x1, x2 );
+    auto const n5 = aig.create_and( n4, x3 );
+    auto const n6 = aig.create_and( !n4, x3 );
+    auto const n7 = aig.create_and( n5, !n6 );
+    auto const n8 = aig.create_and( n5, x1 );
+    aig.create_po( n7 );
+    aig.create_po( n8 );
+    return aig;
+  };
+
+  test_substitute_with_and_without_fanout_index<aig_network>( build, []( aig_network& aig ) {
+    return aig.create_and( aig.make_signal( 1 ), aig.make_signal( 3 ) );
+  } );
+}
+
+TEST_CASE( "structural hashing table of AIGs", "[aig]" )
+{
+  aig_network aig;
+  std::vector<aig_network::signal> fs;
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    fs.push_back( aig.create_pi() );
+  }
+
+  /* enough gates to rehash the table several times */
+  for ( auto i = 0u; i < 50000u; ++i )
+  {
+    auto const a = fs[fs.size() - 1u - ( i * 7u ) % std::min<uint32_t>( fs.size(), 97u )];
+    auto const b = fs[fs.size() - 1u - ( i * 13u ) % std::min<uint32_t>( fs.size(), 89u )];
+    auto const f = aig.create_and( ( i & 1 ) ? a : !a, ( i & 2 ) ? b : !b );
+    if ( !aig.is_constant( aig.get_node( f ) ) && !aig.is_pi( aig.get_node( f ) ) )
+    {
+      fs.push_back( f );
+    }
+  }
+  CHECK( aig._storage->hash.size() == aig.num_gates() );
+
+  /* all gates are found again from their fanins */
+  bool found_all{ true };
+  aig.foreach_gate( [&]( auto const& n ) {
+    auto const& node = aig._storage->nodes[n];
+    found_all = found_all && aig.has_and( aig_network::signal{ node.children[0] }, aig_network::signal{ node.children[1] } ) == aig.make_signal( n );
+  } );
+  CHECK( found_all );
+
+  /* the clone has its own table that refers to its own nodes */
+  auto copy = aig.clone();
+  CHECK( copy._storage->hash == aig._storage->hash );
+  auto const g = copy.create_and( fs[0], fs[1] );
+  CHECK( copy.create_and( fs[1], fs[0] ) == g );
+  CHECK( copy._storage->hash.size() == aig._storage->hash.size() + ( copy.size() - aig.size() ) );
+
+  /* deleted entries are skipped by lookups and reused by insertions */
+  auto const n = aig.get_node( fs.back() );
+  auto const& nobj = aig._storage->nodes[n];
+  aig_network::signal const c0{ nobj.children[0] }, c1{ nobj.children[1] };
+  aig.take_out_node( n );
+  CHECK( aig.is_dead( n ) );
+  CHECK( !aig.has_and( c0, c1 ) );
+  CHECK( aig._storage->hash.size() == aig.num_gates() );
+
+  auto const size = aig.size();
+  auto const h = aig.create_and( c0, c1 );
+  CHECK( aig.get_node( h ) == size );
+  CHECK( aig.has_and( c0, c1 ) == h );
+  CHECK( aig._storage->hash.size() == aig.num_gates() );
+}
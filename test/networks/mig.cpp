@@ -9,6 +9,8 @@
 #include <mockturtle/networks/mig.hpp>
 #include <mockturtle/traits.hpp>
 
+#include "test_substitute.hpp"
+
 using namespace mockturtle;
 
 TEST_CASE( "create and use constants in an MIG", "[mig]" )
@@ -915,3 +917,26 @@ TEST_CASE( "substitute node without re-strashing case 3 in mig_network", "[mig]"
   CHECK( mig.num_gates() == 2 );
   CHECK( simulate<kitty::static_truth_table<3u>>( mig )[0]._bits == 0x80 );
 }
+
+TEST_CASE( "substitute nodes with and without fanout index in mig_network", "[mig]" )
+{
+  auto const build = []() {
+    mig_network mig;
+    auto const x1 = mig.create_pi();
+    auto const x2 = mig.create_pi();
+    auto const x3 = mig.create_pi();
+    auto const n4 = mig.create_and( x1, x2 );
+    auto const n5 = mig.create_maj( n4, x3, !x1 );
+    auto const n6 = mig.create_and( !n4, x3 );
+    auto const n7 = mig.create_maj( n5, !n6, x2 );
+    auto const n8 = mig.create_or( n5, x1 );
+    mig.create_po( n7 );
+    mig.create_po( n8 );
+    mig.create_po( n6 );
+    return mig;
+  };
+
+  test_substitute_with_and_without_fanout_index<mig_network>( build, []( mig_network& mig ) {
+    return mig.create_maj( mig.make_signal( 1 ), mig.make_signal( 2 ), !mig.make_signal( 3 ) );
+  } );
+}
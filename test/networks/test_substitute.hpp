@@ -0,0 +1,47 @@
+#pragma once
+
+#include <catch.hpp>
+
+#include <kitty/static_truth_table.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+
+namespace mockturtle
+{
+
+/* Substitutes the same nodes in two copies of a network, one of them without
+ * fanout index, and checks that both copies end up with the same structure.
+ * `build` returns a network with three PIs and gates 4 to 8, and `replacement`
+ * creates the new gate that replaces node 4 after the index has been built.
+ */
+template<class Ntk, class BuildFn, class ReplacementFn>
+void test_substitute_with_and_without_fanout_index( BuildFn&& build, ReplacementFn&& replacement )
+{
+  Ntk ntk1 = build();
+  Ntk ntk2 = build();
+  ntk2.use_fanout_index( false );
+
+  for ( auto* ntk : { &ntk1, &ntk2 } )
+  {
+    /* node created after the index has been built */
+    ntk->substitute_node( 4, replacement( *ntk ) );
+    ntk->substitute_node( 5, ntk->make_signal( 2 ) );
+    ntk->substitute_node_no_restrash( 8, ntk->make_signal( 3 ) );
+  }
+
+  CHECK( ntk1.size() == ntk2.size() );
+  CHECK( ntk1.num_gates() == ntk2.num_gates() );
+  ntk1.foreach_node( [&]( auto const& n ) {
+    CHECK( ntk1.is_dead( n ) == ntk2.is_dead( n ) );
+    if ( ntk1.is_ci( n ) || ntk1.is_constant( n ) )
+      return;
+    ntk1.foreach_fanin( n, [&]( auto const& f, auto i ) {
+      CHECK( f == typename Ntk::signal{ ntk2._storage->nodes[n].children[i] } );
+    } );
+  } );
+  ntk1.foreach_po( [&]( auto const& f, auto i ) {
+    CHECK( f == ntk2.po_at( i ) );
+  } );
+  CHECK( simulate<kitty::static_truth_table<3u>>( ntk1 ) == simulate<kitty::static_truth_table<3u>>( ntk2 ) );
+}
+
+} /* namespace mockturtle */
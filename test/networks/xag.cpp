@@ -14,6 +14,8 @@
 #include <mockturtle/networks/xag.hpp>
 #include <mockturtle/traits.hpp>
 
+#include "test_substitute.hpp"
+
 using namespace mockturtle;
 
 TEST_CASE( "create and use constants in an xag", "[xag]" )
@@ -915,3 +917,26 @@ TEST_CASE( "substitute node without re-strashing case 4 in xag_network", "[xag]"
   CHECK( xag.num_gates() == 1 );
   CHECK( simulate<kitty::static_truth_table<2u>>( xag )[0]._bits == 0x6 );
 }
+
+TEST_CASE( "substitute nodes with and without fanout index in xag_network", "[xag]" )
+{
+  auto const build = []() {
+    xag_network xag;
+    auto const x1 = xag.create_pi();
+    auto const x2 = xag.create_pi();
+    auto const x3 = xag.create_pi();
+    auto const n4 = xag.create_and( x1, x2 );
+    auto const n5 = xag.create_xor( n4, x3 );
+    auto const n6 = xag.create_and( !n4, x3 );
+    auto const n7 = xag.create_xor( n5, !n6 );
+    auto const n8 = xag.create_or( n5, x1 );
+    xag.create_po( n7 );
+    xag.create_po( n8 );
+    xag.create_po( n6 );
+    return xag;
+  };
+
+  test_substitute_with_and_without_fanout_index<xag_network>( build, []( xag_network& xag ) {
+    return xag.create_and( xag.make_signal( 1 ), xag.make_signal( 3 ) );
+  } );
+}
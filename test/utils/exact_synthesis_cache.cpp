@@ -0,0 +1,207 @@
+#include <catch.hpp>
+
+#include <mockturtle/utils/exact_synthesis_cache.hpp>
+#include <mockturtle/utils/thread_pool.hpp>
+
+#include <kitty/constructors.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/operations.hpp>
+
+#include <atomic>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#if __GNUC__ == 7
+#include <experimental/filesystem>
+#else
+#include <filesystem>
+#endif
+
+using namespace mockturtle;
+
+namespace
+{
+
+percy::synth_result synthesize_lut3( kitty::dynamic_truth_table const& function, percy::chain& c )
+{
+  percy::spec spec;
+  spec.fanin = 3;
+  spec.verbosity = 0;
+  spec[0] = function;
+  return percy::synthesize( spec, c );
+}
+
+std::vector<kitty::dynamic_truth_table> random_functions( uint32_t num_vars, uint32_t num_functions, uint32_t seed )
+{
+  std::vector<kitty::dynamic_truth_table> functions;
+  kitty::dynamic_truth_table function( num_vars );
+  for ( auto i = 0u; i < num_functions; ++i )
+  {
+    kitty::create_random( function, seed + i );
+    functions.push_back( function );
+  }
+  return functions;
+}
+
+} // namespace
+
+TEST_CASE( "reuse chains of NPN-equivalent functions", "[exact_synthesis_cache]" )
+{
+  exact_synthesis_cache cache;
+
+  kitty::dynamic_truth_table function( 4u );
+  kitty::create_from_hex_string( function, "6a3c" );
+  auto const c1 = cache.get_or_synthesize( 3u, function, 0, synthesize_lut3 );
+  REQUIRE( c1 );
+  CHECK( c1->simulate()[0] == function );
+  CHECK( cache.num_misses() == 1u );
+
+  /* all NPN transformations of the function are found in the cache */
+  std::mt19937 rng( 1u );
+  for ( auto i = 0u; i < 50u; ++i )
+  {
+    std::vector<uint8_t> perm{ 0u, 1u, 2u, 3u };
+    std::shuffle( perm.begin(), perm.end(), rng );
+    auto const phase = static_cast<uint32_t>( rng() % 32u );
+    auto const g = kitty::create_from_npn_config( std::make_tuple( function, phase, perm ) );
+
+    auto const c2 = cache.get_or_synthesize( 3u, g, 0, synthesize_lut3 );
+    REQUIRE( c2 );
+    CHECK( c2->simulate()[0] == g );
+    CHECK( c2->get_nr_steps() == c1->get_nr_steps() );
+  }
+  CHECK( cache.num_misses() == 1u );
+  CHECK( cache.num_hits() == 50u );
+  CHECK( cache.size() == 1u );
+
+  /* different kinds are kept apart */
+  CHECK( cache.get_or_synthesize( 4u, function, 0, synthesize_lut3 ) );
+  CHECK( cache.num_misses() == 2u );
+  CHECK( cache.size() == 2u );
+}
+
+TEST_CASE( "blacklist functions with their conflict limits", "[exact_synthesis_cache]" )
+{
+  exact_synthesis_cache cache;
+  kitty::dynamic_truth_table function( 3u );
+  kitty::create_majority( function );
+
+  uint32_t num_calls{ 0u };
+  auto const timeout = [&]( kitty::dynamic_truth_table const&, percy::chain& ) {
+    ++num_calls;
+    return percy::timeout;
+  };
+  auto const failure = [&]( kitty::dynamic_truth_table const&, percy::chain& ) {
+    ++num_calls;
+    return percy::failure;
+  };
+
+  CHECK( !cache.get_or_synthesize( 2u, function, 100, timeout ) );
+  CHECK( num_calls == 1u );
+  CHECK( cache.num_blacklisted() == 1u );
+
+  /* repeated only with a larger conflict limit or without limit */
+  CHECK( !cache.get_or_synthesize( 2u, function, 50, timeout ) );
+  CHECK( !cache.get_or_synthesize( 2u, function, 100, timeout ) );
+  CHECK( num_calls == 1u );
+  CHECK( !cache.get_or_synthesize( 2u, function, 200, timeout ) );
+  CHECK( num_calls == 2u );
+  CHECK( !cache.get_or_synthesize( 2u, function, 150, timeout ) );
+  CHECK( num_calls == 2u );
+
+  /* a failure without timeout is final */
+  CHECK( !cache.get_or_synthesize( 2u, function, 0, failure ) );
+  CHECK( num_calls == 3u );
+  CHECK( !cache.get_or_synthesize( 2u, function, 1000, timeout ) );
+  CHECK( num_calls == 3u );
+
+  /* a synthesized chain replaces the blacklist entry */
+  kitty::dynamic_truth_table other( 3u );
+  kitty::create_from_hex_string( other, "96" );
+  CHECK( !cache.get_or_synthesize( 3u, other, 10, timeout ) );
+  CHECK( cache.get_or_synthesize( 3u, other, 0, synthesize_lut3 ) );
+  CHECK( cache.num_blacklisted() == 1u );
+  CHECK( cache.size() == 1u );
+}
+
+TEST_CASE( "save and load exact synthesis cache", "[exact_synthesis_cache]" )
+{
+#if __GNUC__ == 7
+  namespace fs = std::experimental::filesystem::v1;
+#else
+  namespace fs = std::filesystem;
+#endif
+
+  auto const filename = ( fs::temp_directory_path() / "exact_synthesis_cache_test.bin" ).string();
+  auto const functions = random_functions( 4u, 20u, 42u );
+
+  kitty::dynamic_truth_table blacklisted( 3u );
+  kitty::create_majority( blacklisted );
+
+  {
+    exact_synthesis_cache cache;
+    for ( auto const& f : functions )
+    {
+      CHECK( cache.get_or_synthesize( 3u, f, 0, synthesize_lut3 ) );
+    }
+    CHECK( !cache.get_or_synthesize( 2u, blacklisted, 100, []( auto const&, auto& ) { return percy::timeout; } ) );
+    CHECK( cache.save( filename ) );
+  }
+
+  exact_synthesis_cache cache;
+  CHECK( cache.load( filename ) );
+  CHECK( cache.num_blacklisted() == 1u );
+  auto const size = cache.size();
+
+  auto const no_synthesis = []( auto const&, auto& ) {
+    FAIL( "synthesis called for a cached function" );
+    return percy::failure;
+  };
+  for ( auto const& f : functions )
+  {
+    auto const c = cache.get_or_synthesize( 3u, f, 0, no_synthesis );
+    REQUIRE( c );
+    CHECK( c->simulate()[0] == f );
+  }
+  CHECK( !cache.get_or_synthesize( 2u, blacklisted, 100, no_synthesis ) );
+
+  /* loading again merges the same entries */
+  CHECK( cache.load( filename ) );
+  CHECK( cache.size() == size );
+  CHECK( cache.num_blacklisted() == 1u );
+
+  /* invalid files are rejected without changing the cache */
+  {
+    std::ofstream os( filename, std::ofstream::binary );
+    os << "MTEXSYN";
+  }
+  CHECK( !cache.load( filename ) );
+  CHECK( !cache.load( ( fs::temp_directory_path() / "nonexistent_exact_synthesis_cache.bin" ).string() ) );
+  CHECK( cache.size() == size );
+
+  fs::remove( filename );
+}
+
+TEST_CASE( "share exact synthesis cache between threads", "[exact_synthesis_cache]" )
+{
+  auto const functions = random_functions( 4u, 40u, 7u );
+
+  exact_synthesis_cache cache;
+  std::atomic<uint32_t> num_failed{ 0u };
+
+  thread_pool pool( 4u );
+  pool.parallel_for( 0u, 4u * functions.size(), [&]( uint64_t i, uint32_t ) {
+    auto const& f = functions[i % functions.size()];
+    auto const c = cache.get_or_synthesize( 3u, f, 0, synthesize_lut3 );
+    if ( !c || c->simulate()[0] != f )
+    {
+      ++num_failed;
+    }
+  } );
+
+  CHECK( num_failed == 0u );
+  CHECK( cache.num_hits() + cache.num_misses() == 4u * functions.size() );
+  CHECK( cache.size() <= functions.size() );
+}
@@ -0,0 +1,118 @@
+#include <catch.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+#include <mockturtle/utils/output_buffer.hpp>
+#include <mockturtle/utils/thread_pool.hpp>
+
+#if defined( MOCKTURTLE_ZLIB )
+#include <zlib.h>
+#endif
+
+using namespace mockturtle;
+
+TEST_CASE( "write text and numbers into an output buffer", "[output_buffer]" )
+{
+  std::ostringstream os;
+  {
+    output_buffer out( os, 64u );
+    out << "model " << 42u << ' ' << int64_t( -7 ) << std::string( " end" ) << '\n';
+    CHECK( os.str().empty() );
+
+    /* larger than the buffer */
+    std::string const long_text( 100u, 'x' );
+    out << long_text;
+    for ( auto i = 0u; i < 100u; ++i )
+    {
+      out << i;
+      out.put( ',' );
+    }
+  }
+
+  std::string expected = "model 42 -7 end\n" + std::string( 100u, 'x' );
+  for ( auto i = 0u; i < 100u; ++i )
+  {
+    expected += std::to_string( i ) + ",";
+  }
+  CHECK( os.str() == expected );
+}
+
+TEST_CASE( "format chunks in parallel and write them in order", "[output_buffer]" )
+{
+  auto const format = []( uint64_t begin, uint64_t end, std::string& text ) {
+    for ( auto i = begin; i < end; ++i )
+    {
+      append_number( text, i );
+      text += '\n';
+    }
+  };
+
+  std::ostringstream sequential;
+  {
+    output_buffer out( sequential );
+    write_chunks( out, 10000u, 7u, format );
+  }
+
+  thread_pool pool( 4u );
+  std::ostringstream parallel;
+  {
+    output_buffer out( parallel );
+    write_chunks( out, 10000u, 7u, format, &pool );
+  }
+
+  CHECK( sequential.str().size() == 48890u );
+  CHECK( parallel.str() == sequential.str() );
+}
+
+TEST_CASE( "write into output files", "[output_buffer]" )
+{
+  std::string const filename = "output_buffer_test.txt";
+  {
+    output_file file( filename );
+    CHECK( file.is_open() );
+    output_buffer out( file.stream() );
+    out << "hello " << 1u << '\n';
+  }
+
+  std::ifstream in( filename );
+  std::string const content( ( std::istreambuf_iterator<char>( in ) ), std::istreambuf_iterator<char>() );
+  CHECK( content == "hello 1\n" );
+  std::remove( filename.c_str() );
+
+#if defined( MOCKTURTLE_ZLIB )
+  std::string const gz_filename = "output_buffer_test.txt.gz";
+  std::string expected;
+  {
+    output_file file( gz_filename );
+    output_buffer out( file.stream() );
+    for ( auto i = 0u; i < 100000u; ++i )
+    {
+      out << "line " << i << '\n';
+      expected += "line " + std::to_string( i ) + "\n";
+    }
+  }
+
+  gzFile gz = gzopen( gz_filename.c_str(), "rb" );
+  CHECK( gz != nullptr );
+  std::string decompressed( expected.size() + 1u, '\0' );
+  auto const size = gzread( gz, decompressed.data(), static_cast<unsigned>( decompressed.size() ) );
+  gzclose( gz );
+  decompressed.resize( size );
+  CHECK( decompressed == expected );
+  std::remove( gz_filename.c_str() );
+#else
+  /* compressed files are not written without zlib */
+  std::string const gz_filename = "output_buffer_test.txt.gz";
+  {
+    output_file file( gz_filename );
+    CHECK( !file.is_open() );
+    output_buffer out( file.stream() );
+    out << "hello\n";
+  }
+  CHECK( !std::ifstream( gz_filename ).good() );
+#endif
+}
@@ -0,0 +1,61 @@
+#include <catch.hpp>
+
+#include <string>
+#include <vector>
+
+#include <mockturtle/utils/string_pool.hpp>
+
+using namespace mockturtle;
+
+TEST_CASE( "intern strings", "[string_pool]" )
+{
+  string_pool pool;
+  CHECK( pool.size() == 0u );
+  CHECK( pool.find( "a" ) == string_pool::npos );
+
+  CHECK( pool.insert( "a" ) == 0u );
+  CHECK( pool.insert( "bc" ) == 1u );
+  CHECK( pool.insert( "" ) == 2u );
+  CHECK( pool.insert( "a" ) == 0u );
+  CHECK( pool.insert( std::string( "bc" ) ) == 1u );
+
+  CHECK( pool.size() == 3u );
+  CHECK( pool.num_chars() == 3u );
+  CHECK( pool[0] == "a" );
+  CHECK( pool[1] == "bc" );
+  CHECK( pool[2] == "" );
+  CHECK( pool.find( "bc" ) == 1u );
+  CHECK( pool.find( "b" ) == string_pool::npos );
+
+  pool.clear();
+  CHECK( pool.size() == 0u );
+  CHECK( pool.find( "a" ) == string_pool::npos );
+  CHECK( pool.insert( "bc" ) == 0u );
+}
+
+TEST_CASE( "intern many strings", "[string_pool]" )
+{
+  string_pool pool;
+  pool.reserve( 500u, 2000u );
+
+  std::vector<std::string> strings;
+  for ( auto i = 0u; i < 10000u; ++i )
+  {
+    strings.push_back( "n" + std::to_string( i ) );
+    CHECK( pool.insert( strings.back() ) == i );
+  }
+
+  CHECK( pool.size() == 10000u );
+  for ( auto i = 0u; i < strings.size(); ++i )
+  {
+    CHECK( pool[i] == strings[i] );
+    CHECK( pool.find( strings[i] ) == i );
+    CHECK( pool.insert( strings[i] ) == i );
+  }
+
+  /* copies are independent */
+  auto copy = pool;
+  CHECK( copy.insert( "x" ) == 10000u );
+  CHECK( pool.find( "x" ) == string_pool::npos );
+  CHECK( copy[42] == "n42" );
+}
@@ -3,6 +3,12 @@
 #include <cstdint>
 #include <vector>
 
+#if __GNUC__ == 7
+#include <experimental/filesystem>
+#else
+#include <filesystem>
+#endif
+
 #include <lorina/genlib.hpp>
 #include <lorina/super.hpp>
 #include <mockturtle/io/genlib_reader.hpp>
@@ -1114,4 +1120,145 @@ TEST_CASE( "Complete library generation", "[tech_library]" )
 
     kitty::exact_np_enumeration( tt, test_enumeration );
   }
-}
\ No newline at end of file
+}
+
+#if !__clang__ || __clang_major__ > 10
+TEST_CASE( "Library cache", "[tech_library]" )
+{
+#if __GNUC__ == 7
+  namespace fs = std::experimental::filesystem::v1;
+#else
+  namespace fs = std::filesystem;
+#endif
+
+  std::vector<gate> gates;
+
+  std::istringstream in( large_test_library + "\n"
+                                              "GATE   ha      6 O=a*b;    PIN * INV 1 999 1.2 0.4 1.2 0.4\n"
+                                              "GATE   ha      6 O=a^b;    PIN * INV 1 999 2.1 0.4 2.1 0.4" );
+  auto result = lorina::read_genlib( in, genlib_reader( gates ) );
+
+  CHECK( result == lorina::return_code::success );
+
+  auto const cache_directory = ( fs::temp_directory_path() / "mockturtle-test-library-cache" ).string();
+  fs::remove_all( cache_directory );
+  fs::create_directory( cache_directory );
+
+  tech_library_params tps;
+  tps.load_large_gates = true;
+  tps.cache_directory = cache_directory;
+
+  tech_library<7> lib( gates, tps );
+  tech_library<7> lib_cached( gates, tps );
+
+  CHECK( !lib.loaded_from_cache() );
+  CHECK( lib_cached.loaded_from_cache() );
+  CHECK( std::distance( fs::directory_iterator( cache_directory ), fs::directory_iterator{} ) == 1 );
+
+  CHECK( lib_cached.max_gate_size() == lib.max_gate_size() );
+  CHECK( lib_cached.get_inverter_info() == lib.get_inverter_info() );
+  CHECK( lib_cached.get_buffer_info() == lib.get_buffer_info() );
+  CHECK( lib_cached.num_multioutput_gates() == lib.num_multioutput_gates() );
+  CHECK( lib_cached.num_structural_gates() == lib.num_structural_gates() );
+
+  for ( auto const& hex : { "1", "5", "7", "8", "b", "d", "e" } )
+  {
+    kitty::static_truth_table<2> tt;
+    kitty::create_from_hex_string( tt, hex );
+    auto const gates1 = lib.get_supergates( kitty::extend_to<6>( tt ) );
+    auto const gates2 = lib_cached.get_supergates( kitty::extend_to<6>( tt ) );
+    CHECK( ( gates1 == nullptr ) == ( gates2 == nullptr ) );
+    if ( gates1 == nullptr || gates2 == nullptr )
+      continue;
+
+    CHECK( gates1->size() == gates2->size() );
+    for ( auto i = 0u; i < std::min( gates1->size(), gates2->size() ); ++i )
+    {
+      CHECK( ( *gates1 )[i].root->root->name == ( *gates2 )[i].root->root->name );
+      CHECK( ( *gates1 )[i].area == ( *gates2 )[i].area );
+      CHECK( ( *gates1 )[i].tdelay == ( *gates2 )[i].tdelay );
+      CHECK( ( *gates1 )[i].permutation == ( *gates2 )[i].permutation );
+      CHECK( ( *gates1 )[i].polarity == ( *gates2 )[i].polarity );
+    }
+  }
+
+  uint32_t const pattern1 = lib.get_pattern_id( 3, 3 );
+  CHECK( pattern1 != UINT32_MAX );
+  CHECK( lib_cached.get_pattern_id( 3, 3 ) == pattern1 );
+  CHECK( lib_cached.get_supergates_pattern( pattern1, true ) != nullptr );
+  CHECK( lib_cached.get_supergates_pattern( pattern1, true )->size() == lib.get_supergates_pattern( pattern1, true )->size() );
+
+  /* different parameters use a different cache entry */
+  tps.load_minimum_size_only = false;
+  tech_library<7> lib_other( gates, tps );
+  CHECK( !lib_other.loaded_from_cache() );
+  CHECK( std::distance( fs::directory_iterator( cache_directory ), fs::directory_iterator{} ) == 2 );
+
+  fs::remove_all( cache_directory );
+}
+
+TEST_CASE( "Supergate library cache", "[tech_library]" )
+{
+#if __GNUC__ == 7
+  namespace fs = std::experimental::filesystem::v1;
+#else
+  namespace fs = std::filesystem;
+#endif
+
+  std::vector<gate> gates;
+  super_lib super_data;
+
+  std::istringstream in_genlib( simple_library );
+  auto result = lorina::read_genlib( in_genlib, genlib_reader( gates ) );
+
+  CHECK( result == lorina::return_code::success );
+
+  std::istringstream in_super( super_library );
+  result = lorina::read_super( in_super, mockturtle::super_reader( super_data ) );
+
+  CHECK( result == lorina::return_code::success );
+
+  auto const cache_directory = ( fs::temp_directory_path() / "mockturtle-test-supergate-cache" ).string();
+  fs::remove_all( cache_directory );
+  fs::create_directory( cache_directory );
+
+  tech_library_params ps;
+  ps.load_minimum_size_only = false;
+  ps.cache_directory = cache_directory;
+
+  tech_library<3, classification_type::p_configurations> lib( gates, super_data, ps );
+  tech_library<3, classification_type::p_configurations> lib_cached( gates, super_data, ps );
+
+  CHECK( !lib.loaded_from_cache() );
+  CHECK( lib_cached.loaded_from_cache() );
+
+  /* the supergates referenced by the matching tables are restored with their fanins */
+  kitty::static_truth_table<3> tt;
+  kitty::create_from_hex_string( tt, "01" );
+  auto const gates1 = lib.get_supergates( kitty::extend_to<6>( tt ) );
+  auto const gates2 = lib_cached.get_supergates( kitty::extend_to<6>( tt ) );
+  CHECK( gates1 != nullptr );
+  CHECK( gates2 != nullptr );
+  CHECK( gates2->size() == 2 );
+
+  for ( auto i = 0u; i < gates2->size(); ++i )
+  {
+    auto const& g1 = *( *gates1 )[i].root;
+    auto const& g2 = *( *gates2 )[i].root;
+    CHECK( g2.is_super );
+    CHECK( g2.root->name == g1.root->name );
+    CHECK( g2.num_vars == g1.num_vars );
+    CHECK( g2.function == g1.function );
+    CHECK( g2.area == g1.area );
+    CHECK( g2.tdelay == g1.tdelay );
+    CHECK( g2.fanin.size() == g1.fanin.size() );
+    for ( auto j = 0u; j < std::min( g1.fanin.size(), g2.fanin.size() ); ++j )
+    {
+      CHECK( g2.fanin[j]->id == g1.fanin[j]->id );
+      CHECK( g2.fanin[j]->function == g1.fanin[j]->function );
+    }
+  }
+
+  fs::remove_all( cache_directory );
+}
+#endif
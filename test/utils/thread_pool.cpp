@@ -0,0 +1,64 @@
+#include <catch.hpp>
+
+#include <mockturtle/utils/thread_pool.hpp>
+
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+using namespace mockturtle;
+
+TEST_CASE( "run jobs on a thread pool", "[thread_pool]" )
+{
+  thread_pool pool( 4u );
+  CHECK( pool.num_threads() == 4u );
+
+  std::vector<uint32_t> visited( pool.num_threads(), 0u );
+  pool.run( [&]( uint32_t thread_id ) {
+    ++visited[thread_id];
+  } );
+  CHECK( visited == std::vector<uint32_t>( 4u, 1u ) );
+
+  /* jobs can be repeated */
+  for ( auto i = 0u; i < 100u; ++i )
+  {
+    std::vector<uint64_t> values( 1000u + i );
+    std::iota( values.begin(), values.end(), 0u );
+
+    std::vector<uint64_t> sums( pool.num_threads(), 0u );
+    pool.parallel_for( 0u, values.size(), [&]( uint64_t j, uint32_t thread_id ) {
+      sums[thread_id] += values[j];
+    }, 7u );
+    CHECK( std::accumulate( sums.begin(), sums.end(), uint64_t{ 0 } ) == values.size() * ( values.size() - 1u ) / 2u );
+  }
+}
+
+TEST_CASE( "propagate exceptions from a thread pool", "[thread_pool]" )
+{
+  thread_pool pool( 3u );
+
+  CHECK_THROWS_AS( pool.parallel_for( 0u, 100u, [&]( uint64_t i, uint32_t ) {
+    if ( i == 42u )
+    {
+      throw std::runtime_error( "error" );
+    }
+  } ),
+                   std::runtime_error );
+
+  /* the pool is still usable */
+  uint32_t count{ 0 };
+  pool.run( [&]( uint32_t thread_id ) {
+    if ( thread_id == 0u )
+    {
+      ++count;
+    }
+  } );
+  CHECK( count == 1u );
+
+  thread_pool single( 1u );
+  CHECK( single.num_threads() == 1u );
+  single.parallel_for( 0u, 10u, [&]( uint64_t, uint32_t thread_id ) {
+    CHECK( thread_id == 0u );
+  } );
+}
@@ -0,0 +1,156 @@
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <mockturtle/utils/trace.hpp>
+
+using namespace mockturtle;
+
+TEST_CASE( "trace counters and histograms", "[trace]" )
+{
+  auto& recorder = trace_recorder::instance();
+  recorder.clear();
+
+  auto& counter = recorder.counter( "test/counter" );
+  CHECK( &counter == &recorder.counter( "test/counter" ) );
+  counter.add( 3u );
+  counter.add( 4u );
+  CHECK( counter.value() == 7u );
+
+  auto& histogram = recorder.histogram( "test/histogram" );
+  CHECK( histogram.count() == 0u );
+  CHECK( histogram.min() == 0u );
+  for ( auto v : { 0u, 1u, 2u, 3u, 4u, 100u } )
+  {
+    histogram.add( v );
+  }
+  CHECK( histogram.count() == 6u );
+  CHECK( histogram.sum() == 110u );
+  CHECK( histogram.min() == 0u );
+  CHECK( histogram.max() == 100u );
+  CHECK( histogram.bucket( 0u ) == 1u );
+  CHECK( histogram.bucket( 1u ) == 1u );
+  CHECK( histogram.bucket( 2u ) == 2u );
+  CHECK( histogram.bucket( 3u ) == 1u );
+  CHECK( histogram.bucket( 7u ) == 1u );
+
+  recorder.clear();
+  CHECK( counter.value() == 0u );
+  CHECK( histogram.count() == 0u );
+}
+
+TEST_CASE( "trace scopes from several threads", "[trace]" )
+{
+  auto& recorder = trace_recorder::instance();
+  recorder.clear();
+
+  {
+    trace_scope scope( "test/outer" );
+    {
+      trace_scope inner( "test/inner" );
+    }
+  }
+
+  std::vector<std::thread> threads;
+  for ( auto i = 0u; i < 4u; ++i )
+  {
+    threads.emplace_back( []() {
+      trace_scope scope( "test/worker" );
+      trace_latency latency( trace_recorder::instance().histogram( "test/latency" ) );
+      for ( auto j = 0u; j < 1000u; ++j )
+      {
+        trace_recorder::instance().counter( "test/worker_counter" ).add( 1u );
+      }
+    } );
+  }
+  for ( auto& t : threads )
+  {
+    t.join();
+  }
+
+  CHECK( recorder.num_scopes( "test/outer" ) == 1u );
+  CHECK( recorder.num_scopes( "test/inner" ) == 1u );
+  CHECK( recorder.num_scopes( "test/worker" ) == 4u );
+  CHECK( recorder.histogram( "test/latency" ).count() == 4u );
+  CHECK( recorder.counter( "test/worker_counter" ).value() == 4000u );
+
+  recorder.clear();
+  CHECK( recorder.num_scopes( "test/outer" ) == 0u );
+}
+
+TEST_CASE( "reuse the trace buffers of exited threads", "[trace]" )
+{
+  auto& recorder = trace_recorder::instance();
+  recorder.clear();
+
+  /* the calling thread keeps its buffer */
+  recorder.counter( "test/reuse_counter" ).add( 1u );
+  auto const num_buffers = recorder.num_buffers();
+
+  for ( auto i = 0u; i < 20u; ++i )
+  {
+    std::thread( []() {
+      trace_scope scope( "test/short_worker" );
+      trace_recorder::instance().counter( "test/reuse_counter" ).add( 2u );
+    } ).join();
+  }
+
+  CHECK( recorder.num_buffers() <= num_buffers + 1u );
+  CHECK( recorder.num_scopes( "test/short_worker" ) == 20u );
+  CHECK( recorder.counter( "test/reuse_counter" ).value() == 41u );
+}
+
+TEST_CASE( "export traces as JSON", "[trace]" )
+{
+  auto& recorder = trace_recorder::instance();
+  recorder.clear();
+
+  {
+    trace_scope scope( "test/export" );
+  }
+  recorder.counter( "test/export_counter" ).add( 42u );
+  recorder.histogram( "test/export_histogram" ).add( 5u );
+
+  std::stringstream chrome;
+  recorder.write_chrome_trace( chrome );
+  auto const trace = chrome.str();
+  CHECK( trace.find( "\"traceEvents\"" ) != std::string::npos );
+  CHECK( trace.find( "{\"name\":\"test/export\",\"ph\":\"X\"" ) != std::string::npos );
+  CHECK( trace.find( "{\"name\":\"test/export_counter\",\"ph\":\"C\"" ) != std::string::npos );
+  CHECK( trace.find( "\"args\":{\"value\":42}" ) != std::string::npos );
+
+  std::stringstream flat;
+  recorder.write_json( flat );
+  auto const json = flat.str();
+  CHECK( json.find( "\"test/export\": {\"count\": 1" ) != std::string::npos );
+  CHECK( json.find( "\"test/export_counter\": 42" ) != std::string::npos );
+  CHECK( json.find( "\"test/export_histogram\": {\"count\": 1, \"sum\": 5, \"min\": 5, \"max\": 5, \"buckets\": [0, 0, 0, 1]}" ) != std::string::npos );
+
+  recorder.clear();
+}
+
+TEST_CASE( "escape names in exported traces", "[trace]" )
+{
+  auto& recorder = trace_recorder::instance();
+  recorder.clear();
+
+  {
+    trace_scope scope( "test/\"quoted\"\\path\n" );
+  }
+  recorder.counter( std::string( "test/control\x01" ) ).add( 1u );
+
+  std::stringstream chrome;
+  recorder.write_chrome_trace( chrome );
+  CHECK( chrome.str().find( "{\"name\":\"test/\\\"quoted\\\"\\\\path\\n\",\"ph\":\"X\"" ) != std::string::npos );
+  CHECK( chrome.str().find( "{\"name\":\"test/control\\u0001\",\"ph\":\"C\"" ) != std::string::npos );
+
+  std::stringstream flat;
+  recorder.write_json( flat );
+  CHECK( flat.str().find( "\"test/\\\"quoted\\\"\\\\path\\n\": {\"count\": 1" ) != std::string::npos );
+  CHECK( flat.str().find( "\"test/control\\u0001\": 1" ) != std::string::npos );
+
+  recorder.clear();
+}
@@ -0,0 +1,158 @@
+#include <catch.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/traversal.hpp>
+#include <mockturtle/views/depth_view.hpp>
+#include <mockturtle/views/fanout_view.hpp>
+#include <mockturtle/views/topo_view.hpp>
+
+using namespace mockturtle;
+
+static void collect_topo_rec( aig_network const& aig, aig_network::node const& n, std::vector<aig_network::node>& order )
+{
+  if ( aig.visited( n ) == aig.trav_id() )
+    return;
+  aig.set_visited( n, aig.trav_id() );
+
+  aig.foreach_fanin( n, [&]( auto const& f ) {
+    collect_topo_rec( aig, aig.get_node( f ), order );
+  } );
+  order.push_back( n );
+}
+
+TEST_CASE( "iterative DFS visits nodes in the order of the recursion", "[traversal]" )
+{
+  aig_network aig;
+  auto const a = aig.create_pi();
+  auto const b = aig.create_pi();
+  auto const c = aig.create_pi();
+  auto const f1 = aig.create_and( a, b );
+  auto const f2 = aig.create_and( c, f1 );
+  auto const f3 = aig.create_and( f2, !f1 );
+  auto const f4 = aig.create_and( !a, f3 );
+  aig.create_po( f4 );
+  aig.create_po( f2 );
+
+  std::vector<aig_network::node> expected;
+  aig.incr_trav_id();
+  aig.foreach_po( [&]( auto const& f ) {
+    collect_topo_rec( aig, aig.get_node( f ), expected );
+  } );
+
+  std::vector<aig_network::node> order;
+  std::vector<aig_network::node> entered;
+  iterative_dfs<aig_network::node> dfs;
+  aig.incr_trav_id();
+  aig.foreach_po( [&]( auto const& f ) {
+    dfs.run_fanin(
+        aig, aig.get_node( f ),
+        [&]( auto const& n ) {
+          if ( aig.visited( n ) == aig.trav_id() )
+            return false;
+          aig.set_visited( n, aig.trav_id() );
+          entered.push_back( n );
+          return true;
+        },
+        [&]( auto const& n ) {
+          order.push_back( n );
+        } );
+  } );
+
+  CHECK( order == expected );
+  CHECK( entered == std::vector<aig_network::node>{ 7, 1, 6, 4, 2, 5, 3 } );
+}
+
+TEST_CASE( "iterative DFS in the transitive fanout", "[traversal]" )
+{
+  aig_network aig;
+  auto const a = aig.create_pi();
+  auto const b = aig.create_pi();
+  auto const c = aig.create_pi();
+  auto const f1 = aig.create_and( a, b );
+  auto const f2 = aig.create_and( b, c );
+  auto const f3 = aig.create_and( f1, f2 );
+  aig.create_po( f3 );
+
+  fanout_view fanout_aig{ aig };
+
+  std::vector<aig_network::node> tfo;
+  iterative_dfs<aig_network::node> dfs;
+  fanout_aig.incr_trav_id();
+  dfs.run_fanout(
+      fanout_aig, aig.get_node( c ),
+      [&]( auto const& n ) {
+        if ( fanout_aig.visited( n ) == fanout_aig.trav_id() )
+          return false;
+        fanout_aig.set_visited( n, fanout_aig.trav_id() );
+        return true;
+      },
+      [&]( auto const& n ) {
+        tfo.push_back( n );
+      } );
+
+  CHECK( tfo == std::vector<aig_network::node>{ aig.get_node( f3 ), aig.get_node( f2 ), aig.get_node( c ) } );
+}
+
+TEST_CASE( "bucket queue pops by smallest key", "[traversal]" )
+{
+  bucket_queue<uint32_t> queue;
+  CHECK( queue.empty() );
+
+  queue.push( 3u, 30u );
+  queue.push( 1u, 10u );
+  queue.push( 5u, 50u );
+  queue.push( 1u, 11u );
+  CHECK( queue.size() == 4u );
+
+  CHECK( queue.pop() == std::pair<uint32_t, uint32_t>{ 1u, 11u } );
+  CHECK( queue.pop() == std::pair<uint32_t, uint32_t>{ 1u, 10u } );
+
+  /* smaller keys may be pushed after popping */
+  queue.push( 0u, 0u );
+  CHECK( queue.pop() == std::pair<uint32_t, uint32_t>{ 0u, 0u } );
+  CHECK( queue.pop() == std::pair<uint32_t, uint32_t>{ 3u, 30u } );
+  CHECK( queue.pop() == std::pair<uint32_t, uint32_t>{ 5u, 50u } );
+  CHECK( queue.empty() );
+
+  queue.push( 2u, 20u );
+  queue.clear();
+  CHECK( queue.empty() );
+  queue.push( 4u, 40u );
+  CHECK( queue.pop() == std::pair<uint32_t, uint32_t>{ 4u, 40u } );
+}
+
+TEST_CASE( "views and cleanup on a very deep network", "[traversal]" )
+{
+  /* deep enough to overflow the default stack with one frame per level */
+  uint32_t const length = 500000u;
+
+  aig_network aig;
+  auto const a = aig.create_pi();
+  auto const b = aig.create_pi();
+  auto f = aig.create_and( a, b );
+  for ( auto i = 1u; i < length; ++i )
+  {
+    f = aig.create_and( f, ( i & 1 ) ? a : !b );
+  }
+  aig.create_po( f );
+
+  topo_view topo{ aig };
+  CHECK( topo.size() == aig.size() );
+  uint32_t index{ 0u };
+  bool sorted{ true };
+  topo.foreach_node( [&]( auto const& n ) {
+    sorted = sorted && ( n == index++ );
+  } );
+  CHECK( sorted );
+
+  depth_view depth_aig{ aig };
+  CHECK( depth_aig.depth() == length );
+  CHECK( depth_aig.is_on_critical_path( aig.get_node( a ) ) );
+
+  auto const cleaned = cleanup_dangling( aig );
+  CHECK( cleaned.num_gates() == length );
+}
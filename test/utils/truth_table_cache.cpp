@@ -1,7 +1,9 @@
 #include <catch.hpp>
 
+#include <kitty/bit_operations.hpp>
 #include <kitty/constructors.hpp>
 #include <kitty/dynamic_truth_table.hpp>
+#include <kitty/npn.hpp>
 #include <mockturtle/utils/truth_table_cache.hpp>
 
 using namespace mockturtle;
@@ -45,3 +47,109 @@ TEST_CASE( "working with a truth table cache", "[truth_table_cache]" )
   CHECK( cache[8] == f_maj );
   CHECK( cache[9] == ~f_maj );
 }
+
+TEST_CASE( "working with a compact truth table cache", "[truth_table_cache]" )
+{
+  compact_truth_table_cache cache;
+
+  kitty::dynamic_truth_table zero( 0u ), x1( 1u ), f_and( 2u ), f_or( 2u ), f_maj( 3u ), f_large( 8u );
+
+  kitty::create_from_hex_string( x1, "2" );
+  kitty::create_from_hex_string( f_and, "8" );
+  kitty::create_from_hex_string( f_or, "e" );
+  kitty::create_from_hex_string( f_maj, "e8" );
+  kitty::create_random( f_large, 42 );
+  kitty::clear_bit( f_large, 0 );
+
+  CHECK( cache.size() == 0 );
+  CHECK( cache.insert( zero ) == 0 );
+  CHECK( cache.insert( x1 ) == 2 );
+  CHECK( cache.insert( f_and ) == 4 );
+  CHECK( cache.insert( f_or ) == 6 );
+  CHECK( cache.insert( f_maj ) == 8 );
+  CHECK( cache.insert( f_large ) == 10 );
+
+  CHECK( cache.size() == 6 );
+
+  CHECK( cache.insert( ~zero ) == 1 );
+  CHECK( cache.insert( ~x1 ) == 3 );
+  CHECK( cache.insert( ~f_and ) == 5 );
+  CHECK( cache.insert( ~f_or ) == 7 );
+  CHECK( cache.insert( ~f_maj ) == 9 );
+  CHECK( cache.insert( ~f_large ) == 11 );
+
+  CHECK( cache.size() == 6 );
+
+  CHECK( cache[0] == zero );
+  CHECK( cache[1] == ~zero );
+  CHECK( cache[2] == x1 );
+  CHECK( cache[3] == ~x1 );
+  CHECK( cache[4] == f_and );
+  CHECK( cache[5] == ~f_and );
+  CHECK( cache[6] == f_or );
+  CHECK( cache[7] == ~f_or );
+  CHECK( cache[8] == f_maj );
+  CHECK( cache[9] == ~f_maj );
+  CHECK( cache[10] == f_large );
+  CHECK( cache[11] == ~f_large );
+
+  /* references access the stored words without copying */
+  auto const ref = cache.get( 9 );
+  CHECK( ref.num_vars() == 3u );
+  CHECK( ref.num_blocks() == 1u );
+  CHECK( ref.block( 0 ) == 0x17 );
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    CHECK( ref.get_bit( i ) == kitty::get_bit( ~f_maj, i ) );
+  }
+
+  auto const large_ref = cache.get( 11 );
+  CHECK( large_ref.num_blocks() == 4u );
+  for ( auto i = 0u; i < 4u; ++i )
+  {
+    CHECK( large_ref.block( i ) == ( ~f_large )._bits[i] );
+  }
+
+  /* copies and moves keep the index */
+  auto copy = cache;
+  CHECK( copy.insert( f_maj ) == 8 );
+  auto const copy_ref = copy.get( 11 );
+  auto moved = std::move( copy );
+  CHECK( moved.insert( ~f_large ) == 11 );
+  CHECK( moved.size() == 6 );
+
+  /* moves keep the words in place */
+  CHECK( copy_ref.block( 0 ) == ( ~f_large )._bits[0] );
+
+  /* moved-from caches remain usable */
+  CHECK( copy.size() == 0 );
+  CHECK( copy.insert( f_or ) == 0 );
+  moved = std::move( copy );
+  CHECK( moved.size() == 1 );
+  CHECK( moved.insert( f_or ) == 0 );
+  CHECK( moved.insert( f_and ) == 2 );
+}
+
+TEST_CASE( "NPN classes in a compact truth table cache", "[truth_table_cache]" )
+{
+  compact_truth_table_cache cache;
+
+  kitty::dynamic_truth_table f_and( 2u ), f_or( 2u ), f_lt( 2u ), f_xor( 2u );
+  kitty::create_from_hex_string( f_and, "8" );
+  kitty::create_from_hex_string( f_or, "e" );
+  kitty::create_from_hex_string( f_lt, "2" );
+  kitty::create_from_hex_string( f_xor, "6" );
+
+  auto const [l_and, phase_and, perm_and] = cache.insert_npn( f_and );
+  auto const [l_or, phase_or, perm_or] = cache.insert_npn( f_or );
+  auto const [l_lt, phase_lt, perm_lt] = cache.insert_npn( f_lt );
+  auto const [l_xor, phase_xor, perm_xor] = cache.insert_npn( f_xor );
+
+  CHECK( ( l_and >> 1 ) == ( l_or >> 1 ) );
+  CHECK( ( l_and >> 1 ) == ( l_lt >> 1 ) );
+  CHECK( ( l_and >> 1 ) != ( l_xor >> 1 ) );
+  CHECK( cache.size() == 2u );
+
+  CHECK( kitty::create_from_npn_config( std::make_tuple( cache[l_or], phase_or, perm_or ) ) == f_or );
+  CHECK( kitty::create_from_npn_config( std::make_tuple( cache[l_lt], phase_lt, perm_lt ) ) == f_lt );
+}
@@ -0,0 +1,98 @@
+#include <catch.hpp>
+
+#include <kitty/bit_operations.hpp>
+#include <kitty/constructors.hpp>
+#include <kitty/operators.hpp>
+#include <kitty/partial_truth_table.hpp>
+#include <kitty/static_truth_table.hpp>
+#include <mockturtle/utils/word_operations.hpp>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace mockturtle;
+
+namespace
+{
+
+std::vector<uint64_t> random_words( std::mt19937_64& rng, uint64_t num_words, uint32_t sparsity )
+{
+  std::vector<uint64_t> words( num_words );
+  for ( auto& w : words )
+  {
+    w = rng();
+    for ( auto i = 0u; i < sparsity; ++i )
+    {
+      w &= rng();
+    }
+  }
+  return words;
+}
+
+} // namespace
+
+TEST_CASE( "check and count words of gates", "[word_operations]" )
+{
+  std::mt19937_64 rng( 1u );
+  uint64_t const ones = ~uint64_t( 0 );
+
+  /* lengths around the vector widths */
+  for ( uint64_t num_words : { 1u, 3u, 4u, 5u, 8u, 9u, 16u, 17u, 63u } )
+  {
+    for ( auto round = 0u; round < 50u; ++round )
+    {
+      /* sparse words, such that some intersections are empty */
+      auto const a = random_words( rng, num_words, round % 8u );
+      auto const b = random_words( rng, num_words, round % 5u );
+      auto c = random_words( rng, num_words, round % 7u );
+      if ( round % 3u == 0u )
+      {
+        c[num_words - 1u] = 0u;
+      }
+
+      for ( auto ca : { uint64_t( 0 ), ones } )
+      {
+        for ( auto cb : { uint64_t( 0 ), ones } )
+        {
+          uint64_t and_bits{ 0 }, and3_bits{ 0 }, xor_bits{ 0 };
+          bool and_zero{ true }, and3_zero{ true }, xor_zero{ true };
+          for ( auto i = 0u; i < num_words; ++i )
+          {
+            auto const w_and = ( a[i] ^ ca ) & ( b[i] ^ cb );
+            auto const w_and3 = w_and & c[i];
+            auto const w_xor = ( a[i] ^ b[i] ^ ca ^ cb ) & c[i];
+            and_bits += __builtin_popcountll( w_and );
+            and3_bits += __builtin_popcountll( w_and3 );
+            xor_bits += __builtin_popcountll( w_xor );
+            and_zero = and_zero && w_and == 0u;
+            and3_zero = and3_zero && w_and3 == 0u;
+            xor_zero = xor_zero && w_xor == 0u;
+          }
+
+          CHECK( and_is_zero_words( a.data(), ca, b.data(), cb, num_words ) == and_zero );
+          CHECK( and3_is_zero_words( a.data(), ca, b.data(), cb, c.data(), 0u, num_words ) == and3_zero );
+          CHECK( and3_is_zero_words( c.data(), 0u, a.data(), ca, b.data(), cb, num_words ) == and3_zero );
+          CHECK( xor_and_is_zero_words( a.data(), b.data(), ca ^ cb, c.data(), num_words ) == xor_zero );
+          CHECK( count_and_words( a.data(), ca, b.data(), cb, num_words ) == and_bits );
+          CHECK( count_and3_words( a.data(), ca, b.data(), cb, c.data(), 0u, num_words ) == and3_bits );
+          CHECK( count_xor_and_words( a.data(), b.data(), ca ^ cb, c.data(), num_words ) == xor_bits );
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE( "access words of truth tables", "[word_operations]" )
+{
+  kitty::partial_truth_table a( 200u ), b( 200u );
+  kitty::create_random( a, 1u );
+  kitty::create_random( b, 2u );
+  CHECK( count_and_words( truth_table_words( a ), 0u, truth_table_words( b ), ~uint64_t( 0 ), a.num_blocks() ) == kitty::count_ones( a & ~b ) );
+  CHECK( and_is_zero_words( truth_table_words( a ), 0u, truth_table_words( ~a ), 0u, a.num_blocks() ) );
+
+  kitty::static_truth_table<6> x, y;
+  kitty::create_nth_var( x, 0 );
+  kitty::create_nth_var( y, 1 );
+  CHECK( count_xor_and_words( truth_table_words( x ), truth_table_words( y ), 0u, truth_table_words( x ), 1u ) == 16u );
+}
@@ -0,0 +1,145 @@
+#include <catch.hpp>
+
+#include <set>
+
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/networks/xmg.hpp>
+#include <mockturtle/traits.hpp>
+#include <mockturtle/views/compact_fanout_view.hpp>
+#include <mockturtle/views/fanout_view.hpp>
+
+using namespace mockturtle;
+
+template<typename Ntk>
+void test_compact_fanout_computation()
+{
+  using node = node<Ntk>;
+  using nodes_t = std::set<node>;
+
+  CHECK( has_foreach_fanout_v<compact_fanout_view<Ntk>> );
+
+  Ntk ntk;
+  auto const a = ntk.create_pi();
+  auto const b = ntk.create_pi();
+  auto const f1 = ntk.create_and( a, b );
+  auto const f2 = ntk.create_and( a, f1 );
+  auto const f3 = ntk.create_and( b, f1 );
+  auto const f4 = ntk.create_and( f2, f3 );
+  ntk.create_po( f4 );
+
+  compact_fanout_view fanout_ntk{ ntk };
+  auto const fanouts = [&]( auto const& f ) {
+    nodes_t nodes;
+    fanout_ntk.foreach_fanout( ntk.get_node( f ), [&]( const auto& p ) { nodes.insert( p ); } );
+    return nodes;
+  };
+
+  CHECK( fanouts( a ) == nodes_t{ ntk.get_node( f1 ), ntk.get_node( f2 ) } );
+  CHECK( fanouts( b ) == nodes_t{ ntk.get_node( f1 ), ntk.get_node( f3 ) } );
+  CHECK( fanouts( f1 ) == nodes_t{ ntk.get_node( f2 ), ntk.get_node( f3 ) } );
+  CHECK( fanouts( f2 ) == nodes_t{ ntk.get_node( f4 ) } );
+  CHECK( fanouts( f3 ) == nodes_t{ ntk.get_node( f4 ) } );
+  CHECK( fanouts( f4 ) == nodes_t{} );
+}
+
+TEST_CASE( "compute fanouts in compact fanout view", "[compact_fanout_view]" )
+{
+  test_compact_fanout_computation<aig_network>();
+  test_compact_fanout_computation<xag_network>();
+  test_compact_fanout_computation<mig_network>();
+  test_compact_fanout_computation<xmg_network>();
+  test_compact_fanout_computation<klut_network>();
+}
+
+TEST_CASE( "update compact fanout view on network events", "[compact_fanout_view]" )
+{
+  aig_network aig;
+  std::vector<aig_network::signal> a( 8u ), b( 8u );
+  std::generate( a.begin(), a.end(), [&]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return aig.create_pi(); } );
+  auto carry = aig.get_constant( false );
+  carry_ripple_adder_inplace( aig, a, b, carry );
+  for ( auto const& s : a )
+  {
+    aig.create_po( s );
+  }
+  aig.create_po( carry );
+
+  /* no free slots to exercise relocations and compactions */
+  compact_fanout_view_params ps;
+  ps.slack = 0u;
+  compact_fanout_view<aig_network> compact_aig{ aig, ps };
+  fanout_view<aig_network> fanout_aig{ aig };
+
+  /* substitute every gate by an equivalent structure */
+  std::vector<aig_network::node> gates;
+  aig.foreach_gate( [&]( auto const& n ) { gates.push_back( n ); } );
+  for ( auto const& n : gates )
+  {
+    if ( aig.is_dead( n ) )
+      continue;
+
+    auto const f0 = aig._storage->nodes[n].children[0];
+    auto const f1 = aig._storage->nodes[n].children[1];
+    aig_network::signal const x{ f0 }, y{ f1 };
+    compact_aig.substitute_node( n, compact_aig.create_xor( x, compact_aig.create_and( x, !y ) ) );
+  }
+
+  aig.foreach_node( [&]( auto const& n ) {
+    std::vector<aig_network::node> expected, actual;
+    fanout_aig.foreach_fanout( n, [&]( auto const& p ) { expected.push_back( p ); } );
+    compact_aig.foreach_fanout( n, [&]( auto const& p ) { actual.push_back( p ); } );
+    std::sort( expected.begin(), expected.end() );
+    std::sort( actual.begin(), actual.end() );
+    CHECK( expected == actual );
+  } );
+}
+
+TEST_CASE( "substitute node with dependency in compact fanout view", "[compact_fanout_view]" )
+{
+  aig_network aig{};
+  compact_fanout_view faig( aig );
+
+  auto const a = faig.create_pi();
+  auto const b = faig.create_pi();
+  auto const c = faig.create_pi();
+  auto const tmp = faig.create_and( b, c );
+  auto const f1 = faig.create_and( a, b );
+  auto const f2 = faig.create_and( tmp, a );
+  auto const f3 = faig.create_and( f1, f2 );
+  faig.create_po( f3 );
+  faig.substitute_node( faig.get_node( tmp ), f1 );
+  faig.substitute_node( faig.get_node( f1 ), faig.get_constant( 1 ) );
+
+  CHECK( faig.is_dead( faig.get_node( f1 ) ) );
+  CHECK( faig.is_dead( faig.get_node( f2 ) ) );
+  CHECK( faig.is_dead( faig.get_node( f3 ) ) );
+  aig.foreach_po( [&]( auto s ) {
+    CHECK( aig.is_dead( aig.get_node( s ) ) == false );
+  } );
+}
+
+TEST_CASE( "substitute node without restrashing in compact fanout view", "[compact_fanout_view]" )
+{
+  aig_network aig;
+  compact_fanout_view faig( aig );
+  auto const x1 = faig.create_pi();
+  auto const x2 = faig.create_pi();
+  auto const f1 = faig.create_and( x1, x2 );
+  auto const f2 = faig.create_and( x1, f1 );
+  faig.create_po( f2 );
+
+  CHECK( simulate<kitty::static_truth_table<2u>>( faig )[0]._bits == 0x8 );
+
+  faig.substitute_node_no_restrash( faig.get_node( f2 ), !f2 );
+
+  CHECK( faig.fanout_size( faig.get_node( x1 ) ) == 2 );
+  CHECK( faig.fanout_size( faig.get_node( f1 ) ) == 1 );
+  CHECK( faig.fanout( faig.get_node( f1 ) ) == std::vector<aig_network::node>{ faig.get_node( f2 ) } );
+  CHECK( simulate<kitty::static_truth_table<2u>>( faig )[0]._bits == 0x7 );
+}
@@ -1,6 +1,12 @@
 #include <catch.hpp>
 
+#include <algorithm>
 #include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/networks/klut.hpp>
@@ -120,3 +126,56 @@ TEST_CASE( "copy names", "[names_view]" )
   test_copy_names_view<xmg_network>();
   test_copy_names_view<klut_network>();
 }
+
+TEST_CASE( "names of complemented signals and bulk export", "[names_view]" )
+{
+  names_view<aig_network> aig;
+  auto const a = aig.create_pi( "a" );
+  auto const b = aig.create_pi( "b" );
+  auto const f = aig.create_and( a, b );
+  aig.create_po( f, "f" );
+  aig.create_po( !f );
+
+  aig.set_name( f, "t" );
+  aig.set_name( !f, "t_n" );
+  aig.set_name( aig.get_constant( true ), "one" );
+  aig.set_name( a, "x" ); /* renames a */
+
+  CHECK( !aig.has_name( !a ) );
+  CHECK( !aig.has_name( aig.get_constant( false ) ) );
+  CHECK( aig.get_name( a ) == "x" );
+  CHECK( aig.get_name( f ) == "t" );
+  CHECK( aig.get_name( !f ) == "t_n" );
+  CHECK( aig.get_name_view( aig.get_constant( true ) ) == "one" );
+  CHECK( aig.has_output_name( 0 ) );
+  CHECK( !aig.has_output_name( 1 ) );
+  CHECK( !aig.has_output_name( 2 ) );
+  CHECK_THROWS_AS( aig.get_name( !a ), std::out_of_range );
+  CHECK_THROWS_AS( aig.get_output_name( 1 ), std::out_of_range );
+
+  std::vector<std::pair<aig_network::signal, std::string>> names;
+  aig.foreach_name( [&]( auto const& s, std::string_view name ) {
+    names.emplace_back( s, std::string( name ) );
+  } );
+  CHECK( names.size() == 5u );
+  CHECK( names[0] == std::make_pair( a, std::string( "x" ) ) );
+  CHECK( names[1] == std::make_pair( b, std::string( "b" ) ) );
+  CHECK( names[2] == std::make_pair( f, std::string( "t" ) ) );
+  CHECK( std::count( names.begin(), names.end(), std::make_pair( !f, std::string( "t_n" ) ) ) == 1 );
+  CHECK( std::count( names.begin(), names.end(), std::make_pair( aig.get_constant( true ), std::string( "one" ) ) ) == 1 );
+
+  std::vector<std::pair<uint32_t, std::string>> output_names;
+  aig.foreach_output_name( [&]( auto index, std::string_view name ) {
+    output_names.emplace_back( index, std::string( name ) );
+  } );
+  CHECK( output_names == std::vector<std::pair<uint32_t, std::string>>{ { 0u, "f" } } );
+
+  /* names are restored in bulk into another view */
+  names_view<aig_network> copy{ aig };
+  copy.reserve_names( 5u, 16u );
+  aig.foreach_name( [&]( auto const& s, std::string_view name ) {
+    copy.set_name( s, name );
+  } );
+  CHECK( copy.get_name( !f ) == "t_n" );
+  CHECK( copy.get_name( b ) == "b" );
+}
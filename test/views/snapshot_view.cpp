@@ -0,0 +1,126 @@
+#include <catch.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/io/serialize.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/views/depth_view.hpp>
+#include <mockturtle/views/names_view.hpp>
+#include <mockturtle/views/snapshot_view.hpp>
+
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/static_truth_table.hpp>
+
+using namespace mockturtle;
+
+TEST_CASE( "load aig_network from a mapped snapshot", "[snapshot_view]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+  const auto f1 = aig.create_and( a, b );
+  const auto f2 = aig.create_and( !f1, c );
+  const auto f3 = aig.create_or( f2, a );
+  aig.create_po( f3 );
+  aig.create_po( !f2 );
+
+  serialize_network( aig, std::string( "snapshot_view.snap" ) );
+
+  snapshot_view<aig_network> snap{ "snapshot_view.snap" };
+  CHECK( snap.is_valid() );
+  CHECK( !snap.has_hash() );
+  CHECK( snap.size() == aig.size() );
+  CHECK( snap.num_pis() == aig.num_pis() );
+  CHECK( snap.num_pos() == aig.num_pos() );
+  CHECK( snap._storage->nodes == aig._storage->nodes );
+  CHECK( snap._storage->hash.empty() );
+
+  /* analysis passes work without the hash table */
+  depth_view depth_snap{ snap };
+  CHECK( depth_snap.depth() == 3u );
+
+  const auto tts = simulate<kitty::static_truth_table<3u>>( snap );
+  const auto tts_aig = simulate<kitty::static_truth_table<3u>>( aig );
+  CHECK( tts == tts_aig );
+  CHECK( !snap.has_hash() );
+
+  /* unlocking loads the hash table */
+  auto aig2 = snap.unlock();
+  REQUIRE( aig2 );
+  CHECK( snap.has_hash() );
+  CHECK( aig2->_storage->hash == aig._storage->hash );
+  CHECK( aig2->create_and( a, b ) == f1 );
+  CHECK( aig2->size() == aig.size() );
+  CHECK( snap.unlock()->size() == aig.size() );
+
+  std::remove( "snapshot_view.snap" );
+}
+
+TEST_CASE( "load names_view<klut_network> from a mapped snapshot", "[snapshot_view]" )
+{
+  names_view<klut_network> klut;
+  const auto a = klut.create_pi();
+  const auto b = klut.create_pi();
+  const auto f = klut.create_xor( a, b );
+  klut.create_po( f );
+  klut.set_name( a, "a" );
+  klut.set_name( b, "b" );
+  klut.set_output_name( 0, "y" );
+
+  serialize_network( klut, std::string( "snapshot_view_klut.snap" ) );
+
+  snapshot_view<names_view<klut_network>> snap{ "snapshot_view_klut.snap" };
+  CHECK( snap.is_valid() );
+  CHECK( snap.get_name( a ) == "a" );
+  CHECK( snap.get_output_name( 0 ) == "y" );
+  CHECK( simulate<kitty::dynamic_truth_table>( snap, default_simulator<kitty::dynamic_truth_table>( 2u ) )[0]._bits[0] == 0x6 );
+
+  auto klut2 = snap.unlock();
+  REQUIRE( klut2 );
+  CHECK( klut2->create_xor( a, b ) == f );
+  CHECK( klut2->get_name( b ) == "b" );
+
+  /* invalid files and network types are rejected */
+  snapshot_view<aig_network> wrong{ "snapshot_view_klut.snap" };
+  CHECK( !wrong.is_valid() );
+  snapshot_view<klut_network> missing{ "snapshot_view_missing.snap" };
+  CHECK( !missing.is_valid() );
+  CHECK( !missing.unlock() );
+
+  std::remove( "snapshot_view_klut.snap" );
+}
+
+TEST_CASE( "report a corrupt hash table when unlocking a snapshot", "[snapshot_view]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  aig.create_po( aig.create_and( a, b ) );
+
+  std::string const filename = "snapshot_view_hash.snap";
+  serialize_network( aig, filename );
+
+  /* the hash section is followed by the empty data section; overwrite its kind */
+  {
+    std::fstream file( filename, std::ios::in | std::ios::out | std::ios::binary );
+    file.seekg( 0, std::ios::end );
+    auto const size = static_cast<uint64_t>( file.tellg() );
+    auto const num_slots = aig._storage->hash.slots().size();
+    uint64_t const kind = 42u;
+    file.seekp( size - sizeof( uint64_t ) * ( 4u + num_slots ) );
+    file.write( reinterpret_cast<char const*>( &kind ), sizeof( kind ) );
+  }
+
+  snapshot_view<aig_network> snap{ filename };
+  CHECK( snap.is_valid() );
+  CHECK( !snap.unlock() );
+  CHECK( !snap.has_hash() );
+  CHECK( snap._storage->hash.empty() );
+
+  std::remove( filename.c_str() );
+}
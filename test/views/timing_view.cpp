@@ -0,0 +1,168 @@
+#include <catch.hpp>
+
+#include <mockturtle/algorithms/mig_algebraic_rewriting.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
+#include <mockturtle/generators/random_network.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/traits.hpp>
+#include <mockturtle/views/depth_view.hpp>
+#include <mockturtle/views/fanout_view.hpp>
+#include <mockturtle/views/timing_view.hpp>
+
+#include <random>
+
+using namespace mockturtle;
+
+TEST_CASE( "create timing view", "[timing_view]" )
+{
+  using timing_ntk = timing_view<fanout_view<aig_network>>;
+
+  CHECK( is_network_type_v<timing_ntk> );
+  CHECK( has_depth_v<timing_ntk> );
+  CHECK( has_level_v<timing_ntk> );
+  CHECK( has_update_levels_v<timing_ntk> );
+}
+
+TEST_CASE( "compute arrival and required times for AIG", "[timing_view]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+  const auto f1 = aig.create_and( a, b );
+  const auto f2 = aig.create_and( f1, c );
+  const auto f3 = aig.create_and( a, c );
+  aig.create_po( f2 );
+  aig.create_po( f3 );
+
+  fanout_view fanout_aig{ aig };
+  timing_view aig_t{ fanout_aig };
+
+  CHECK( aig_t.depth() == 2u );
+  CHECK( aig_t.level( aig.get_node( a ) ) == 0u );
+  CHECK( aig_t.level( aig.get_node( f1 ) ) == 1u );
+  CHECK( aig_t.level( aig.get_node( f2 ) ) == 2u );
+  CHECK( aig_t.level( aig.get_node( f3 ) ) == 1u );
+
+  CHECK( aig_t.required( aig.get_node( a ) ) == 0 );
+  CHECK( aig_t.required( aig.get_node( c ) ) == 1 );
+  CHECK( aig_t.required( aig.get_node( f3 ) ) == 2 );
+  CHECK( aig_t.slack( aig.get_node( f1 ) ) == 0 );
+  CHECK( aig_t.slack( aig.get_node( f3 ) ) == 1 );
+  CHECK( aig_t.slack( aig.get_node( c ) ) == 1 );
+  CHECK( aig_t.is_on_critical_path( aig.get_node( b ) ) );
+  CHECK( !aig_t.is_on_critical_path( aig.get_node( f3 ) ) );
+
+  aig_t.set_required_time( 4u );
+  CHECK( aig_t.slack( aig.get_node( f1 ) ) == 2 );
+  CHECK( aig_t.required( aig.get_node( f2 ) ) == 4 );
+  aig_t.reset_required_time();
+
+  /* deepen the second output */
+  const auto f4 = aig_t.create_and( f2, b );
+  aig_t.substitute_node( aig.get_node( f3 ), aig_t.create_and( f4, a ) );
+
+  CHECK( aig_t.depth() == 4u );
+  CHECK( aig_t.level( aig.get_node( f4 ) ) == 3u );
+  CHECK( aig_t.slack( aig.get_node( f1 ) ) == 0 );
+  CHECK( aig_t.slack( aig.get_node( c ) ) == 1 );
+  CHECK( aig_t.required( aig.get_node( a ) ) == 0 );
+  CHECK( aig_t.required( aig.get_node( c ) ) == 1 );
+
+  /* new outputs */
+  aig_t.create_po( f1 );
+  CHECK( aig_t.depth() == 4u );
+  aig_t.create_po( aig_t.create_and( aig_t.create_and( f4, c ), b ) );
+  CHECK( aig_t.depth() == 5u );
+}
+
+template<class Ntk>
+static void collect_tfo( Ntk const& ntk, node<Ntk> const& n, std::vector<bool>& tfo )
+{
+  if ( tfo[ntk.node_to_index( n )] )
+    return;
+  tfo[ntk.node_to_index( n )] = true;
+  ntk.foreach_fanout( n, [&]( auto const& g ) {
+    collect_tfo( ntk, g, tfo );
+  } );
+}
+
+TEST_CASE( "incremental timing under random substitutions", "[timing_view]" )
+{
+  random_network_generator_params_size gps;
+  gps.num_pis = 10u;
+  gps.num_gates = 200u;
+  auto gen = random_aig_generator( gps );
+  aig_network aig = gen.generate();
+
+  timing_view aig_t{ fanout_view<aig_network>{ aig } };
+  std::mt19937 rng( 42u );
+
+  for ( auto i = 0u; i < 100u; ++i )
+  {
+    /* pick a random gate to substitute */
+    std::vector<aig_network::node> gates;
+    aig_t.foreach_gate( [&]( auto const& n ) {
+      gates.push_back( n );
+    } );
+    if ( gates.empty() )
+      break;
+    auto const n = gates[rng() % gates.size()];
+
+    /* the new function uses a fanin of n and a node outside the TFO of n */
+    std::vector<bool> tfo( aig_t.size(), false );
+    collect_tfo( aig_t, n, tfo );
+    std::vector<aig_network::node> candidates;
+    aig_t.foreach_node( [&]( auto const& m ) {
+      if ( !tfo[aig_t.node_to_index( m )] && !aig_t.is_dead( m ) )
+        candidates.push_back( m );
+    } );
+
+    std::vector<aig_network::signal> fanins;
+    aig_t.foreach_fanin( n, [&]( auto const& f ) {
+      fanins.push_back( f );
+    } );
+    auto const fanin = fanins[rng() % fanins.size()];
+    auto const other = aig_t.make_signal( candidates[rng() % candidates.size()] );
+    aig_t.substitute_node( n, aig_t.create_and( fanin, ( rng() % 2u ) ? other : !other ) );
+
+    /* compare with a full recomputation */
+    depth_view aig_d{ aig };
+    CHECK( aig_t.depth() == aig_d.depth() );
+    aig_d.foreach_node( [&]( auto const& m ) {
+      if ( aig_d.is_dead( m ) || !aig_d.is_on_critical_path( m ) )
+        return;
+      CHECK( aig_t.level( m ) == aig_d.level( m ) );
+      CHECK( aig_t.is_on_critical_path( m ) );
+      CHECK( aig_t.slack( m ) == 0 );
+    } );
+  }
+
+  /* only the affected nodes are updated */
+  CHECK( aig_t.num_updates() < 100u * aig.size() );
+}
+
+TEST_CASE( "MIG depth rewriting on timing view", "[timing_view]" )
+{
+  mig_network mig;
+  std::vector<mig_network::signal> a( 8 ), b( 8 );
+  std::generate( a.begin(), a.end(), [&mig]() { return mig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&mig]() { return mig.create_pi(); } );
+  auto carry = mig.get_constant( false );
+  carry_ripple_adder_inplace( mig, a, b, carry );
+  std::for_each( a.begin(), a.end(), [&]( auto f ) { mig.create_po( f ); } );
+  mig.create_po( carry );
+
+  mig_network mig2 = mig.clone();
+
+  depth_view mig_d{ mig };
+  mig_algebraic_depth_rewriting( mig_d );
+
+  timing_view mig_t{ fanout_view<mig_network>{ mig2 } };
+  mig_algebraic_depth_rewriting( mig_t );
+
+  CHECK( mig_t.depth() < 16u );
+  CHECK( mig_t.depth() == mig_d.depth() );
+  CHECK( mig_t.num_gates() == mig_d.num_gates() );
+}